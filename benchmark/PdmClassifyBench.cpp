@@ -0,0 +1,122 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+
+// Measures the per-uevent cost of DeviceClassFactory::create() with the
+// subsystem dispatch table against probing every registered subsystem in
+// turn, as the factory did before subsystems declared their match keys.
+//
+// usage: pdm-classify-bench [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AutoAndroidSubSystem.h"
+#include "BluetoothSubSystem.h"
+#include "CdcSubSystem.h"
+#include "DefaultSubSystem.h"
+#include "DeviceClassFactory.h"
+#include "GamepadSubSystem.h"
+#include "HIDSubsystem.h"
+#include "MTPSubsystem.h"
+#include "NfcSubsystem.h"
+#include "PTPSubsystem.h"
+#include "SoundSubsystem.h"
+#include "StorageSubsystem.h"
+#include "VideoSubsystem.h"
+
+namespace {
+    using DevProps = std::unordered_map<std::string, std::string>;
+
+    // Property sets of typical uevents seen while a device is plugged in
+    std::vector<DevProps> sampleEvents()
+    {
+        return {
+            {{"ACTION", "add"}, {"SUBSYSTEM", "usb"}, {"DEVTYPE", "usb_device"},
+             {"DEVPATH", "/devices/platform/xhci-hcd.0.auto/usb1/1-1"}, {"ID_USB_INTERFACES", ":080650:"},
+             {"ID_VENDOR_ID", "0781"}, {"ID_MODEL_ID", "5581"}, {"DEVNAME", "bus/usb/001/002"}},
+            {{"ACTION", "add"}, {"SUBSYSTEM", "block"}, {"DEVTYPE", "disk"},
+             {"DEVPATH", "/devices/platform/xhci-hcd.0.auto/usb1/1-1/1-1:1.0/host0/target0:0:0/0:0:0:0/block/sda"},
+             {"ID_USB_INTERFACES", ":080650:"}, {"DEVNAME", "sda"}, {"ID_BUS", "usb"}},
+            {{"ACTION", "add"}, {"SUBSYSTEM", "block"}, {"DEVTYPE", "partition"},
+             {"DEVPATH", "/devices/platform/xhci-hcd.0.auto/usb1/1-1/1-1:1.0/host0/target0:0:0/0:0:0:0/block/sda/sda1"},
+             {"ID_USB_INTERFACES", ":080650:"}, {"DEVNAME", "sda1"}, {"ID_FS_TYPE", "vfat"}},
+            {{"ACTION", "add"}, {"SUBSYSTEM", "usb"}, {"DEVTYPE", "usb_device"},
+             {"DEVPATH", "/devices/platform/xhci-hcd.0.auto/usb1/1-2"}, {"ID_USB_INTERFACES", ":030101:030000:"}},
+            {{"ACTION", "add"}, {"SUBSYSTEM", "sound"}, {"DEVPATH", "/devices/platform/xhci-hcd.0.auto/usb1/1-3/1-3:1.0/sound/card1"},
+             {"ID_USB_INTERFACES", ":010100:010200:030000:"}},
+            {{"ACTION", "add"}, {"SUBSYSTEM", "video4linux"}, {"DEVNAME", "video0"},
+             {"DEVPATH", "/devices/platform/xhci-hcd.0.auto/usb1/1-4/1-4:1.0/video4linux/video0"},
+             {"ID_USB_INTERFACES", ":0e0100:0e0200:010100:010200:"}},
+            {{"ACTION", "add"}, {"SUBSYSTEM", "usb"}, {"DEVTYPE", "usb_device"},
+             {"DEVPATH", "/devices/platform/xhci-hcd.0.auto/usb1/1-5"}, {"ID_USB_INTERFACES", ":e00101:"}, {"ID_BLUETOOTH", "1"}},
+            {{"ACTION", "add"}, {"SUBSYSTEM", "usb"}, {"DEVTYPE", "usb_interface"},
+             {"DEVPATH", "/devices/platform/xhci-hcd.0.auto/usb1/1-1/1-1:1.0"}},
+            {{"ACTION", "add"}, {"SUBSYSTEM", "usb"}, {"DEVTYPE", "usb_device"},
+             {"DEVPATH", "/devices/platform/xhci-hcd.0.auto/usb2"}, {"ID_USB_INTERFACES", ":090000:"}},
+        };
+    }
+
+    template <class Classify>
+    double runBenchmark(const std::vector<DevProps> &events, size_t iterations, Classify classify)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            for (auto const& event : events) {
+                DevProps props = event;
+                delete classify(props);
+            }
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        return static_cast<double>(elapsed.count()) / (iterations * events.size());
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t iterations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    std::vector<DevProps> events = sampleEvents();
+
+    std::vector<std::function<DeviceClass*(const PdmDevPropertyBlockPtr&)>> probeOrder = {
+        &StorageSubsystem::create, &SoundSubsystem::create, &VideoSubsystem::create, &HIDSubsystem::create,
+        &MTPSubsystem::create, &PTPSubsystem::create, &CdcSubSystem::create, &BluetoothSubSystem::create,
+        &GamepadSubSystem::create, &NfcSubsystem::create, &AutoAndroidSubSystem::create
+    };
+
+    double probeNs = runBenchmark(events, iterations, [&probeOrder](DevProps &props) -> DeviceClass* {
+        PdmDevPropertyBlockPtr devProps = std::make_shared<const PdmDevPropertyBlock>(props, false);
+        for (auto const& create : probeOrder) {
+            DeviceClass *devClass = create(devProps);
+            if (devClass)
+                return devClass;
+        }
+        return DefaultSubSystem::create(devProps);
+    });
+    double dispatchNs = runBenchmark(events, iterations, [](DevProps &props) {
+        return DeviceClassFactory::getInstance().create(props, false);
+    });
+
+    std::printf("events: %zu iterations: %zu\n", events.size(), iterations);
+    std::printf("probing all subsystems: %8.1f ns/event\n", probeNs);
+    std::printf("dispatch table:         %8.1f ns/event\n", dispatchNs);
+    return 0;
+}
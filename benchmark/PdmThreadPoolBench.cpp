@@ -0,0 +1,206 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+// Compares the locked std::function queue of PdmThreadPool::enqueue() with
+// the allocation free ring used by PdmThreadPool::post(): submit throughput
+// under load, and the wake-up latency from submitting a task to an idle pool
+// until the task starts. Also checks that a single worker runs post() and
+// enqueue() tasks in submission order when the ring overflows.
+//
+// usage: pdm-threadpool-bench [producers] [tasks per producer] [workers] [wake-up samples]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "PdmThreadPool.h"
+
+namespace {
+    std::atomic<size_t> sCompleted(0);
+
+    void countTask(void *context, void *arg)
+    {
+        sCompleted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool countCallable()
+    {
+        sCompleted.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    template <class Submit>
+    double runBenchmark(size_t producers, size_t tasksPerProducer, size_t workers, Submit submit)
+    {
+        sCompleted = 0;
+        size_t total = producers * tasksPerProducer;
+        auto start = std::chrono::steady_clock::now();
+        {
+            PdmThreadPool pool(workers);
+            std::vector<std::thread> producerThreads;
+            for (size_t p = 0; p < producers; p++) {
+                producerThreads.emplace_back([&pool, &submit, tasksPerProducer]() {
+                    for (size_t i = 0; i < tasksPerProducer; i++)
+                        submit(pool);
+                });
+            }
+            for (auto &producer : producerThreads)
+                producer.join();
+            while (sCompleted.load() < total)
+                std::this_thread::yield();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        return static_cast<double>(elapsed.count()) / total;
+    }
+
+    struct WakeupSample {
+        std::chrono::steady_clock::time_point submitted;
+        std::atomic<int64_t> latencyNs;
+    };
+
+    void wakeupTask(void *context, void *arg)
+    {
+        WakeupSample *sample = static_cast<WakeupSample*>(arg);
+        sample->latencyNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - sample->submitted).count());
+    }
+
+    bool wakeupCallable(WakeupSample *sample)
+    {
+        wakeupTask(nullptr, sample);
+        return true;
+    }
+
+    struct WakeupStats {
+        int64_t p50;
+        int64_t p99;
+        int64_t max;
+    };
+
+    // One task at a time into a pool whose workers went back to sleep, so
+    // every sample pays the full post-to-start wake-up
+    template <class Submit>
+    WakeupStats runWakeup(size_t samples, size_t workers, Submit submit)
+    {
+        std::vector<int64_t> latencies;
+        latencies.reserve(samples);
+        PdmThreadPool pool(workers);
+        WakeupSample sample;
+        for (size_t i = 0; i < samples; i++) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            sample.latencyNs = -1;
+            sample.submitted = std::chrono::steady_clock::now();
+            submit(pool, &sample);
+            while (sample.latencyNs.load() < 0)
+                std::this_thread::yield();
+            latencies.push_back(sample.latencyNs.load());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        WakeupStats stats = {0, 0, 0};
+        if (latencies.empty())
+            return stats;
+        stats.p50 = latencies[latencies.size() / 2];
+        stats.p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+        stats.max = latencies.back();
+        return stats;
+    }
+
+    struct OrderLog {
+        std::atomic<bool> released;
+        std::vector<size_t> ran;
+    };
+
+    void holdTask(void *context, void *arg)
+    {
+        OrderLog *log = static_cast<OrderLog*>(context);
+        while (!log->released.load())
+            std::this_thread::yield();
+    }
+
+    void orderTask(void *context, void *arg)
+    {
+        static_cast<OrderLog*>(context)->ran.push_back(reinterpret_cast<size_t>(arg));
+    }
+
+    // Holds the only worker so the ring fills and spills to the locked
+    // queue, interleaving enqueue() with post(), then checks the run order
+    bool checkSubmissionOrder()
+    {
+        const size_t tasks = PDM_THREAD_POOL_RING_SIZE * 4;
+        OrderLog log;
+        log.released = false;
+        log.ran.reserve(tasks);
+        {
+            PdmThreadPool pool(1);
+            pool.post(&holdTask, &log, nullptr);
+            for (size_t i = 0; i < tasks; i++) {
+                if (i % 64 == 0) {
+                    auto result = pool.enqueue(&orderTask, &log, reinterpret_cast<void*>(i));
+                } else {
+                    pool.post(&orderTask, &log, reinterpret_cast<void*>(i));
+                }
+            }
+            log.released = true;
+        }
+        if (log.ran.size() != tasks)
+            return false;
+        for (size_t i = 0; i < tasks; i++) {
+            if (log.ran[i] != i)
+                return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t producers = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 4;
+    size_t tasksPerProducer = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 200000;
+    size_t workers = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 1;
+    size_t samples = (argc > 4) ? std::strtoul(argv[4], nullptr, 10) : 2000;
+
+    double enqueueNs = runBenchmark(producers, tasksPerProducer, workers, [](PdmThreadPool &pool) {
+        auto result = pool.enqueue(&countCallable);
+    });
+    double postNs = runBenchmark(producers, tasksPerProducer, workers, [](PdmThreadPool &pool) {
+        pool.post(&countTask, nullptr, nullptr);
+    });
+
+    std::printf("producers: %zu tasks/producer: %zu workers: %zu\n", producers, tasksPerProducer, workers);
+    std::printf("enqueue (locked queue): %8.1f ns/task\n", enqueueNs);
+    std::printf("post (lock-free ring):  %8.1f ns/task\n", postNs);
+
+    WakeupStats enqueueWakeup = runWakeup(samples, workers, [](PdmThreadPool &pool, WakeupSample *sample) {
+        auto result = pool.enqueue(&wakeupCallable, sample);
+    });
+    WakeupStats postWakeup = runWakeup(samples, workers, [](PdmThreadPool &pool, WakeupSample *sample) {
+        pool.post(&wakeupTask, nullptr, sample);
+    });
+    std::printf("wake-up latency, %zu samples (p50 / p99 / max ns)\n", samples);
+    std::printf("enqueue (locked queue): %8lld / %8lld / %8lld\n",
+                (long long)enqueueWakeup.p50, (long long)enqueueWakeup.p99, (long long)enqueueWakeup.max);
+    std::printf("post (lock-free ring):  %8lld / %8lld / %8lld\n",
+                (long long)postWakeup.p50, (long long)postWakeup.p99, (long long)postWakeup.max);
+
+    bool ordered = checkSubmissionOrder();
+    std::printf("submission order, post() and enqueue() on one worker: %s\n", ordered ? "kept" : "BROKEN");
+    return ordered ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Replays a uevent trace recorded through Common/UeventRecordFile. Every
+// event goes through DeviceClassFactory, DeviceManager and the handlers
+// like in the service, one at a time, and the per-event latency and the
+// throughput are reported so releases can be compared on the same trace.
+//
+// Side effects are local stand-ins: replay/PdmFsStandIn.cpp replaces the
+// mount, fsck and format calls of PdmFs, and device notifications are
+// counted by an observer instead of reaching Luna. The handlers read the
+// installed pdm.conf.
+//
+// usage: pdm-uevent-replay [--speed N] [--mount-ms N] [--fsck-ms N] trace
+//   --speed     0 replays back to back (default), 1 with the recorded
+//               timing, N that many times faster
+//   --mount-ms  simulated duration of a mount
+//   --fsck-ms   simulated duration of a file system check
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DeviceClassFactory.h"
+#include "DeviceHandler.h"
+#include "DeviceManager.h"
+#include "IObserver.h"
+#include "PdmConfig.h"
+#include "PdmReplayStandIns.h"
+#include "PdmUeventRecorder.h"
+#include "PluginAdapter.h"
+
+namespace {
+    // Stands in for the Luna subscribers
+    class NotificationCounter : public IObserver {
+    public:
+        std::atomic<uint64_t> count;
+        NotificationCounter() : count(0) {}
+        void update(const int &eventDeviceType, const int &eventID, IDevice* device) override { count++; }
+    };
+
+    struct EventLatency {
+        size_t index;
+        uint64_t latencyNs;
+    };
+
+    void usage(const char *name)
+    {
+        std::fprintf(stderr, "usage: %s [--speed N] [--mount-ms N] [--fsck-ms N] trace\n", name);
+    }
+
+    double percentileUs(const std::vector<EventLatency> &sorted, double percentile)
+    {
+        size_t index = static_cast<size_t>(percentile * (sorted.size() - 1));
+        return sorted[index].latencyNs / 1000.0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    double speed = 0;
+    std::string tracePath;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc)
+            speed = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--mount-ms") == 0 && i + 1 < argc)
+            PdmReplayStandIns::mountDelayMs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--fsck-ms") == 0 && i + 1 < argc)
+            PdmReplayStandIns::fsckDelayMs = std::atoi(argv[++i]);
+        else if (argv[i][0] != '-' && tracePath.empty())
+            tracePath = argv[i];
+        else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (tracePath.empty()) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<PdmUeventRecord> records;
+    if (!PdmUeventRecorder::readTrace(tracePath, records) || records.empty()) {
+        std::fprintf(stderr, "cannot read uevents from %s\n", tracePath.c_str());
+        return EXIT_FAILURE;
+    }
+
+    PluginAdapter pluginAdapter;
+    PdmConfig config;
+    if (config.readFile() != PdmConfigStatus::PDM_CONFIG_ERROR_NONE ||
+        !DeviceManager::getInstance()->init(&config, &pluginAdapter)) {
+        std::fprintf(stderr, "cannot initialize the handlers from pdm.conf\n");
+        return EXIT_FAILURE;
+    }
+    // Events recorded after boot are handled as hotplug, not as power on
+    pluginAdapter.resumeDone();
+    NotificationCounter notifications;
+    for (auto handler : DeviceManager::getInstance()->getDeviceHandlerList())
+        handler->Register(&notifications);
+
+    std::vector<EventLatency> latencies;
+    latencies.reserve(records.size());
+    uint64_t firstTimeUs = records.front().timeUs;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < records.size(); i++) {
+        PdmUeventRecord &record = records[i];
+        if (speed > 0) {
+            auto offset = std::chrono::microseconds(static_cast<int64_t>((record.timeUs - firstTimeUs) / speed));
+            std::this_thread::sleep_until(start + offset);
+        }
+        auto begin = std::chrono::steady_clock::now();
+        DeviceClass *devClass = DeviceClassFactory::getInstance().create(record.devProps, record.isPowerOnConnect);
+        if (devClass) {
+            DeviceManager::getInstance()->HandlePdmDevice(devClass);
+            delete devClass;
+        }
+        auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+        latencies.push_back({i, static_cast<uint64_t>(latency.count())});
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::vector<EventLatency> sorted = latencies;
+    std::sort(sorted.begin(), sorted.end(), [](const EventLatency &a, const EventLatency &b) {
+        return a.latencyNs < b.latencyNs;
+    });
+    uint64_t totalNs = 0;
+    for (auto const& event : latencies)
+        totalNs += event.latencyNs;
+
+    std::printf("events: %zu in %.3f ms, %.1f events/s\n", records.size(), elapsed.count() / 1000.0,
+                elapsed.count() ? records.size() * 1e6 / elapsed.count() : 0.0);
+    std::printf("latency us: avg %.1f p50 %.1f p90 %.1f p99 %.1f max %.1f\n",
+                totalNs / 1000.0 / latencies.size(), percentileUs(sorted, 0.50), percentileUs(sorted, 0.90),
+                percentileUs(sorted, 0.99), sorted.back().latencyNs / 1000.0);
+    std::printf("notifications: %llu mounts: %llu fscks: %llu\n", (unsigned long long)notifications.count.load(),
+                (unsigned long long)PdmReplayStandIns::mountCount.load(), (unsigned long long)PdmReplayStandIns::fsckCount.load());
+
+    std::printf("slowest events:\n");
+    for (size_t i = sorted.size(); i > 0 && i + 5 > sorted.size(); i--) {
+        const EventLatency &event = sorted[i - 1];
+        auto &devProps = records[event.index].devProps;
+        std::printf("  #%zu %8.1f us %s %s\n", event.index, event.latencyNs / 1000.0,
+                    devProps["ACTION"].c_str(), devProps["DEVPATH"].c_str());
+    }
+
+    std::printf("handlers:\n");
+    for (auto const& entry : DeviceManager::getInstance()->getHandlerStats()) {
+        const DeviceHandlerStats &stats = entry.second;
+        std::printf("  %-20s invoked %6llu claimed %6llu skipped %6llu total %10.1f us max %8.1f us\n",
+                    entry.first.c_str(), (unsigned long long)stats.invocations, (unsigned long long)stats.claimed,
+                    (unsigned long long)stats.skipped, stats.totalTimeNs / 1000.0, stats.maxTimeNs / 1000.0);
+    }
+    return EXIT_SUCCESS;
+}
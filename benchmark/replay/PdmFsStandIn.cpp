@@ -0,0 +1,154 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+// Stand-in for src/utils/PdmFs.cpp: nothing is mounted, checked or
+// formatted, the calls only take the configured time and report success.
+
+#include <chrono>
+#include <thread>
+
+#include "Common.h"
+#include "PdmFs.h"
+#include "PdmLogUtils.h"
+#include "PdmReplayStandIns.h"
+
+namespace PdmReplayStandIns
+{
+    std::atomic<int> mountDelayMs(0);
+    std::atomic<int> fsckDelayMs(0);
+    std::atomic<uint64_t> mountCount(0);
+    std::atomic<uint64_t> fsckCount(0);
+};
+
+namespace {
+    void simulateDelay(const std::atomic<int> &delayMs)
+    {
+        int delay = delayMs.load();
+        if (delay > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    }
+}
+
+PdmDevStatus PdmFs::format(DiskPartitionInfo *partition, std::string &fileSysType, const std::string &label)
+{
+    partition->setFsType(fileSysType);
+    partition->setVolumeLabel(label);
+    return PdmDevStatus::PDM_DEV_SUCCESS;
+}
+
+void PdmFs::setDefaultFsForFormat(DiskPartitionInfo *partition, std::string &fileSysType)
+{
+}
+
+PdmDevStatus PdmFs::fsck(DiskPartitionInfo &partition, const std::string &fsckMode)
+{
+    partition.setFsckStatus(PARTITION_FSCK_STARTED);
+    simulateDelay(PdmReplayStandIns::fsckDelayMs);
+    PdmReplayStandIns::fsckCount++;
+    partition.setFsckStatus(PdmDevStatus::PDM_DEV_SUCCESS);
+    return PdmDevStatus::PDM_DEV_SUCCESS;
+}
+
+bool PdmFs::mountPartition(DiskPartitionInfo &partition, const bool &readOnly)
+{
+    simulateDelay(PdmReplayStandIns::mountDelayMs);
+    PdmReplayStandIns::mountCount++;
+    return true;
+}
+
+bool PdmFs::umount(DiskPartitionInfo &partition, const bool lazyUnmount) const
+{
+    return true;
+}
+
+PdmDevStatus PdmFs::setVolumeLabel(DiskPartitionInfo *partition, const std::string &volLabel)
+{
+    if (volLabel.empty())
+        return PdmDevStatus::PDM_DEV_VOLUME_LABEL_EMPTY;
+    partition->setVolumeLabel(volLabel);
+    return PdmDevStatus::PDM_DEV_SUCCESS;
+}
+
+PdmDevStatus PdmFs::isWritable(DiskPartitionInfo *partition, bool &isWritable)
+{
+    isWritable = true;
+    return PdmDevStatus::PDM_DEV_SUCCESS;
+}
+
+// Same policy as the service, only the side effects are replaced
+bool PdmFs::isSupportedFileSystem(const std::string fsType, const std::string &storageType)
+{
+    if (fsType.empty())
+        return false;
+
+    if (storageType == PdmDevAttributes::PDM_STORAGE_USB_UNDEFINED || storageType == PdmDevAttributes::PDM_STORAGE_STREAMING)
+        return false;
+
+    return fsType == PdmDevAttributes::PDM_DRV_TYPE_FAT  ||
+           fsType == PdmDevAttributes::PDM_DRV_TYPE_NTFS ||
+           fsType == PdmDevAttributes::PDM_DRV_TYPE_EXT2 ||
+           fsType == PdmDevAttributes::PDM_DRV_TYPE_EXT3 ||
+           fsType == PdmDevAttributes::PDM_DRV_TYPE_EXT4;
+}
+
+bool PdmFs::calculateSpaceInfo(const std::string &mountName, SpaceInfo *spaceInfo)
+{
+    *spaceInfo = SpaceInfo();
+    return true;
+}
+
+uint64_t PdmFs::mountflags(const std::string &fsType, const bool &readOnly)
+{
+    return 0;
+}
+
+void PdmFs::checkFileSystem(DiskPartitionInfo &partition)
+{
+    partition.setIsSupportedFs(isSupportedFileSystem(partition.getFsType(), partition.getStorageTypeString()));
+}
+
+PdmDevStatus PdmFs::checkOnly(DiskPartitionInfo &partition)
+{
+    simulateDelay(PdmReplayStandIns::fsckDelayMs);
+    PdmReplayStandIns::fsckCount++;
+    return PdmDevStatus::PDM_DEV_SUCCESS;
+}
+
+bool PdmFs::canCheckOnly(DiskPartitionInfo &partition) const
+{
+    return true;
+}
+
+bool PdmFs::remountReadWrite(DiskPartitionInfo &partition)
+{
+    return true;
+}
+
+PdmFsState PdmFs::probeFsState(DiskPartitionInfo &partition)
+{
+    return PdmFsState::UNKNOWN;
+}
+
+bool PdmFs::isDriveBusy(DiskPartitionInfo &partition, std::vector<pid_t> *busyPids) const
+{
+    return false;
+}
+
+bool PdmFs::isAnyDriveBusy(const std::list<DiskPartitionInfo*> &partitions, std::vector<pid_t> *busyPids) const
+{
+    return false;
+}
@@ -0,0 +1,35 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef PDMREPLAYSTANDINS_H_
+#define PDMREPLAYSTANDINS_H_
+
+#include <atomic>
+#include <cstdint>
+
+// Knobs of the local stand-ins pdm-uevent-replay links instead of the
+// hardware dependent side effects.
+namespace PdmReplayStandIns
+{
+    // Simulated duration of a mount and of a file system check
+    extern std::atomic<int> mountDelayMs;
+    extern std::atomic<int> fsckDelayMs;
+    extern std::atomic<uint64_t> mountCount;
+    extern std::atomic<uint64_t> fsckCount;
+};
+
+#endif /* PDMREPLAYSTANDINS_H_ */
@@ -47,7 +47,7 @@ class AutoAndroidDeviceHandler : public DeviceHandler
 {
 private:
     libusb_device_handle* mHandle;
-    std::list<AutoAndroidDevice*> sList;
+    PdmDeviceRegistry<AutoAndroidDevice> sList;
     bool m_deviceRemoved;
     libusb_context* m_context;
 
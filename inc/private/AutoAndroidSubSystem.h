@@ -28,18 +28,19 @@ using namespace PdmDevAttributes;
 class AutoAndroidSubSystem : public DeviceClass
 {
     std::string mDevType;
-    std::unordered_map<std::string, std::string> mDevPropMap;
     static bool mIsObjRegistered;
     static bool RegisterSubSystem()
     {
-        DeviceClassFactory::getInstance().Register("autoandroid", std::bind(&AutoAndroidSubSystem::create, std::placeholders::_1));
+        DeviceClassFactory::getInstance().Register("autoandroid", std::bind(&AutoAndroidSubSystem::create, std::placeholders::_1),
+            {{DeviceClassFactory::USB_INTERFACE_CLASS, "06"}, {DeviceClassFactory::USB_INTERFACE_CLASS, "ff"}});
         return true;
     }
 
-    static bool canProcessEvent(std::unordered_map<std::string, std::string> mDevPropMap)
+    static bool canProcessEvent(const PdmDevPropertyBlock &devProps)
     {
-        std::string interfaceClass = mDevPropMap[PdmDevAttributes::ID_USB_INTERFACES];
-        if (((interfaceClass.find(":06") != std::string::npos) || (interfaceClass.find(":ff") != std::string::npos)) && (mDevPropMap[DEVTYPE] == USB_DEVICE) && (mDevPropMap[ID_BLUETOOTH] != "1"))
+        PdmStringView interfaceClass = devProps.get(PdmDevProperty::ID_USB_INTERFACES);
+        if (((interfaceClass.find(":06") != PdmStringView::npos) || (interfaceClass.find(":ff") != PdmStringView::npos)) &&
+            (devProps.get(PdmDevProperty::DEVTYPE) == USB_DEVICE) && (devProps.get(PdmDevProperty::ID_BLUETOOTH) != "1"))
             return true;
 
         PDM_LOG_DEBUG("AutoAndroidSubSystem:%s line: %d AutoAndroidSubSystem Object created", __FUNCTION__, __LINE__);
@@ -47,9 +48,9 @@ class AutoAndroidSubSystem : public DeviceClass
     }
 
 public:
-    AutoAndroidSubSystem(std::unordered_map<std::string, std::string> &);
+    explicit AutoAndroidSubSystem(const PdmDevPropertyBlockPtr &devProps);
     virtual ~AutoAndroidSubSystem();
-    static AutoAndroidSubSystem* create(std::unordered_map<std::string, std::string>&);
+    static AutoAndroidSubSystem* create(const PdmDevPropertyBlockPtr &devProps);
     std::string getIdProduct();
     std::string getModelId();
 };
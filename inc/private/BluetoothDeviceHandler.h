@@ -27,7 +27,7 @@
 class BluetoothDeviceHandler : public DeviceHandler
 {
 private:
-    std::list<BluetoothDevice*> sList;
+    PdmDeviceRegistry<BluetoothDevice> sList;
     static bool mIsObjRegistered;
     BluetoothDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter);
     //Register Object to object factory. This is called automatically
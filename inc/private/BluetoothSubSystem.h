@@ -28,17 +28,17 @@ using namespace PdmDevAttributes;
 class BluetoothSubSystem : public DeviceClass
 {
     std::string mDevType;
-    std::unordered_map<std::string, std::string> mDevPropMap;
     static bool mIsObjRegistered;
     static bool RegisterSubSystem()
     {
-        DeviceClassFactory::getInstance().Register("bluetooth", std::bind(&BluetoothSubSystem::create, std::placeholders::_1));
+        DeviceClassFactory::getInstance().Register("bluetooth", std::bind(&BluetoothSubSystem::create, std::placeholders::_1),
+            {{ID_BLUETOOTH, "1"}});
         return true;
     }
 
-    static bool canProcessEvent(std::unordered_map<std::string, std::string> mDevPropMap)
+    static bool canProcessEvent(const PdmDevPropertyBlock &devProps)
     {
-        if(mDevPropMap[ID_BLUETOOTH] == "1")
+        if(devProps.get(PdmDevProperty::ID_BLUETOOTH) == "1")
             return true;
 
         PDM_LOG_DEBUG("BluetoothSubSystem:%s line: %d BluetoothSubSystem Object created", __FUNCTION__, __LINE__);
@@ -46,9 +46,9 @@ class BluetoothSubSystem : public DeviceClass
     }
 
 public:
-    BluetoothSubSystem(std::unordered_map<std::string, std::string> &);
+    explicit BluetoothSubSystem(const PdmDevPropertyBlockPtr &devProps);
     virtual ~BluetoothSubSystem();
-    static BluetoothSubSystem* create(std::unordered_map<std::string, std::string>&);
+    static BluetoothSubSystem* create(const PdmDevPropertyBlockPtr &devProps);
 };
 
 #endif /* _BLUETOOTH_SUSBSYSTEM_H_ */
@@ -30,7 +30,7 @@ private:
     bool m_is3g4gDongleSupported;
     const std::string iClass = ":02";
     const std::string ethernetInterfaceClass = ":0206";
-    std::list<CdcDevice*> sList;
+    PdmDeviceRegistry<CdcDevice> sList;
     bool m_deviceRemoved;
 
     CdcDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter);
@@ -28,24 +28,19 @@ using namespace PdmDevAttributes;
 class CdcSubSystem : public DeviceClass
 {
     std::string mDevType;
-    std::unordered_map<std::string, std::string> mDevPropMap;
     static bool mIsObjRegistered;
     static bool RegisterSubSystem()
     {
-        DeviceClassFactory::getInstance().Register("cdc", std::bind(&CdcSubSystem::create, std::placeholders::_1));
+        DeviceClassFactory::getInstance().Register("cdc", std::bind(&CdcSubSystem::create, std::placeholders::_1),
+            {{DeviceClassFactory::USB_INTERFACE_CLASS, "02"}, {ID_USB_MODEM_DONGLE, YES}});
         return true;
     }
 
-    static bool canProcessEvent(std::unordered_map<std::string, std::string> mDevPropMap)
+    static bool canProcessEvent(const PdmDevPropertyBlock &devProps)
     {
-        const std::string iClass = ":02";
-        const std::string ethernetInterfaceClass = ":0206";
-        std::string interfaceClass = mDevPropMap[ID_USB_INTERFACES];
-
-        if ((interfaceClass.find(iClass) != std::string::npos) ||
-            (mDevPropMap[ID_USB_MODEM_DONGLE] == YES) ||
-            ((mDevPropMap[ID_USB_INTERFACES].find(ethernetInterfaceClass)) != std::string::npos) ||
-            ((mDevPropMap[ID_USB_MODEM_DONGLE] == YES)))
+        // ":02" also covers the ethernet control model ":0206"
+        if ((devProps.get(PdmDevProperty::ID_USB_INTERFACES).find(":02") != PdmStringView::npos) ||
+            (devProps.get(PdmDevProperty::ID_USB_MODEM_DONGLE) == YES))
             return true;
 
         PDM_LOG_DEBUG("CdcSubSystem:%s line: %d CdcSubSystem Object created", __FUNCTION__, __LINE__);
@@ -53,9 +48,9 @@ class CdcSubSystem : public DeviceClass
     }
 
 public:
-    CdcSubSystem(std::unordered_map<std::string, std::string> &);
+    explicit CdcSubSystem(const PdmDevPropertyBlockPtr &devProps);
     virtual ~CdcSubSystem();
-    static CdcSubSystem* create(std::unordered_map<std::string, std::string>&);
+    static CdcSubSystem* create(const PdmDevPropertyBlockPtr &devProps);
     std::string getUsbModemId();
     std::string getUsbSerialId();
 	std::string getUsbSerialSubType();
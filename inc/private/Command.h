@@ -17,12 +17,32 @@
 #ifndef COMMAND_H_
 #define COMMAND_H_
 
+#include <chrono>
+#include <string>
+
+// Execution lane a command is dispatched on. Each lane has its own workers
+// so that long storage jobs never delay hotplug handling or short queries.
+enum class CommandLane {
+    HOTPLUG = 0,
+    QUERY,
+    STORAGE_JOB,
+    MAX_LANES
+};
+
 class Command {
 
+private:
+    std::chrono::steady_clock::time_point m_enqueueTime;
+
 public:
 
     virtual ~Command(){}
     virtual void execute() = 0;
+    virtual CommandLane getLane() const { return CommandLane::HOTPLUG; }
+    // Commands with the same ordering key are executed one after another
+    virtual std::string getOrderingKey() const { return ""; }
+    void setEnqueueTime(std::chrono::steady_clock::time_point enqueueTime) { m_enqueueTime = enqueueTime; }
+    std::chrono::steady_clock::time_point getEnqueueTime() const { return m_enqueueTime; }
 
 };
 
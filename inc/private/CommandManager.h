@@ -17,13 +17,52 @@
 #ifndef COMMANDMANAGER_H
 #define COMMANDMANAGER_H
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include "Command.h"
+#include "PdmStrandExecutor.h"
 #include "PdmThreadPool.h"
 
+// Snapshot of the counters kept for one command lane.
+typedef struct CommandLaneStats {
+    uint64_t enqueued;
+    uint64_t completed;
+    uint64_t queueDepth;
+    uint64_t maxQueueDepth;
+    uint64_t totalWaitUs;
+    uint64_t maxWaitUs;
+    uint64_t totalExecUs;
+    uint64_t maxExecUs;
+}CommandLaneStats;
+
 class CommandManager {
 
 private:
-     PdmThreadPool *m_cmdPool;
+    struct LaneCounters {
+        std::atomic<uint64_t> enqueued{0};
+        std::atomic<uint64_t> completed{0};
+        std::atomic<uint64_t> queueDepth{0};
+        std::atomic<uint64_t> maxQueueDepth{0};
+        std::atomic<uint64_t> totalWaitUs{0};
+        std::atomic<uint64_t> maxWaitUs{0};
+        std::atomic<uint64_t> totalExecUs{0};
+        std::atomic<uint64_t> maxExecUs{0};
+    };
+    static constexpr size_t LANE_COUNT = static_cast<size_t>(CommandLane::MAX_LANES);
+
+    // Hotplug events run on per-device strands: events of one USB device stay
+    // in order while different devices are handled in parallel. The other
+    // lanes use a single-worker pool which keeps FIFO order inside the lane,
+    // storage jobs are ordered against hotplug by the storage handler.
+    PdmStrandExecutor *m_hotplugStrands;
+    std::array<PdmThreadPool*, LANE_COUNT> m_lanePools;
+    std::array<LaneCounters, LANE_COUNT> m_laneCounters;
+
+    void runCommand(Command *cmd, CommandLane lane);
+    static void runPostedCommand(void *context, void *arg);
+    static void updateMax(std::atomic<uint64_t> &maxValue, uint64_t value);
 public:
     CommandManager();
     CommandManager(const CommandManager&) = delete;
@@ -31,6 +70,8 @@ public:
     ~CommandManager();
     bool sendCommand(Command *cmd);
     static bool executeCommand(Command *cmd);
+    CommandLaneStats getLaneStats(CommandLane lane) const;
+    static const char* getLaneName(CommandLane lane);
 };
 
 #endif // COMMANDMANAGER_H
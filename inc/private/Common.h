@@ -164,6 +164,7 @@ enum DeviceEventType { STORAGE_DEVICE = 0,
 
 //drive status
     const std::string MOUNT_OK                    = "MOUNT_OK ";
+    const std::string MOUNT_READ_ONLY_OK          = "MOUNT_READ_ONLY_OK ";
     const std::string MOUNT_NOT_OK                = "MOUNT_NOT_OK ";
     const std::string IS_MOUNTING                 = "IS_MOUNTING ";
     const std::string UMOUNT_NOT_OK               = "UMOUNT_NOT_OK ";
@@ -205,11 +206,18 @@ enum DeviceEventType { STORAGE_DEVICE = 0,
     const std::string USB_FULL_SPEED = "FULL";
     const std::string USB_LOW_SPEED = "LOW";
 
-//Fsck command timeout for storage device
-    #define  FSCK_COMMAND_TIMEOUT  124
+//Deadline of automatic fsck runs
+    #define  PDM_FSCK_AUTO_TIMEOUT_MS  20000
 
-//Fsck timeout command value
-    const std::string timeout = "timeout 20 ";
+//Deadline of the no-modify check of a read-only mounted partition
+    #define  PDM_FSCK_CHECK_ONLY_TIMEOUT_MS  300000
+
+//fsck and mkfs run at lower CPU and I/O priority
+    #define  PDM_FSCK_NICE_VALUE  10
+    #define  PDM_FSCK_IO_LEVEL  7
+
+//Deadline of the FUSE mount and unmount helpers
+    #define  PDM_FUSE_MOUNT_TIMEOUT_MS  10000
 //Sound device
     const std::string CARD_ID = "CARD_ID";
     const std::string CARD_NAME = "CARD_NAME";
@@ -25,7 +25,6 @@
 class DefaultSubSystem : public DeviceClass
 {
     std::string mDevType;
-    std::unordered_map<std::string, std::string> mDevPropMap;
     static bool mIsObjRegistered;
     static bool RegisterSubSystem()
     {
@@ -34,9 +33,9 @@ class DefaultSubSystem : public DeviceClass
     }
 
 public:
-    DefaultSubSystem(std::unordered_map<std::string, std::string> &);
+    explicit DefaultSubSystem(const PdmDevPropertyBlockPtr &devProps);
     virtual ~DefaultSubSystem();
-    static DefaultSubSystem* create(std::unordered_map<std::string, std::string>&);
+    static DefaultSubSystem* create(const PdmDevPropertyBlockPtr &devProps);
 };
 
 #endif /* _DEFAULT_SUSBSYSTEM_H_ */
@@ -27,7 +27,6 @@
 
 enum DeviceSpeed { FULL = 12, HIGH = 480, SUPER = 5000};
 
-enum DeviceActions {USB_DEV_ADD =0, USB_DEV_REMOVE, USB_DEV_CHANGE};
 enum UsbDeviceTypes {TYPE_DEV_USB =0, TYPE_DEV_DISK, TYPE_DEV_PARTITION};
 
 // Map to associate storage device type with the UsbDeviceTypes enum values
@@ -37,13 +36,6 @@ static std::map<std::string, UsbDeviceTypes> sMapUsbDeviceType= {
     {"partition",  TYPE_DEV_PARTITION}
 };
 
-// Map to associate device actions with the DeviceActions enum values
-static std::map<std::string, DeviceActions> sMapDeviceActions= {
-    {"add",     USB_DEV_ADD},
-    {"remove",  USB_DEV_REMOVE},
-    {"change",  USB_DEV_CHANGE}
-};
-
 class Device : public IDevice {
 
 protected:
@@ -67,10 +59,10 @@ protected:
     std::string m_productName;
     std::string m_devSpeed;
     std::string m_deviceSubType;
-#ifdef WEBOS_SESSION
-    std::string m_devPath;
     std::string m_vendorID;
     std::string m_productID;
+#ifdef WEBOS_SESSION
+    std::string m_devPath;
     std::string m_hubPortNumber;
     std::string m_deviceSetId;
 #endif
@@ -100,10 +92,10 @@ public:
     virtual int getPortSpeed(){return m_usbPortSpeed;}
     virtual void setDeviceType(std::string devType){m_deviceType = devType;}
     virtual int getBusNumber(){return m_busNum;}
-#ifdef WEBOS_SESSION
-    virtual std::string getDevPath(){ return m_devPath;}
     virtual std::string getVendorID() {return m_vendorID;}
     virtual std::string getProductID() {return m_productID;}
+#ifdef WEBOS_SESSION
+    virtual std::string getDevPath(){ return m_devPath;}
     virtual std::string getHubPortNumber() {return m_hubPortNumber;}
     virtual std::string getDeviceSetId() {return m_deviceSetId;}
     void setDeviceSetId(std::string hubPortPath);
@@ -24,6 +24,7 @@
 #include <unordered_map>
 
 #include "Common.h"
+#include "PdmDevPropertyBlock.h"
 
 class BusType
 {
@@ -40,12 +41,18 @@ class Usb : public BusType
 class DeviceClass
 {
     // BusType mBusType;
-    std::unordered_map<std::string, std::string> mDevPropMap;
+    PdmDevPropertyBlockPtr mDevProps;
+
+protected:
+    std::string getPropertyString(PdmDevProperty property) const;
 
 public:
     DeviceClass() = default;
     virtual ~DeviceClass() = default;
-    DeviceClass(std::unordered_map<std::string, std::string> &);
+    explicit DeviceClass(const PdmDevPropertyBlockPtr &devProps);
+    // The view stays valid as long as this device class lives
+    PdmStringView getProperty(PdmDevProperty property) const;
+    DeviceActions getDeviceAction() const;
     virtual std::string getDevType();
     virtual std::string getSubsystemName();
     virtual std::string getAction();
@@ -58,6 +65,8 @@ public:
     virtual std::string getIsPowerOnConnect();
     virtual std::string getIdVendorFromDataBase();
     virtual std::string getIdVendor();
+    virtual std::string getIdVendorId();
+    virtual std::string getIdModelId();
     virtual std::string getDevNumber();
     virtual std::string getDevName();
     virtual std::string getMediaPlayerId();
@@ -67,6 +76,8 @@ public:
     virtual std::string getFsUuid();
     virtual std::string getFsLabelEnc();
     virtual std::string getIdBlackList();
+    std::string getUsbDevicePath();
+    static std::string usbDevicePathOf(PdmStringView devPath);
 
 #ifdef WEBOS_SESSION
     virtual std::string getUsbPort();
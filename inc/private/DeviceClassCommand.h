@@ -16,6 +16,7 @@
 
 #ifndef DEVICECLASSCOMMAND_H_
 #define DEVICECLASSCOMMAND_H_
+#include <chrono>
 #include "Command.h"
 #include "DeviceClass.h"
 
@@ -23,12 +24,16 @@ class DeviceClassCommand : public Command {
 
 private:
     DeviceClass *mDevClassPtr;
+    std::string mOrderingKey;
+    std::chrono::steady_clock::time_point mReceiveTime;
 public:
-    DeviceClassCommand(DeviceClass *event);
+    DeviceClassCommand(DeviceClass *event,
+                       std::chrono::steady_clock::time_point receiveTime = std::chrono::steady_clock::now());
     DeviceClassCommand(const DeviceClass&) = delete;
     DeviceClassCommand& operator=(const DeviceClass&) = delete;
     virtual ~DeviceClassCommand();
     void execute();
+    std::string getOrderingKey() const override;
 };
 
 #endif /* DEVICECLASSCOMMAND_H_ */
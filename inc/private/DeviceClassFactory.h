@@ -19,31 +19,61 @@
 
 #include <libudev.h>
 
+#include <array>
 #include <unordered_map>
 #include <string>
 #include <memory>
 #include <functional>
+#include <vector>
 #include "Common.h"
 #include "DeviceClass.h"
 
-using devCreateFptr =  std::function<DeviceClass* (std::unordered_map<std::string, std::string>&)>;
+using devCreateFptr =  std::function<DeviceClass* (const PdmDevPropertyBlockPtr&)>;
 using devCreatorMap = std::unordered_map<std::string, devCreateFptr>;
 
+// A udev property value a subsystem claims. Use USB_INTERFACE_CLASS as the
+// property to claim one USB interface class of ID_USB_INTERFACES, e.g. "08".
+struct DeviceClassMatchKey {
+    std::string property;
+    std::string value;
+};
+using DeviceClassMatchKeys = std::vector<DeviceClassMatchKey>;
+
 class DeviceClassFactory {
 private:
 	devCreatorMap mDevMap;
-	std::unordered_map<std::string, std::string> mDevProMap;
-	void parseDevProps(struct udev_device*, bool isPowerOnConnect);
+	using ClaimMap = std::unordered_map<std::string, std::vector<std::string>>;
+	// value -> creators claiming it, in registration order. Properties are
+	// kept in the order they were first claimed.
+	std::vector<std::pair<PdmDevProperty, ClaimMap>> mPropertyClaims;
+	ClaimMap mInterfaceClaims;
+	// Creators matched by one event, kept on the stack. There are far fewer
+	// subsystems than slots.
+	struct CandidateList {
+		std::array<const std::string*, 16> names;
+		size_t count = 0;
+	};
+	static void addCandidates(const ClaimMap &claims, PdmStringView value, CandidateList &candidates);
+	DeviceClass* dispatch(const PdmDevPropertyBlockPtr &devProps, CandidateList &candidates) const;
+	DeviceClass* probe(const PdmDevPropertyBlockPtr &devProps, const CandidateList &tried) const;
 	explicit DeviceClassFactory();
 	DeviceClassFactory(const DeviceClassFactory&) = delete;
     DeviceClassFactory& operator=(const DeviceClassFactory&) = delete;
     DeviceClassFactory(DeviceClassFactory&&) = delete;
     DeviceClassFactory& operator=(DeviceClassFactory&&) = delete;
 public:
+	// Subsystems register from static initializers, keep this a literal
+	static constexpr const char* USB_INTERFACE_CLASS = "USB_INTERFACE_CLASS";
 	static DeviceClassFactory& getInstance();
 	void Register(std::string, devCreateFptr);
+	void Register(std::string, devCreateFptr, const DeviceClassMatchKeys &matchKeys);
 	void Deregister(std::string);
 	DeviceClass* create(struct udev_device*, bool isPowerOnConnect);
+	// Safe to call from several threads once all subsystems are registered
+	DeviceClass* create(const PdmDevPropertyBlockPtr &devProps);
+	// For properties read back from a uevent trace
+	DeviceClass* create(const std::unordered_map<std::string, std::string> &devProps, bool isPowerOnConnect);
+	static PdmDevPropertyBlockPtr readDevProps(struct udev_device*, bool isPowerOnConnect);
 	~DeviceClassFactory();
 };
 
@@ -17,7 +17,10 @@
 #ifndef DEVICEHANDLER_H_
 #define DEVICEHANDLER_H_
 
+#include <atomic>
+#include <cstdint>
 #include <list>
+#include <mutex>
 #include <string>
 #include <algorithm>
 
@@ -29,16 +32,71 @@
 #include "CommandTypes.h"
 #include "DeviceClass.h"
 #include "PdmLogUtils.h"
+#include "PdmDeviceRegistry.h"
+
+// Routing bits of a uevent. DeviceManager only offers an event to the
+// handlers whose mask shares a bit with it, remove events go to every
+// handler. Interface bits follow the classes of ID_USB_INTERFACES, property
+// bits are set when the udev property is present.
+enum PdmEventMaskBits : uint32_t {
+    PDM_EVENT_NONE                = 0,
+    PDM_EVENT_SUBSYSTEM_SOUND     = 1u << 0,
+    PDM_EVENT_SUBSYSTEM_RFKILL    = 1u << 1,
+    PDM_EVENT_IFC_AUDIO           = 1u << 8,
+    PDM_EVENT_IFC_CDC             = 1u << 9,
+    PDM_EVENT_IFC_HID             = 1u << 10,
+    PDM_EVENT_IFC_IMAGE           = 1u << 11,
+    PDM_EVENT_IFC_STORAGE         = 1u << 12,
+    PDM_EVENT_IFC_SMARTCARD       = 1u << 13,
+    PDM_EVENT_IFC_VIDEO           = 1u << 14,
+    PDM_EVENT_IFC_VENDOR          = 1u << 15,
+    PDM_EVENT_PROP_ATA            = 1u << 16,
+    PDM_EVENT_PROP_GAMEPAD        = 1u << 17,
+    PDM_EVENT_PROP_BLUETOOTH      = 1u << 18,
+    PDM_EVENT_PROP_MEDIA_PLAYER   = 1u << 19,
+    PDM_EVENT_PROP_USB_SERIAL     = 1u << 20,
+    PDM_EVENT_PROP_MODEM_DONGLE   = 1u << 21,
+    PDM_EVENT_ALL                 = 0xffffffffu
+};
+
+struct DeviceHandlerStats {
+    uint64_t invocations;   // events passed to HandlerEvent
+    uint64_t claimed;       // events HandlerEvent returned true for
+    uint64_t skipped;       // events routed away by the event mask
+    uint64_t totalTimeNs;   // time spent in HandlerEvent
+    uint64_t maxTimeNs;
+};
 
 class DeviceHandler: public DeviceStateObserver {
+private:
+    // Serializes HandlerEvent calls, events of different devices may be
+    // dispatched to the same handler from several hotplug workers. Commands,
+    // plugin events and luna list reads take it too. Handlers that guard
+    // their device list themselves skip it entirely.
+    std::mutex m_eventMtx;
+    // Atomic, events of a handler owning its list lock update them in parallel
+    std::atomic<uint64_t> m_invocations;
+    std::atomic<uint64_t> m_claimed;
+    std::atomic<uint64_t> m_skipped;
+    std::atomic<uint64_t> m_totalTimeNs;
+    std::atomic<uint64_t> m_maxTimeNs;
 protected:
     PdmConfig* const m_pConfObj;
     PluginAdapter* const m_pluginAdapter;
     std::string m_handlerName;
+    // Events this handler wants, PDM_EVENT_ALL unless the handler narrows it
+    uint32_t m_eventMask;
+    // Set by handlers whose device list has its own lock, their events and
+    // commands then run without m_eventMtx, so different devices are
+    // handled in parallel and commands do not stall hotplug events.
+    bool m_ownsListLock;
+    std::unique_lock<std::mutex> lockDeviceList();
 public:
     PdmLunaHandler *lunaHandler;
     DeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter)
-                           : m_pConfObj(pConfObj),m_pluginAdapter(pluginAdapter),m_handlerName(""){
+                           : m_invocations(0),m_claimed(0),m_skipped(0),m_totalTimeNs(0),m_maxTimeNs(0)
+                           , m_pConfObj(pConfObj),m_pluginAdapter(pluginAdapter),m_handlerName("")
+                           , m_eventMask(PDM_EVENT_ALL),m_ownsListLock(false){
         lunaHandler = PdmLunaHandler::getInstance();
     }
     virtual ~DeviceHandler(){}
@@ -46,8 +104,14 @@ public:
     virtual bool HandlerCommand(CommandType *cmdtypes, CommandResponse *cmdResponse) = 0;
     virtual bool GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message) = 0;
     virtual bool HandlePluginEvent(int eventType);
+    bool dispatchEvent(DeviceClass* deviceClass);
+    bool dispatchCommand(CommandType *cmdtypes, CommandResponse *cmdResponse);
+    bool dispatchPluginEvent(int eventType);
     void commandResponse(CommandResponse *cmdResponse, PdmDevStatus result);
     virtual std::string getHandlerName() { return m_handlerName; }
+    uint32_t getEventMask() const { return m_eventMask; }
+    void countSkippedEvent() { m_skipped.fetch_add(1, std::memory_order_relaxed); }
+    DeviceHandlerStats getEventStats() const;
 };
 //To get the device with number
 template < class T >  T* getDeviceWithNum (std::list<T*>& sList, int devNum){
@@ -86,5 +150,15 @@ template < class T >  T* getDeviceWithName(std::list<T*>& sList, std::string dev
     }
     return nullptr;
 }
+//Indexed lookups for handlers keeping their devices in a PdmDeviceRegistry
+template < class T >  T* getDeviceWithNum (const PdmDeviceRegistry<T>& sList, int devNum){
+    return sList.findWithNum(devNum);
+}
+template < class T >  T* getDeviceWithPath(const PdmDeviceRegistry<T>& sList, const std::string &devPath){
+    return sList.findWithPath(devPath);
+}
+template < class T >  T* getDeviceWithName(const PdmDeviceRegistry<T>& sList, const std::string &devName){
+    return sList.findWithName(devName);
+}
 
 #endif /* DEVICEHANDLER_H_ */
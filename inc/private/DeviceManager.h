@@ -21,11 +21,13 @@
 #include <cstdarg>
 #include <list>
 #include <string>
+#include <utility>
 
 #include "CommandManager.h"
 #include "CommandTypes.h"
 #include "PluginAdapter.h"
 #include "DeviceClass.h"
+#include "DeviceHandler.h"
 
 class DeviceHandler;
 class PdmConfig;
@@ -36,6 +38,8 @@ class DeviceManager {
 private:
     PdmConfig* m_pConfObj;
     PluginAdapter* m_pluginAdapter;
+    // Built once in init() and read-only afterwards, so it is safe to walk
+    // from the concurrent hotplug workers without locking.
     std::list<DeviceHandler*> mHandlerList;
 
 public:
@@ -47,11 +51,14 @@ public:
     bool HandlePdmCommand(CommandType *cmdtypes, CommandResponse *cmdResponse);
     bool HandlePluginEvent(int eventType);
     std::list<DeviceHandler*> getDeviceHandlerList();
+    // Per handler event counts and time spent, for profiling
+    std::list<std::pair<std::string, DeviceHandlerStats>> getHandlerStats();
     static DeviceManager *getInstance();
 
 private:
 
     bool createPdmdeviceList();
+    static uint32_t getEventMask(DeviceClass *devClassPtr);
 };
 
 #endif //_DEVICEMANAGER_H
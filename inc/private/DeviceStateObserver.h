@@ -18,6 +18,7 @@
 #define DEVICESTATEOBSERVER_H_
 
 #include <list>
+#include <mutex>
 #include "IObserver.h"
 
 class DeviceStateObserver {
@@ -32,6 +33,7 @@ protected:
     void Notify(const int &eventDeviceType, const int &eventID, IDevice* device = nullptr);
 private:
     std::list<IObserver*> *_observers;
+    mutable std::mutex _observersMtx;
 };
 
 #endif /* DEVICESTATEOBSERVER_H_ */
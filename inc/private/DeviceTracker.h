@@ -20,6 +20,8 @@
 #include <functional>
 #include "IObserver.h"
 
+#define PDM_DEVICE_TRACKER_QUEUE_LIMIT 256
+
 using lunaCb = std::function<bool(int)>;
 
 class PluginAdapter;
@@ -29,6 +31,7 @@ class DeviceTracker :public IObserver
     private :
         PluginAdapter* m_pluginAdapter;
         void update(const int &eventDeviceType, const int &eventID, IDevice* device = nullptr) override;
+        void notifyPlugin(const int &eventID, IDevice* device);
         lunaCb mLunaServiceCallback;
 
     public :
@@ -31,6 +31,7 @@ private:
     int m_fsckStatus;
     bool m_isSupportedFS;
     std::string driveStatus;
+    std::string m_fsState;
     std::mutex cmdExectionLock;
 
 public:
@@ -46,6 +47,8 @@ public:
     void setVolumeLabel(const std::string &label);
     void setFsckStatus(int fsckStatus) { m_fsckStatus = fsckStatus; }
     int getFsckStatus() { return m_fsckStatus; }
+    void setFsState(const std::string &fsState) { m_fsState = fsState; }
+    const std::string getFsState() { return m_fsState; }
     bool partitionLock();
     void partitionUnLock();
     bool isPartitionMounted(std::string hubPortPath);
@@ -27,7 +27,7 @@
 class GamepadDeviceHandler : public DeviceHandler
 {
 private:
-    std::list<GamepadDevice*> sList;
+    PdmDeviceRegistry<GamepadDevice> sList;
     static bool mIsObjRegistered;
     GamepadDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter);
     //Register Object to object factory. This is called automatically
@@ -28,17 +28,17 @@ using namespace PdmDevAttributes;
 class GamepadSubSystem : public DeviceClass
 {
     std::string mDevType;
-    std::unordered_map<std::string, std::string> mDevPropMap;
     static bool mIsObjRegistered;
     static bool RegisterSubSystem()
     {
-        DeviceClassFactory::getInstance().Register("gamepad", std::bind(&GamepadSubSystem::create, std::placeholders::_1));
+        DeviceClassFactory::getInstance().Register("gamepad", std::bind(&GamepadSubSystem::create, std::placeholders::_1),
+            {{ID_GAMEPAD, "1"}});
         return true;
     }
 
-    static bool canProcessEvent(std::unordered_map<std::string, std::string> mDevPropMap)
+    static bool canProcessEvent(const PdmDevPropertyBlock &devProps)
     {
-        if(mDevPropMap[ID_GAMEPAD] == "1")
+        if(devProps.get(PdmDevProperty::ID_GAMEPAD) == "1")
             return true;
 
         PDM_LOG_DEBUG("GamepadSubSystem:%s line: %d GamepadSubSystem Object created", __FUNCTION__, __LINE__);
@@ -46,9 +46,9 @@ class GamepadSubSystem : public DeviceClass
     }
 
 public:
-    GamepadSubSystem(std::unordered_map<std::string, std::string> &);
+    explicit GamepadSubSystem(const PdmDevPropertyBlockPtr &devProps);
     virtual ~GamepadSubSystem();
-    static GamepadSubSystem* create(std::unordered_map<std::string, std::string>&);
+    static GamepadSubSystem* create(const PdmDevPropertyBlockPtr &devProps);
     std::string getGamepadId();
 };
 
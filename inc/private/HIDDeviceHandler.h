@@ -28,7 +28,7 @@ class HIDDeviceHandler : public DeviceHandler
 {
 private:
     const std::string iClass = ":03";
-    std::list<HIDDevice*> sList;
+    PdmDeviceRegistry<HIDDevice> sList;
 
     HIDDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter);
     static bool mIsObjRegistered;
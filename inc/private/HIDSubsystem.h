@@ -26,26 +26,25 @@
 class HIDSubsystem :public DeviceClass
 {
 	std::string mDevType;
-	std::unordered_map<std::string, std::string> mDevPropMap;
 	static bool mIsObjRegistered;
 	static bool RegisterSubSystem() {
 		PDM_LOG_DEBUG("HIDSubsystem:%s line: %d HIDSubsystem Registered", __FUNCTION__, __LINE__);
-		DeviceClassFactory::getInstance().Register("input", std::bind(&HIDSubsystem::create, std::placeholders::_1));
+		DeviceClassFactory::getInstance().Register("input", std::bind(&HIDSubsystem::create, std::placeholders::_1),
+		    {{DeviceClassFactory::USB_INTERFACE_CLASS, "03"}});
 		return true;
 	}
-    static bool canProcessEvent(std::unordered_map<std::string, std::string> mDevPropMap)
+    static bool canProcessEvent(const PdmDevPropertyBlock &devProps)
     {
-        const std::string iClass = ":03";
-        if (mDevPropMap[PdmDevAttributes::ID_USB_INTERFACES].find(iClass) != std::string::npos)
+        if (devProps.get(PdmDevProperty::ID_USB_INTERFACES).find(":03") != PdmStringView::npos)
             return true;
         PDM_LOG_DEBUG("HIDSubsystem:%s line: %d HIDSubsystem Object created", __FUNCTION__, __LINE__);
         return false;
     }
 
 public:
-    HIDSubsystem(std::unordered_map<std::string, std::string>& devPropMap);
+    explicit HIDSubsystem(const PdmDevPropertyBlockPtr &devProps);
     virtual ~HIDSubsystem();
-	static HIDSubsystem* create(std::unordered_map<std::string, std::string>& devPropMap);
+	static HIDSubsystem* create(const PdmDevPropertyBlockPtr &devProps);
 	std::string getProcessed();
 };
 
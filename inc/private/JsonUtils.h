@@ -26,6 +26,9 @@
 #define SCHEMA_V2_1(required,p1)                         "{\"type\":\"object\",\"additionalProperties\":false" required ",\"properties\":{" SCHEMA_V2_SYSTEM_PARAMETERS "," p1 "}}"
 #define SCHEMA_V2_2(required,p1,p2)                      "{\"type\":\"object\",\"additionalProperties\":false" required ",\"properties\":{" SCHEMA_V2_SYSTEM_PARAMETERS "," p1 "," p2 "}}"
 #define SCHEMA_V2_3(required,p1,p2,p3)                   "{\"type\":\"object\",\"additionalProperties\":false" required ",\"properties\":{" SCHEMA_V2_SYSTEM_PARAMETERS "," p1 "," p2 "," p3 "}}"
+#define SCHEMA_V2_5(required,p1,p2,p3,p4,p5)             "{\"type\":\"object\",\"additionalProperties\":false" required ",\"properties\":{" SCHEMA_V2_SYSTEM_PARAMETERS "," p1 "," p2 "," p3 "," p4 "," p5 "}}"
+#define SCHEMA_V2_10(required,p1,p2,p3,p4,p5,p6,p7,p8,p9,p10) "{\"type\":\"object\",\"additionalProperties\":false" required ",\"properties\":{" SCHEMA_V2_SYSTEM_PARAMETERS "," p1 "," p2 "," p3 "," p4 "," p5 "," p6 "," p7 "," p8 "," p9 "," p10 "}}"
+#define SCHEMA_V2_12(required,p1,p2,p3,p4,p5,p6,p7,p8,p9,p10,p11,p12) "{\"type\":\"object\",\"additionalProperties\":false" required ",\"properties\":{" SCHEMA_V2_SYSTEM_PARAMETERS "," p1 "," p2 "," p3 "," p4 "," p5 "," p6 "," p7 "," p8 "," p9 "," p10 "," p11 "," p12 "}}"
 
 #define LSERROR_CHECK_AND_PRINT(ret, lsError)\
      do {                          \
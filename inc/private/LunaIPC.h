@@ -34,7 +34,7 @@ private:
     PdmLunaService *mPdmService;
 public:
     ~LunaIPC();
-    bool init(GMainLoop *mainLoop,CommandManager *pCommandManager);
+    bool init(GMainLoop *mainLoop,CommandManager *pCommandManager, PdmConfig* const pConfObj = nullptr);
     bool deInit();
     static LunaIPC *getInstance();
     LSHandle *getLSHandle(void);
@@ -28,7 +28,7 @@ class MTPDeviceHandler : public DeviceHandler
 {
 private:
     static bool mIsObjRegistered;
-    std::list<MTPDevice*> mMtpList;
+    PdmDeviceRegistry<MTPDevice> mMtpList;
     MTPDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter);
     //Register Object to object factory. This is called automatically
     static bool RegisterObject() {
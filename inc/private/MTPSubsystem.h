@@ -26,7 +26,6 @@
 class MTPSubsystem : public DeviceClass
 {
     std::string mDevType;
-    std::unordered_map<std::string, std::string> mDevPropMap;
     static bool mIsObjRegistered;
     static bool RegisterSubSystem()
     {
@@ -34,14 +33,14 @@ class MTPSubsystem : public DeviceClass
         DeviceClassFactory::getInstance().Register("mtp", std::bind(&MTPSubsystem::create, std::placeholders::_1));
         return true;
     }
-    static bool canProcessEvent(std::unordered_map<std::string, std::string> mDevPropMap)
+    static bool canProcessEvent(const PdmDevPropertyBlock &devProps)
     {
         return false;
     }
 public:
-    MTPSubsystem(std::unordered_map<std::string, std::string> &devPropMap);
+    explicit MTPSubsystem(const PdmDevPropertyBlockPtr &devProps);
     virtual ~MTPSubsystem();
-    static MTPSubsystem *create(std::unordered_map<std::string, std::string> &devPropMap);
+    static MTPSubsystem* create(const PdmDevPropertyBlockPtr &devProps);
     std::string getDevLinks();
 };
 
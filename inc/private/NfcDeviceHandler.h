@@ -24,7 +24,7 @@ class NfcDeviceHandler : public DeviceHandler
 {
 private:
     const std::string iClass = ":0b";
-    std::list<NfcDevice*> sList;
+    PdmDeviceRegistry<NfcDevice> sList;
     bool m_deviceRemoved;
 
     NfcDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter);
@@ -28,18 +28,17 @@ using namespace PdmDevAttributes;
 class NfcSubsystem : public DeviceClass
 {
     std::string mDevType;
-    std::unordered_map<std::string, std::string> mDevPropMap;
     static bool mIsObjRegistered;
     static bool RegisterSubSystem()
     {
         PDM_LOG_DEBUG("NfcSubsystem:%s line: %d NfcSubsystem Registered", __FUNCTION__, __LINE__);
-        DeviceClassFactory::getInstance().Register("nfc", std::bind(&NfcSubsystem::create, std::placeholders::_1));
+        DeviceClassFactory::getInstance().Register("nfc", std::bind(&NfcSubsystem::create, std::placeholders::_1),
+            {{DeviceClassFactory::USB_INTERFACE_CLASS, "0b"}});
         return true;
     }
-    static bool canProcessEvent(std::unordered_map<std::string, std::string> mDevPropMap)
+    static bool canProcessEvent(const PdmDevPropertyBlock &devProps)
     {
-        const std::string iClass = ":0b";
-        if (mDevPropMap[ID_USB_INTERFACES].find(iClass) != std::string::npos)
+        if (devProps.get(PdmDevProperty::ID_USB_INTERFACES).find(":0b") != PdmStringView::npos)
             return true;
 
         PDM_LOG_DEBUG("NfcSubsystem:%s line: %d NfcSubsystem Object created", __FUNCTION__, __LINE__);
@@ -47,9 +46,9 @@ class NfcSubsystem : public DeviceClass
     }
 
 public:
-    NfcSubsystem(std::unordered_map<std::string, std::string> &devPropMap);
+    explicit NfcSubsystem(const PdmDevPropertyBlockPtr &devProps);
     virtual ~NfcSubsystem();
-    static NfcSubsystem *create(std::unordered_map<std::string, std::string> &devPropMap);
+    static NfcSubsystem* create(const PdmDevPropertyBlockPtr &devProps);
 };
 
 #endif /* _NFC_SUSBSYSTEM_H_ */
\ No newline at end of file
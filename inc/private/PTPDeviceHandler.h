@@ -29,7 +29,7 @@ class PTPDeviceHandler : public DeviceHandler
 private:
     const std::string iClass = ":06";
     static bool mIsObjRegistered;
-    std::list<PTPDevice*> sList;
+    PdmDeviceRegistry<PTPDevice> sList;
     PTPDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter);
     //Register Object to object factory. This is called automatically
     static bool RegisterObject() {
@@ -28,19 +28,17 @@ using namespace PdmDevAttributes;
 class PTPSubsystem : public DeviceClass
 {
     std::string mDevType;
-    std::unordered_map<std::string, std::string> mDevPropMap;
     static bool mIsObjRegistered;
     static bool RegisterSubSystem()
     {
         PDM_LOG_DEBUG("PTPSubsystem:%s line: %d PTPSubsystem Registered", __FUNCTION__, __LINE__);
-        DeviceClassFactory::getInstance().Register("ptp", std::bind(&PTPSubsystem::create, std::placeholders::_1));
+        DeviceClassFactory::getInstance().Register("ptp", std::bind(&PTPSubsystem::create, std::placeholders::_1),
+            {{DeviceClassFactory::USB_INTERFACE_CLASS, "06"}});
         return true;
     }
-    static bool canProcessEvent(std::unordered_map<std::string, std::string> mDevPropMap)
+    static bool canProcessEvent(const PdmDevPropertyBlock &devProps)
     {
-        const std::string iClass = ":06";
-        std::string interfaceClass = mDevPropMap[ID_USB_INTERFACES];
-        if (interfaceClass.find(iClass) != std::string::npos)
+        if (devProps.get(PdmDevProperty::ID_USB_INTERFACES).find(":06") != PdmStringView::npos)
             return true;
 
         PDM_LOG_DEBUG("PTPSubsystem:%s line: %d PTPSubsystem Object created", __FUNCTION__, __LINE__);
@@ -48,9 +46,9 @@ class PTPSubsystem : public DeviceClass
     }
 
 public:
-    PTPSubsystem(std::unordered_map<std::string, std::string> &devPropMap);
+    explicit PTPSubsystem(const PdmDevPropertyBlockPtr &devProps);
     virtual ~PTPSubsystem();
-    static PTPSubsystem *create(std::unordered_map<std::string, std::string> &devPropMap);
+    static PTPSubsystem* create(const PdmDevPropertyBlockPtr &devProps);
     std::string getBusNum();
 };
 
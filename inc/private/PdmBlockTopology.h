@@ -0,0 +1,75 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef _PDM_BLOCK_TOPOLOGY_H
+#define _PDM_BLOCK_TOPOLOGY_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define PDM_SYSFS_CLASS_BLOCK "/sys/class/block"
+
+// Sizes and offsets are in 512 byte sectors, as reported by sysfs
+typedef struct PdmBlockPartition {
+    std::string name;
+    int number;
+    uint64_t start;
+    uint64_t size;
+    bool readOnly;
+}PdmBlockPartition;
+
+typedef struct PdmBlockDisk {
+    std::string name;
+    uint64_t size;
+    bool readOnly;
+    bool removable;
+    bool rotational;
+    std::vector<PdmBlockPartition> partitions;
+}PdmBlockDisk;
+
+// Topology of the block disks read from /sys/class/block/<disk>/. Disks are
+// cached until a uevent of the disk or one of its partitions invalidates
+// them.
+class PdmBlockTopology {
+
+private:
+    std::mutex m_cacheMtx;
+    std::unordered_map<std::string, PdmBlockDisk> m_cache;
+    // Bumped by every invalidation so a sysfs read racing with one is not cached
+    uint64_t m_generation;
+    std::string m_sysfsRoot;
+
+    PdmBlockTopology();
+    bool readDisk(const std::string &diskName, PdmBlockDisk &disk) const;
+    static bool readValue(const std::string &path, uint64_t &value);
+    static std::string getKernelName(const std::string &devName);
+
+public:
+    PdmBlockTopology(const PdmBlockTopology&) = delete;
+    PdmBlockTopology& operator=(const PdmBlockTopology&) = delete;
+    static PdmBlockTopology& getInstance();
+    // devName may be a kernel name or a /dev path
+    bool getDisk(const std::string &devName, PdmBlockDisk &disk);
+    int getPartitionCount(const std::string &devName);
+    // Drops the disk of devName, or of the partition devName
+    void invalidate(const std::string &devName);
+};
+
+#endif //_PDM_BLOCK_TOPOLOGY_H
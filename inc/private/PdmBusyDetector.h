@@ -0,0 +1,43 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef _PDM_BUSY_DETECTOR_H
+#define _PDM_BUSY_DETECTOR_H
+
+#include <map>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+#define PDM_BUSY_SCAN_BUDGET_MS 1000
+
+// Finds the processes using files below mount points, the in-process
+// replacement of "lsof +D". One pass over /proc checks the fds, cwd, root and
+// file mappings of every process against all the given mount points.
+namespace PdmBusyDetector
+{
+    // Fills users with the PIDs found per mount point. Returns false if the
+    // scan did not finish within budgetMs, users then holds what was found.
+    bool findUsers(const std::vector<std::string> &mountPoints, std::map<std::string, std::vector<pid_t>> &users,
+                   unsigned int budgetMs = PDM_BUSY_SCAN_BUDGET_MS);
+    // An incomplete scan counts as busy
+    bool isBusy(const std::string &mountPoint, std::vector<pid_t> &pids);
+    // "1234(name) 5678(name)" for logs and replies
+    std::string describe(const std::vector<pid_t> &pids);
+};
+
+#endif //_PDM_BUSY_DETECTOR_H
@@ -37,6 +37,7 @@ public:
     PdmCommand& operator=(const PdmCommand&) = delete;
     ~PdmCommand();
     void execute();
+    CommandLane getLane() const override;
 };
 
 
@@ -0,0 +1,78 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef _PDM_DELTA_HISTORY_H
+#define _PDM_DELTA_HISTORY_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include <pbnjson.hpp>
+
+#define PDM_DELTA_HISTORY_LIMIT 64
+
+// Changes of one device list payload, e.g. storageDeviceList. Each payload
+// that differs from the previous one gets the next sequence number and a
+// record of the entries added, changed and removed. The last
+// PDM_DELTA_HISTORY_LIMIT records are kept for clients catching up.
+// Used on the main loop only.
+class PdmDeltaHistory {
+
+private:
+    enum Change {
+        ADDED = 0,
+        CHANGED,
+        REMOVED
+    };
+    typedef struct EntryChange {
+        Change change;
+        std::string id;
+        // The new entry, or the last one for REMOVED
+        std::string entry;
+    }EntryChange;
+    typedef struct Record {
+        uint64_t seq;
+        std::vector<EntryChange> changes;
+    }Record;
+
+    std::string m_listField;
+    // Entries without this field are identified by their whole text
+    std::string m_idField;
+    std::string m_lastPayload;
+    std::map<std::string, std::string> m_entries;
+    std::deque<Record> m_records;
+    uint64_t m_seq;
+
+    std::map<std::string, std::string> parseEntries(const std::string &payloadText) const;
+    static pbnjson::JValue createDelta(uint64_t fromSeq, uint64_t seq, const std::vector<EntryChange> &changes);
+
+public:
+    PdmDeltaHistory(const std::string &listField, const std::string &idField);
+    // Records the differences of payloadText to the previous payload,
+    // returns false when there were none
+    bool update(const std::string &payloadText);
+    uint64_t getSeq() const { return m_seq; }
+    // Delta of the last update
+    pbnjson::JValue getLastDelta() const;
+    // Changes after seq folded into one delta, false when the history does
+    // not reach back to seq
+    bool getChangesSince(uint64_t seq, pbnjson::JValue &delta) const;
+};
+
+#endif //_PDM_DELTA_HISTORY_H
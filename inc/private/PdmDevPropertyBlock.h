@@ -0,0 +1,128 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+
+#ifndef PDMDEVPROPERTYBLOCK_H_
+#define PDMDEVPROPERTYBLOCK_H_
+
+#include <array>
+#include <cstdint>
+#include <experimental/string_view>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+using PdmStringView = std::experimental::string_view;
+
+enum DeviceActions {USB_DEV_ADD =0, USB_DEV_REMOVE, USB_DEV_CHANGE, USB_DEV_UNKNOWN};
+
+// udev properties read by PDM. Properties of an event not listed here are
+// not kept once the device class has been created.
+enum class PdmDevProperty : uint8_t {
+    ACTION = 0,
+    SUBSYSTEM,
+    DEVTYPE,
+    DEVPATH,
+    DEVNAME,
+    DEVNUM,
+    BUSNUM,
+    DEVLINKS,
+    SPEED,
+    IS_POWER_ON_CONNECT,
+    ID_USB_INTERFACES,
+    ID_USB_DRIVER,
+    ID_SERIAL_SHORT,
+    ID_MODEL,
+    ID_MODEL_ID,
+    ID_VENDOR,
+    ID_VENDOR_ID,
+    ID_PRODUCT_ID,
+    ID_VENDOR_FROM_DATABASE,
+    ID_MEDIA_PLAYER,
+    ID_BLACKLIST,
+    ID_BLACK_LISTED_SUPER_SPEED_DEVICE,
+    ID_FS_TYPE,
+    ID_FS_UUID,
+    ID_FS_LABEL_ENC,
+    ID_INSTANCE,
+    ID_ATA,
+    CARD_READER,
+    HARD_DISK,
+    READ_ONLY,
+    DISK_MEDIA_CHANGE,
+    ID_GAMEPAD,
+    ID_BLUETOOTH,
+    ID_USB_SERIAL,
+    ID_USB_MODEM_DONGLE,
+    USB_SERIAL_SUB_TYPE,
+    NET_IFIINDEX,
+    NET_LINK_MODE,
+    NET_DUPLEX,
+    NET_ADDRESS,
+    NET_OPERSTATE,
+    PROCESSED,
+    CARD_ID,
+    CARD_NAME,
+    CARD_NUMBER,
+    ID_V4L_CAPABILITIES,
+    ID_V4L_PRODUCT,
+    ID_V4L_VERSION,
+    USB_PORT,
+    RFKILL_NAME,
+    COUNT
+};
+
+// Immutable properties of one uevent. Values are stored back to back in a
+// single buffer and returned as views into it, so reading a property never
+// allocates. Views stay valid as long as the block lives.
+class PdmDevPropertyBlock {
+
+private:
+    struct Slot {
+        uint32_t offset;
+        uint32_t length;
+    };
+    static const uint32_t ABSENT = UINT32_MAX;
+
+    std::unique_ptr<char[]> m_arena;
+    std::array<Slot, static_cast<size_t>(PdmDevProperty::COUNT)> m_slots;
+    DeviceActions m_action;
+
+public:
+    // Indexed by PdmDevProperty, a view without data is an absent property
+    using Values = std::array<PdmStringView, static_cast<size_t>(PdmDevProperty::COUNT)>;
+
+    // On power on enumeration the event is treated as an add. DEVNAME is
+    // kept without "/dev/" and ID_MODEL with spaces for underscores.
+    PdmDevPropertyBlock(const Values &values, bool isPowerOnConnect);
+    PdmDevPropertyBlock(const std::unordered_map<std::string, std::string> &devProps, bool isPowerOnConnect);
+    PdmDevPropertyBlock(const PdmDevPropertyBlock&) = delete;
+    PdmDevPropertyBlock& operator=(const PdmDevPropertyBlock&) = delete;
+
+    PdmStringView get(PdmDevProperty property) const;
+    bool has(PdmDevProperty property) const;
+    DeviceActions getAction() const { return m_action; }
+    Values getValues() const;
+
+    static bool fromName(PdmStringView name, PdmDevProperty &property);
+    static const char* getName(PdmDevProperty property);
+    static DeviceActions parseAction(PdmStringView action);
+};
+
+using PdmDevPropertyBlockPtr = std::shared_ptr<const PdmDevPropertyBlock>;
+
+#endif /* PDMDEVPROPERTYBLOCK_H_ */
@@ -0,0 +1,84 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+
+#ifndef _PDM_DEVICE_FILTER_H
+#define _PDM_DEVICE_FILTER_H
+
+#include <initializer_list>
+#include <set>
+#include <string>
+#include <luna-service2/lunaservice.h>
+#include <pbnjson.hpp>
+
+// Optional filters and "fields" projection of a getAttached*DeviceList
+// request. A device is listed only when it carries every requested attribute
+// with the requested value, so a storage criterion leaves non storage lists
+// empty. Without "fields" every field is put.
+class PdmDeviceFilter {
+
+private:
+    bool m_hasDeviceType;
+    bool m_hasStorageType;
+    bool m_hasUsbPortNum;
+    bool m_hasIsMounted;
+    bool m_hasVendorId;
+    bool m_hasProductId;
+    int m_usbPortNum;
+    bool m_isMounted;
+    std::string m_deviceType;
+    std::string m_storageType;
+    // Lower case, sysfs and udev report the hex ids in either case
+    std::string m_vendorId;
+    std::string m_productId;
+    std::set<std::string> m_fields;
+
+    static std::string toLower(const std::string &id);
+
+public:
+    PdmDeviceFilter();
+    explicit PdmDeviceFilter(const pbnjson::JValue &request);
+    // Empty filter when there is no message, e.g. for subscription replies
+    static PdmDeviceFilter fromMessage(LSMessage *message);
+
+    // Whether the shared unfiltered payload answers the request
+    bool isEmpty() const;
+    // Equal for requests getting the same payload
+    std::string toString() const;
+
+    bool wants(const char *field) const { return m_fields.empty() || m_fields.count(field) != 0; }
+    bool wantsAny(std::initializer_list<const char*> fields) const;
+    bool hasStorageCriteria() const { return m_hasStorageType || m_hasIsMounted; }
+    bool hasMountCriteria() const { return m_hasIsMounted; }
+    bool matchesStorageType(const std::string &storageType) const { return !m_hasStorageType || storageType == m_storageType; }
+    bool matchesMounted(bool isMounted) const { return !m_hasIsMounted || isMounted == m_isMounted; }
+
+    // Device level criteria, T is a Device
+    template <class T> bool matches(T *device) const {
+        if (m_hasDeviceType && device->getDeviceType() != m_deviceType)
+            return false;
+        if (m_hasUsbPortNum && device->getUsbPortNumber() != m_usbPortNum)
+            return false;
+        if (m_hasVendorId && toLower(device->getVendorID()) != m_vendorId)
+            return false;
+        if (m_hasProductId && toLower(device->getProductID()) != m_productId)
+            return false;
+        return true;
+    }
+};
+
+#endif //_PDM_DEVICE_FILTER_H
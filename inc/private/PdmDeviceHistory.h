@@ -0,0 +1,89 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef _PDM_DEVICE_HISTORY_H
+#define _PDM_DEVICE_HISTORY_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <glib.h>
+#include <luna-service2/lunaservice.h>
+#include <luna-service2++/handle.hpp>
+#include <pbnjson.hpp>
+
+#define PDM_DEVICE_HISTORY_KIND "com.webos.service.pdmhistory:1"
+// Changes of a device within this delay are written to DB8 in one call
+#define PDM_DEVICE_HISTORY_WRITE_DELAY_MS 100
+
+typedef struct PdmDeviceHistoryStats {
+    uint64_t records;
+    uint64_t writes;
+    uint64_t dbCalls;
+}PdmDeviceHistoryStats;
+
+// Device history of the pdmhistory DB8 kind by hubPortPath. PDM is the only
+// writer of the kind, so once loaded the records are served from memory and
+// changes are persisted behind: pending changes of a device are merged and
+// sent from the main loop after PDM_DEVICE_HISTORY_WRITE_DELAY_MS, or by
+// flush() before PDM queries DB8 itself.
+class PdmDeviceHistory {
+
+private:
+    struct PendingWrite {
+        bool remove;            // delete the stored record first
+        pbnjson::JValue props;  // then merge these, null when none
+    };
+
+    std::mutex m_mutex;
+    LSHandle *m_handle;
+    std::map<std::string, pbnjson::JValue> m_records;
+    std::map<std::string, PendingWrite> m_pending;
+    std::vector<std::string> m_pendingOrder;
+    guint m_flushSourceId;
+    uint64_t m_writes;
+    uint64_t m_dbCalls;
+
+    PdmDeviceHistory();
+    void scheduleFlush();
+    bool callDb(const char *method, const pbnjson::JValue &params);
+    static int flushCb(void *data);
+    static bool cbDbResponse(LSHandle *sh, LSMessage *message, void *user_data);
+
+public:
+    PdmDeviceHistory(const PdmDeviceHistory&) = delete;
+    PdmDeviceHistory& operator=(const PdmDeviceHistory&) = delete;
+    static PdmDeviceHistory& getInstance();
+    // Reads the whole kind once, blocking, returns the records found
+    pbnjson::JValue load(LS::Handle *handle);
+    // Copy of the record of hubPortPath, null when there is none
+    pbnjson::JValue find(const std::string &hubPortPath);
+    // Copies of the records of deviceType
+    pbnjson::JValue findDeviceType(const std::string &deviceType);
+    // Same as a DB8 mergePut of props on the record of hubPortPath
+    void merge(const std::string &hubPortPath, pbnjson::JValue props);
+    void remove(const std::string &hubPortPath);
+    // Deletes the records of deviceType, also those not loaded
+    void removeDeviceType(const std::string &deviceType);
+    // Sends the pending changes now
+    void flush();
+    PdmDeviceHistoryStats getStats();
+};
+
+#endif //_PDM_DEVICE_HISTORY_H
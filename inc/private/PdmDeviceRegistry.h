@@ -0,0 +1,308 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+
+#ifndef PDMDEVICEREGISTRY_H_
+#define PDMDEVICEREGISTRY_H_
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Stable reference to a registered device. A handle is never reused, so
+// resolving it after the device has been removed safely yields nullptr.
+using PdmDeviceHandle = uint64_t;
+static const PdmDeviceHandle PDM_INVALID_DEVICE_HANDLE = 0;
+
+// Radix tree mapping string keys to values. Lookups return the oldest value
+// whose key is a prefix of the query, the same device the linear list scans
+// returned, in O(query length).
+template <class T>
+class PdmPrefixIndex {
+
+private:
+    struct Node {
+        std::string label;
+        std::map<char, std::unique_ptr<Node>> children;
+        // Values stored for the key ending at this node, ordered by handle
+        std::vector<std::pair<PdmDeviceHandle, T*>> values;
+    };
+
+    Node m_root;
+
+    static size_t commonPrefixLength(const std::string &label, const std::string &key, size_t pos) {
+        size_t len = 0;
+        while (len < label.size() && pos + len < key.size() && label[len] == key[pos + len])
+            len++;
+        return len;
+    }
+
+    static void insertValue(Node *node, PdmDeviceHandle handle, T *value) {
+        auto it = node->values.begin();
+        while (it != node->values.end() && it->first < handle)
+            ++it;
+        node->values.insert(it, std::make_pair(handle, value));
+    }
+
+public:
+    void insert(const std::string &key, PdmDeviceHandle handle, T *value) {
+        Node *node = &m_root;
+        size_t pos = 0;
+        while (pos < key.size()) {
+            auto it = node->children.find(key[pos]);
+            if (it == node->children.end()) {
+                std::unique_ptr<Node> leaf(new Node());
+                leaf->label = key.substr(pos);
+                Node *leafPtr = leaf.get();
+                node->children[key[pos]] = std::move(leaf);
+                insertValue(leafPtr, handle, value);
+                return;
+            }
+            Node *child = it->second.get();
+            size_t len = commonPrefixLength(child->label, key, pos);
+            if (len < child->label.size()) {
+                // Split the edge at the first mismatching character
+                std::unique_ptr<Node> mid(new Node());
+                mid->label = child->label.substr(0, len);
+                child->label.erase(0, len);
+                char childFirst = child->label[0];
+                mid->children[childFirst] = std::move(it->second);
+                Node *midPtr = mid.get();
+                it->second = std::move(mid);
+                child = midPtr;
+            }
+            node = child;
+            pos += len;
+        }
+        insertValue(node, handle, value);
+    }
+
+    void erase(const std::string &key, PdmDeviceHandle handle) {
+        std::vector<Node*> path;
+        Node *node = &m_root;
+        size_t pos = 0;
+        path.push_back(node);
+        while (pos < key.size()) {
+            auto it = node->children.find(key[pos]);
+            if (it == node->children.end())
+                return;
+            Node *child = it->second.get();
+            if (key.compare(pos, child->label.size(), child->label) != 0)
+                return;
+            pos += child->label.size();
+            node = child;
+            path.push_back(node);
+        }
+        for (auto it = node->values.begin(); it != node->values.end(); ++it) {
+            if (it->first == handle) {
+                node->values.erase(it);
+                break;
+            }
+        }
+        // Drop empty leaves and merge single child chains left behind
+        while (path.size() > 1) {
+            Node *current = path.back();
+            Node *parent = path[path.size() - 2];
+            if (!current->values.empty())
+                break;
+            if (current->children.empty()) {
+                parent->children.erase(current->label[0]);
+                path.pop_back();
+                continue;
+            }
+            if (current->children.size() == 1) {
+                std::unique_ptr<Node> only = std::move(current->children.begin()->second);
+                current->children.clear();
+                current->label += only->label;
+                current->children = std::move(only->children);
+                current->values = std::move(only->values);
+            }
+            break;
+        }
+    }
+
+    T* findPrefixOf(const std::string &query) const {
+        const Node *node = &m_root;
+        size_t pos = 0;
+        T *found = nullptr;
+        PdmDeviceHandle foundHandle = 0;
+        while (true) {
+            if (!node->values.empty() && (found == nullptr || node->values.front().first < foundHandle)) {
+                foundHandle = node->values.front().first;
+                found = node->values.front().second;
+            }
+            if (pos >= query.size())
+                break;
+            auto it = node->children.find(query[pos]);
+            if (it == node->children.end())
+                break;
+            const Node *child = it->second.get();
+            if (query.compare(pos, child->label.size(), child->label) != 0)
+                break;
+            pos += child->label.size();
+            node = child;
+        }
+        return found;
+    }
+
+    void clear() {
+        m_root.children.clear();
+        m_root.values.clear();
+    }
+};
+
+// Device container of a handler. Keeps insertion order for iteration and
+// payload generation, and indexes devices on number, name and sysfs path so
+// event and command lookups do not scan the whole list.
+// Indexed keys are captured when a device is added; call refresh() after
+// setDeviceInfo/updateDeviceInfo may have changed them.
+// Not thread safe, callers serialize access like they did for the list.
+template <class T>
+class PdmDeviceRegistry {
+
+private:
+    struct Entry {
+        PdmDeviceHandle handle;
+        int deviceNum;
+        std::string devicePath;
+        std::string deviceName;
+    };
+
+    std::list<T*> m_devices;
+    std::unordered_map<T*, Entry> m_entries;
+    std::unordered_map<PdmDeviceHandle, T*> m_handles;
+    std::unordered_map<int, std::map<PdmDeviceHandle, T*>> m_numIndex;
+    PdmPrefixIndex<T> m_pathIndex;
+    PdmPrefixIndex<T> m_nameIndex;
+    PdmDeviceHandle m_nextHandle;
+
+    void index(T *device, Entry &entry) {
+        entry.deviceNum = device->getDeviceNum();
+        entry.devicePath = device->getDevicePath();
+        entry.deviceName = device->getDeviceName();
+        m_numIndex[entry.deviceNum][entry.handle] = device;
+        m_pathIndex.insert(entry.devicePath, entry.handle, device);
+        m_nameIndex.insert(entry.deviceName, entry.handle, device);
+    }
+
+    void unindex(const Entry &entry) {
+        auto numIt = m_numIndex.find(entry.deviceNum);
+        if (numIt != m_numIndex.end()) {
+            numIt->second.erase(entry.handle);
+            if (numIt->second.empty())
+                m_numIndex.erase(numIt);
+        }
+        m_pathIndex.erase(entry.devicePath, entry.handle);
+        m_nameIndex.erase(entry.deviceName, entry.handle);
+    }
+
+public:
+    using const_iterator = typename std::list<T*>::const_iterator;
+
+    PdmDeviceRegistry() : m_nextHandle(PDM_INVALID_DEVICE_HANDLE + 1) {}
+    PdmDeviceRegistry(const PdmDeviceRegistry&) = delete;
+    PdmDeviceRegistry& operator=(const PdmDeviceRegistry&) = delete;
+
+    PdmDeviceHandle add(T *device) {
+        if (device == nullptr)
+            return PDM_INVALID_DEVICE_HANDLE;
+        auto it = m_entries.find(device);
+        if (it != m_entries.end())
+            return it->second.handle;
+        Entry &entry = m_entries[device];
+        entry.handle = m_nextHandle++;
+        index(device, entry);
+        m_handles[entry.handle] = device;
+        m_devices.push_back(device);
+        return entry.handle;
+    }
+
+    void remove(T *device) {
+        auto it = m_entries.find(device);
+        if (it == m_entries.end())
+            return;
+        unindex(it->second);
+        m_handles.erase(it->second.handle);
+        m_entries.erase(it);
+        m_devices.remove(device);
+    }
+
+    // Re-index a device whose number, path or name may have changed
+    void refresh(T *device) {
+        auto it = m_entries.find(device);
+        if (it == m_entries.end())
+            return;
+        Entry &entry = it->second;
+        if (entry.deviceNum == device->getDeviceNum() &&
+            entry.devicePath == device->getDevicePath() &&
+            entry.deviceName == device->getDeviceName())
+            return;
+        unindex(entry);
+        index(device, entry);
+    }
+
+    void clear() {
+        m_devices.clear();
+        m_entries.clear();
+        m_handles.clear();
+        m_numIndex.clear();
+        m_pathIndex.clear();
+        m_nameIndex.clear();
+    }
+
+    T* findWithNum(int devNum) const {
+        auto it = m_numIndex.find(devNum);
+        if (it == m_numIndex.end() || it->second.empty())
+            return nullptr;
+        return it->second.begin()->second;
+    }
+
+    // Device whose sysfs path is a prefix of devPath, e.g. the usb_device
+    // owning a partition. O(path length).
+    T* findWithPath(const std::string &devPath) const {
+        return m_pathIndex.findPrefixOf(devPath);
+    }
+
+    // Device whose name is a prefix of devName, e.g. sda for sda1
+    T* findWithName(const std::string &devName) const {
+        return m_nameIndex.findPrefixOf(devName);
+    }
+
+    PdmDeviceHandle getHandle(T *device) const {
+        auto it = m_entries.find(device);
+        return (it == m_entries.end()) ? PDM_INVALID_DEVICE_HANDLE : it->second.handle;
+    }
+
+    T* resolve(PdmDeviceHandle handle) const {
+        auto it = m_handles.find(handle);
+        return (it == m_handles.end()) ? nullptr : it->second;
+    }
+
+    bool contains(T *device) const { return m_entries.find(device) != m_entries.end(); }
+    bool empty() const { return m_devices.empty(); }
+    size_t size() const { return m_devices.size(); }
+    const_iterator begin() const { return m_devices.begin(); }
+    const_iterator end() const { return m_devices.end(); }
+    const std::list<T*>& devices() const { return m_devices; }
+};
+
+#endif /* PDMDEVICEREGISTRY_H_ */
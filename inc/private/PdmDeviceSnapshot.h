@@ -0,0 +1,102 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef PDMDEVICESNAPSHOT_H_
+#define PDMDEVICESNAPSHOT_H_
+
+#include <string>
+#include "IDevice.h"
+
+// Copy of the attributes of a device taken when an event is posted. Observers
+// run after the handler may have updated or deleted the device, e.g. on
+// REMOVE, so they get this copy instead.
+class PdmDeviceSnapshot : public IDevice {
+
+public:
+    enum Kind {
+        DEVICE = 0,
+        STORAGE_DEVICE,
+        MTP_DEVICE,
+        PARTITION
+    };
+
+    explicit PdmDeviceSnapshot(IDevice *device);
+    PdmDeviceSnapshot(const PdmDeviceSnapshot&) = delete;
+    PdmDeviceSnapshot& operator=(const PdmDeviceSnapshot&) = delete;
+    Kind getKind() const { return m_kind; }
+    // Storage attributes, empty for devices that are not storage
+    std::string getDriveName() const { return m_driveName; }
+    unsigned long getDriveSize() const { return m_driveSize; }
+
+    int getUsbPortNumber() override { return m_usbPortNum; }
+    int getDeviceNum() override { return m_deviceNum; }
+    std::string getDeviceStatus() override { return m_deviceStatus; }
+    std::string getDeviceType() override { return m_deviceType; }
+    std::string getErrorReason() override { return m_errorReason; }
+    std::string getVendorName() override { return m_vendorName; }
+    std::string getProductName() override { return m_productName; }
+    std::string getSerialNumber() override { return m_serialNumber; }
+    std::string getDevSpeed() override { return m_devSpeed; }
+    std::string getDevicePath() override { return m_devicePath; }
+    std::string getDeviceSubType() override { return m_deviceSubType; }
+    std::string getDeviceName() override { return m_deviceName; }
+    bool isConnectedToPower() override { return m_isPowerOnConnect; }
+    std::string getDeviceSpeed(int speed) const override;
+    bool canDisplayToast() override { return m_isToastRequired; }
+    int getPortSpeed() override { return m_usbPortSpeed; }
+    // The snapshot is shared by all observers of the event, it is not
+    // changed. Observers that change devices do it in updateLive().
+    void setDeviceType(std::string devType) override;
+    int getBusNumber() override { return m_busNum; }
+#ifdef WEBOS_SESSION
+    std::string getDevPath() override { return m_devPath; }
+    std::string getHubPortNumber() override { return m_hubPortNumber; }
+    std::string getVendorID() override { return m_vendorID; }
+    std::string getProductID() override { return m_productID; }
+    std::string getDeviceSetId() override { return m_deviceSetId; }
+#endif
+
+private:
+    Kind m_kind;
+    int m_usbPortNum;
+    int m_deviceNum;
+    int m_usbPortSpeed;
+    int m_busNum;
+    bool m_isPowerOnConnect;
+    bool m_isToastRequired;
+    unsigned long m_driveSize;
+    std::string m_deviceStatus;
+    std::string m_deviceType;
+    std::string m_errorReason;
+    std::string m_vendorName;
+    std::string m_productName;
+    std::string m_serialNumber;
+    std::string m_devSpeed;
+    std::string m_devicePath;
+    std::string m_deviceSubType;
+    std::string m_deviceName;
+    std::string m_driveName;
+#ifdef WEBOS_SESSION
+    std::string m_devPath;
+    std::string m_hubPortNumber;
+    std::string m_vendorID;
+    std::string m_productID;
+    std::string m_deviceSetId;
+#endif
+};
+
+#endif /* PDMDEVICESNAPSHOT_H_ */
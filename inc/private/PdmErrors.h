@@ -25,7 +25,9 @@ namespace PdmErrors
     enum PdmResponseErrors {
         PDM_RESPONSE_FAILURE = -1,
         PDM_RESPONSE_SPACEINFO_FAILURE = 103,
-        PDM_RESPOSE_CATEGORY_MISMATCH = 104
+        PDM_RESPOSE_CATEGORY_MISMATCH = 104,
+        PDM_RESPONSE_FILTER_WITH_CATEGORY = 105,
+        PDM_RESPONSE_FILTER_WITH_DELTA = 106
     };
 
     enum PdmDeviceErrors {
@@ -94,7 +96,9 @@ namespace PdmErrors
         {PDM_CONFIG_ERROR_LOAD,                     "Failed to load configuration"},
         {PDM_CONFIG_ERROR_NOCATEGORY,               "Category not found in config"},
         {PDM_CONFIG_ERROR_NOKEY,                    "Key not found in config"},
-        {PDM_RESPOSE_CATEGORY_MISMATCH,             "Category is not matching"}
+        {PDM_RESPOSE_CATEGORY_MISMATCH,             "Category is not matching"},
+        {PDM_RESPONSE_FILTER_WITH_CATEGORY,         "Filters and fields cannot be combined with category"},
+        {PDM_RESPONSE_FILTER_WITH_DELTA,            "Filters and fields cannot be combined with delta"}
     };
     void logPdmErrorCodeAndText(int errorCode);
 };
@@ -19,7 +19,11 @@
 
 #include "DiskPartitionInfo.h"
 #include "PdmErrors.h"
+#include "PdmSuperblockProbe.h"
+#include <list>
 #include <sys/statfs.h>
+#include <sys/types.h>
+#include <vector>
 
 typedef struct SpaceInfo {
     uint64_t driveSize;
@@ -41,14 +45,23 @@ public:
     ~PdmFs() = default;
     PdmDevStatus format(DiskPartitionInfo *partition, std::string &fileSysType,const std::string &label);
     PdmDevStatus fsck(DiskPartitionInfo &partition, const std::string& fsckMode);
+    // No-modify check of a partition that may be mounted read-only
+    PdmDevStatus checkOnly(DiskPartitionInfo &partition);
+    bool canCheckOnly(DiskPartitionInfo &partition) const;
     bool mountPartition(DiskPartitionInfo &partition, const bool &readOnly);
+    bool remountReadWrite(DiskPartitionInfo &partition);
     bool umount(DiskPartitionInfo &partition, const bool lazyUnmount) const;
     PdmDevStatus setVolumeLabel(DiskPartitionInfo *partition, const std::string &volLabel);
     PdmDevStatus isWritable(DiskPartitionInfo *partition, bool &isWritable);
     bool isSupportedFileSystem(const std::string fsType, const std::string &storageType);
-    bool isDriveBusy(DiskPartitionInfo &partition) const;
+    // busyPids, if given, gets the processes using the drive
+    bool isDriveBusy(DiskPartitionInfo &partition, std::vector<pid_t> *busyPids = nullptr) const;
+    // Checks all the partitions in one scan
+    bool isAnyDriveBusy(const std::list<DiskPartitionInfo*> &partitions, std::vector<pid_t> *busyPids = nullptr) const;
     bool calculateSpaceInfo(const std::string &mountName, SpaceInfo *fsInfo);
     void checkFileSystem(DiskPartitionInfo &partition);
+    // Reads the dirty state of an unmounted partition into its fsState
+    PdmFsState probeFsState(DiskPartitionInfo &partition);
 };
 
 
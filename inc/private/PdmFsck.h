@@ -34,7 +34,12 @@ private:
 public:
     PdmFsck();
     ~PdmFsck();
-    PdmDevStatus fsck(const std::string& fsckMode,const std::string driveType,const std::string driveName);
+    // checkerRan is false when the checker could not be started, the drive
+    // is then reported as checked so that it mounts as without fsck
+    PdmDevStatus fsck(const std::string& fsckMode,const std::string driveType,const std::string driveName, bool *checkerRan = nullptr);
+    // Checks without modifying, safe on a read-only mounted partition
+    PdmDevStatus checkOnly(const std::string driveType,const std::string driveName);
+    static bool hasCheckOnly(const std::string &driveType);
 
 
 };
@@ -0,0 +1,97 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef _PDM_FSCK_SCHEDULER_H
+#define _PDM_FSCK_SCHEDULER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PdmProcessRunner.h"
+
+#define PDM_FSCK_SCHEDULER_MAX_CONCURRENT 3
+// Checks running at once on one disk. A spinning disk seeks between
+// concurrent checks and gets slower for every one of them.
+#define PDM_FSCK_ROTATIONAL_DISK_LIMIT 1
+#define PDM_FSCK_FLASH_DISK_LIMIT 2
+
+// Runs the attach time fsck and mount work of storage partitions. Tasks of
+// one rotational disk run one after the other, tasks of different disks run
+// in parallel up to PDM_FSCK_SCHEDULER_MAX_CONCURRENT. Among the runnable
+// tasks the one with the highest priority, e.g. the largest partition, runs
+// first.
+class PdmFsckScheduler {
+
+private:
+    struct Task {
+        uint64_t seq;
+        const void *owner;
+        std::string diskName;
+        uint64_t priority;
+        std::function<void()> fn;
+    };
+    struct Running {
+        const void *owner;
+        std::thread::id worker;
+        PdmProcessId process;
+        bool cancelled;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_taskCv;
+    std::condition_variable m_doneCv;
+    std::list<Task> m_queue;
+    std::vector<Running> m_running;
+    // Per disk, running task count and limit while it has tasks
+    std::map<std::string, unsigned int> m_diskRunning;
+    std::map<std::string, unsigned int> m_diskLimit;
+    uint64_t m_nextSeq;
+    bool m_stop;
+    std::vector<std::thread> m_workers;
+
+    PdmFsckScheduler();
+    ~PdmFsckScheduler();
+    void workerLoop();
+    std::list<Task>::iterator nextRunnable();
+    void releaseDisk(const std::string &diskName);
+    Running* findRunning(std::thread::id worker);
+    static unsigned int readDiskLimit(const std::string &diskName);
+
+public:
+    PdmFsckScheduler(const PdmFsckScheduler&) = delete;
+    PdmFsckScheduler& operator=(const PdmFsckScheduler&) = delete;
+    static PdmFsckScheduler& getInstance();
+    // Queues fn for the disk diskName, e.g. sda. Tasks of equal priority run
+    // in submission order.
+    void submit(const void *owner, const std::string &diskName, uint64_t priority, std::function<void()> fn);
+    // Runs a checker for the calling task, cancel() of the task owner
+    // terminates it. Outside of a task this is PdmProcessRunner::run.
+    PdmProcessResult runProcess(const PdmProcessSpec &spec);
+    // Drops the queued tasks of owner, cancels the processes of its running
+    // ones and waits for them. Returns the number of dropped tasks.
+    size_t cancel(const void *owner);
+    size_t getQueuedCount();
+};
+
+#endif //_PDM_FSCK_SCHEDULER_H
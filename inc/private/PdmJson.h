@@ -20,8 +20,9 @@
 #include <list>
 #include "PdmLunaHandler.h"
 #include "CdcDevice.h"
+#include "PdmDeviceFilter.h"
 
-template < class T > bool getAttachedDeviceStatus(std::list<T*>& sList, pbnjson::JValue &payload)
+template < class T > bool getAttachedDeviceStatus(const std::list<T*>& sList, pbnjson::JValue &payload)
 {
     if(sList.empty())
         return false;
@@ -55,7 +56,7 @@ template < class T > bool getAttachedStreamingDeviceStatus(const std::list<T*>&
     return true;
 }
 
-template < class T > bool getAttachedStorageDeviceStatus(std::list<T*>& sList, pbnjson::JValue &payload)
+template < class T > bool getAttachedStorageDeviceStatus(const std::list<T*>& sList, pbnjson::JValue &payload)
 {
     if(sList.empty())
         return false;
@@ -81,10 +82,13 @@ template < class T > bool getAttachedStorageDeviceStatus(std::list<T*>& sList, p
     return true;
 }
 
-template < class T > bool getAttachedNonStorageDeviceList(std::list<T*>& sList, pbnjson::JValue &payload)
+template < class T > bool getAttachedNonStorageDeviceList(const std::list<T*>& sList, pbnjson::JValue &payload, const PdmDeviceFilter &filter = PdmDeviceFilter())
 {
    if(sList.empty())
         return false;
+   // Non storage devices have neither a storage type nor a mount state
+   if(filter.hasStorageCriteria())
+        return true;
 
     for(auto device: sList)
     {
@@ -95,41 +99,48 @@ template < class T > bool getAttachedNonStorageDeviceList(std::list<T*>& sList,
        {
             continue;
        }
+#endif
+       if(!filter.matches(device))
+            continue;
        pbnjson::JValue nonStorageDeviceObj = pbnjson::Object();
-       nonStorageDeviceObj.put("deviceNum",(int64_t)device->getDeviceNum());
-       nonStorageDeviceObj.put("usbPortNum", (int64_t)device->getUsbPortNumber());
-       nonStorageDeviceObj.put("vendorName", device->getVendorName());
-       nonStorageDeviceObj.put("productName", device->getProductName());
-       nonStorageDeviceObj.put("serialNumber", device->getSerialNumber());
-       nonStorageDeviceObj.put("deviceType", device->getDeviceType());
-       nonStorageDeviceObj.put("deviceSubtype", device->getDeviceSubType());
-       nonStorageDeviceObj.put("isPowerOnConnect", device->isConnectedToPower());
-       nonStorageDeviceObj.put("devSpeed", device->getDevSpeed());
-       nonStorageDeviceObj.put("devPath", device->getDevPath());
-       nonStorageDeviceObj.put("hubPortPath", device->getHubPortNumber());
-       nonStorageDeviceObj.put("vendorId", device->getVendorID());
-       nonStorageDeviceObj.put("productId", device->getProductID());
-       if(device->getDeviceType() == "BLUETOOTH") {
+       if(filter.wants("deviceNum"))
+            nonStorageDeviceObj.put("deviceNum",(int64_t)device->getDeviceNum());
+       if(filter.wants("usbPortNum"))
+            nonStorageDeviceObj.put("usbPortNum", (int64_t)device->getUsbPortNumber());
+       if(filter.wants("vendorName"))
+            nonStorageDeviceObj.put("vendorName", device->getVendorName());
+       if(filter.wants("productName"))
+            nonStorageDeviceObj.put("productName", device->getProductName());
+       if(filter.wants("serialNumber"))
+            nonStorageDeviceObj.put("serialNumber", device->getSerialNumber());
+       if(filter.wants("deviceType"))
+            nonStorageDeviceObj.put("deviceType", device->getDeviceType());
+       if(filter.wants("deviceSubtype"))
+            nonStorageDeviceObj.put("deviceSubtype", device->getDeviceSubType());
+       if(filter.wants("isPowerOnConnect"))
+            nonStorageDeviceObj.put("isPowerOnConnect", device->isConnectedToPower());
+       if(filter.wants("devSpeed"))
+            nonStorageDeviceObj.put("devSpeed", device->getDevSpeed());
+#ifdef WEBOS_SESSION
+       if(filter.wants("devPath"))
+            nonStorageDeviceObj.put("devPath", device->getDevPath());
+       if(filter.wants("hubPortPath"))
+            nonStorageDeviceObj.put("hubPortPath", device->getHubPortNumber());
+       if(filter.wants("vendorId"))
+            nonStorageDeviceObj.put("vendorId", device->getVendorID());
+       if(filter.wants("productId"))
+            nonStorageDeviceObj.put("productId", device->getProductID());
+       if(device->getDeviceType() == "BLUETOOTH" && filter.wants("deviceName")) {
             nonStorageDeviceObj.put("deviceName", device->getDeviceName());
        }
-       nonStorageDeviceObj.put("deviceSetId", device->getDeviceSetId());
-#else
-       pbnjson::JValue nonStorageDeviceObj = pbnjson::Object();
-       nonStorageDeviceObj.put("deviceNum",(int64_t)device->getDeviceNum());
-       nonStorageDeviceObj.put("usbPortNum", (int64_t)device->getUsbPortNumber());
-       nonStorageDeviceObj.put("vendorName", device->getVendorName());
-       nonStorageDeviceObj.put("productName", device->getProductName());
-       nonStorageDeviceObj.put("serialNumber", device->getSerialNumber());
-       nonStorageDeviceObj.put("deviceType", device->getDeviceType());
-       nonStorageDeviceObj.put("deviceSubtype", device->getDeviceSubType());
-       nonStorageDeviceObj.put("isPowerOnConnect", device->isConnectedToPower());
-       nonStorageDeviceObj.put("devSpeed", device->getDevSpeed());
+       if(filter.wants("deviceSetId"))
+            nonStorageDeviceObj.put("deviceSetId", device->getDeviceSetId());
 #endif
        payload.append(nonStorageDeviceObj);
    }
    return true;
 }
-template < class T > bool getAttachedStorageDeviceList (std::list<T*>& sList, pbnjson::JValue &payload)
+template < class T > bool getAttachedStorageDeviceList (const std::list<T*>& sList, pbnjson::JValue &payload, const PdmDeviceFilter &filter = PdmDeviceFilter())
 {
     if(sList.empty())
         return false;
@@ -139,76 +150,76 @@ template < class T > bool getAttachedStorageDeviceList (std::list<T*>& sList, pb
 #ifdef WEBOS_SESSION
         if(storageIter->getErrorReason() == "NOMOUNTED")
             continue;
+#endif
+        if(!filter.matches(storageIter) || !filter.matchesStorageType(storageIter->getStorageTypeString()))
+            continue;
+        //in suspend case before umount need to send isMounted as false
+        bool isMounted = storageIter->getPowerStatus() && storageIter->getIsMounted();
+        if(!filter.matchesMounted(isMounted))
+            continue;
 
         pbnjson::JValue storageDevice = pbnjson::Object();
-        pbnjson::JValue storageDriveList = pbnjson::Array();
-        storageDevice.put("deviceNum", (int32_t)storageIter->getDeviceNum());
-        storageDevice.put("usbPortNum", (int32_t)storageIter->getUsbPortNumber());
-        storageDevice.put("vendorName",  storageIter->getVendorName());
-        storageDevice.put("productName", storageIter->getProductName());
-        storageDevice.put("serialNumber", storageIter->getSerialNumber());
-        storageDevice.put("deviceType", storageIter->getDeviceType());
-        storageDevice.put("storageType", storageIter->getStorageTypeString());
-        storageDevice.put("rootPath", storageIter->getRootPath());
-        storageDevice.put("isPowerOnConnect", storageIter->isConnectedToPower());
-        storageDevice.put("devSpeed", storageIter->getDevSpeed());
-        storageDevice.put("errorReason", storageIter->getErrorReason());
+        if(filter.wants("deviceNum"))
+            storageDevice.put("deviceNum", (int32_t)storageIter->getDeviceNum());
+        if(filter.wants("usbPortNum"))
+            storageDevice.put("usbPortNum", (int32_t)storageIter->getUsbPortNumber());
+        if(filter.wants("vendorName"))
+            storageDevice.put("vendorName",  storageIter->getVendorName());
+        if(filter.wants("productName"))
+            storageDevice.put("productName", storageIter->getProductName());
+        if(filter.wants("serialNumber"))
+            storageDevice.put("serialNumber", storageIter->getSerialNumber());
+        if(filter.wants("deviceType"))
+            storageDevice.put("deviceType", storageIter->getDeviceType());
+        if(filter.wants("storageType"))
+            storageDevice.put("storageType", storageIter->getStorageTypeString());
+        if(filter.wants("rootPath"))
+            storageDevice.put("rootPath", storageIter->getRootPath());
+        if(filter.wants("isPowerOnConnect"))
+            storageDevice.put("isPowerOnConnect", storageIter->isConnectedToPower());
+        if(filter.wants("devSpeed"))
+            storageDevice.put("devSpeed", storageIter->getDevSpeed());
+        if(filter.wants("errorReason"))
+            storageDevice.put("errorReason", storageIter->getErrorReason());
         //storageDevice.put("hubPortPath", storageIter->getHubPortNumber());
-        pbnjson::JValue driveInfo = pbnjson::Object();
-        driveInfo.put("driveName", storageIter->getDriveName());
-        driveInfo.put("mountName", storageIter->getMountName());
-        driveInfo.put("uuid", storageIter->getUuid());
-        driveInfo.put("volumeLabel", storageIter->getVolumeLable());
-        driveInfo.put("fsType", storageIter->getFsType());
-        driveInfo.put("driveSize", (int64_t) storageIter->getDriveSize());
-
-        if(storageIter->getPowerStatus())
-            driveInfo.put("isMounted", storageIter->getIsMounted());
-        else  //in suspend case before umount need to send isMounted as false
-            driveInfo.put("isMounted", false);
-
-        storageDriveList.append(driveInfo);
-        storageDevice.put("storageDriveList", storageDriveList);
+        if(filter.wantsAny({"driveName", "mountName", "uuid", "volumeLabel", "fsType", "driveSize", "isMounted"}))
+        {
+            pbnjson::JValue storageDriveList = pbnjson::Array();
+            pbnjson::JValue driveInfo = pbnjson::Object();
+            if(filter.wants("driveName"))
+                driveInfo.put("driveName", storageIter->getDriveName());
+            if(filter.wants("mountName"))
+                driveInfo.put("mountName", storageIter->getMountName());
+            if(filter.wants("uuid"))
+                driveInfo.put("uuid", storageIter->getUuid());
+            if(filter.wants("volumeLabel"))
+                driveInfo.put("volumeLabel", storageIter->getVolumeLable());
+            if(filter.wants("fsType"))
+                driveInfo.put("fsType", storageIter->getFsType());
+#ifdef WEBOS_SESSION
+            if(filter.wants("driveSize"))
+                driveInfo.put("driveSize", (int64_t) storageIter->getDriveSize());
 #else
-        pbnjson::JValue storageDevice = pbnjson::Object();
-        pbnjson::JValue storageDriveList = pbnjson::Array();
-        storageDevice.put("deviceNum", (int32_t)storageIter->getDeviceNum());
-        storageDevice.put("usbPortNum", (int32_t)storageIter->getUsbPortNumber());
-        storageDevice.put("vendorName",  storageIter->getVendorName());
-        storageDevice.put("productName", storageIter->getProductName());
-        storageDevice.put("serialNumber", storageIter->getSerialNumber());
-        storageDevice.put("deviceType", storageIter->getDeviceType());
-        storageDevice.put("storageType", storageIter->getStorageTypeString());
-        storageDevice.put("rootPath", storageIter->getRootPath());
-        storageDevice.put("isPowerOnConnect", storageIter->isConnectedToPower());
-        storageDevice.put("devSpeed", storageIter->getDevSpeed());
-        storageDevice.put("errorReason", storageIter->getErrorReason());
-        pbnjson::JValue driveInfo = pbnjson::Object();
-        driveInfo.put("driveName", storageIter->getDriveName());
-        driveInfo.put("mountName", storageIter->getMountName());
-        driveInfo.put("uuid", storageIter->getUuid());
-        driveInfo.put("volumeLabel", storageIter->getVolumeLable());
-        driveInfo.put("fsType", storageIter->getFsType());
-        driveInfo.put("driveSize", (int32_t)storageIter->getDriveSize());
-
-        if(storageIter->getPowerStatus())
-            driveInfo.put("isMounted", storageIter->getIsMounted());
-        else  //in suspend case before umount need to send isMounted as false
-            driveInfo.put("isMounted", false);
-
-        storageDriveList.append(driveInfo);
-        storageDevice.put("storageDriveList", storageDriveList);
+            if(filter.wants("driveSize"))
+                driveInfo.put("driveSize", (int32_t)storageIter->getDriveSize());
 #endif
+            if(filter.wants("isMounted"))
+                driveInfo.put("isMounted", isMounted);
+
+            storageDriveList.append(driveInfo);
+            storageDevice.put("storageDriveList", storageDriveList);
+        }
         payload.append(storageDevice);
     }
     return true;
 }
 
-template < class T > bool getAttachedUsbStorageDeviceList (std::list<T*>& sList, pbnjson::JValue &payload)
+template < class T > bool getAttachedUsbStorageDeviceList (const std::list<T*>& sList, pbnjson::JValue &payload, const PdmDeviceFilter &filter = PdmDeviceFilter())
 {
     if(sList.empty())
         return false;
 
+    bool wantsDrives = filter.wantsAny({"isMounted", "mountName", "driveSize", "volumeLabel", "uuid", "driveName", "fsType", "fsState"});
     for( auto storageIter : sList )
     {
 #ifdef WEBOS_SESSION
@@ -218,57 +229,103 @@ template < class T > bool getAttachedUsbStorageDeviceList (std::list<T*>& sList,
         if(storageIter->getDiskPartition().empty())
 #endif
             continue;
+        if(!filter.matches(storageIter) || !filter.matchesStorageType(storageIter->getStorageTypeString()))
+            continue;
         pbnjson::JValue storageDevice = pbnjson::Object();
         pbnjson::JValue storageDriveList = pbnjson::Array();
+        size_t matchedDrives = 0;
         for(auto disk : storageIter->getDiskPartition())
         {
+            bool isMounted = false;
+            if(filter.hasMountCriteria() || filter.wants("isMounted")) {
+#ifndef WEBOS_SESSION
+                //in suspend case before umount need to send isMounted as false
+                isMounted = disk->getPowerStatus() && disk->isMounted();
+#else
+                isMounted = disk->isPartitionMounted(storageIter->getHubPortNumber());
+#endif
+                if(!filter.matchesMounted(isMounted))
+                    continue;
+            }
+            matchedDrives++;
+            if(!wantsDrives)
+                continue;
+
             pbnjson::JValue driveInfo = pbnjson::Object();
+            if(filter.wants("isMounted"))
+                driveInfo.put("isMounted", isMounted);
 #ifndef WEBOS_SESSION
-            if(disk->getPowerStatus())
-                driveInfo.put("isMounted", disk->isMounted());
-            else //in suspend case before umount need to send isMounted as false
-            driveInfo.put("isMounted", false);
-            driveInfo.put("mountName", disk->getMountName());
-            driveInfo.put("driveSize", (int32_t)disk->getDriveSize());
+            if(filter.wants("mountName"))
+                driveInfo.put("mountName", disk->getMountName());
+            if(filter.wants("driveSize"))
+                driveInfo.put("driveSize", (int32_t)disk->getDriveSize());
 #else
-            driveInfo.put("isMounted", disk->isPartitionMounted(storageIter->getHubPortNumber()));
-            driveInfo.put("mountName", disk->getPartitionMountName(storageIter->getHubPortNumber(), disk->getDriveName()));
-            driveInfo.put("driveSize", disk->getPartitionSize(storageIter->getHubPortNumber(), disk->getDriveName()));
+            if(filter.wants("mountName"))
+                driveInfo.put("mountName", disk->getPartitionMountName(storageIter->getHubPortNumber(), disk->getDriveName()));
+            if(filter.wants("driveSize"))
+                driveInfo.put("driveSize", disk->getPartitionSize(storageIter->getHubPortNumber(), disk->getDriveName()));
 #endif
-            driveInfo.put("volumeLabel", disk->getVolumeLable());
-            driveInfo.put("uuid", disk->getUuid());
-            driveInfo.put("driveName", disk->getDriveName());
-            driveInfo.put("fsType", disk->getFsType());
+            if(filter.wants("volumeLabel"))
+                driveInfo.put("volumeLabel", disk->getVolumeLable());
+            if(filter.wants("uuid"))
+                driveInfo.put("uuid", disk->getUuid());
+            if(filter.wants("driveName"))
+                driveInfo.put("driveName", disk->getDriveName());
+            if(filter.wants("fsType"))
+                driveInfo.put("fsType", disk->getFsType());
+            if(filter.wants("fsState"))
+                driveInfo.put("fsState", disk->getFsState());
 
             storageDriveList.append(driveInfo);
         }
-        storageDevice.put("storageDriveList", storageDriveList);
-        storageDevice.put("deviceNum", (int32_t)storageIter->getDeviceNum());
-        storageDevice.put("usbPortNum",(int32_t)storageIter->getUsbPortNumber());
-        storageDevice.put("vendorName",  storageIter->getVendorName());
-        storageDevice.put("productName", storageIter->getProductName());
-        storageDevice.put("serialNumber",storageIter->getSerialNumber());
-        storageDevice.put("deviceType", storageIter->getDeviceType());
-        storageDevice.put("storageType", storageIter->getStorageTypeString());
+        // No drive in the requested mount state
+        if(matchedDrives == 0)
+            continue;
+        if(wantsDrives)
+            storageDevice.put("storageDriveList", storageDriveList);
+        if(filter.wants("deviceNum"))
+            storageDevice.put("deviceNum", (int32_t)storageIter->getDeviceNum());
+        if(filter.wants("usbPortNum"))
+            storageDevice.put("usbPortNum",(int32_t)storageIter->getUsbPortNumber());
+        if(filter.wants("vendorName"))
+            storageDevice.put("vendorName",  storageIter->getVendorName());
+        if(filter.wants("productName"))
+            storageDevice.put("productName", storageIter->getProductName());
+        if(filter.wants("serialNumber"))
+            storageDevice.put("serialNumber",storageIter->getSerialNumber());
+        if(filter.wants("deviceType"))
+            storageDevice.put("deviceType", storageIter->getDeviceType());
+        if(filter.wants("storageType"))
+            storageDevice.put("storageType", storageIter->getStorageTypeString());
 #ifdef WEBOS_SESSION
-        storageDevice.put("hubPortPath", storageIter->getHubPortNumber());
-        storageDevice.put("errorReason", storageIter->getErrorReason(storageIter->getHubPortNumber()));
-        storageDevice.put("vendorId", storageIter->getVendorID());
-        storageDevice.put("productId", storageIter->getProductID());
-        storageDevice.put("deviceSetId", storageIter->getDeviceSetId());
-        storageDevice.put("rootPath", storageIter->getStorageRootPath(storageIter->getHubPortNumber()));
+        if(filter.wants("hubPortPath"))
+            storageDevice.put("hubPortPath", storageIter->getHubPortNumber());
+        if(filter.wants("errorReason"))
+            storageDevice.put("errorReason", storageIter->getErrorReason(storageIter->getHubPortNumber()));
+        if(filter.wants("vendorId"))
+            storageDevice.put("vendorId", storageIter->getVendorID());
+        if(filter.wants("productId"))
+            storageDevice.put("productId", storageIter->getProductID());
+        if(filter.wants("deviceSetId"))
+            storageDevice.put("deviceSetId", storageIter->getDeviceSetId());
+        if(filter.wants("rootPath"))
+            storageDevice.put("rootPath", storageIter->getStorageRootPath(storageIter->getHubPortNumber()));
 #else
-        storageDevice.put("rootPath", storageIter->getRootPath());
-        storageDevice.put("errorReason", storageIter->getErrorReason());
+        if(filter.wants("rootPath"))
+            storageDevice.put("rootPath", storageIter->getRootPath());
+        if(filter.wants("errorReason"))
+            storageDevice.put("errorReason", storageIter->getErrorReason());
 #endif
-        storageDevice.put("isPowerOnConnect", storageIter->isConnectedToPower());
-        storageDevice.put("devSpeed", storageIter->getDevSpeed());
+        if(filter.wants("isPowerOnConnect"))
+            storageDevice.put("isPowerOnConnect", storageIter->isConnectedToPower());
+        if(filter.wants("devSpeed"))
+            storageDevice.put("devSpeed", storageIter->getDevSpeed());
         payload.append(storageDevice);
     }
     return true;
 }
 
-template < class T > bool getExampleAttachedUsbStorageDeviceList (std::list<T*>& sList, pbnjson::JValue &payload)
+template < class T > bool getExampleAttachedUsbStorageDeviceList (const std::list<T*>& sList, pbnjson::JValue &payload)
 {
     if(sList.empty())
         return false;
@@ -305,6 +362,7 @@ template < class T > bool getExampleAttachedUsbStorageDeviceList (std::list<T*>&
             driveInfo.put("driveName", disk->getDriveName());
             driveInfo.put("driveSize", (int32_t)disk->getDriveSize());
             driveInfo.put("fsType", disk->getFsType());
+            driveInfo.put("fsState", disk->getFsState());
             driveInfo.put("mountName", disk->getMountName());
 
             storageDriveList.append(driveInfo);
@@ -326,7 +384,7 @@ template < class T > bool getExampleAttachedUsbStorageDeviceList (std::list<T*>&
     return true;
 }
 
-template < class T > bool getAttachedAudioDeviceList(std::list<T*>& sList, pbnjson::JValue &payload, bool groupSubDevices)
+template < class T > bool getAttachedAudioDeviceList(const std::list<T*>& sList, pbnjson::JValue &payload, bool groupSubDevices)
 {
     if(sList.empty())
         return false;
@@ -355,7 +413,7 @@ template < class T > bool getAttachedAudioDeviceList(std::list<T*>& sList, pbnjs
     return true;
 }
 
-template < class T > bool getAttachedVideoDeviceList(std::list<T*>& sList, pbnjson::JValue &payload, bool groupSubDevices)
+template < class T > bool getAttachedVideoDeviceList(const std::list<T*>& sList, pbnjson::JValue &payload, bool groupSubDevices)
 {
    if(sList.empty())
         return false;
@@ -387,7 +445,7 @@ template < class T > bool getAttachedVideoDeviceList(std::list<T*>& sList, pbnjs
    return true;
 }
 
-template < class T > bool getAttachedNetDeviceList(std::list<T*>& sList, pbnjson::JValue &payload)
+template < class T > bool getAttachedNetDeviceList(const std::list<T*>& sList, pbnjson::JValue &payload)
 {
    if(sList.empty())
         return false;
@@ -0,0 +1,108 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef _PDM_LATENCY_STATS_H
+#define _PDM_LATENCY_STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+// Stages of the path from a uevent to the subscriber replies. HANDLER
+// includes NOTIFY, which posts the events to the observer bus.
+enum class PdmLatencyStage {
+    DISPATCH = 0,        // uevent receive to command enqueue, includes coalescing
+    QUEUE_WAIT,          // command enqueue to dequeue
+    HANDLER,             // handler entry to exit
+    NOTIFY,              // DeviceStateObserver::Notify
+    OBSERVER_QUEUE,      // event post to observer delivery
+    PAYLOAD_BUILD,       // subscription payload creation
+    SUBSCRIPTION_REPLY,  // LSSubscriptionReply calls
+    END_TO_END,          // uevent receive to the first subscriber reply of an event
+    MAX_STAGES
+};
+
+// Bucket i counts samples below 2^i us, the last bucket everything above
+#define PDM_LATENCY_BUCKET_COUNT 25
+
+typedef struct PdmLatencyHistogram {
+    uint64_t count;
+    uint64_t totalUs;
+    uint64_t maxUs;
+    std::array<uint64_t, PDM_LATENCY_BUCKET_COUNT> buckets;
+}PdmLatencyHistogram;
+
+typedef std::array<PdmLatencyHistogram, static_cast<size_t>(PdmLatencyStage::MAX_STAGES)> PdmLatencyStageHistograms;
+
+// Latency histograms per stage and device type, the device type being the
+// subsystem of the uevent being handled. Stages measured outside of a uevent,
+// e.g. a notification after a format, are reported under "none".
+namespace PdmLatencyStats
+{
+    typedef std::chrono::steady_clock Clock;
+
+    // Marks the uevent handled by the calling thread for the stages measured
+    // in its scope
+    class EventScope {
+    public:
+        EventScope(const std::string &deviceType, Clock::time_point receiveTime);
+        EventScope(const EventScope&) = delete;
+        EventScope& operator=(const EventScope&) = delete;
+        ~EventScope();
+        static EventScope* current();
+        const std::string& getDeviceType() const { return m_deviceType; }
+        Clock::time_point getReceiveTime() const { return m_receiveTime; }
+        bool markReplied();
+    private:
+        std::string m_deviceType;
+        Clock::time_point m_receiveTime;
+        bool m_replied;
+        EventScope *m_previous;
+    };
+
+    // Accumulates the time spent between start() and stop() calls and
+    // records it as one sample when destroyed
+    class StageTimer {
+    public:
+        explicit StageTimer(PdmLatencyStage stage);
+        StageTimer(const StageTimer&) = delete;
+        StageTimer& operator=(const StageTimer&) = delete;
+        ~StageTimer();
+        void start();
+        void stop();
+    private:
+        PdmLatencyStage m_stage;
+        Clock::time_point m_start;
+        Clock::duration m_elapsed;
+        bool m_running;
+        bool m_used;
+    };
+
+    void record(PdmLatencyStage stage, const std::string &deviceType, Clock::time_point start, Clock::time_point end);
+    void record(PdmLatencyStage stage, Clock::time_point start, Clock::time_point end);
+    // Records END_TO_END once for the uevent of the calling thread
+    void markReplied();
+    std::map<std::string, PdmLatencyStageHistograms> getHistograms();
+    void reset();
+    uint64_t getPercentileUs(const PdmLatencyHistogram &histogram, unsigned int percentile);
+    const char* getStageName(PdmLatencyStage stage);
+};
+
+#endif //_PDM_LATENCY_STATS_H
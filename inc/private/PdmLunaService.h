@@ -17,8 +17,15 @@
 #ifndef _PDMLUNASERVICE_H
 #define _PDMLUNASERVICE_H
 
+#include <chrono>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
 #include <glib.h>
 #include <luna-service2++/handle.hpp>
 #include <luna-service2/lunaservice.hpp>
@@ -27,6 +34,8 @@
 #include "pbnjson.hpp"
 #include "CommandTypes.h"
 #include "Command.h"
+#include "PdmConfig.h"
+#include "PdmDeltaHistory.h"
 
 #define PDM_SERVICE_NAME                  "com.webos.service.pdm"
 
@@ -37,6 +46,10 @@
 #define PDM_EVENT_AUDIO_SUB_DEVICES             "getAttachedAudioSubDeviceList"
 #define PDM_EVENT_NON_STORAGE_DEVICES_VIDEO     "getAttachedVideoDeviceList"
 #define PDM_EVENT_NON_STORAGE_SUB_DEVICES_VIDEO "getAttachedVideoSubDeviceList"
+// Appended to the event of a list for its "delta": true subscribers
+#define PDM_EVENT_DELTA_SUFFIX                  ":delta"
+// Appended to the event of a list for subscribers with filters or "fields"
+#define PDM_EVENT_FILTER_SUFFIX                 ":filter"
 
 //#ifdef WEBOS_SESSION
 #define PDM_EVENT_ALL_ATTACHED_DEVICE_LIST         "getAttachedAllDeviceList"
@@ -99,10 +112,39 @@ class PdmLunaService
         pbnjson::JValue createJsonGetAttachedDeviceStatus(LSMessage *message);
         pbnjson::JValue createJsonGetAttachedNonStorageDeviceList(LSMessage *message, std::string deviceType = std::string());
         pbnjson::JValue createJsonGetAttachedStorageDeviceList(LSMessage *message);
+        // Serialized payloads served from PdmPayloadCache. returnValue 0 or 1
+        // replaces the one of the payload, as get calls reply whether they
+        // subscribed.
+        std::string getStorageDeviceListText(int returnValue = -1);
+        std::string getNonStorageDeviceListText(const std::string &deviceType, int returnValue = -1);
+        std::string getDeviceStatusText(int returnValue = -1);
+        // Delta histories by list event, created by the first delta request
+        std::map<std::string, std::unique_ptr<PdmDeltaHistory>> mDeltaHistories;
+        PdmDeltaHistory* getDeltaHistory(const std::string &eventKey, bool create);
+        std::string getEventPayloadText(const std::string &eventKey);
+        void notifyDeltaSubscribers(const std::string &eventKey, const std::string &payloadText);
+        bool isDeltaRequest(LSMessage *message);
+        bool replyDelta(LSHandle *sh, LSMessage *message, const std::string &eventKey);
+        std::string getFilteredListText(const std::string &eventKey, LSMessage *message, int returnValue = -1);
+        bool replyFiltered(LSHandle *sh, LSMessage *message, const std::string &eventKey);
+        void replyFilteredSubscribers(const std::string &eventKey);
+        // Device changes waiting for the coalescing window, all on the main
+        // loop. Each subscription key is replied once per flush.
+        int mNotifyWindowMs;
+        guint mNotifyFlushSourceId;
+        std::chrono::steady_clock::time_point mLastNotifyFlush;
+        std::set<unsigned int> mPendingNotifyTypes;
+        std::vector<std::pair<std::string, std::chrono::steady_clock::time_point>> mPendingNotifyTraces;
+        uint64_t mNotifyRequests;
+        uint64_t mNotifyFlushes;
+        int readNotifyCoalescingWindow(PdmConfig* const pConfObj);
+        void scheduleNotifyFlush();
+        static int flushNotificationsCb(void *data);
+        bool flushNotifications();
     public:
         PdmLunaService(CommandManager *cmdManager);
         ~PdmLunaService();
-        bool init(GMainLoop *);
+        bool init(GMainLoop *, PdmConfig* const pConfObj = nullptr);
         bool PdmLunaServiceRegister(const char *srvcname, GMainLoop *mainLoop, LSHandle **mServiceHandle);
         LSHandle *get_LSHandle(void);
 #ifdef WEBOS_SESSION
@@ -145,6 +187,9 @@ class PdmLunaService
         static bool _cbmountandFullFsck(LSHandle *sh, LSMessage *message , void *data){
             return static_cast<PdmLunaService*>(data)->cbmountandFullFsck(sh, message);
         }
+        static bool _cbgetPerformanceStats(LSHandle *sh, LSMessage *message , void *data){
+            return static_cast<PdmLunaService*>(data)->cbGetPerformanceStats(sh, message);
+        }
 #ifdef WEBOS_SESSION
         static bool _cbgetAttachedDeviceList(LSHandle *sh, LSMessage *message , void *data){
             return static_cast<PdmLunaService*>(data)->cbgetAttachedDeviceList(sh, message);
@@ -160,7 +205,7 @@ class PdmLunaService
         void deletePreviousMountName(std::string hubPortPath);
         void displayConnectedToast(std::string device, std::string deviceSetId);
         void displayDisconnectedToast(std::string device, std::string deviceSetId);
-        bool isDriveBusy(std::string mountName);
+        bool isDriveBusy(std::string mountName, std::vector<pid_t> *busyPids = nullptr);
         bool isWritable(std::string driveNmae);
         void updateAllDeviceSessionPayload(std::string deviceSetId);
         void updateHostPayload(std::string deviceType);
@@ -189,9 +234,7 @@ class PdmLunaService
         static bool cbAllDeviceSessionResponse(LSHandle * sh, LSMessage * message, void * user_data);
         static bool cbHostPayloadResponse (LSHandle * sh, LSMessage * message, void * user_data);
         static bool cbPayloadResponse(LSHandle * sh, LSMessage * message, void * user_data);
-        static bool cbQueryResponse(LSHandle* lshandle, LSMessage *message, void *user_data);
         static bool cbDb8FindResponse(LSHandle * sh, LSMessage * message, void * user_data);
-        static bool cbDeleteResponse (LSHandle * sh, LSMessage * message, void * user_data);
         bool getDevicesFromDB(std::string deviceType, std::string sessionId);
         bool cbgetAttachedAllDeviceList(LSHandle *sh, LSMessage *message);
         pbnjson::JValue createJsonGetAttachedAllDeviceList(LSMessage *message );
@@ -203,6 +246,7 @@ class PdmLunaService
         static bool cbUpdateStorageDeviceListResponse(LSHandle * sh, LSMessage * message, void * user_data);
 #endif
         bool notifySubscribers(unsigned int eventDeviceType, const int &eventID, std::string hubPortPath);
+        bool hasSubscribers(const char *eventKey);
         bool cbGetExample(LSHandle *sh, LSMessage *message);
         bool cbGetAttachedStorageDeviceList(LSHandle *sh, LSMessage *message);
         bool cbGetAttachedNonStorageDeviceList(LSHandle *sh, LSMessage *message);
@@ -216,6 +260,7 @@ class PdmLunaService
         bool cbUmountAllDrive(LSHandle *sh, LSMessage *message);
         bool commandReply(CommandResponse *cmdRes, void *msg);
         bool cbmountandFullFsck(LSHandle *sh, LSMessage *message);
+        bool cbGetPerformanceStats(LSHandle *sh, LSMessage *message);
 
         bool deinit();
 
@@ -0,0 +1,127 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef PDM_MPMC_QUEUE_H
+#define PDM_MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bounded lock-free queue for many producers and many consumers.
+// Storage is allocated once, push and pop never allocate. Based on the
+// sequence-numbered ring of D. Vyukov: each cell carries the position it is
+// valid for, so producers only contend on the enqueue position and
+// consumers on the dequeue position.
+template <class T>
+class PdmMpmcQueue {
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> m_buffer;
+    size_t m_mask;
+    // Padding keeps the producer and consumer positions on separate cache lines
+    char m_pad0[64];
+    std::atomic<size_t> m_enqueuePos;
+    char m_pad1[64];
+    std::atomic<size_t> m_dequeuePos;
+
+public:
+    // capacity is rounded up to a power of two
+    explicit PdmMpmcQueue(size_t capacity);
+    PdmMpmcQueue(const PdmMpmcQueue&) = delete;
+    PdmMpmcQueue& operator=(const PdmMpmcQueue&) = delete;
+    bool tryPush(const T &value);
+    bool tryPop(T &value);
+    bool empty() const;
+};
+
+template <class T>
+PdmMpmcQueue<T>::PdmMpmcQueue(size_t capacity)
+    : m_mask(0)
+    , m_enqueuePos(0)
+    , m_dequeuePos(0)
+{
+    size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+    m_buffer.reset(new Cell[size]);
+    m_mask = size - 1;
+    for (size_t i = 0; i < size; i++)
+        m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <class T>
+bool PdmMpmcQueue<T>::tryPush(const T &value)
+{
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell &cell = m_buffer[pos & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.data = value;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // full
+            return false;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <class T>
+bool PdmMpmcQueue<T>::tryPop(T &value)
+{
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell &cell = m_buffer[pos & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                value = cell.data;
+                cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // empty
+            return false;
+        } else {
+            pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <class T>
+bool PdmMpmcQueue<T>::empty() const
+{
+    size_t pos = m_dequeuePos.load(std::memory_order_acquire);
+    const Cell &cell = m_buffer[pos & m_mask];
+    return (intptr_t)cell.sequence.load(std::memory_order_acquire) - (intptr_t)(pos + 1) < 0;
+}
+
+#endif  //PDM_MPMC_QUEUE_H
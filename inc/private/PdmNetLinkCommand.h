@@ -24,12 +24,14 @@ class PdmNetLinkCommand : public Command {
 
 private:
     DeviceClass *m_deviceClassEvent;
+    std::string m_orderingKey;
 public:
     PdmNetLinkCommand(DeviceClass *deviceClassEvent);
     PdmNetLinkCommand(const DeviceClass&) = delete;
     PdmNetLinkCommand& operator=(const DeviceClass&) = delete;
     ~PdmNetLinkCommand();
     void execute();
+    std::string getOrderingKey() const override;
 
 };
 
@@ -17,7 +17,11 @@
 #ifndef _PDMNETLINKCLASSADAPTER_H
 #define _PDMNETLINKCLASSADAPTER_H
 #include <libudev.h>
+#include <chrono>
 #include "CommandManager.h"
+#include "PdmDevPropertyBlock.h"
+
+class DeviceClass;
 
 
 class PdmNetlinkClassAdapter {
@@ -28,10 +32,13 @@ private:
 	PdmNetlinkClassAdapter(PdmNetlinkClassAdapter&&) = delete;
 	PdmNetlinkClassAdapter& operator=(PdmNetlinkClassAdapter&&) = delete;
 	CommandManager *mCmdManager;
+	void sendDeviceClass(DeviceClass*, std::chrono::steady_clock::time_point receiveTime);
 public:
 	static PdmNetlinkClassAdapter& getInstance();
 	void setCommandManager(CommandManager*);
 	void handleEvent(struct udev_device*, bool isPowerOnConnect);
+	void handleEvent(const PdmDevPropertyBlockPtr &devProps,
+	                 std::chrono::steady_clock::time_point receiveTime = std::chrono::steady_clock::now());
    	~PdmNetlinkClassAdapter();
 
 };
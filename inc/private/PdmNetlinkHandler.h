@@ -17,7 +17,10 @@
 #ifndef _PDMNETLINKHANDLER_H
 #define _PDMNETLINKHANDLER_H
 
+#include <string>
+
 #include "CommandManager.h"
+#include "PdmConfig.h"
 #include "PdmNetlinkListener.h"
 #include "DeviceClass.h"
 
@@ -25,8 +28,12 @@ class PdmNetlinkHandler: public PdmNetlinkListener
 {
 private:
     CommandManager *m_commandManager;
+    PdmConfig *m_pConfObj;
+    int readCoalescingWindow();
+    int readReceiveBufferSize();
+    std::string readUeventRecordFile();
 public:
-    explicit PdmNetlinkHandler(CommandManager *cmdManager);
+    PdmNetlinkHandler(CommandManager *cmdManager, PdmConfig *pConfObj);
     ~PdmNetlinkHandler();
     bool start();
     bool stop();
@@ -17,24 +17,69 @@
 #ifndef _PDMNETLINKLISTENER_H
 #define _PDMNETLINKLISTENER_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "PdmDevPropertyBlock.h"
+#include "PdmUeventCoalescer.h"
 
 class DeviceClass;
+struct EnumeratedDevice;
+
+typedef struct UeventResyncStats {
+    uint64_t overflows;           // ENOBUFS reported by the monitor socket
+    uint64_t seqnumGaps;
+    uint64_t inconsistentEvents;  // events contradicting the shadow state
+    uint64_t resyncs;
+    uint64_t resyncedEvents;      // events synthesized by the resyncs
+}UeventResyncStats;
 
 class PdmNetlinkListener {
 
 private:
     std::thread m_listenerThread;
+    PdmUeventCoalescer m_coalescer;
+    int m_receiveBufferSize;
+    // Properties of the monitored devices the handlers were told about, by
+    // devpath. Owned by the listener thread after the cold boot enumeration.
+    std::unordered_map<std::string, PdmDevPropertyBlockPtr> m_shadowDevices;
+    std::set<std::string> m_resyncSubsystems;
+    std::chrono::steady_clock::time_point m_resyncDeadline;
+    unsigned long long m_lastSeqnum;
+    std::atomic<uint64_t> m_overflows;
+    std::atomic<uint64_t> m_seqnumGaps;
+    std::atomic<uint64_t> m_inconsistentEvents;
+    std::atomic<uint64_t> m_resyncs;
+    std::atomic<uint64_t> m_resyncedEvents;
 public:
   PdmNetlinkListener();
   virtual ~PdmNetlinkListener();
   bool startListener();
   bool stopListener();
+  void setCoalescingWindow(int windowMs);
+  UeventCoalescingStats getCoalescingStats() const;
+  // Socket receive buffer in bytes, 0 keeps the kernel default
+  void setReceiveBufferSize(int bufferSize);
+  UeventResyncStats getResyncStats() const;
   virtual void onEvent(DeviceClass *deviceClassEvent) = 0;
 private:
   void init();
   void runListner();
   void threadStart();
   void enumerate_devices(struct udev* udev);
+  static void collectDevices(struct udev* udev, const std::set<std::string> &subsystems,
+                             bool isPowerOnConnect, std::vector<EnumeratedDevice> &enumDevices);
+  void dispatchEvent(struct udev_device *device, std::chrono::steady_clock::time_point receiveTime);
+  void trackEvent(const PdmDevPropertyBlockPtr &devProps);
+  void checkSeqnum(struct udev_device *device);
+  void scheduleResync(const std::string &subsystem);
+  int getTimeoutMs() const;
+  void resync();
 };
 #endif //_PDMNETLINKLISTENER_H
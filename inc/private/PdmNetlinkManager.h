@@ -32,8 +32,11 @@ private:
 
 public:
     ~PdmNetlinkManager();
-    int start(CommandManager *cmdManager);
+    int start(CommandManager *cmdManager, PdmConfig *pConfObj);
     int stop();
+    // False until the listener is started
+    bool getCoalescingStats(UeventCoalescingStats &stats) const;
+    bool getResyncStats(UeventResyncStats &stats) const;
 
     static PdmNetlinkManager *getInstance();
 };
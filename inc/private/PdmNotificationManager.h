@@ -22,6 +22,9 @@
 #include "PdmLocaleHandler.h"
 
 #define PDM_SHM_KEY 45697
+#define PDM_NOTIFICATION_QUEUE_LIMIT 32
+
+class PdmDeviceSnapshot;
 
 class PdmNotificationManager :public IObserver
 {
@@ -48,9 +51,9 @@ class PdmNotificationManager :public IObserver
         void showToast(const std::string& message,const std::string &iconUrl);
         bool isToastRequired(int eventDeviceType);
         void showConnectingToast(int eventDeviceType);
-        void showFormatStartedToast(IDevice* device);
-        void showFormatSuccessToast(IDevice* device);
-        void showFormatFailToast(IDevice* device);
+        void showFormatStartedToast(PdmDeviceSnapshot* device);
+        void showFormatSuccessToast(PdmDeviceSnapshot* device);
+        void showFormatFailToast(PdmDeviceSnapshot* device);
 
         bool createToast(
             const std::string &message,
@@ -77,11 +80,11 @@ class PdmNotificationManager :public IObserver
         }
 
         void createAlertForMaxUsbStorageDevices();
-        void unMountMtpDeviceAlert(IDevice* device);
-        void createAlertForFsckTimeout(IDevice* device);
-        void createAlertForUnmountedDeviceRemoval(IDevice* device);
-        void createAlertForUnsupportedFileSystem(IDevice* device);
-        void closeUnsupportedFsAlert(IDevice* device);
+        void unMountMtpDeviceAlert(PdmDeviceSnapshot* device);
+        void createAlertForFsckTimeout(PdmDeviceSnapshot* device);
+        void createAlertForUnmountedDeviceRemoval(PdmDeviceSnapshot* device);
+        void createAlertForUnsupportedFileSystem(PdmDeviceSnapshot* device);
+        void closeUnsupportedFsAlert(PdmDeviceSnapshot* device);
         void sendAlertInfo(pdmEvent pEvent, pbnjson::JValue parameters);
 
     public :
@@ -0,0 +1,108 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef PDMOBSERVERBUS_H_
+#define PDMOBSERVERBUS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "IObserver.h"
+#include "PdmDeviceSnapshot.h"
+
+// Immutable record of one DeviceStateObserver::Notify call, shared by all
+// observers it is posted to
+struct PdmDeviceEvent {
+    PdmDeviceEvent(int deviceType, int id, IDevice *dev);
+    PdmDeviceEvent(const PdmDeviceEvent&) = delete;
+    PdmDeviceEvent& operator=(const PdmDeviceEvent&) = delete;
+
+    const int eventDeviceType;
+    const int eventID;
+    const std::unique_ptr<PdmDeviceSnapshot> device;
+    const std::chrono::steady_clock::time_point postTime;
+    // Latency trace of the uevent that caused the event, if any
+    const bool traced;
+    const std::string traceDeviceType;
+    const std::chrono::steady_clock::time_point traceReceiveTime;
+};
+
+typedef std::function<bool(const PdmDeviceEvent &waiting, const PdmDeviceEvent &event)> PdmEventMergeFn;
+typedef std::function<void(int eventDeviceType, int eventID, IDevice *device)> PdmLiveUpdateFn;
+
+// Delivery policy of an observer attached to the bus. When the queue is full
+// the oldest waiting event is dropped; canMerge lets a new event replace the
+// last waiting one. updateLive, if set, is called right away from Notify
+// with the live device, before the record is taken, for work that may
+// change the device.
+typedef struct PdmObserverPolicy {
+    std::string name;
+    size_t queueLimit;
+    PdmEventMergeFn canMerge;
+    PdmLiveUpdateFn updateLive;
+}PdmObserverPolicy;
+
+typedef struct PdmObserverQueueStats {
+    uint64_t posted;
+    uint64_t delivered;
+    uint64_t merged;
+    uint64_t dropped;
+    uint64_t queueDepth;
+    uint64_t maxQueueDepth;
+}PdmObserverQueueStats;
+
+// Delivers DeviceStateObserver events to the attached observers on the
+// GMainLoop, so a slow plugin or bus call does not hold up device handling.
+// Observers that are not attached keep being called from Notify.
+class PdmObserverBus {
+
+private:
+    struct ObserverQueue {
+        PdmObserverPolicy policy;
+        std::deque<std::shared_ptr<const PdmDeviceEvent>> events;
+        bool scheduled;
+        PdmObserverQueueStats stats;
+    };
+
+    std::mutex m_queuesMtx;
+    std::unordered_map<IObserver*, ObserverQueue> m_queues;
+
+    PdmObserverBus() = default;
+    static int deliverEvents(void *data);
+    void deliver(IObserver *observer);
+
+public:
+    PdmObserverBus(const PdmObserverBus&) = delete;
+    PdmObserverBus& operator=(const PdmObserverBus&) = delete;
+    static PdmObserverBus& getInstance();
+    void attach(IObserver *observer, const PdmObserverPolicy &policy);
+    // Waiting events of the observer are discarded
+    void detach(IObserver *observer);
+    bool isAttached(IObserver *observer);
+    void updateLive(IObserver *observer, int eventDeviceType, int eventID, IDevice *device);
+    bool post(IObserver *observer, const std::shared_ptr<const PdmDeviceEvent> &event);
+    std::list<std::pair<std::string, PdmObserverQueueStats>> getStats();
+};
+
+#endif /* PDMOBSERVERBUS_H_ */
@@ -0,0 +1,85 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef _PDM_PAYLOAD_CACHE_H
+#define _PDM_PAYLOAD_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <pbnjson.hpp>
+
+#include "Common.h"
+
+// Dependency masks of cached payloads, one bit per DeviceEventType
+#define PDM_PAYLOAD_DEPENDS_ON(type) (1u << (type))
+#define PDM_PAYLOAD_DEPENDS_ON_STORAGE (PDM_PAYLOAD_DEPENDS_ON(PdmDevAttributes::STORAGE_DEVICE) | \
+                                        PDM_PAYLOAD_DEPENDS_ON(PdmDevAttributes::MTP_DEVICE) | \
+                                        PDM_PAYLOAD_DEPENDS_ON(PdmDevAttributes::PTP_DEVICE))
+#define PDM_PAYLOAD_DEPENDS_ON_ALL 0xFFFFFFFFu
+#define PDM_PAYLOAD_DEPENDS_ON_NON_STORAGE (PDM_PAYLOAD_DEPENDS_ON_ALL & ~PDM_PAYLOAD_DEPENDS_ON_STORAGE)
+
+typedef struct PdmPayloadCacheStats {
+    uint64_t version;
+    uint64_t hits;
+    uint64_t misses;
+    // Payloads not built because nobody was subscribed to them
+    uint64_t skipped;
+}PdmPayloadCacheStats;
+
+// Serialized device list payloads keyed by payload name. Every device type
+// has a version that DeviceStateObserver::Notify bumps before the event is
+// delivered, a payload is only built and stringified again once a version
+// it depends on moved. PdmDeviceHistory changes mark every payload stale.
+class PdmPayloadCache {
+
+private:
+    struct Entry {
+        uint64_t stamp;
+        std::string text;
+    };
+
+    std::mutex m_mutex;
+    uint64_t m_typeVersions[PdmDevAttributes::UNKNOWN_DEVICE];
+    // Bumped with every type version, the version of the device snapshot
+    uint64_t m_version;
+    std::unordered_map<std::string, Entry> m_entries;
+    uint64_t m_hits;
+    uint64_t m_misses;
+    uint64_t m_skipped;
+
+    PdmPayloadCache();
+    uint64_t getStamp(uint32_t dependsOn) const;
+
+public:
+    PdmPayloadCache(const PdmPayloadCache&) = delete;
+    PdmPayloadCache& operator=(const PdmPayloadCache&) = delete;
+    static PdmPayloadCache& getInstance();
+    // Marks the payloads listing devices of eventDeviceType as stale,
+    // ALL_DEVICE and unknown types mark every payload stale
+    void invalidate(int eventDeviceType);
+    void invalidateAll();
+    // Cached text of key, build is called when a device type in dependsOn
+    // changed since the text was built
+    std::string get(const std::string &key, uint32_t dependsOn, const std::function<pbnjson::JValue()> &build);
+    void countSkipped();
+    PdmPayloadCacheStats getStats();
+};
+
+#endif //_PDM_PAYLOAD_CACHE_H
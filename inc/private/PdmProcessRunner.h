@@ -0,0 +1,133 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _PDM_PROCESS_RUNNER_H
+#define _PDM_PROCESS_RUNNER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+#include <vector>
+
+#define PDM_PROCESS_MAX_CONCURRENT 4
+#define PDM_PROCESS_URGENT_MAX_CONCURRENT 2
+#define PDM_PROCESS_KILL_GRACE_MS 2000
+#define PDM_PROCESS_OUTPUT_LIMIT (64 * 1024)
+
+enum class PdmIoPriorityClass {
+    INHERIT = 0,
+    REALTIME = 1,
+    BEST_EFFORT = 2,
+    IDLE = 3
+};
+
+typedef uint64_t PdmProcessId;
+static const PdmProcessId PDM_INVALID_PROCESS_ID = 0;
+
+typedef struct PdmProcessSpec {
+    // argv[0] is looked up in PATH, no shell is involved
+    std::vector<std::string> argv;
+    // 0 runs without deadline. On expiry the process gets SIGTERM, then
+    // SIGKILL after PDM_PROCESS_KILL_GRACE_MS.
+    unsigned int timeoutMs = 0;
+    int niceValue = 0;
+    PdmIoPriorityClass ioClass = PdmIoPriorityClass::INHERIT;
+    int ioLevel = 4;
+    // Short helpers a caller waits on, e.g. FUSE mounts. They have their own
+    // queue and PDM_PROCESS_URGENT_MAX_CONCURRENT slots, so a long fsck or
+    // format never delays them.
+    bool urgent = false;
+    // Called on the runner thread for each line of stdout/stderr
+    std::function<void(const std::string&)> onOutputLine;
+}PdmProcessSpec;
+
+typedef struct PdmProcessResult {
+    enum Status {
+        EXITED,
+        SIGNALED,
+        TIMEOUT,
+        CANCELLED,
+        SPAWN_FAILED
+    };
+    Status status = SPAWN_FAILED;
+    int exitCode = -1;
+    int signal = 0;
+    // Merged stdout and stderr, the last PDM_PROCESS_OUTPUT_LIMIT bytes
+    std::string output;
+    unsigned int durationMs = 0;
+
+    bool succeeded() const { return status == EXITED && exitCode == 0; }
+}PdmProcessResult;
+
+typedef std::function<void(const PdmProcessResult&)> PdmProcessDoneCb;
+
+// Runs helper tools (fsck, mkfs, label and FUSE mount tools) with
+// posix_spawn. One runner thread polls the pidfds and output pipes of all
+// children, enforces their deadlines and starts queued requests while fewer
+// than PDM_PROCESS_MAX_CONCURRENT are running.
+class PdmProcessRunner {
+
+private:
+    struct Request;
+    typedef std::shared_ptr<Request> RequestPtr;
+
+    std::mutex m_mutex;
+    std::deque<RequestPtr> m_pending;
+    std::deque<RequestPtr> m_urgentPending;
+    std::map<PdmProcessId, RequestPtr> m_requests;
+    PdmProcessId m_nextId;
+    unsigned int m_maxConcurrent;
+    unsigned int m_running;
+    unsigned int m_urgentRunning;
+    int m_wakeFd;
+    bool m_stop;
+    std::thread m_thread;
+
+    PdmProcessRunner();
+    ~PdmProcessRunner();
+    void wake();
+    void runLoop();
+    void startPending(std::deque<RequestPtr> &pending, unsigned int &running, unsigned int maxConcurrent,
+                      std::vector<RequestPtr> &finished);
+    bool spawn(const RequestPtr &request);
+    void readOutput(const RequestPtr &request);
+    bool reap(const RequestPtr &request);
+    void finish(const RequestPtr &request);
+
+public:
+    PdmProcessRunner(const PdmProcessRunner&) = delete;
+    PdmProcessRunner& operator=(const PdmProcessRunner&) = delete;
+    static PdmProcessRunner& getInstance();
+    // Queues spec, done is called on the runner thread once it completed
+    PdmProcessId runAsync(const PdmProcessSpec &spec, PdmProcessDoneCb done);
+    // Blocks the calling thread until the process completed. onQueued gets
+    // the id right after queuing, e.g. to cancel it from another thread.
+    PdmProcessResult run(const PdmProcessSpec &spec, std::function<void(PdmProcessId)> onQueued = nullptr);
+    // Terminates a running process or drops a queued one
+    bool cancel(PdmProcessId id);
+    // Splits a command line on whitespace, without any quoting rules
+    static std::vector<std::string> splitArgs(const std::string &cmdLine);
+    static std::string describe(const PdmProcessResult &result);
+};
+
+#endif //_PDM_PROCESS_RUNNER_H
@@ -0,0 +1,38 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef _PDM_STARTUP_METRICS_H
+#define _PDM_STARTUP_METRICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Milestones of the cold-boot device enumeration. Durations are reported in
+// milliseconds relative to the start of the enumeration, -1 if not reached yet.
+namespace PdmStartupMetrics
+{
+    void markEnumerationStart();
+    void markEnumerationCollected(size_t deviceCount);
+    void markEnumerationDispatched();
+    void markFirstMount(const std::string &driveName);
+    int64_t getCollectTimeMs();
+    int64_t getDispatchTimeMs();
+    int64_t getTimeToFirstMountMs();
+};
+
+#endif //_PDM_STARTUP_METRICS_H
@@ -0,0 +1,52 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef PDMSTRANDEXECUTOR_H_
+#define PDMSTRANDEXECUTOR_H_
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "PdmThreadPool.h"
+
+// Runs tasks on a shared worker pool while guaranteeing that tasks posted
+// with the same key never run concurrently and run in posting order.
+// Tasks with different keys may run in parallel.
+class PdmStrandExecutor {
+
+private:
+    // A strand exists while it has queued or running tasks
+    std::unordered_map<std::string, std::deque<std::function<void()>>> m_strands;
+    std::mutex m_strandMtx;
+    PdmThreadPool *m_pool;
+
+    void runStrand(const std::string &key);
+    static void runStrandTask(void *context, void *arg);
+
+public:
+    explicit PdmStrandExecutor(size_t workers);
+    PdmStrandExecutor(const PdmStrandExecutor&) = delete;
+    PdmStrandExecutor& operator=(const PdmStrandExecutor&) = delete;
+    ~PdmStrandExecutor();
+    void post(const std::string &key, std::function<void()> task);
+    size_t getActiveStrandCount();
+};
+
+#endif /* PDMSTRANDEXECUTOR_H_ */
@@ -0,0 +1,63 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef _PDM_SUPERBLOCK_PROBE_H
+#define _PDM_SUPERBLOCK_PROBE_H
+
+#include <cstdint>
+#include <string>
+
+// Largest FAT hashed into a fingerprint, bigger ones are not fingerprinted
+#define PDM_FAT_FINGERPRINT_MAX_BYTES (16 * 1024 * 1024)
+
+// On-disk state that changes whenever a volume is mounted or written.
+// ext2/3/4 use the mount count, last write time and kilobytes written of the
+// superblock; FAT has no such counters, so the boot sector, FSInfo and the
+// first FAT are hashed instead.
+typedef struct PdmFsFingerprint {
+    uint32_t mountCount = 0;
+    uint64_t writeTime = 0;
+    uint64_t generation = 0;
+
+    bool operator==(const PdmFsFingerprint &other) const {
+        return mountCount == other.mountCount && writeTime == other.writeTime && generation == other.generation;
+    }
+    bool operator!=(const PdmFsFingerprint &other) const { return !(*this == other); }
+}PdmFsFingerprint;
+
+// Dirty state as recorded by the file system itself
+enum class PdmFsState {
+    UNKNOWN = 0,
+    CLEAN,
+    DIRTY,
+    ERROR
+};
+
+// Reads file system metadata straight from the block device
+namespace PdmSuperblockProbe
+{
+    // Reads the FAT clean and hard error bits of FAT[1] and the BPB dirty
+    // flag, the ext2/3/4 s_state and needs_recovery flag, or the NTFS
+    // $Volume dirty flag. UNKNOWN for other types or unreadable devices.
+    PdmFsState probeState(const std::string &devPath, const std::string &fsType);
+    // "unknown", "clean", "dirty" or "error", as reported in payloads
+    const char* getStateName(PdmFsState state);
+    // False if fsType has no fingerprint or the device could not be read
+    bool readFingerprint(const std::string &devPath, const std::string &fsType, PdmFsFingerprint &fingerprint);
+};
+
+#endif //_PDM_SUPERBLOCK_PROBE_H
@@ -32,52 +32,90 @@
 #include <future>
 #include <functional>
 #include <stdexcept>
+#include <atomic>
 #include "PdmLogUtils.h"
+#include "PdmMpmcQueue.h"
+
+// Ring slots per worker
+#define PDM_THREAD_POOL_RING_SIZE 256
+
+// Fire-and-forget task for PdmThreadPool::post()
+using PdmTaskFn = void (*)(void *context, void *arg);
 
 class PdmThreadPool {
 
 private:
+    struct PdmTask {
+        PdmTaskFn fn;
+        void *context;
+        void *arg;
+    };
     bool terminate;
     std::vector< std::thread > workers;
+    // Shared by all workers, so a slow task only holds up its own worker
+    PdmMpmcQueue<PdmTask> ring;
+    std::atomic<size_t> sleepingWorkers;
     std::condition_variable condition;
     std::mutex queue_mutex;
     std::queue< std::function<void()> > pdm_tasks;
+    // Size of pdm_tasks. While it is non zero post() queues behind it, so
+    // every ring task is older than every queued one and the worker keeps
+    // submission order by draining the ring first.
+    std::atomic<size_t> queuedTasks;
+
+    void workerLoop();
 
 public:
     PdmThreadPool(size_t);
     template<class F, class... Args>
     auto enqueue(F&& f, Args&&... args)
         -> std::future<typename std::result_of<F(Args...)>::type>;
+    void post(PdmTaskFn fn, void *context, void *arg);
     ~PdmThreadPool();
 
 };
 
 
 inline PdmThreadPool::PdmThreadPool(size_t threads)
-    :   terminate(false)
+    :   terminate(false), ring(PDM_THREAD_POOL_RING_SIZE * (threads ? threads : 1)), sleepingWorkers(0), queuedTasks(0)
 {
     for(size_t i = 0;i<threads;++i)
-        workers.emplace_back(
-            [this]
-            {
-                for(;;)
-                {
-                    std::function<void()> task = [] () {};
-
-                    {
-                        std::unique_lock<std::mutex> lock(this->queue_mutex);
-                        this->condition.wait(lock,
-                            [this]{ return this->terminate || !this->pdm_tasks.empty(); });
-                        if(this->terminate && this->pdm_tasks.empty())
-                            return;
-                        task = std::move(this->pdm_tasks.front());
-                        this->pdm_tasks.pop();
-                    }
-
-                    task();
-                }
-            }
-        );
+        workers.emplace_back(&PdmThreadPool::workerLoop, this);
+}
+
+inline void PdmThreadPool::workerLoop()
+{
+    for(;;)
+    {
+        PdmTask ringTask;
+        if(ring.tryPop(ringTask)) {
+            ringTask.fn(ringTask.context, ringTask.arg);
+            continue;
+        }
+
+        std::function<void()> task = [] () {};
+
+        {
+            std::unique_lock<std::mutex> lock(this->queue_mutex);
+            sleepingWorkers++;
+            this->condition.wait(lock,
+                [this]{
+                    // pairs with the fence in post(), a producer either sees
+                    // this worker sleeping or the worker sees its task
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    return this->terminate || !this->pdm_tasks.empty() || !ring.empty(); });
+            sleepingWorkers--;
+            if(!ring.empty())
+                continue;
+            if(this->terminate && this->pdm_tasks.empty())
+                return;
+            task = std::move(this->pdm_tasks.front());
+            this->pdm_tasks.pop();
+            queuedTasks--;
+        }
+
+        task();
+    }
 }
 
 
@@ -99,11 +137,38 @@ auto PdmThreadPool::enqueue(F&& f, Args&&... args)
             throw std::runtime_error("enqueue on terminated PdmThreadPool");
 
         pdm_tasks.emplace([task](){ (*task)(); });
+        queuedTasks++;
     }
     condition.notify_one();
     return res;
 }
 
+// Queues fn(context, arg) without allocating. The first idle worker takes
+// it, the mutex is only taken to wake a sleeping one. Falls back to the
+// locked queue when the ring is full or older tasks are already waiting
+// there.
+inline void PdmThreadPool::post(PdmTaskFn fn, void *context, void *arg)
+{
+    PdmTask task = { fn, context, arg };
+    if(queuedTasks.load() == 0 && ring.tryPush(task)) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(sleepingWorkers.load() > 0) {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            condition.notify_one();
+        }
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        if(terminate)
+            throw std::runtime_error("post on terminated PdmThreadPool");
+        pdm_tasks.emplace([task](){ task.fn(task.context, task.arg); });
+        queuedTasks++;
+    }
+    condition.notify_one();
+}
+
 inline PdmThreadPool::~PdmThreadPool()
 {
     {
@@ -0,0 +1,79 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef PDMUEVENTCOALESCER_H_
+#define PDMUEVENTCOALESCER_H_
+
+#include <libudev.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+
+typedef struct UeventCoalescingStats {
+    uint64_t received;
+    uint64_t dispatched;
+    uint64_t mergedChanges;
+    uint64_t cancelledEvents;
+}UeventCoalescingStats;
+
+// Holds uevents for a short window before dispatching them so that bursts
+// can be reduced: a "change" replaces the data of a pending "change" of the
+// same devpath in place, if nothing else was queued for that devpath since,
+// and a "remove" cancels a pending "add" of the same devpath
+// together with everything queued for it in between. Events are dispatched
+// in arrival order with the time they were received. A window of 0 ms
+// dispatches every event immediately.
+class PdmUeventCoalescer {
+
+private:
+    struct PendingEvent {
+        struct udev_device *device;
+        std::string devPath;
+        std::string action;
+        std::chrono::steady_clock::time_point receiveTime;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    std::function<void(struct udev_device*, std::chrono::steady_clock::time_point)> m_dispatch;
+    std::chrono::milliseconds m_window;
+    std::list<PendingEvent> m_pending;
+    // Updated by the listener thread, read from anywhere through getStats()
+    std::atomic<uint64_t> m_received;
+    std::atomic<uint64_t> m_dispatched;
+    std::atomic<uint64_t> m_mergedChanges;
+    std::atomic<uint64_t> m_cancelledEvents;
+
+    void dispatch(PendingEvent &event);
+    bool cancelPendingAdd(const std::string &devPath);
+
+public:
+    explicit PdmUeventCoalescer(std::function<void(struct udev_device*, std::chrono::steady_clock::time_point)> dispatchFn);
+    PdmUeventCoalescer(const PdmUeventCoalescer&) = delete;
+    PdmUeventCoalescer& operator=(const PdmUeventCoalescer&) = delete;
+    ~PdmUeventCoalescer();
+    void setWindow(int windowMs);
+    void push(struct udev_device *device);
+    int getTimeoutMs() const;
+    void flushExpired();
+    void flushAll();
+    UeventCoalescingStats getStats() const;
+};
+
+#endif /* PDMUEVENTCOALESCER_H_ */
@@ -0,0 +1,64 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef PDMUEVENTRECORDER_H_
+#define PDMUEVENTRECORDER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "PdmDevPropertyBlock.h"
+
+typedef struct PdmUeventRecord {
+    uint64_t timeUs;        // since the first recorded event
+    bool isPowerOnConnect;
+    std::unordered_map<std::string, std::string> devProps;
+}PdmUeventRecord;
+
+// Writes the properties of the uevents handed to PdmNetlinkClassAdapter to
+// a trace file, one JSON object per line, so field hotplug storms can be
+// replayed with pdm-uevent-replay. Only the properties PDM reads are kept.
+// Recording is off unless a trace file is opened.
+class PdmUeventRecorder {
+
+private:
+    std::mutex m_traceMtx;
+    std::ofstream m_trace;
+    std::atomic<bool> m_isRecording;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    PdmUeventRecorder();
+    PdmUeventRecorder(const PdmUeventRecorder&) = delete;
+    PdmUeventRecorder& operator=(const PdmUeventRecorder&) = delete;
+
+public:
+    static PdmUeventRecorder& getInstance();
+    ~PdmUeventRecorder();
+    bool open(const std::string &tracePath);
+    void close();
+    bool isRecording() const { return m_isRecording.load(std::memory_order_relaxed); }
+    void record(const PdmDevPropertyBlock &devProps);
+    static bool readTrace(const std::string &tracePath, std::vector<PdmUeventRecord> &records);
+};
+
+#endif /* PDMUEVENTRECORDER_H_ */
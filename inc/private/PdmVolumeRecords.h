@@ -0,0 +1,67 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef _PDM_VOLUME_RECORDS_H
+#define _PDM_VOLUME_RECORDS_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "PdmSuperblockProbe.h"
+
+#define PDM_VOLUME_RECORDS_FILE WEBOS_INSTALL_LOCALSTATEDIR "/lib/pdm/volume-records.json"
+#define PDM_VOLUME_RECORD_LIMIT 64
+
+// Volumes PDM unmounted cleanly, keyed by file system UUID and device
+// serial, with the fingerprint read right after the unmount. A volume that
+// still matches its record on re-attach was not touched elsewhere and does
+// not need fsck. Records are consumed on re-attach, so a volume that is
+// mounted and then pulled out is checked next time.
+class PdmVolumeRecords {
+
+private:
+    typedef struct Record {
+        int64_t unmountTime;
+        PdmFsFingerprint fingerprint;
+    }Record;
+
+    std::mutex m_mutex;
+    std::map<std::string, Record> m_records;
+    bool m_loaded;
+    std::string m_filePath;
+
+    PdmVolumeRecords();
+    static std::string makeKey(const std::string &uuid, const std::string &serial);
+    void load();
+    void save();
+
+public:
+    PdmVolumeRecords(const PdmVolumeRecords&) = delete;
+    PdmVolumeRecords& operator=(const PdmVolumeRecords&) = delete;
+    static PdmVolumeRecords& getInstance();
+    void recordCleanUnmount(const std::string &uuid, const std::string &serial,
+                            const std::string &devPath, const std::string &fsType);
+    // True if the volume is unchanged since its clean unmount
+    bool takeCleanRecord(const std::string &uuid, const std::string &serial,
+                         const std::string &devPath, const std::string &fsType);
+    // Called once the volume is mounted writable
+    void forget(const std::string &uuid, const std::string &serial);
+};
+
+#endif //_PDM_VOLUME_RECORDS_H
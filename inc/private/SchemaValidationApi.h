@@ -18,9 +18,26 @@
 #define SCHEMAVALIDATIONAPI_H
 
 #define JSON_SCHEMA_VALIDATE_ATTACH_DEVICE_LIST \
-     SCHEMA_V2_1( \
+     SCHEMA_V2_3( \
         ",\"required\":[\"subscribe\"]" , \
-         SCHEMA_V2_PROP(subscribe, boolean) \
+         SCHEMA_V2_PROP(subscribe, boolean), \
+         SCHEMA_V2_PROP(delta, boolean), \
+         SCHEMA_V2_PROP(sinceSeq, integer) \
+    )
+
+#define JSON_SCHEMA_VALIDATE_STORAGE_ATTACH_DEVICE_LIST \
+     SCHEMA_V2_10( \
+        ",\"required\":[\"subscribe\"]" , \
+         SCHEMA_V2_PROP(subscribe, boolean), \
+         SCHEMA_V2_PROP(delta, boolean), \
+         SCHEMA_V2_PROP(sinceSeq, integer), \
+         SCHEMA_V2_PROP(deviceType, string), \
+         SCHEMA_V2_PROP(storageType, string), \
+         SCHEMA_V2_PROP(usbPortNum, integer), \
+         SCHEMA_V2_PROP(isMounted, boolean), \
+         SCHEMA_V2_PROP(vendorId, string), \
+         SCHEMA_V2_PROP(productId, string), \
+         SCHEMA_V2_PROP(fields, array, ",\"items\":{\"type\":\"string\"}") \
     )
 
 #define JSON_SCHEMA_FORMAT_VALIDATE_DRIVE_NAME \
@@ -58,11 +75,20 @@
     )
 
 #define JSON_SCHEMA_VALIDATE_NON_STORAGE_ATTACH_DEVICE_LIST \
-     SCHEMA_V2_3( \
+     SCHEMA_V2_12( \
         ",\"required\":[\"subscribe\"]" , \
          SCHEMA_V2_PROP(subscribe, boolean), \
          SCHEMA_V2_PROP(category, string), \
-         SCHEMA_V2_PROP(groupSubDevices, boolean) \
+         SCHEMA_V2_PROP(groupSubDevices, boolean), \
+         SCHEMA_V2_PROP(delta, boolean), \
+         SCHEMA_V2_PROP(sinceSeq, integer), \
+         SCHEMA_V2_PROP(deviceType, string), \
+         SCHEMA_V2_PROP(storageType, string), \
+         SCHEMA_V2_PROP(usbPortNum, integer), \
+         SCHEMA_V2_PROP(isMounted, boolean), \
+         SCHEMA_V2_PROP(vendorId, string), \
+         SCHEMA_V2_PROP(productId, string), \
+         SCHEMA_V2_PROP(fields, array, ",\"items\":{\"type\":\"string\"}") \
     )
 
 #define JSON_SCHEMA_IO_PERFORMANCE_VALIDATE_DRIVE_NAME \
@@ -73,6 +99,12 @@
           SCHEMA_V2_PROP(chunkSize, integer) \
     )
 
+#define JSON_SCHEMA_VALIDATE_PERFORMANCE_STATS \
+     SCHEMA_V2_1( \
+         "" , \
+          SCHEMA_V2_PROP(reset, boolean) \
+    )
+
 #define JSON_SCHEMA_MOUNT_AND_FULL_FSCK_VALIDATE_MOUNT_NAME \
      SCHEMA_V2_2( \
          ",\"required\":[\"mountName\"]" , \
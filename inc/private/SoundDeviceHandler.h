@@ -28,7 +28,7 @@ class SoundDeviceHandler : public DeviceHandler
 {
 private:
     const std::string iClass = ":01";
-    std::list<SoundDevice*> sList;
+    PdmDeviceRegistry<SoundDevice> sList;
     bool m_deviceRemoved;
 
     SoundDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter);
@@ -25,29 +25,28 @@
 class SoundSubsystem : public DeviceClass
 {
     std::string mDevType;
-    std::unordered_map<std::string, std::string> mDevPropMap;
     // void init();
     static bool mIsObjRegistered;
     static bool RegisterSubSystem()
     {
-        DeviceClassFactory::getInstance().Register("sound", std::bind(&SoundSubsystem::create, std::placeholders::_1));
+        DeviceClassFactory::getInstance().Register("sound", std::bind(&SoundSubsystem::create, std::placeholders::_1),
+            {{DeviceClassFactory::USB_INTERFACE_CLASS, "01"}, {PdmDevAttributes::SUBSYSTEM, "sound"}});
         return true;
     }
-    static bool canProcessEvent(std::unordered_map<std::string, std::string> mDevPropMap)
+    static bool canProcessEvent(const PdmDevPropertyBlock &devProps)
     {
-        const std::string iClass = ":01";
-        if ((mDevPropMap[PdmDevAttributes::ID_USB_INTERFACES].find(iClass) != std::string::npos) || (mDevPropMap[PdmDevAttributes::SUBSYSTEM] == "sound"))
+        if ((devProps.get(PdmDevProperty::ID_USB_INTERFACES).find(":01") != PdmStringView::npos) || (devProps.get(PdmDevProperty::SUBSYSTEM) == "sound"))
             return true;
         return false;
     }
 
 public:
-    SoundSubsystem(std::unordered_map<std::string, std::string> &);
+    explicit SoundSubsystem(const PdmDevPropertyBlockPtr &devProps);
     virtual ~SoundSubsystem();
     std::string getCardId();
     std::string getCardName();
     std::string getCardNumber();
-    static SoundSubsystem* create(std::unordered_map<std::string, std::string>&);
+    static SoundSubsystem* create(const PdmDevPropertyBlockPtr &devProps);
 };
 
 #endif /* _SOUND_SUSBSYSTEM_H_ */
@@ -21,10 +21,10 @@
 #include <functional>
 #include <list>
 #include <string>
-#include <thread>
 #include<tuple>
 #include <vector>
 #include "DiskPartitionInfo.h"
+#include "PdmBlockTopology.h"
 #include "PdmFs.h"
 #include "Storage.h"
 #include "DeviceClass.h"
@@ -43,12 +43,12 @@ private:
     int m_partitionCount;
     int  m_timeoutId;
     std::atomic<int> m_fsckThreadCount;
+    bool m_readOnlyFirstMount;
     std::list<DiskPartitionInfo*> m_diskPartitionList;
 
     using handlerCb = std::function<void(EventType, Storage*)>;
     handlerCb m_storageDeviceHandlerCb;
     PdmFs m_pdmFileSystemObj;
-    std::vector<std::thread> m_fsckThreadArray;
     std::tuple <int,int,int> mHddDiskStats;
 
 private:
@@ -61,11 +61,17 @@ private:
    void handleCardReaderDeviceChange(DeviceClass*);
    void storageDeviceNotification();
    void fsckOnDeviceAddThread(DiskPartitionInfo *partition);
+   void fsckReadOnlyMountedThread(DiskPartitionInfo *partition);
+   bool readReadOnlyFirstMount();
+   uint64_t getFsckPriority(const PdmBlockDisk &disk, DiskPartitionInfo &partition);
    DiskPartitionInfo* findPartition(const std::string &drivename);
    void pdmSmartDeviceInfoLogger();
-   PdmDevStatus umountPartition(DiskPartitionInfo &partition, const bool lazyUnmount);
+   PdmDevStatus umountPartition(DiskPartitionInfo &partition, const bool lazyUnmount, std::vector<pid_t> *busyPids = nullptr);
    PdmDevStatus mountPartition(DiskPartitionInfo &partition, const bool readOnly);
    PdmDevStatus fsckPartition(DiskPartitionInfo &partition, const std::string &fsckMode);
+   PdmDevStatus mountPartitionReadOnlyFirst(DiskPartitionInfo &partition);
+   PdmDevStatus remountPartitionWritable(DiskPartitionInfo &partition);
+   void recordCleanUnmount(DiskPartitionInfo &partition);
    void checkSdCardAddRemove(DeviceClass*);
    bool triggerUevent();
 
@@ -82,15 +88,16 @@ public:
    void setDeviceInfo(DeviceClass*);
    PdmDevStatus setPartitionVolumeLabel(const std::string &drivename,const std::string &volumeLabel);
    void setPartitionInfo(DeviceClass*);
-   PdmDevStatus umountAllPartition(const bool lazyUnmount);
+   // busyPids, if given, gets the processes that kept a partition busy
+   PdmDevStatus umountAllPartition(const bool lazyUnmount, std::vector<pid_t> *busyPids = nullptr);
    PdmDevStatus mountAllPartition();
-   PdmDevStatus fsck(const std::string driveName);
-   PdmDevStatus eject();
+   PdmDevStatus fsck(const std::string driveName, std::vector<pid_t> *busyPids = nullptr);
+   PdmDevStatus eject(std::vector<pid_t> *busyPids = nullptr);
    PdmDevStatus isWritable(const std::string &driveName, bool &isWritable);
    bool isDevAddNotified() {return m_isDevAddEventNotified;}
    DiskPartitionInfo* getSpaceInfo(const std::string driveName, bool directCheck);
    void checkRemovalNotifications();
-   PdmDevStatus formatDiskStart(const std::string driveName,std::string fsType,const std::string &volumeLabel);
+   PdmDevStatus formatDiskStart(const std::string driveName,std::string fsType,const std::string &volumeLabel, std::vector<pid_t> *busyPids = nullptr);
    void onDeviceRemove();
    std::list<DiskPartitionInfo*> getDiskPartition(){return m_diskPartitionList;}
    void storageDeviceFsckNotification();
@@ -22,9 +22,14 @@
 #include "StorageDevice.h"
 #include "PdmLogUtils.h"
 #include "DeviceClass.h"
+#include <atomic>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 class HddDeviceHandler;
 
@@ -33,14 +38,25 @@ class StorageDeviceHandler: public DeviceHandler {
 private:
 
 
-    bool mSpaceInfoThreadStatus;
+    std::atomic<bool> mSpaceInfoThreadStatus;
     static bool mIsObjRegistered;
     std::size_t m_maxStorageDevices;
-    std::list<StorageDevice*> mStorageList;
+    PdmDeviceRegistry<StorageDevice> mStorageList;
     std::thread mSpaceInfoThread;
     std::condition_variable mNotifyCv;
     std::mutex mNotifyMtx;
     std::mutex mStorageListMtx;
+    // Devices being created, counted against m_maxStorageDevices since
+    // several devices can be attached in parallel
+    std::size_t mPendingDevices;
+    std::mutex mSpaceInfoThreadMtx;
+    // Devices in use by commands running on the query/storage job lanes.
+    // A hotplug remove of such a device is completed by the last user.
+    std::unordered_map<StorageDevice*, int> mDeviceUseCount;
+    std::unordered_set<StorageDevice*> mRemovingDevices;
+    std::unordered_set<StorageDevice*> mDeferredRemoval;
+    // Add/change events of a device in use, replayed in order by the last user
+    std::unordered_map<StorageDevice*, std::list<std::unique_ptr<DeviceClass>>> mHeldEvents;
 
     StorageDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter);
     //Register Object to object factory. This is called automatically
@@ -49,11 +65,19 @@ private:
                                               &StorageDeviceHandler::CreateObject));
     }
     void removeDevice(StorageDevice *storageDevice);
+    void refreshDevice(StorageDevice *storageDevice);
+    StorageDevice* acquireDeviceWithName(const std::string &devName);
+    StorageDevice* acquireDeviceWithNum(int devNum);
+    std::list<StorageDevice*> acquireAllDevices();
+    void acquireDeviceLocked(StorageDevice *storageDevice);
+    void releaseDevice(StorageDevice *storageDevice);
+    bool holdEventLocked(StorageDevice *storageDevice, DeviceClass *devClass);
 	bool deleteStorageDevice(DeviceClass*);
 	void ProcessStorageDevice(DeviceClass*);
-	void checkStorageDevice(DeviceClass*);
+	void checkStorageDevice(DeviceClass*, bool replay = false);
 	void createStorageDevice(DeviceClass*, IDevice*);
 
+    void appendBusyPids(CommandResponse *cmdResponse, const std::vector<pid_t> &busyPids);
     bool format(CommandType *cmdtypes, CommandResponse *cmdResponse);
     bool eject(CommandType *cmdtypes, CommandResponse *cmdResponse);
     bool fsck(CommandType *cmdtypes, CommandResponse *cmdResponse);
@@ -30,28 +30,27 @@ using namespace PdmDevAttributes;
 class StorageSubsystem : public DeviceClass
 {
     std::string mDevType;
-    std::unordered_map<std::string, std::string> mDevPropMap;
     static bool mIsObjRegistered;
     static bool RegisterSubSystem()
     {
         PDM_LOG_DEBUG("StorageSubsystem:%s line: %d StorageSubsystem Registered", __FUNCTION__, __LINE__);
-        DeviceClassFactory::getInstance().Register("storage", std::bind(&StorageSubsystem::create, std::placeholders::_1));
+        DeviceClassFactory::getInstance().Register("storage", std::bind(&StorageSubsystem::create, std::placeholders::_1),
+            {{DeviceClassFactory::USB_INTERFACE_CLASS, "08"}, {ID_ATA, PDM_HDD_ID_ATA}});
         return true;
     }
-    static bool canProcessEvent(std::unordered_map<std::string, std::string> mDevPropMap)
+    static bool canProcessEvent(const PdmDevPropertyBlock &devProps)
     {
-        const std::string iClass = ":08";
-        std::string interfaceClass = mDevPropMap[ID_USB_INTERFACES];
-        if ((interfaceClass.find(iClass) != std::string::npos) || (mDevPropMap[ID_ATA] == PDM_HDD_ID_ATA))
+        PdmStringView interfaceClass = devProps.get(PdmDevProperty::ID_USB_INTERFACES);
+        if ((interfaceClass.find(":08") != PdmStringView::npos) || (devProps.get(PdmDevProperty::ID_ATA) == PDM_HDD_ID_ATA))
             return true;
         PDM_LOG_DEBUG("StorageSubsystem:%s line: %d StorageSubsystem Object created", __FUNCTION__, __LINE__);
         return false;
     }
 
 public:
-    StorageSubsystem(std::unordered_map<std::string, std::string> &devPropMap);
+    explicit StorageSubsystem(const PdmDevPropertyBlockPtr &devProps);
     virtual ~StorageSubsystem();
-    static StorageSubsystem *create(std::unordered_map<std::string, std::string> &devPropMap);
+    static StorageSubsystem* create(const PdmDevPropertyBlockPtr &devProps);
     std::string getHardDisk();
     std::string isCardReader();
     std::string isHardDisk();
@@ -27,7 +27,7 @@ class VideoDeviceHandler : public DeviceHandler
 {
 private:
     const std::string iClass = ":0e";
-    std::list<VideoDevice*> sList;
+    PdmDeviceRegistry<VideoDevice> sList;
     bool mIsCameraReady;
     bool mdeviceRemoved;
 
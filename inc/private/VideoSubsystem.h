@@ -25,30 +25,29 @@
 class VideoSubsystem :public DeviceClass
 {
 	std::string mDevType;
-	std::unordered_map<std::string, std::string> mDevPropMap;
 	// void init();
 	static bool mIsObjRegistered;
 	static bool RegisterSubSystem() {
-		DeviceClassFactory::getInstance().Register("video4linux", std::bind(&VideoSubsystem::create, std::placeholders::_1));
+		DeviceClassFactory::getInstance().Register("video4linux", std::bind(&VideoSubsystem::create, std::placeholders::_1),
+		    {{DeviceClassFactory::USB_INTERFACE_CLASS, "0e"}, {PdmDevAttributes::SUBSYSTEM, "video4linux"}});
 		return true;
 	}
 
-	static bool canProcessEvent(std::unordered_map<std::string, std::string> mDevPropMap)
+	static bool canProcessEvent(const PdmDevPropertyBlock &devProps)
 	{
-		const std::string iClass = ":0e";
-		if((mDevPropMap[PdmDevAttributes::ID_USB_INTERFACES].find(iClass) == std::string::npos) && (mDevPropMap[PdmDevAttributes::SUBSYSTEM] !=  "video4linux"))
+		if((devProps.get(PdmDevProperty::ID_USB_INTERFACES).find(":0e") == PdmStringView::npos) && (devProps.get(PdmDevProperty::SUBSYSTEM) != "video4linux"))
 			return false;
 		return true;
 	}
 public:
-    VideoSubsystem(std::unordered_map<std::string, std::string>& devPropMap);
+    explicit VideoSubsystem(const PdmDevPropertyBlockPtr &devProps);
 	virtual ~VideoSubsystem();
 	std::string getCapabilities();
 	std::string getProductName();
 	std::string getVersion();
 	// std::string getDevSpeed();
 	// std::string getUsbDriverId();
-	static VideoSubsystem* create(std::unordered_map<std::string, std::string>& devPropMap);
+	static VideoSubsystem* create(const PdmDevPropertyBlockPtr &devProps);
 };
 
 #endif /* _VIDEO_SUSBSYSTEM_H_ */
@@ -67,7 +67,7 @@ int main(int argc, char *argv[])
         pDevTracker->attachObservers();
         pNotificationMgr->attachObservers();
 
-        if(LunaIPC::getInstance()->init(mainLoop,pCommandManager) == false)
+        if(LunaIPC::getInstance()->init(mainLoop,pCommandManager,pConfObj) == false)
             throw std::runtime_error("LunaIPC init fail");
 
         pluginAdapter->pluginLoader(LunaIPC::getInstance()->getLSHandle(), PLUGIN_PATH);
@@ -82,7 +82,7 @@ int main(int argc, char *argv[])
 
         PdmNetlinkClassAdapter::getInstance().setCommandManager(pCommandManager);
         
-        PdmNetlinkManager::getInstance()->start(pCommandManager);
+        PdmNetlinkManager::getInstance()->start(pCommandManager, pConfObj);
         g_main_loop_run(mainLoop);
         DeviceNotification::getInstance()->deInit();
         LunaIPC::getInstance()->deInit();
@@ -20,6 +20,7 @@
 #include <luna-service2++/handle.hpp>
 
 #include "Device.h"
+#include "PdmDeviceHistory.h"
 #include "PdmLogUtils.h"
 #include "LunaIPC.h"
 
@@ -31,8 +32,9 @@ Device::Device(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter, st
     m_isPowerOnConnect(false), m_isToastRequired(true), m_deviceNum(0), m_usbPortNum(0), m_busNum(0), m_usbPortSpeed(0), m_pConfObj(pConfObj)
     , m_pluginAdapter(pluginAdapter), m_deviceStatus(PdmDevAttributes::PDM_ERR_NOTHING), m_deviceType(deviceType), m_errorReason(errorReason), m_deviceName("")
     , m_devicePath(""), m_serialNumber(""), m_vendorName(""), m_productName(""), m_devSpeed(""), m_deviceSubType("")
+    , m_vendorID(""), m_productID("")
 #ifdef WEBOS_SESSION
-    , m_devPath(""), m_vendorID(""), m_productID(""), m_hubPortNumber(""), m_deviceSetId("")
+    , m_devPath(""), m_hubPortNumber(""), m_deviceSetId("")
 #endif
 {
 }
@@ -85,6 +87,9 @@ void Device::setDeviceInfo(DeviceClass* deviceClassEve)
       std::string delimeter = "/";
       std::string usbInfoString = m_devicePath.substr(m_devicePath.rfind(delimeter) + delimeter.size());
       getBasicUsbInfo(usbInfoString);
+#else
+      m_vendorID = deviceClassEve->getIdVendorId();
+      m_productID = deviceClassEve->getIdModelId();
 #endif
     }
     if(!deviceClassEve->getIdVendorFromDataBase().empty()){
@@ -107,77 +112,14 @@ void Device::setDeviceInfo(DeviceClass* deviceClassEve)
 #ifdef WEBOS_SESSION
 void Device::setDeviceSetId(std::string hubPortPath)
 {
-    PDM_LOG_DEBUG("Device::%s line:%d", __FUNCTION__, __LINE__);
-    LSError lserror;
-    LSErrorInit(&lserror);
-
-    m_deviceSetId = "";
-
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue query;
-
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                             {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
-
-    find_query.put("query", query);
-
-    LS::Payload find_payload(find_query);
-    LS::Call call = LunaIPC::getInstance()->getLSCPPHandle()->callOneReply("luna://com.webos.service.db/find", find_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull())
-    {
-        PDM_LOG_DEBUG("Db8 LS2 response is empty in %s", __PRETTY_FUNCTION__ );
-    }
-
-    if(!request["returnValue"].asBool())
-    {
-        PDM_LOG_DEBUG("Call to Db8 to save/delete message failed in %s", __PRETTY_FUNCTION__ );
-    }
-
-    m_deviceSetId = request["results"][0]["deviceSetId"].asString();
-
+    m_deviceSetId = PdmDeviceHistory::getInstance().find(hubPortPath)["deviceSetId"].asString();
     PDM_LOG_DEBUG("Device::%s line:%d deviceSetId: %s", __FUNCTION__, __LINE__, m_deviceSetId.c_str());
 }
 
 std::string Device::getErrorReason(std::string hubPortPath)
 {
-    PDM_LOG_DEBUG("Device::%s line:%d", __FUNCTION__, __LINE__);
-    LSError lserror;
-    LSErrorInit(&lserror);
-
-    std::string m_errorReason;
-
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue query;
-
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                             {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
-
-    find_query.put("query", query);
-
-    LS::Payload find_payload(find_query);
-    LS::Call call = LunaIPC::getInstance()->getLSCPPHandle()->callOneReply("luna://com.webos.service.db/find", find_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull())
-    {
-        PDM_LOG_DEBUG("Db8 LS2 response is empty in %s", __PRETTY_FUNCTION__ );
-    }
-
-    if(!request["returnValue"].asBool())
-    {
-        PDM_LOG_DEBUG("Call to Db8 to is failed in %s", __PRETTY_FUNCTION__ );
-    }
-
-    m_errorReason = request["results"][0]["errorReason"].asString();
-    PDM_LOG_DEBUG("Device::%s line:%d deviceSetId: %s", __FUNCTION__, __LINE__, m_errorReason.c_str());
+    std::string m_errorReason = PdmDeviceHistory::getInstance().find(hubPortPath)["errorReason"].asString();
+    PDM_LOG_DEBUG("Device::%s line:%d errorReason: %s", __FUNCTION__, __LINE__, m_errorReason.c_str());
     if(m_errorReason.empty()) {
         m_errorReason = "Not selected";
     }
@@ -186,39 +128,8 @@ std::string Device::getErrorReason(std::string hubPortPath)
 
 std::string Device::getStorageRootPath(std::string hubPortPath)
 {
-    PDM_LOG_DEBUG("Device::%s line:%d hubPortPath:%s", __FUNCTION__, __LINE__, hubPortPath.c_str());
-    LSError lserror;
-    LSErrorInit(&lserror);
-
-    std::string m_rootPath;
-
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue query;
-
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                             {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
-
-    find_query.put("query", query);
-
-    LS::Payload find_payload(find_query);
-    LS::Call call = LunaIPC::getInstance()->getLSCPPHandle()->callOneReply("luna://com.webos.service.db/find", find_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull())
-    {
-        PDM_LOG_DEBUG("Db8 LS2 response is empty in %s", __PRETTY_FUNCTION__ );
-    }
-
-    if(!request["returnValue"].asBool())
-    {
-        PDM_LOG_DEBUG("Call to Db8 to is failed in %s", __PRETTY_FUNCTION__ );
-    }
-
-    m_rootPath = request["results"][0]["rootPath"].asString();
-    PDM_LOG_DEBUG("Device::%s line:%d deviceSetId: %s", __FUNCTION__, __LINE__, m_rootPath.c_str());
+    std::string m_rootPath = PdmDeviceHistory::getInstance().find(hubPortPath)["rootPath"].asString();
+    PDM_LOG_DEBUG("Device::%s line:%d hubPortPath:%s rootPath: %s", __FUNCTION__, __LINE__, hubPortPath.c_str(), m_rootPath.c_str());
     if(m_rootPath.empty()) {
         m_rootPath = "Device not selected";
     }
@@ -23,7 +23,7 @@ using namespace PdmDevAttributes;
 void GamepadDevice::setDeviceInfo(DeviceClass* devClass)
 {
     PDM_LOG_DEBUG("GamepadDevice:%s line: %d setDeviceInfo", __FUNCTION__, __LINE__);
-    if(devClass->getAction() == DEVICE_ADD ) {
+    if(devClass->getDeviceAction() == USB_DEV_ADD ) {
         PDM_LOG_DEBUG("GamepadDevice:%s line: %d setDeviceInfo: DEVICE_ADD", __FUNCTION__, __LINE__);
         if(!devClass->getSpeed().empty()) {
             m_devSpeed = getDeviceSpeed(stoi(devClass->getSpeed(), nullptr));
@@ -25,7 +25,7 @@ void HIDDevice::setDeviceInfo(DeviceClass* devClass)
 {
     HIDSubsystem *hidSubsystem = (HIDSubsystem *)devClass;
 
-    if(devClass->getAction() == DEVICE_ADD ) {
+    if(devClass->getDeviceAction() == USB_DEV_ADD ) {
         Device::setDeviceInfo(devClass);
         if(devClass->getDevType() == USB_DEVICE ) {
             if(!devClass->getSpeed().empty()) {
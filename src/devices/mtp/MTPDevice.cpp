@@ -16,6 +16,7 @@
 
 #include "MTPDevice.h"
 #include "PdmLogUtils.h"
+#include "PdmProcessRunner.h"
 #include "PdmUtils.h"
 #include <unistd.h>
 #include "MTPSubsystem.h"
@@ -109,11 +110,15 @@ void MTPDevice::registerCallback(handlerCb mtpDeviceHandlerCb) {
 
 bool MTPDevice::unmountDevice() const {
 
-    std::string syscommand = FUSERMOUNT + mountName;
-    int32_t res = system(syscommand.c_str());
+    PdmProcessSpec spec;
+    spec.argv = PdmProcessRunner::splitArgs(FUSERMOUNT);
+    spec.argv.push_back(mountName);
+    spec.timeoutMs = PDM_FUSE_MOUNT_TIMEOUT_MS;
+    spec.urgent = true;
+    PdmProcessResult result = PdmProcessRunner::getInstance().run(spec);
 
-    if(res) {
-        PDM_LOG_ERROR("MTPDevice:%s line: %d MTP device umount failed" , __FUNCTION__, __LINE__);
+    if(!result.succeeded()) {
+        PDM_LOG_ERROR("MTPDevice:%s line: %d MTP device umount failed, %s" , __FUNCTION__, __LINE__, PdmProcessRunner::describe(result).c_str());
         return false;
     }
     return true;
@@ -121,12 +126,17 @@ bool MTPDevice::unmountDevice() const {
 
 bool MTPDevice::mountDevice(const std::string &mtpDeviceName) {
 
-     std::string syscommand = MTP_MOUNT_COMMAND +"/dev/"+ mtpDeviceName + " " + mountName;
-     PDM_LOG_INFO("MTPDevice:",0,"%s line: %d MTP device mount CMD: %s", __FUNCTION__,__LINE__,syscommand.c_str());
-     int32_t res = system(syscommand.c_str());
-
-     if(res){
-         PDM_LOG_ERROR("MTPDevice:%s line: %d MTP device mount failed res: %d, str: %s" , __FUNCTION__, __LINE__, res, strerror(errno));
+     PdmProcessSpec spec;
+     spec.argv = PdmProcessRunner::splitArgs(MTP_MOUNT_COMMAND);
+     spec.argv.push_back("/dev/" + mtpDeviceName);
+     spec.argv.push_back(mountName);
+     spec.timeoutMs = PDM_FUSE_MOUNT_TIMEOUT_MS;
+     spec.urgent = true;
+     PDM_LOG_INFO("MTPDevice:",0,"%s line: %d MTP device mount /dev/%s on %s", __FUNCTION__,__LINE__,mtpDeviceName.c_str(),mountName.c_str());
+     PdmProcessResult result = PdmProcessRunner::getInstance().run(spec);
+
+     if(!result.succeeded()){
+         PDM_LOG_ERROR("MTPDevice:%s line: %d MTP device mount failed, %s, output: %s" , __FUNCTION__, __LINE__, PdmProcessRunner::describe(result).c_str(), result.output.c_str());
          return false;
      }
      return true;
@@ -20,7 +20,7 @@ using namespace PdmDevAttributes;
 
 void NfcDevice::setDeviceInfo(DeviceClass* devClass)
 {
-    if(devClass->getAction() == DEVICE_ADD ) {
+    if(devClass->getDeviceAction() == USB_DEV_ADD ) {
         if (!devClass->getSpeed().empty()) {
             m_devSpeed = getDeviceSpeed(stoi(devClass->getSpeed(), nullptr));
         }
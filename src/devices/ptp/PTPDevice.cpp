@@ -18,6 +18,7 @@
 #include <iomanip>
 #include <dirent.h>
 #include "PdmLogUtils.h"
+#include "PdmProcessRunner.h"
 #include "PdmUtils.h"
 #include "PTPDevice.h"
 #include "PTPSubsystem.h"
@@ -120,15 +121,21 @@ PdmDevStatus PTPDevice::eject()
 
 bool PTPDevice::mountDevice()
 {
-    std::stringstream sysCommandStream;
-    sysCommandStream << PTP_MOUNT_COMMAND << " --port=usb:" << std::setfill('0')
-                     << std::setw(3) << m_busNum << "," << std::setfill('0')
-                     << std::setw(3) << m_ptpDevNum << " " << mountName;
-
-    int res = system(sysCommandStream.str().c_str());
-    if (res)
+    std::stringstream portStream;
+    portStream << "--port=usb:" << std::setfill('0')
+               << std::setw(3) << m_busNum << "," << std::setfill('0')
+               << std::setw(3) << m_ptpDevNum;
+
+    PdmProcessSpec spec;
+    spec.argv = PdmProcessRunner::splitArgs(PTP_MOUNT_COMMAND);
+    spec.argv.push_back(portStream.str());
+    spec.argv.push_back(mountName);
+    spec.timeoutMs = PDM_FUSE_MOUNT_TIMEOUT_MS;
+    spec.urgent = true;
+    PdmProcessResult result = PdmProcessRunner::getInstance().run(spec);
+    if (!result.succeeded())
     {
-        PDM_LOG_ERROR("PTPDevice:%s line: %d PTP device mount failed %d ", __FUNCTION__, __LINE__, res);
+        PDM_LOG_ERROR("PTPDevice:%s line: %d PTP device mount failed, %s, output: %s", __FUNCTION__, __LINE__, PdmProcessRunner::describe(result).c_str(), result.output.c_str());
         return false;
     }
 
@@ -136,7 +143,7 @@ bool PTPDevice::mountDevice()
     {
         return true;
     }
-    PDM_LOG_ERROR("PTPDevice:%s line: %d PTP device mount empty %d ", __FUNCTION__, __LINE__, res);
+    PDM_LOG_ERROR("PTPDevice:%s line: %d PTP device mount empty", __FUNCTION__, __LINE__);
     return false;
 }
 
@@ -146,12 +153,16 @@ bool PTPDevice::unmountDevice() const
     if (!isMounted)
         return true;
 
-    std::string sysCommand = FUSERMOUNT + mountName;
-    int32_t res = system(sysCommand.c_str());
+    PdmProcessSpec spec;
+    spec.argv = PdmProcessRunner::splitArgs(FUSERMOUNT);
+    spec.argv.push_back(mountName);
+    spec.timeoutMs = PDM_FUSE_MOUNT_TIMEOUT_MS;
+    spec.urgent = true;
+    PdmProcessResult result = PdmProcessRunner::getInstance().run(spec);
 
-    if (res)
+    if (!result.succeeded())
     {
-        PDM_LOG_ERROR("PTPDevice:%s line: %d PTP device umount failed", __FUNCTION__, __LINE__);
+        PDM_LOG_ERROR("PTPDevice:%s line: %d PTP device umount failed, %s", __FUNCTION__, __LINE__, PdmProcessRunner::describe(result).c_str());
         return false;
     }
     return true;
@@ -14,19 +14,26 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <errno.h>
 #include <memory>
 #include <string.h>
 #include "StorageDevice.h"
+#include "PdmBlockTopology.h"
+#include "PdmFsckScheduler.h"
 #include "PdmLogUtils.h"
+#include "PdmPayloadCache.h"
 #include "PdmSmartInfo.h"
+#include "PdmStartupMetrics.h"
 #include "PdmUtils.h"
+#include "PdmVolumeRecords.h"
 #include "StorageDeviceHandler.h"
 #include "StorageSubsystem.h"
 
 #define PDM_HDD_ID_ATA "1"
 #define PDM_HARD_DISK "HDD"
 #define PDM_STORAGE_DEVICE_CONNECTION_TIME 10000
+#define PDM_STORAGE_READ_ONLY_FIRST_MOUNT false
 #define USB30_BLACKDEVICE "USB30_BLACKDEVICE"
 
 using namespace PdmDevAttributes;
@@ -42,6 +49,7 @@ StorageDevice::StorageDevice(PdmConfig* const pConfObj, PluginAdapter* const plu
             , m_partitionCount(0)
             , m_timeoutId(0)
             , m_fsckThreadCount(0)
+            , m_readOnlyFirstMount(readReadOnlyFirstMount())
             , m_storageDeviceHandlerCb([] (EventType e, Storage* s){(void)e;(void)s;})
 {
     mHddDiskStats = std::make_tuple(-1,-1,-1);
@@ -57,6 +65,23 @@ StorageDevice::~StorageDevice() {
     }
 }
 
+// Under WEBOS_SESSION partitions are mounted on request, not on attach
+bool StorageDevice::readReadOnlyFirstMount()
+{
+#ifdef WEBOS_SESSION
+    return false;
+#else
+    bool readOnlyFirst = PDM_STORAGE_READ_ONLY_FIRST_MOUNT;
+    pbnjson::JValue readOnlyFirstConfVal = pbnjson::JValue();
+    PdmConfigStatus confErrCode = m_pConfObj->getValue("Common","ReadOnlyFirstMount",readOnlyFirstConfVal);
+    if(confErrCode != PdmConfigStatus::PDM_CONFIG_ERROR_NONE)
+        return readOnlyFirst;
+    if(readOnlyFirstConfVal.isBoolean())
+        readOnlyFirst = readOnlyFirstConfVal.asBool();
+    return readOnlyFirst;
+#endif
+}
+
 /*
  countPartitions
  @return int
@@ -64,15 +89,9 @@ StorageDevice::~StorageDevice() {
 */
 int StorageDevice::countPartitions(const std::string &devName)
 {
-    int count = 0;
     if(devName.empty())
-        return count;
-    std::string sysCommand = "lsblk -n /dev/" + devName + " | grep -c part";
-    std::string partitions = PdmUtils::execShellCmd(sysCommand);
-    if(!partitions.empty()){
-        count = std::stoi(partitions);
-    }
-    return count;
+        return 0;
+    return PdmBlockTopology::getInstance().getPartitionCount(devName);
 }
 
 void StorageDevice::setStorageInterfaceType(DeviceClass* devClass)
@@ -174,7 +193,7 @@ void StorageDevice::updateDiskInfo(DeviceClass* devClass)
     StorageSubsystem* storageSubSystem = (StorageSubsystem*)devClass;
 
     PDM_LOG_DEBUG("StorageDevice:%s line: %d ACTION = %s", __FUNCTION__, __LINE__, devClass->getAction().c_str());
-    switch(sMapDeviceActions[devClass->getAction()])
+    switch(devClass->getDeviceAction())
     {
         case DeviceActions::USB_DEV_ADD:
             m_deviceName = devClass->getDevName();
@@ -265,14 +284,35 @@ void StorageDevice::setPartitionInfo(DeviceClass* devClass)
 				mountAllPartition(); // direct mount without FSCK
 				storageDeviceNotification();
 			} else {
+				// Partitions not known to be clean can be browsed read-only
+				// while they are checked, if their checker has a no-modify mode
+				std::list<DiskPartitionInfo*> readOnlyFirst;
+				if(m_readOnlyFirstMount) {
+					for(auto partitionInfo : m_diskPartitionList){
+						if(partitionInfo->isSupportedFs() && partitionInfo->getFsState() != PdmSuperblockProbe::getStateName(PdmFsState::CLEAN)
+						   && m_pdmFileSystemObj.canCheckOnly(*partitionInfo)
+						   && mountPartitionReadOnlyFirst(*partitionInfo) == PdmDevStatus::PDM_DEV_SUCCESS)
+							readOnlyFirst.push_back(partitionInfo);
+					}
+				}
+				if(!readOnlyFirst.empty())
+					storageDeviceNotification();
 
+				// Counted before any task can run and finish
+				m_fsckThreadCount += std::count_if(m_diskPartitionList.begin(), m_diskPartitionList.end(), [](DiskPartitionInfo* dev){return dev->isSupportedFs();});
+				PdmBlockDisk disk;
+				bool hasTopology = PdmBlockTopology::getInstance().getDisk(m_deviceName, disk);
 				for(auto partitionInfo : m_diskPartitionList){
 					if(partitionInfo->isSupportedFs()){
-						m_fsckThreadArray.push_back(std::thread(&StorageDevice::fsckOnDeviceAddThread, this, partitionInfo));
-						m_fsckThreadCount++;
+						uint64_t priority = hasTopology ? getFsckPriority(disk, *partitionInfo) : 0;
+						if(std::find(readOnlyFirst.begin(), readOnlyFirst.end(), partitionInfo) != readOnlyFirst.end())
+							PdmFsckScheduler::getInstance().submit(this, m_deviceName, priority, [this, partitionInfo]{fsckReadOnlyMountedThread(partitionInfo);});
+						else
+							PdmFsckScheduler::getInstance().submit(this, m_deviceName, priority, [this, partitionInfo]{fsckOnDeviceAddThread(partitionInfo);});
 				   }
 				}
-				m_timeoutId = g_timeout_add (PDM_STORAGE_DEVICE_CONNECTION_TIME,(GSourceFunc)notifyStorageConnecting, this);
+				if(readOnlyFirst.empty())
+					m_timeoutId = g_timeout_add (PDM_STORAGE_DEVICE_CONNECTION_TIME,(GSourceFunc)notifyStorageConnecting, this);
 				}
 		}else{
 			m_errorReason = PDM_ERR_UNSUPPORT_FS;
@@ -288,8 +328,18 @@ void StorageDevice:: storageDeviceFsckNotification()
 {
     m_fsckThreadCount--;
     if(m_fsckThreadCount == 0 ) {
-        storageDeviceNotification();
-        g_source_remove(m_timeoutId);
+        if(!m_isDevAddEventNotified)
+            storageDeviceNotification();
+        else if(std::any_of(m_diskPartitionList.begin(), m_diskPartitionList.end(), [&](DiskPartitionInfo* dev){return (dev->getFsckStatus() == PDM_DEV_FSCK_TIMEOUT);})) {
+            // Added read-only already, the partition stays read-only
+            m_errorReason = PDM_ERR_NEED_FSCK;
+            m_storageDeviceHandlerCb(FSCK_TIMED_OUT,this);
+        } else if(std::any_of(m_diskPartitionList.begin(), m_diskPartitionList.end(), [&](DiskPartitionInfo* dev){return (dev->getFsckStatus() == PDM_DEV_FSCK_FAIL);})) {
+            m_errorReason = PDM_ERR_NEED_FSCK;
+        }
+        if(m_timeoutId)
+            g_source_remove(m_timeoutId);
+        m_timeoutId = 0;
     }
 }
 
@@ -315,9 +365,13 @@ void StorageDevice::storageDeviceNotification()
 #endif
     }
 #ifndef WEBOS_SESSION
-    else if(std::any_of(m_diskPartitionList.begin(), m_diskPartitionList.end(), [&](DiskPartitionInfo* dev){return dev->isMounted();})){
+    // A partition fsck could not repair is reported even if it did not mount
+    else if(std::any_of(m_diskPartitionList.begin(), m_diskPartitionList.end(), [&](DiskPartitionInfo* dev){return dev->isMounted() || dev->getFsckStatus() == PDM_DEV_FSCK_FAIL;})){
 #endif
-        m_errorReason = PDM_ERR_NOTHING;
+        if(std::any_of(m_diskPartitionList.begin(), m_diskPartitionList.end(), [&](DiskPartitionInfo* dev){return (dev->getFsckStatus() == PDM_DEV_FSCK_FAIL);}))
+            m_errorReason = PDM_ERR_NEED_FSCK;
+        else
+            m_errorReason = PDM_ERR_NOTHING;
         m_deviceIsMounted = true;
         m_storageDeviceHandlerCb(ADD,this);
         m_isDevAddEventNotified = true;
@@ -365,12 +419,12 @@ PdmDevStatus StorageDevice::isWritable(const std::string &driveName, bool &isWri
  @return bool
  umout all mounted partition in device
 */
-PdmDevStatus StorageDevice::umountAllPartition(const bool lazyUnmount)
+PdmDevStatus StorageDevice::umountAllPartition(const bool lazyUnmount, std::vector<pid_t> *busyPids)
 {
     PdmDevStatus result = PdmDevStatus::PDM_DEV_SUCCESS;
     PDM_LOG_DEBUG("StorageDevice:%s line: %d", __FUNCTION__, __LINE__);
     for(auto partition : m_diskPartitionList ){
-        if(umountPartition(*partition, lazyUnmount) != PdmDevStatus::PDM_DEV_SUCCESS)
+        if(umountPartition(*partition, lazyUnmount, busyPids) != PdmDevStatus::PDM_DEV_SUCCESS)
             result = PdmDevStatus::PDM_DEV_UMOUNT_ALL_FAIL;
     }
     return result;
@@ -419,6 +473,9 @@ DiskPartitionInfo* StorageDevice::findPartition(const std::string &drivename)
 */
 void StorageDevice::deletePartitionData()
 {
+    // Queued checks of the partitions are dropped, running ones terminated
+    PdmFsckScheduler::getInstance().cancel(this);
+    m_fsckThreadCount = 0;
     umountAllPartition(true);
     for(auto partition : m_diskPartitionList){
         delete partition;
@@ -431,7 +488,7 @@ void StorageDevice::deletePartitionData()
  @return bool
  Initialize the format setup for device
 */
-PdmDevStatus StorageDevice::formatDiskStart(const std::string driveName,std::string fsType,const std::string &volumeLabel)
+PdmDevStatus StorageDevice::formatDiskStart(const std::string driveName,std::string fsType,const std::string &volumeLabel, std::vector<pid_t> *busyPids)
 {
     DiskPartitionInfo* partition = findPartition(driveName);
     if( !partition )
@@ -440,7 +497,7 @@ PdmDevStatus StorageDevice::formatDiskStart(const std::string driveName,std::str
     if(isReadOnly)
         return PdmDevStatus::PDM_DEV_FORMAT_FAIL;
 
-    if(umountPartition(*partition, false) != PdmDevStatus::PDM_DEV_SUCCESS)
+    if(umountPartition(*partition, false, busyPids) != PdmDevStatus::PDM_DEV_SUCCESS)
         return PdmDevStatus::PDM_DEV_UMOUNT_FAIL;
 
     m_storageDeviceHandlerCb(FORMAT_STARTED,partition);
@@ -464,7 +521,7 @@ PdmDevStatus StorageDevice::formatDiskStart(const std::string driveName,std::str
  3.FSCK selected partition
  4.mount the partition
 */
-PdmDevStatus StorageDevice::fsck(const std::string driveName)
+PdmDevStatus StorageDevice::fsck(const std::string driveName, std::vector<pid_t> *busyPids)
 {
     DiskPartitionInfo* partition = findPartition(driveName);
     if( !partition )
@@ -473,7 +530,7 @@ PdmDevStatus StorageDevice::fsck(const std::string driveName)
     if(isReadOnly)
         return PdmDevStatus::PDM_DEV_FSCK_FAIL;
 
-    if(umountPartition(*partition, false) != PdmDevStatus::PDM_DEV_SUCCESS)
+    if(umountPartition(*partition, false, busyPids) != PdmDevStatus::PDM_DEV_SUCCESS)
         return PdmDevStatus::PDM_DEV_UMOUNT_FAIL;
 
     if(fsckPartition(*partition, PDM_FSCK_AUTO) == PdmDevStatus::PDM_DEV_SUCCESS)
@@ -489,10 +546,6 @@ PdmDevStatus StorageDevice::fsck(const std::string driveName)
 */
 void StorageDevice::onDeviceRemove()
 {
-    for(auto& fsckThread : m_fsckThreadArray)
-        fsckThread.join();
-    m_fsckThreadArray.clear();
-    m_fsckThreadCount = 0;
     deletePartitionData();
     removeRootDir();
     checkRemovalNotifications();
@@ -531,9 +584,9 @@ void StorageDevice::removeRootDir()
  @return bool
  Ejects all mounted partition on successes true else false
 */
-PdmDevStatus StorageDevice::eject()
+PdmDevStatus StorageDevice::eject(std::vector<pid_t> *busyPids)
 {
-    if(umountAllPartition(false) == PdmDevStatus::PDM_DEV_SUCCESS) {
+    if(umountAllPartition(false, busyPids) == PdmDevStatus::PDM_DEV_SUCCESS) {
         m_errorReason = m_deviceStatus = PDM_ERR_EJECTED;
         return PdmDevStatus::PDM_DEV_SUCCESS;
     }
@@ -570,13 +623,68 @@ PdmDevStatus StorageDevice::enforceFsckAndMount(bool needFsck)
      return result;
 }
 
+/*
+ getFsckPriority
+ @return
+ Scheduling priority of the check of partition, the largest partition of a
+ disk is the one most likely to be browsed first
+*/
+uint64_t StorageDevice::getFsckPriority(const PdmBlockDisk &disk, DiskPartitionInfo &partition)
+{
+    for(auto &blockPartition : disk.partitions) {
+        if(blockPartition.name == partition.getDriveName())
+            return blockPartition.size;
+    }
+    // Partitionless media, the file system spans the whole disk
+    return disk.size;
+}
+
 void StorageDevice::fsckOnDeviceAddThread(DiskPartitionInfo *partition)
 {
-    fsckPartition(*partition, PDM_FSCK_AUTO);
+    // A volume we unmounted cleanly and nobody touched since needs no fsck
+    if(PdmVolumeRecords::getInstance().takeCleanRecord(partition->getUuid(), m_serialNumber,
+                                                      "/dev/" + partition->getDriveName(), partition->getFsType())) {
+        partition->setFsckStatus(PdmDevStatus::PDM_DEV_SUCCESS);
+#ifndef WEBOS_SESSION
+        mountPartition(*partition, false);
+#endif
+    } else {
+        fsckPartition(*partition, PDM_FSCK_AUTO);
+    }
     storageDeviceFsckNotification();
 
 }
 
+/*
+ fsckReadOnlyMountedThread
+ Checks a partition mounted by mountPartitionReadOnlyFirst. A clean one is
+ remounted writable in place, one with errors is unmounted and repaired
+ unless it is in use, then it stays read-only.
+*/
+void StorageDevice::fsckReadOnlyMountedThread(DiskPartitionInfo *partition)
+{
+    PdmDevStatus checkStatus = m_pdmFileSystemObj.checkOnly(*partition);
+    partition->setFsckStatus(checkStatus == PdmDevStatus::PDM_DEV_FSCK_TIMEOUT ? checkStatus : PdmDevStatus::PDM_DEV_SUCCESS);
+    // Ejected or unmounted while being checked
+    if(partition->getDriveStatus() != MOUNT_READ_ONLY_OK) {
+        storageDeviceFsckNotification();
+        return;
+    }
+
+    if(checkStatus == PdmDevStatus::PDM_DEV_SUCCESS) {
+        remountPartitionWritable(*partition);
+    } else if(checkStatus != PdmDevStatus::PDM_DEV_FSCK_TIMEOUT && checkStatus != PdmDevStatus::PDM_DEV_ERROR) {
+        // Forced after errors were found, the superblock may well claim the
+        // volume is clean. Without a check result the bounded auto run is kept.
+        const std::string &fsckMode = (checkStatus == PdmDevStatus::PDM_DEV_FSCK_FAIL) ? PDM_FSCK_FORCE : PDM_FSCK_AUTO;
+        if(umountPartition(*partition, false) == PdmDevStatus::PDM_DEV_SUCCESS)
+            fsckPartition(*partition, fsckMode);
+        else
+            PDM_LOG_WARNING("StorageDevice:%s line: %d %s is in use, staying read-only", __FUNCTION__, __LINE__, partition->getDriveName().c_str());
+    }
+    storageDeviceFsckNotification();
+}
+
 DiskPartitionInfo* StorageDevice::getSpaceInfo(const std::string driveName, bool directCheck)
 {
     DiskPartitionInfo* partition = findPartition(driveName);
@@ -585,29 +693,36 @@ DiskPartitionInfo* StorageDevice::getSpaceInfo(const std::string driveName, bool
         if(!m_pdmFileSystemObj.calculateSpaceInfo(partition->getMountName(), &spaceData))
             return partition;
         partition->partitionLock();
+        // driveSize is part of the storage device list
+        bool sizeChanged = (partition->getDriveSize() != spaceData.driveSize);
         partition->setDriveSize(spaceData.driveSize);
         partition->setUsedSize(spaceData.usedSize);
         partition->setFreeSize(spaceData.freeSize);
         partition->setUsedRate(spaceData.usedRate);
         partition->partitionUnLock();
+        if(sizeChanged)
+            PdmPayloadCache::getInstance().invalidate(STORAGE_DEVICE);
     }
     return partition;
 }
 
-PdmDevStatus StorageDevice::umountPartition(DiskPartitionInfo &partition, const bool lazyUnmount) {
+PdmDevStatus StorageDevice::umountPartition(DiskPartitionInfo &partition, const bool lazyUnmount, std::vector<pid_t> *busyPids) {
 
     PdmDevStatus umountStatus = PdmDevStatus::PDM_DEV_SUCCESS;
 
     if(partition.isMounted() == false)
         return umountStatus;
     //if lazy umount option is true don't check the drive busy condition
-    if(lazyUnmount == false && m_pdmFileSystemObj.isDriveBusy(partition) == true)
+    if(lazyUnmount == false && m_pdmFileSystemObj.isDriveBusy(partition, busyPids) == true)
         return PdmDevStatus::PDM_DEV_BUSY;
+    bool wasWritable = (partition.getDriveStatus() == MOUNT_OK);
     partition.partitionLock();
     partition.setDriveStatus(IS_UNMOUNTING);
     m_storageDeviceHandlerCb(UMOUNT,nullptr);
     if(m_pdmFileSystemObj.umount(partition, lazyUnmount)) {
         partition.setDriveStatus(UMOUNT_OK);
+        if(!lazyUnmount && wasWritable)
+            recordCleanUnmount(partition);
         m_storageDeviceHandlerCb(UMOUNT,nullptr);
     }else{
         partition.setDriveStatus(UMOUNT_NOT_OK);
@@ -626,6 +741,9 @@ PdmDevStatus StorageDevice::mountPartition(DiskPartitionInfo &partition, const b
 
     if(m_pdmFileSystemObj.mountPartition(partition, readOnly)){
         partition.setDriveStatus(MOUNT_OK);
+        if(!readOnly)
+            PdmVolumeRecords::getInstance().forget(partition.getUuid(), m_serialNumber);
+        PdmStartupMetrics::markFirstMount(partition.getDriveName());
         m_storageDeviceHandlerCb(MOUNT,nullptr);
     } else {
         partition.setDriveStatus(MOUNT_NOT_OK);
@@ -635,6 +753,32 @@ PdmDevStatus StorageDevice::mountPartition(DiskPartitionInfo &partition, const b
     return mountStatus;
 }
 
+PdmDevStatus StorageDevice::mountPartitionReadOnlyFirst(DiskPartitionInfo &partition) {
+
+    partition.setDriveStatus(IS_MOUNTING);
+    m_storageDeviceHandlerCb(MOUNT,nullptr);
+
+    if(!m_pdmFileSystemObj.mountPartition(partition, true)) {
+        partition.setDriveStatus(MOUNT_NOT_OK);
+        m_storageDeviceHandlerCb(UMOUNT,nullptr);
+        return PdmDevStatus::PDM_DEV_MOUNT_FAIL;
+    }
+    partition.setDriveStatus(MOUNT_READ_ONLY_OK);
+    PdmStartupMetrics::markFirstMount(partition.getDriveName());
+    m_storageDeviceHandlerCb(MOUNT,nullptr);
+    return PdmDevStatus::PDM_DEV_SUCCESS;
+}
+
+PdmDevStatus StorageDevice::remountPartitionWritable(DiskPartitionInfo &partition) {
+
+    if(!m_pdmFileSystemObj.remountReadWrite(partition))
+        return PdmDevStatus::PDM_DEV_MOUNT_FAIL;
+    partition.setDriveStatus(MOUNT_OK);
+    PdmVolumeRecords::getInstance().forget(partition.getUuid(), m_serialNumber);
+    m_storageDeviceHandlerCb(MOUNT,nullptr);
+    return PdmDevStatus::PDM_DEV_SUCCESS;
+}
+
 PdmDevStatus StorageDevice::fsckPartition(DiskPartitionInfo &partition, const std::string &fsckMode) {
 
     PdmDevStatus fsckStatus = PdmDevStatus::PDM_DEV_SUCCESS;
@@ -643,6 +787,9 @@ PdmDevStatus StorageDevice::fsckPartition(DiskPartitionInfo &partition, const st
 #ifndef WEBOS_SESSION
     if( fsckStatus == PdmDevStatus::PDM_DEV_SUCCESS)
         fsckStatus = mountPartition(partition,false);
+    else if( fsckStatus == PdmDevStatus::PDM_DEV_FSCK_FAIL)
+        // Errors were left behind, still browsable until it is repaired
+        mountPartitionReadOnlyFirst(partition);
 #endif
     m_storageDeviceHandlerCb(FSCK_FINISHED, nullptr);
     return fsckStatus;
@@ -658,15 +805,26 @@ bool StorageDevice::suspendUmountAllPartitions(const bool lazyUnmount) {
 
     bool retValue = true;
     PDM_LOG_DEBUG("StorageDevice:%s line: %d", __FUNCTION__, __LINE__);
+    if(lazyUnmount == false && m_pdmFileSystemObj.isAnyDriveBusy(m_diskPartitionList) == true)
+        return false;
     for(auto partition : m_diskPartitionList ) {
-        if(lazyUnmount == false && m_pdmFileSystemObj.isDriveBusy(*partition) == true)
-            return false;
+        bool wasWritable = (partition->getDriveStatus() == MOUNT_OK);
         if(m_pdmFileSystemObj.umount(*partition, lazyUnmount) == false)
             retValue = false;
+        else if(lazyUnmount == false && wasWritable)
+            recordCleanUnmount(*partition);
     }
     return retValue;
 }
 
+void StorageDevice::recordCleanUnmount(DiskPartitionInfo &partition)
+{
+    if(isReadOnly)
+        return;
+    PdmVolumeRecords::getInstance().recordCleanUnmount(partition.getUuid(), m_serialNumber,
+                                                      "/dev/" + partition.getDriveName(), partition.getFsType());
+}
+
 void StorageDevice::resumeRequest(const int &eventType) {
     PDM_LOG_DEBUG("StorageDevice:%s line: %d", __FUNCTION__, __LINE__);
     for(auto partition : m_diskPartitionList )
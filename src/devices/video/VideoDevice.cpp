@@ -44,7 +44,7 @@ VideoDevice::~VideoDevice() {
 
 void VideoDevice::setDeviceInfo(DeviceClass* devClassPtr, bool isCameraReady)
 {
-    if(devClassPtr->getAction() == DEVICE_ADD ) {
+    if(devClassPtr->getDeviceAction() == USB_DEV_ADD ) {
         PDM_LOG_DEBUG("VideoDevice:%s line: %d setDeviceInfo: DEVICE_ADD", __FUNCTION__, __LINE__);
         if(!devClassPtr->getSpeed().empty()) {
             m_devSpeed = getDeviceSpeed(stoi(devClassPtr->getSpeed(), nullptr));
@@ -79,7 +79,7 @@ void VideoDevice::updateDeviceInfo(DeviceClass* devClassPtr)
         }
 
         VideoSubDevice* subDevice = getSubDevice("/dev/" + devClassPtr->getDevName());
-        switch (sMapDeviceActions[devClassPtr->getAction()]) {
+        switch (devClassPtr->getDeviceAction()) {
             case DeviceActions::USB_DEV_ADD:
                 if (!devClassPtr->getDevName().empty()) {
                     if (subDevice) {
@@ -24,19 +24,17 @@ using namespace PdmDevAttributes;
 
 bool AutoAndroidSubSystem::mIsObjRegistered = AutoAndroidSubSystem::RegisterSubSystem();
 
-AutoAndroidSubSystem::AutoAndroidSubSystem(std::unordered_map<std::string, std::string>& devPropMap)
-	: mDevType("autoandroid"), DeviceClass(devPropMap)
+AutoAndroidSubSystem::AutoAndroidSubSystem(const PdmDevPropertyBlockPtr &devProps)
+	: DeviceClass(devProps), mDevType("autoandroid")
 {
-	for (auto &prop : devPropMap)
-		mDevPropMap[prop.first] = prop.second;
 }
 
 AutoAndroidSubSystem::~AutoAndroidSubSystem() {}
 
-AutoAndroidSubSystem *AutoAndroidSubSystem::create(std::unordered_map<std::string, std::string> &devProMap)
+AutoAndroidSubSystem *AutoAndroidSubSystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
     PDM_LOG_DEBUG("AutoAndroidSubSystem:%s line: %d", __FUNCTION__, __LINE__);
-    bool canProcessEve = AutoAndroidSubSystem::canProcessEvent(devProMap);
+    bool canProcessEve = AutoAndroidSubSystem::canProcessEvent(*devProMap);
 
     if (!canProcessEve)
         return nullptr;
@@ -48,10 +46,10 @@ AutoAndroidSubSystem *AutoAndroidSubSystem::create(std::unordered_map<std::strin
 
 std::string AutoAndroidSubSystem::getIdProduct()
 {
-    return mDevPropMap[ID_PRODUCT_ID];
+    return getPropertyString(PdmDevProperty::ID_PRODUCT_ID);
 }
 
 std::string AutoAndroidSubSystem::getModelId()
 {
-    return mDevPropMap[ID_MODEL_ID];
+    return getPropertyString(PdmDevProperty::ID_MODEL_ID);
 }
\ No newline at end of file
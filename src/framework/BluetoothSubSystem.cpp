@@ -24,19 +24,17 @@ using namespace PdmDevAttributes;
 
 bool BluetoothSubSystem::mIsObjRegistered = BluetoothSubSystem::RegisterSubSystem();
 
-BluetoothSubSystem::BluetoothSubSystem(std::unordered_map<std::string, std::string>& devPropMap)
-	: mDevType("bluetooth"), DeviceClass(devPropMap)
+BluetoothSubSystem::BluetoothSubSystem(const PdmDevPropertyBlockPtr &devProps)
+	: DeviceClass(devProps), mDevType("bluetooth")
 {
-	for (auto &prop : devPropMap)
-		mDevPropMap[prop.first] = prop.second;
 }
 
 BluetoothSubSystem::~BluetoothSubSystem() {}
 
-BluetoothSubSystem *BluetoothSubSystem::create(std::unordered_map<std::string, std::string> &devProMap)
+BluetoothSubSystem *BluetoothSubSystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
     PDM_LOG_DEBUG("BluetoothSubSystem:%s line: %d", __FUNCTION__, __LINE__);
-    bool canProcessEve = BluetoothSubSystem::canProcessEvent(devProMap);
+    bool canProcessEve = BluetoothSubSystem::canProcessEvent(*devProMap);
 
     if (!canProcessEve)
         return nullptr;
@@ -24,19 +24,17 @@ using namespace PdmDevAttributes;
 
 bool CdcSubSystem::mIsObjRegistered = CdcSubSystem::RegisterSubSystem();
 
-CdcSubSystem::CdcSubSystem(std::unordered_map<std::string, std::string>& devPropMap)
-	: mDevType("cdc"), DeviceClass(devPropMap)
+CdcSubSystem::CdcSubSystem(const PdmDevPropertyBlockPtr &devProps)
+	: DeviceClass(devProps), mDevType("cdc")
 {
-	for (auto &prop : devPropMap)
-		mDevPropMap[prop.first] = prop.second;
 }
 
 CdcSubSystem::~CdcSubSystem() {}
 
-CdcSubSystem *CdcSubSystem::create(std::unordered_map<std::string, std::string> &devProMap)
+CdcSubSystem *CdcSubSystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
     PDM_LOG_DEBUG("CdcSubSystem:%s line: %d", __FUNCTION__, __LINE__);
-    bool canProcessEve = CdcSubSystem::canProcessEvent(devProMap);
+    bool canProcessEve = CdcSubSystem::canProcessEvent(*devProMap);
 
     if (!canProcessEve)
         return nullptr;
@@ -48,45 +46,45 @@ CdcSubSystem *CdcSubSystem::create(std::unordered_map<std::string, std::string>
 
 std::string CdcSubSystem::getUsbModemId()
 {
-    return mDevPropMap[ID_USB_MODEM_DONGLE];
+    return getPropertyString(PdmDevProperty::ID_USB_MODEM_DONGLE);
 }
 
 std::string CdcSubSystem::getIdUsbSerial()
 {
-    return mDevPropMap[ID_USB_SERIAL];
+    return getPropertyString(PdmDevProperty::ID_USB_SERIAL);
 }
 
 std::string CdcSubSystem::getUsbSerialId()
 {
-    return mDevPropMap[ID_USB_SERIAL];
+    return getPropertyString(PdmDevProperty::ID_USB_SERIAL);
 }
 
 std::string CdcSubSystem::getUsbSerialSubType()
 {
-    return mDevPropMap[USB_SERIAL_SUB_TYPE];
+    return getPropertyString(PdmDevProperty::USB_SERIAL_SUB_TYPE);
 }
 
 std::string CdcSubSystem::getNetIfIndex()
 {
-    return mDevPropMap[NET_IFIINDEX];
+    return getPropertyString(PdmDevProperty::NET_IFIINDEX);
 }
 
 std::string CdcSubSystem::getNetLinkMode()
 {
-    return mDevPropMap[NET_LINK_MODE];
+    return getPropertyString(PdmDevProperty::NET_LINK_MODE);
 }
 
 std::string CdcSubSystem::getNetDuplex()
 {
-    return mDevPropMap[NET_DUPLEX];
+    return getPropertyString(PdmDevProperty::NET_DUPLEX);
 }
 
 std::string CdcSubSystem::getNetAddress()
 {
-    return mDevPropMap[NET_ADDRESS];
+    return getPropertyString(PdmDevProperty::NET_ADDRESS);
 }
 
 std::string CdcSubSystem::getNetOperState()
 {
-    return mDevPropMap[NET_OPERSTATE];
+    return getPropertyString(PdmDevProperty::NET_OPERSTATE);
 }
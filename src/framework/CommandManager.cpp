@@ -17,24 +17,118 @@
 #include "CommandManager.h"
 #include "PdmLogUtils.h"
 
+#define PDM_COMMAND_LANE_WAIT_WARN_US 1000000
+#define PDM_HOTPLUG_LANE_WORKERS 3
+
 CommandManager::CommandManager() {
-    m_cmdPool = new PdmThreadPool(1);
+    m_hotplugStrands = new PdmStrandExecutor(PDM_HOTPLUG_LANE_WORKERS);
+    m_lanePools[static_cast<size_t>(CommandLane::HOTPLUG)] = nullptr;
+    m_lanePools[static_cast<size_t>(CommandLane::QUERY)] = new PdmThreadPool(1);
+    m_lanePools[static_cast<size_t>(CommandLane::STORAGE_JOB)] = new PdmThreadPool(1);
 }
 
 CommandManager::~CommandManager() {
-    delete m_cmdPool;
-    m_cmdPool = nullptr;
+    delete m_hotplugStrands;
+    m_hotplugStrands = nullptr;
+    for(size_t lane = 0; lane < LANE_COUNT; lane++) {
+        delete m_lanePools[lane];
+        m_lanePools[lane] = nullptr;
+    }
 }
 
 bool CommandManager::sendCommand(Command *cmd) {
-    PDM_LOG_DEBUG("CommandManager:%s line: %d", __FUNCTION__, __LINE__);
-    auto result = m_cmdPool->enqueue(&CommandManager::executeCommand, cmd);
+    if(!cmd)
+        return false;
+
+    CommandLane lane = cmd->getLane();
+    size_t index = static_cast<size_t>(lane);
+    if(index >= LANE_COUNT) {
+        PDM_LOG_ERROR("CommandManager:%s line: %d invalid lane: %zu", __FUNCTION__, __LINE__, index);
+        delete cmd;
+        return false;
+    }
+    PDM_LOG_DEBUG("CommandManager:%s line: %d lane: %s", __FUNCTION__, __LINE__, getLaneName(lane));
+
+    LaneCounters &counters = m_laneCounters[index];
+    counters.enqueued++;
+    updateMax(counters.maxQueueDepth, ++counters.queueDepth);
+    cmd->setEnqueueTime(std::chrono::steady_clock::now());
+    if(lane == CommandLane::HOTPLUG) {
+        m_hotplugStrands->post(cmd->getOrderingKey(), [this, cmd]() {
+            runCommand(cmd, CommandLane::HOTPLUG);
+        });
+        return true;
+    }
+    m_lanePools[index]->post(&CommandManager::runPostedCommand, this, cmd);
     return true;
 }
 
+void CommandManager::runPostedCommand(void *context, void *arg) {
+    CommandManager *cmdManager = static_cast<CommandManager*>(context);
+    Command *cmd = static_cast<Command*>(arg);
+    cmdManager->runCommand(cmd, cmd->getLane());
+}
+
+void CommandManager::runCommand(Command *cmd, CommandLane lane) {
+    LaneCounters &counters = m_laneCounters[static_cast<size_t>(lane)];
+    counters.queueDepth--;
+
+    auto startTime = std::chrono::steady_clock::now();
+    uint64_t waitUs = std::chrono::duration_cast<std::chrono::microseconds>(startTime - cmd->getEnqueueTime()).count();
+    counters.totalWaitUs += waitUs;
+    updateMax(counters.maxWaitUs, waitUs);
+    if(waitUs > PDM_COMMAND_LANE_WAIT_WARN_US)
+        PDM_LOG_WARNING("CommandManager:%s line: %d lane: %s command waited %llu us", __FUNCTION__, __LINE__,
+                        getLaneName(lane), (unsigned long long)waitUs);
+
+    executeCommand(cmd);
+
+    uint64_t execUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+    counters.totalExecUs += execUs;
+    updateMax(counters.maxExecUs, execUs);
+    counters.completed++;
+}
+
 bool CommandManager::executeCommand(Command *cmd){
      PDM_LOG_DEBUG("CommandManager:%s line: %d", __FUNCTION__, __LINE__);
      cmd->execute();
      delete cmd;
      return true;
 }
+
+void CommandManager::updateMax(std::atomic<uint64_t> &maxValue, uint64_t value) {
+    uint64_t current = maxValue.load();
+    while(value > current && !maxValue.compare_exchange_weak(current, value));
+}
+
+CommandLaneStats CommandManager::getLaneStats(CommandLane lane) const {
+    CommandLaneStats stats = {};
+    size_t index = static_cast<size_t>(lane);
+    if(index >= LANE_COUNT)
+        return stats;
+
+    const LaneCounters &counters = m_laneCounters[index];
+    stats.enqueued = counters.enqueued.load();
+    stats.completed = counters.completed.load();
+    stats.queueDepth = counters.queueDepth.load();
+    stats.maxQueueDepth = counters.maxQueueDepth.load();
+    stats.totalWaitUs = counters.totalWaitUs.load();
+    stats.maxWaitUs = counters.maxWaitUs.load();
+    stats.totalExecUs = counters.totalExecUs.load();
+    stats.maxExecUs = counters.maxExecUs.load();
+    return stats;
+}
+
+const char* CommandManager::getLaneName(CommandLane lane) {
+    switch(lane)
+    {
+        case CommandLane::HOTPLUG:
+            return "hotplug";
+        case CommandLane::QUERY:
+            return "query";
+        case CommandLane::STORAGE_JOB:
+            return "storageJob";
+        default:
+            return "unknown";
+    }
+}
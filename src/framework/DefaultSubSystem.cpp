@@ -24,16 +24,14 @@ using namespace PdmDevAttributes;
 
 bool DefaultSubSystem::mIsObjRegistered = DefaultSubSystem::RegisterSubSystem();
 
-DefaultSubSystem::DefaultSubSystem(std::unordered_map<std::string, std::string>& devPropMap)
-	: mDevType("default"), DeviceClass(devPropMap)
+DefaultSubSystem::DefaultSubSystem(const PdmDevPropertyBlockPtr &devProps)
+	: DeviceClass(devProps), mDevType("default")
 {
-	for (auto &prop : devPropMap)
-		mDevPropMap[prop.first] = prop.second;
 }
 
 DefaultSubSystem::~DefaultSubSystem() {}
 
-DefaultSubSystem* DefaultSubSystem::create(std::unordered_map<std::string, std::string>& devProMap)
+DefaultSubSystem* DefaultSubSystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
 	PDM_LOG_DEBUG("DefaultSubSystem:%s line: %d", __FUNCTION__, __LINE__);
 
@@ -17,99 +17,124 @@
 #include "Common.h"
 #include "DeviceClass.h"
 
-DeviceClass::DeviceClass(std::unordered_map<std::string, std::string> &devPropMap)
+DeviceClass::DeviceClass(const PdmDevPropertyBlockPtr &devProps)
+    : mDevProps(devProps)
 {
-    for (auto &prop : devPropMap)
-        mDevPropMap[prop.first] = prop.second;
+}
+
+PdmStringView DeviceClass::getProperty(PdmDevProperty property) const
+{
+    if (!mDevProps)
+        return PdmStringView();
+    return mDevProps->get(property);
+}
+
+std::string DeviceClass::getPropertyString(PdmDevProperty property) const
+{
+    return getProperty(property).to_string();
+}
+
+DeviceActions DeviceClass::getDeviceAction() const
+{
+    if (!mDevProps)
+        return USB_DEV_UNKNOWN;
+    return mDevProps->getAction();
 }
 
 std::string DeviceClass::getDevType()
 {
-    return mDevPropMap[PdmDevAttributes::DEVTYPE];
+    return getPropertyString(PdmDevProperty::DEVTYPE);
 }
 
 std::string DeviceClass::getSubsystemName()
 {
-    return mDevPropMap[PdmDevAttributes::SUBSYSTEM];
+    return getPropertyString(PdmDevProperty::SUBSYSTEM);
 }
 
 std::string DeviceClass::getAction()
 {
-    return mDevPropMap[PdmDevAttributes::ACTION];
+    return getPropertyString(PdmDevProperty::ACTION);
 }
 
 std::string DeviceClass::getDevPath()
 {
-    return mDevPropMap[PdmDevAttributes::DEVPATH];
+    return getPropertyString(PdmDevProperty::DEVPATH);
 }
 
 std::string DeviceClass::getInterfaceClass()
 {
-    std::string bInterfaceClass;
-    if (!mDevPropMap[PdmDevAttributes::ID_USB_INTERFACES].empty())
-        bInterfaceClass = mDevPropMap[PdmDevAttributes::ID_USB_INTERFACES];
-    return bInterfaceClass;
+    return getPropertyString(PdmDevProperty::ID_USB_INTERFACES);
 }
 
 std::string DeviceClass::getUsbDriver()
 {
-    return mDevPropMap[PdmDevAttributes::ID_USB_DRIVER];
+    return getPropertyString(PdmDevProperty::ID_USB_DRIVER);
 }
 
 std::string DeviceClass::getIdSerilShort()
 {
-    return mDevPropMap[PdmDevAttributes::ID_SERIAL_SHORT];
+    return getPropertyString(PdmDevProperty::ID_SERIAL_SHORT);
 }
 
 std::string DeviceClass::getIdModel()
 {
-    return mDevPropMap[PdmDevAttributes::ID_MODEL];
+    return getPropertyString(PdmDevProperty::ID_MODEL);
 }
 
 std::string DeviceClass::getIsPowerOnConnect()
 {
-    return mDevPropMap[PdmDevAttributes::IS_POWER_ON_CONNECT];
+    return getPropertyString(PdmDevProperty::IS_POWER_ON_CONNECT);
 }
 
 std::string DeviceClass::getIdVendorFromDataBase()
 {
-    return mDevPropMap[PdmDevAttributes::ID_VENDOR_FROM_DATABASE];
+    return getPropertyString(PdmDevProperty::ID_VENDOR_FROM_DATABASE);
 }
 
 std::string DeviceClass::getIdVendor()
 {
-    return mDevPropMap[PdmDevAttributes::ID_VENDOR];
+    return getPropertyString(PdmDevProperty::ID_VENDOR);
+}
+
+std::string DeviceClass::getIdVendorId()
+{
+    return getPropertyString(PdmDevProperty::ID_VENDOR_ID);
+}
+
+std::string DeviceClass::getIdModelId()
+{
+    return getPropertyString(PdmDevProperty::ID_MODEL_ID);
 }
 
 std::string DeviceClass::getDevNumber()
 {
-    return mDevPropMap[PdmDevAttributes::DEVNUM];
+    return getPropertyString(PdmDevProperty::DEVNUM);
 }
 
 std::string DeviceClass::getDevName()
 {
-    return mDevPropMap[PdmDevAttributes::DEVNAME];
+    return getPropertyString(PdmDevProperty::DEVNAME);
 }
 
 std::string DeviceClass::getMediaPlayerId()
 {
-    return mDevPropMap[PdmDevAttributes::ID_MEDIA_PLAYER];
+    return getPropertyString(PdmDevProperty::ID_MEDIA_PLAYER);
 }
 
 std::string DeviceClass::getBluetoothId()
 {
-    return mDevPropMap[PdmDevAttributes::ID_BLUETOOTH];
+    return getPropertyString(PdmDevProperty::ID_BLUETOOTH);
 }
 
 #ifdef WEBOS_SESSION
 std::string DeviceClass::getUsbPort()
 {
-    return mDevPropMap[PdmDevAttributes::USB_PORT];
+    return getPropertyString(PdmDevProperty::USB_PORT);
 }
 
 std::string DeviceClass::getRfKillName()
 {
-    return mDevPropMap[PdmDevAttributes::RFKILL_NAME];
+    return getPropertyString(PdmDevProperty::RFKILL_NAME);
 }
 #endif
 
@@ -120,25 +145,53 @@ std::string DeviceClass::getBusType()
 
 std::string DeviceClass::getSpeed()
 {
-    return mDevPropMap[PdmDevAttributes::SPEED];
+    return getPropertyString(PdmDevProperty::SPEED);
 }
 
 std::string DeviceClass::getFsType()
 {
-    return mDevPropMap[PdmDevAttributes::ID_FS_TYPE];
+    return getPropertyString(PdmDevProperty::ID_FS_TYPE);
 }
 
 std::string DeviceClass::getFsUuid()
 {
-    return mDevPropMap[PdmDevAttributes::ID_FS_UUID];
+    return getPropertyString(PdmDevProperty::ID_FS_UUID);
 }
 
 std::string DeviceClass::getFsLabelEnc()
 {
-    return mDevPropMap[PdmDevAttributes::ID_FS_LABEL_ENC];
+    return getPropertyString(PdmDevProperty::ID_FS_LABEL_ENC);
 }
 
 std::string DeviceClass::getIdBlackList()
 {
-    return mDevPropMap[PdmDevAttributes::ID_BLACKLIST];
-}
\ No newline at end of file
+    return getPropertyString(PdmDevProperty::ID_BLACKLIST);
+}
+
+// Returns DEVPATH cut after its deepest USB port component (e.g. "1-1.2"),
+// so that every interface, block device or sound card of one physical USB
+// device maps to the same path. Empty for devices not below a USB port.
+std::string DeviceClass::getUsbDevicePath()
+{
+    return usbDevicePathOf(getProperty(PdmDevProperty::DEVPATH));
+}
+
+std::string DeviceClass::usbDevicePathOf(PdmStringView devPath)
+{
+    PdmStringView::size_type usbDevEnd = 0;
+    PdmStringView::size_type start = 0;
+
+    while (start < devPath.length()) {
+        PdmStringView::size_type end = devPath.find('/', start);
+        if (end == PdmStringView::npos)
+            end = devPath.length();
+        PdmStringView component = devPath.substr(start, end - start);
+        PdmStringView::size_type dash = component.find('-');
+        if (dash != PdmStringView::npos && dash > 0 && dash + 1 < component.length() &&
+            component.find_first_not_of("0123456789") == dash &&
+            component.find_first_not_of("0123456789.", dash + 1) == PdmStringView::npos)
+            usbDevEnd = end;
+        start = end + 1;
+    }
+    return devPath.substr(0, usbDevEnd).to_string();
+}
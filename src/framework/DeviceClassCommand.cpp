@@ -16,10 +16,14 @@
 
 #include "DeviceClassCommand.h"
 #include "DeviceManager.h"
+#include "PdmLatencyStats.h"
 
-DeviceClassCommand::DeviceClassCommand(DeviceClass *ptr)
+DeviceClassCommand::DeviceClassCommand(DeviceClass *ptr, std::chrono::steady_clock::time_point receiveTime)
+    : mReceiveTime(receiveTime)
 {
     mDevClassPtr = ptr;
+    if (mDevClassPtr)
+        mOrderingKey = mDevClassPtr->getUsbDevicePath();
 }
 
 DeviceClassCommand::~DeviceClassCommand()
@@ -29,9 +33,19 @@ DeviceClassCommand::~DeviceClassCommand()
     mDevClassPtr = nullptr;
 }
 
+std::string DeviceClassCommand::getOrderingKey() const
+{
+    return mOrderingKey;
+}
+
 void DeviceClassCommand::execute()
 {
     if (mDevClassPtr) {
+        PdmLatencyStats::EventScope eventScope(mDevClassPtr->getSubsystemName(), mReceiveTime);
+        if (getEnqueueTime() != std::chrono::steady_clock::time_point()) {
+            PdmLatencyStats::record(PdmLatencyStage::DISPATCH, mReceiveTime, getEnqueueTime());
+            PdmLatencyStats::record(PdmLatencyStage::QUEUE_WAIT, getEnqueueTime(), std::chrono::steady_clock::now());
+        }
         DeviceManager::getInstance()->HandlePdmDevice(mDevClassPtr);
         if(mDevClassPtr)
             delete mDevClassPtr;
@@ -28,8 +28,32 @@ DeviceClassFactory& DeviceClassFactory::getInstance() {
 	return obj;
 }
 
+constexpr const char* DeviceClassFactory::USB_INTERFACE_CLASS;
+
 void DeviceClassFactory::Register(std::string devType, devCreateFptr fPtr)
 {
+	Register(std::move(devType), std::move(fPtr), DeviceClassMatchKeys());
+}
+
+void DeviceClassFactory::Register(std::string devType, devCreateFptr fPtr, const DeviceClassMatchKeys &matchKeys)
+{
+	Deregister(devType);
+	for (auto const& key : matchKeys) {
+		if (key.property == USB_INTERFACE_CLASS) {
+			mInterfaceClaims[key.value].push_back(devType);
+			continue;
+		}
+		PdmDevProperty property;
+		if (!PdmDevPropertyBlock::fromName(key.property, property)) {
+			PDM_LOG_ERROR("DeviceClassFactory:%s line: %d %s claims unknown property %s", __FUNCTION__, __LINE__, devType.c_str(), key.property.c_str());
+			continue;
+		}
+		auto claims = std::find_if(mPropertyClaims.begin(), mPropertyClaims.end(),
+			[property](const std::pair<PdmDevProperty, ClaimMap> &entry) { return entry.first == property; });
+		if (claims == mPropertyClaims.end())
+			claims = mPropertyClaims.insert(mPropertyClaims.end(), std::make_pair(property, ClaimMap()));
+		claims->second[key.value].push_back(devType);
+	}
 	mDevMap[devType] = std::move(fPtr);
 }
 
@@ -38,57 +62,125 @@ void DeviceClassFactory::Deregister(std::string devType)
 	auto itr = mDevMap.find(devType);
 	if ( itr != mDevMap.end())
 		mDevMap.erase(itr);
+	auto removeCreator = [&devType](ClaimMap &claims) {
+		for (auto &value : claims) {
+			auto &creators = value.second;
+			creators.erase(std::remove(creators.begin(), creators.end(), devType), creators.end());
+		}
+	};
+	for (auto &property : mPropertyClaims)
+		removeCreator(property.second);
+	removeCreator(mInterfaceClaims);
 }
 
-void DeviceClassFactory::parseDevProps(struct udev_device* device, bool isPowerOnConnect)
+// Only reads the udev device, so it may run on any thread as long as the
+// device belongs to a udev context used by that thread alone. Values are
+// copied from the udev list straight into the block.
+PdmDevPropertyBlockPtr DeviceClassFactory::readDevProps(struct udev_device* device, bool isPowerOnConnect)
 {
-    mDevProMap.clear();
+    PdmDevPropertyBlock::Values values;
+    PdmDevProperty property;
     struct udev_list_entry *list_entry;
     udev_list_entry_foreach(list_entry, udev_device_get_properties_list_entry(device)){
-        std::string name = udev_list_entry_get_name(list_entry);
-        std::string value = udev_list_entry_get_value(list_entry);
-        if(name.compare("ID_MODEL") == 0) {
-            std::replace( value.begin(), value.end(), '_', ' ');
-        }
-        if(name.compare("DEVNAME") == 0){
-           std::string dev = "/dev/";
-           if(value.compare(0,dev.length(),dev) == 0)
-              value.erase(0,dev.length());
-        }
-        PDM_LOG_DEBUG("DeviceClassFactory::parseDevProps - Name: %s Value: %s", name.c_str(), value.c_str());
-        mDevProMap[name] = std::move(value);
-    }
-
-    if(isPowerOnConnect){
-        mDevProMap[PdmDevAttributes::ACTION] = PdmDevAttributes::DEVICE_ADD;
-        mDevProMap[PdmDevAttributes::IS_POWER_ON_CONNECT] = "true";
-    } else {
-        mDevProMap[PdmDevAttributes::IS_POWER_ON_CONNECT] = "false";
+        const char *name = udev_list_entry_get_name(list_entry);
+        const char *value = udev_list_entry_get_value(list_entry);
+        if (!name || !PdmDevPropertyBlock::fromName(name, property))
+            continue;
+        PDM_LOG_DEBUG("DeviceClassFactory::readDevProps - Name: %s Value: %s", name, value ? value : "");
+        values[static_cast<size_t>(property)] = value ? value : "";
     }
+    return std::make_shared<const PdmDevPropertyBlock>(values, isPowerOnConnect);
 }
 
 DeviceClass* DeviceClassFactory::create(struct udev_device* device, bool isPowerOnConnect)
 {
-    PDM_LOG_DEBUG("DeviceClassFactory:%s line: %d mDevMap Siz: %d", __FUNCTION__, __LINE__, mDevMap.size());
-    parseDevProps(device, isPowerOnConnect);
-    PDM_LOG_DEBUG("DeviceClassFactory:%s line: %d mDevMap Siz: %d", __FUNCTION__, __LINE__, mDevMap.size());
-    DeviceClass* subDevClasPtr;
+    return create(readDevProps(device, isPowerOnConnect));
+}
+
+void DeviceClassFactory::addCandidates(const ClaimMap &claims, PdmStringView value, CandidateList &candidates)
+{
+    auto valueItr = claims.find(value.to_string());
+    if (valueItr == claims.end())
+        return;
+    for (auto const& devType : valueItr->second) {
+        auto last = candidates.names.begin() + candidates.count;
+        if (candidates.count < candidates.names.size() &&
+            std::find_if(candidates.names.begin(), last,
+                [&devType](const std::string *name) { return *name == devType; }) == last)
+            candidates.names[candidates.count++] = &devType;
+    }
+}
 
-    PDM_LOG_DEBUG("DeviceClassFactory:%s line: %d mDevMap Siz: %d", __FUNCTION__, __LINE__, mDevMap.size());
+// Looks up the creators claiming the event's properties. Claims on udev
+// properties such as SUBSYSTEM or ID_GAMEPAD take precedence over USB
+// interface classes, which are tried in interface order. Creators claiming
+// the same value are tried in registration order. The creator still
+// applies its full canProcessEvent check and may decline.
+DeviceClass* DeviceClassFactory::dispatch(const PdmDevPropertyBlockPtr &devProps, CandidateList &candidates) const
+{
+    for (auto const& property : mPropertyClaims) {
+        if (devProps->has(property.first))
+            addCandidates(property.second, devProps->get(property.first), candidates);
+    }
+    // ID_USB_INTERFACES is ":ccsspp:ccsspp:", cc being the interface class
+    PdmStringView interfaces = devProps->get(PdmDevProperty::ID_USB_INTERFACES);
+    size_t pos = interfaces.find(':');
+    while (pos != PdmStringView::npos && pos + 2 < interfaces.size()) {
+        if (interfaces[pos + 1] != ':')
+            addCandidates(mInterfaceClaims, interfaces.substr(pos + 1, 2), candidates);
+        pos = interfaces.find(':', pos + 1);
+    }
 
-    for (auto const& dev : mDevMap) {
-        subDevClasPtr = mDevMap[dev.first](mDevProMap);
-        if(subDevClasPtr) {
+    for (size_t i = 0; i < candidates.count; i++) {
+        auto itr = mDevMap.find(*candidates.names[i]);
+        if (itr == mDevMap.end())
+            continue;
+        DeviceClass* subDevClasPtr = itr->second(devProps);
+        if (subDevClasPtr)
             return subDevClasPtr;
-        }
     }
+    return nullptr;
+}
 
-    if (mDevMap.size() > 0) {
-        subDevClasPtr = mDevMap["default"](mDevProMap);
-        PDM_LOG_DEBUG("DeviceClassFactory:%s line: %d mDevMap Siz: %d", __FUNCTION__, __LINE__, mDevMap.size());
+// Falls back to every creator when no claim produced a device class, as
+// claims only narrow the search. Creators already tried by dispatch() are
+// skipped.
+DeviceClass* DeviceClassFactory::probe(const PdmDevPropertyBlockPtr &devProps, const CandidateList &tried) const
+{
+    auto last = tried.names.begin() + tried.count;
+    for (auto const& creator : mDevMap) {
+        if (creator.first == "default" ||
+            std::find_if(tried.names.begin(), last,
+                [&creator](const std::string *name) { return *name == creator.first; }) != last)
+            continue;
+        DeviceClass* subDevClasPtr = creator.second(devProps);
+        if (subDevClasPtr)
+            return subDevClasPtr;
     }
+    return nullptr;
+}
 
-    PDM_LOG_DEBUG("DeviceClassFactory:%s line: %d", __FUNCTION__, __LINE__);
-	return subDevClasPtr;
+DeviceClass* DeviceClassFactory::create(const std::unordered_map<std::string, std::string> &devProps, bool isPowerOnConnect)
+{
+    return create(std::make_shared<const PdmDevPropertyBlock>(devProps, isPowerOnConnect));
 }
 
+DeviceClass* DeviceClassFactory::create(const PdmDevPropertyBlockPtr &devProps)
+{
+    PDM_LOG_DEBUG("DeviceClassFactory:%s line: %d mDevMap Siz: %zu", __FUNCTION__, __LINE__, mDevMap.size());
+    CandidateList candidates;
+    DeviceClass* subDevClasPtr = dispatch(devProps, candidates);
+    if (subDevClasPtr)
+        return subDevClasPtr;
+
+    subDevClasPtr = probe(devProps, candidates);
+    if (subDevClasPtr)
+        return subDevClasPtr;
+
+    auto itr = mDevMap.find("default");
+    if (itr != mDevMap.end()) {
+        subDevClasPtr = itr->second(devProps);
+        PDM_LOG_DEBUG("DeviceClassFactory:%s line: %d default device class", __FUNCTION__, __LINE__);
+    }
+    return subDevClasPtr;
+}
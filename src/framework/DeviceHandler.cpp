@@ -14,6 +14,8 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <chrono>
+
 #include "DeviceHandler.h"
 #include "PdmErrors.h"
 
@@ -31,6 +33,57 @@ void DeviceHandler::commandResponse(CommandResponse *cmdResponse, PdmDevStatus r
     }
 }
 
+bool DeviceHandler::dispatchEvent(DeviceClass* deviceClass)
+{
+    std::unique_lock<std::mutex> lock = lockDeviceList();
+    auto start = std::chrono::steady_clock::now();
+    bool result = HandlerEvent(deviceClass);
+    uint64_t elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    m_invocations.fetch_add(1, std::memory_order_relaxed);
+    if (result)
+        m_claimed.fetch_add(1, std::memory_order_relaxed);
+    m_totalTimeNs.fetch_add(elapsedNs, std::memory_order_relaxed);
+    uint64_t maxTimeNs = m_maxTimeNs.load(std::memory_order_relaxed);
+    while (elapsedNs > maxTimeNs && !m_maxTimeNs.compare_exchange_weak(maxTimeNs, elapsedNs, std::memory_order_relaxed))
+        ;
+    return result;
+}
+
+bool DeviceHandler::dispatchCommand(CommandType *cmdtypes, CommandResponse *cmdResponse)
+{
+    if (m_ownsListLock)
+        return HandlerCommand(cmdtypes, cmdResponse);
+    std::lock_guard<std::mutex> lock(m_eventMtx);
+    return HandlerCommand(cmdtypes, cmdResponse);
+}
+
+bool DeviceHandler::dispatchPluginEvent(int eventType)
+{
+    if (m_ownsListLock)
+        return HandlePluginEvent(eventType);
+    std::lock_guard<std::mutex> lock(m_eventMtx);
+    return HandlePluginEvent(eventType);
+}
+
+std::unique_lock<std::mutex> DeviceHandler::lockDeviceList()
+{
+    if (m_ownsListLock)
+        return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(m_eventMtx);
+}
+
+DeviceHandlerStats DeviceHandler::getEventStats() const
+{
+    DeviceHandlerStats stats;
+    stats.invocations = m_invocations.load(std::memory_order_relaxed);
+    stats.claimed = m_claimed.load(std::memory_order_relaxed);
+    stats.skipped = m_skipped.load(std::memory_order_relaxed);
+    stats.totalTimeNs = m_totalTimeNs.load(std::memory_order_relaxed);
+    stats.maxTimeNs = m_maxTimeNs.load(std::memory_order_relaxed);
+    return stats;
+}
+
 bool DeviceHandler::HandlePluginEvent(int eventType) {
     return true;
 }
@@ -19,6 +19,8 @@
 #include "Device.h"
 #include "DeviceHandler.h"
 #include "PdmDeviceFactory.h"
+#include "PdmLatencyStats.h"
+#include "PdmPayloadCache.h"
 #include "PdmUtils.h"
 #include "DeviceManager.h"
 #include "StorageDeviceHandler.h"
@@ -73,16 +75,23 @@ bool DeviceManager::createPdmdeviceList() {
 
 bool DeviceManager::HandlePdmDevice(DeviceClass *devClassPtr)
 {
+    PdmLatencyStats::StageTimer handlerTimer(PdmLatencyStage::HANDLER);
+    handlerTimer.start();
     if (!(devClassPtr->getIdBlackList()).empty() && std::stoi(devClassPtr->getIdBlackList(),nullptr)) {
         PDM_LOG_DEBUG("Blacklist device detected");
         BlackListDeviceHandler blackListDeviceHandler(devClassPtr);
         return true;
     }
     
-    PDM_LOG_DEBUG("DeviceManager:%s line: %d", __FUNCTION__, __LINE__);
+    uint32_t eventMask = getEventMask(devClassPtr);
+    PDM_LOG_DEBUG("DeviceManager:%s line: %d eventMask: 0x%x", __FUNCTION__, __LINE__, eventMask);
     for(auto handler : mHandlerList)
     {
-        bool result = handler->HandlerEvent(devClassPtr);
+        if ((handler->getEventMask() & eventMask) == PDM_EVENT_NONE) {
+            handler->countSkippedEvent();
+            continue;
+        }
+        bool result = handler->dispatchEvent(devClassPtr);
         if(devClassPtr->getDevType() ==  "usb_device")
             continue;
         if(result)
@@ -91,10 +100,71 @@ bool DeviceManager::HandlePdmDevice(DeviceClass *devClassPtr)
 	return false;
 }
 
+uint32_t DeviceManager::getEventMask(DeviceClass *devClassPtr)
+{
+    // Handlers look for their device in their own list on remove, and the
+    // properties of a remove event are not reliable enough to route on
+    if (devClassPtr->getDeviceAction() == USB_DEV_REMOVE)
+        return PDM_EVENT_ALL;
+
+    uint32_t eventMask = PDM_EVENT_NONE;
+    PdmStringView subsystem = devClassPtr->getProperty(PdmDevProperty::SUBSYSTEM);
+    if (subsystem == "sound")
+        eventMask |= PDM_EVENT_SUBSYSTEM_SOUND;
+    else if (subsystem == "rfkill")
+        eventMask |= PDM_EVENT_SUBSYSTEM_RFKILL;
+
+    // ID_USB_INTERFACES is ":ccsspp:ccsspp:", cc being the interface class
+    PdmStringView interfaces = devClassPtr->getProperty(PdmDevProperty::ID_USB_INTERFACES);
+    size_t pos = interfaces.find(':');
+    while (pos != PdmStringView::npos && pos + 2 < interfaces.size()) {
+        PdmStringView interfaceClass = interfaces.substr(pos + 1, 2);
+        if (interfaceClass == "01")
+            eventMask |= PDM_EVENT_IFC_AUDIO;
+        else if (interfaceClass == "02")
+            eventMask |= PDM_EVENT_IFC_CDC;
+        else if (interfaceClass == "03")
+            eventMask |= PDM_EVENT_IFC_HID;
+        else if (interfaceClass == "06")
+            eventMask |= PDM_EVENT_IFC_IMAGE;
+        else if (interfaceClass == "08")
+            eventMask |= PDM_EVENT_IFC_STORAGE;
+        else if (interfaceClass == "0b")
+            eventMask |= PDM_EVENT_IFC_SMARTCARD;
+        else if (interfaceClass == "0e")
+            eventMask |= PDM_EVENT_IFC_VIDEO;
+        else if (interfaceClass == "ff")
+            eventMask |= PDM_EVENT_IFC_VENDOR;
+        pos = interfaces.find(':', pos + 1);
+    }
+
+    if (!devClassPtr->getProperty(PdmDevProperty::ID_ATA).empty())
+        eventMask |= PDM_EVENT_PROP_ATA;
+    if (!devClassPtr->getProperty(PdmDevProperty::ID_GAMEPAD).empty())
+        eventMask |= PDM_EVENT_PROP_GAMEPAD;
+    if (!devClassPtr->getProperty(PdmDevProperty::ID_BLUETOOTH).empty())
+        eventMask |= PDM_EVENT_PROP_BLUETOOTH;
+    if (!devClassPtr->getProperty(PdmDevProperty::ID_MEDIA_PLAYER).empty())
+        eventMask |= PDM_EVENT_PROP_MEDIA_PLAYER;
+    if (!devClassPtr->getProperty(PdmDevProperty::ID_USB_SERIAL).empty())
+        eventMask |= PDM_EVENT_PROP_USB_SERIAL;
+    if (!devClassPtr->getProperty(PdmDevProperty::ID_USB_MODEM_DONGLE).empty())
+        eventMask |= PDM_EVENT_PROP_MODEM_DONGLE;
+    return eventMask;
+}
+
+std::list<std::pair<std::string, DeviceHandlerStats>> DeviceManager::getHandlerStats()
+{
+    std::list<std::pair<std::string, DeviceHandlerStats>> handlerStats;
+    for (auto handler : mHandlerList)
+        handlerStats.push_back(std::make_pair(handler->getHandlerName(), handler->getEventStats()));
+    return handlerStats;
+}
+
 bool DeviceManager::HandlePdmCommand(CommandType *cmdtypes, CommandResponse *cmdResponse){
     for(auto handler : mHandlerList)
     {
-        if(handler->HandlerCommand(cmdtypes, cmdResponse))
+        if(handler->dispatchCommand(cmdtypes, cmdResponse))
             return true;
     }
 
@@ -108,8 +178,10 @@ std::list<DeviceHandler*> DeviceManager::getDeviceHandlerList() {
 bool DeviceManager::HandlePluginEvent(int eventType) {
     bool result = true;
     for(auto handler : mHandlerList) {
-        if(handler->HandlePluginEvent(eventType) ==  false)
+        if(handler->dispatchPluginEvent(eventType) ==  false)
             result = false;
     }
+    // Power status and mounts change without a device event
+    PdmPayloadCache::getInstance().invalidateAll();
     return result;
 }
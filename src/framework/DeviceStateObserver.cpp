@@ -15,22 +15,52 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "DeviceStateObserver.h"
+#include "PdmLatencyStats.h"
+#include "PdmObserverBus.h"
+#include "PdmPayloadCache.h"
 
 void DeviceStateObserver::Register(IObserver* observer) {
-    if(observer)
+    if(observer) {
+        std::lock_guard<std::mutex> lock(_observersMtx);
         _observers->push_front(observer);
+    }
 }
 
 void DeviceStateObserver::Unregister(IObserver* observer) {
 
-    if(observer)
+    if(observer) {
+        std::lock_guard<std::mutex> lock(_observersMtx);
         _observers->remove(observer);
+    }
 
 }
 
 void DeviceStateObserver::Notify(const int &eventDeviceType, const int &eventID, IDevice* device) {
-    for (std::list<IObserver*>::iterator it = _observers->begin(); it != _observers->end(); it++)
+    PdmLatencyStats::StageTimer notifyTimer(PdmLatencyStage::NOTIFY);
+    notifyTimer.start();
+    // Before any observer can ask for a payload listing the device
+    PdmPayloadCache::getInstance().invalidate(eventDeviceType);
+    std::list<IObserver*> observers;
+    {
+        std::lock_guard<std::mutex> lock(_observersMtx);
+        observers = *_observers;
+    }
+    PdmObserverBus &bus = PdmObserverBus::getInstance();
+    // May still change the device, so before the record below is taken
+    for (auto observer : observers)
+        bus.updateLive(observer, eventDeviceType, eventID, device);
+    // Observers attached to the bus get one shared record of the event later,
+    // the others are called right away
+    std::shared_ptr<const PdmDeviceEvent> event;
+    for (std::list<IObserver*>::iterator it = observers.begin(); it != observers.end(); it++) {
+        if (bus.isAttached(*it)) {
+            if (!event)
+                event = std::make_shared<const PdmDeviceEvent>(eventDeviceType, eventID, device);
+            if (bus.post(*it, event))
+                continue;
+        }
         (*it)->update(eventDeviceType,eventID,device);
+    }
 }
 
 DeviceStateObserver::DeviceStateObserver() {
@@ -41,11 +71,15 @@ DeviceStateObserver::DeviceStateObserver() {
 
 DeviceStateObserver::DeviceStateObserver(const DeviceStateObserver& obj) {
     _observers = new std::list<IObserver*>();
+    std::lock_guard<std::mutex> lock(obj._observersMtx);
     *_observers = *obj._observers;
 }
 
 DeviceStateObserver& DeviceStateObserver::operator=(const DeviceStateObserver& obj) {
     if ( this != &obj) {
+        std::lock(_observersMtx, obj._observersMtx);
+        std::lock_guard<std::mutex> lock(_observersMtx, std::adopt_lock);
+        std::lock_guard<std::mutex> objLock(obj._observersMtx, std::adopt_lock);
         *_observers = *obj._observers;
     }
     return *this;
@@ -20,6 +20,7 @@
 #include "DeviceManager.h"
 #include "PdmLogUtils.h"
 #include "LunaIPC.h"
+#include "PdmObserverBus.h"
 
 using namespace PdmDevAttributes;
 
@@ -30,6 +31,7 @@ DeviceTracker::DeviceTracker(PluginAdapter* const pluginAdapter)
 
 DeviceTracker::~DeviceTracker()
 {
+    PdmObserverBus::getInstance().detach(this);
     std::list<DeviceHandler*> pDeviceHandlerList = DeviceManager::getInstance()->getDeviceHandlerList();
 
     for(auto handler : pDeviceHandlerList)
@@ -43,19 +45,40 @@ void DeviceTracker::RegisterCallback(lunaCb func)
 
 void DeviceTracker::attachObservers()
 {
+    // The plugin runs on the notifying thread, the Luna replies on the main
+    // loop. Device-less events only make the subscribers refresh their
+    // lists, repeated ones are merged.
+    PdmObserverPolicy policy;
+    policy.name = "DeviceTracker";
+    policy.queueLimit = PDM_DEVICE_TRACKER_QUEUE_LIMIT;
+    policy.canMerge = [](const PdmDeviceEvent &waiting, const PdmDeviceEvent &event) {
+        return !waiting.device && !event.device && (waiting.eventID == event.eventID) &&
+               (waiting.eventDeviceType == event.eventDeviceType);
+    };
+    policy.updateLive = [this](int eventDeviceType, int eventID, IDevice *device) {
+        notifyPlugin(eventID, device);
+    };
+    PdmObserverBus::getInstance().attach(this, policy);
+
     std::list<DeviceHandler*> pDeviceHandlerList = DeviceManager::getInstance()->getDeviceHandlerList();
 
     for(auto handler : pDeviceHandlerList)
         handler->Register(this);
 }
 
+// Plugins may change the device through IDevice, e.g. setDeviceType(), so
+// they get the live device and not the copy update() runs with
+void DeviceTracker::notifyPlugin(const int &eventID, IDevice* device)
+{
+    m_pluginAdapter->notifyChange(PdmEvent, eventID, device);
+}
+
 void DeviceTracker::update(const int &eventDeviceType, const int &eventID, IDevice* device)
 {
     unsigned int eventType = UNKNOWN_DEVICE;
     std::string hubPortPath;
     PDM_LOG_DEBUG("DeviceTracker::update -  Event: %d eventID: %d", eventDeviceType, eventID);
 
-    m_pluginAdapter->notifyChange(PdmEvent, eventID, device);
 #ifdef WEBOS_SESSION
     if(device) {
         if (!device->getHubPortNumber().empty()) {
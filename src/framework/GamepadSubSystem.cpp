@@ -24,19 +24,17 @@ using namespace PdmDevAttributes;
 
 bool GamepadSubSystem::mIsObjRegistered = GamepadSubSystem::RegisterSubSystem();
 
-GamepadSubSystem::GamepadSubSystem(std::unordered_map<std::string, std::string>& devPropMap)
-	: mDevType("gamepad"), DeviceClass(devPropMap)
+GamepadSubSystem::GamepadSubSystem(const PdmDevPropertyBlockPtr &devProps)
+	: DeviceClass(devProps), mDevType("gamepad")
 {
-	for (auto &prop : devPropMap)
-		mDevPropMap[prop.first] = prop.second;
 }
 
 GamepadSubSystem::~GamepadSubSystem() {}
 
-GamepadSubSystem *GamepadSubSystem::create(std::unordered_map<std::string, std::string> &devProMap)
+GamepadSubSystem *GamepadSubSystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
     PDM_LOG_DEBUG("GamepadSubSystem:%s line: %d", __FUNCTION__, __LINE__);
-    bool canProcessEve = GamepadSubSystem::canProcessEvent(devProMap);
+    bool canProcessEve = GamepadSubSystem::canProcessEvent(*devProMap);
 
     if (!canProcessEve)
         return nullptr;
@@ -48,5 +46,5 @@ GamepadSubSystem *GamepadSubSystem::create(std::unordered_map<std::string, std::
 
 std::string GamepadSubSystem::getGamepadId()
 {
-    return mDevPropMap[ID_GAMEPAD];
+    return getPropertyString(PdmDevProperty::ID_GAMEPAD);
 }
\ No newline at end of file
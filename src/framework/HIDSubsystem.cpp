@@ -23,18 +23,16 @@
 using namespace PdmDevAttributes;
 bool HIDSubsystem::mIsObjRegistered = HIDSubsystem::RegisterSubSystem();
 
-HIDSubsystem::HIDSubsystem(std::unordered_map<std::string, std::string>& devPropMap)
-	: mDevType("input"), DeviceClass(devPropMap)
+HIDSubsystem::HIDSubsystem(const PdmDevPropertyBlockPtr &devProps)
+	: DeviceClass(devProps), mDevType("input")
 {
-	for (auto &prop : devPropMap)
-		mDevPropMap[prop.first] = prop.second;
 }
 
 HIDSubsystem::~HIDSubsystem() {}
 
-HIDSubsystem *HIDSubsystem::create(std::unordered_map<std::string, std::string> &devProMap)
+HIDSubsystem *HIDSubsystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
-    bool canProcessEve = HIDSubsystem::canProcessEvent(devProMap);
+    bool canProcessEve = HIDSubsystem::canProcessEvent(*devProMap);
 
     if (!canProcessEve)
         return nullptr;
@@ -46,5 +44,5 @@ HIDSubsystem *HIDSubsystem::create(std::unordered_map<std::string, std::string>
 
 std::string HIDSubsystem::getProcessed()
 {
-    return mDevPropMap[PROCESSED];
+    return getPropertyString(PdmDevProperty::PROCESSED);
 }
@@ -23,18 +23,16 @@ using namespace PdmDevAttributes;
 
 bool MTPSubsystem::mIsObjRegistered = MTPSubsystem::RegisterSubSystem();
 
-MTPSubsystem::MTPSubsystem(std::unordered_map<std::string, std::string>& devPropMap)
-	: mDevType("mtp"), DeviceClass(devPropMap)
+MTPSubsystem::MTPSubsystem(const PdmDevPropertyBlockPtr &devProps)
+	: DeviceClass(devProps), mDevType("mtp")
 {
-	for (auto &prop : devPropMap)
-		mDevPropMap[prop.first] = prop.second;
 }
 
 MTPSubsystem::~MTPSubsystem() {}
 
-MTPSubsystem *MTPSubsystem::create(std::unordered_map<std::string, std::string> &devProMap)
+MTPSubsystem *MTPSubsystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
-    bool canProcessEve = MTPSubsystem::canProcessEvent(devProMap);
+    bool canProcessEve = MTPSubsystem::canProcessEvent(*devProMap);
 
     if (!canProcessEve)
         return nullptr;
@@ -46,5 +44,5 @@ MTPSubsystem *MTPSubsystem::create(std::unordered_map<std::string, std::string>
 
 std::string MTPSubsystem::getDevLinks()
 {
-    return mDevPropMap[DEVLINKS];
+    return getPropertyString(PdmDevProperty::DEVLINKS);
 }
\ No newline at end of file
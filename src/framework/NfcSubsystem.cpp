@@ -24,18 +24,16 @@ using namespace PdmDevAttributes;
 
 bool NfcSubsystem::mIsObjRegistered = NfcSubsystem::RegisterSubSystem();
 
-NfcSubsystem::NfcSubsystem(std::unordered_map<std::string, std::string> &devPropMap)
-    : mDevType("nfc"), DeviceClass(devPropMap)
+NfcSubsystem::NfcSubsystem(const PdmDevPropertyBlockPtr &devProps)
+    : DeviceClass(devProps), mDevType("nfc")
 {
-    for (auto &prop : devPropMap)
-        mDevPropMap[prop.first] = prop.second;
 }
 
 NfcSubsystem::~NfcSubsystem() {}
 
-NfcSubsystem *NfcSubsystem::create(std::unordered_map<std::string, std::string> &devProMap)
+NfcSubsystem *NfcSubsystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
-    bool canProcessEve = NfcSubsystem::canProcessEvent(devProMap);
+    bool canProcessEve = NfcSubsystem::canProcessEvent(*devProMap);
 
     if (!canProcessEve)
         return nullptr;
@@ -24,18 +24,16 @@ using namespace PdmDevAttributes;
 
 bool PTPSubsystem::mIsObjRegistered = PTPSubsystem::RegisterSubSystem();
 
-PTPSubsystem::PTPSubsystem(std::unordered_map<std::string, std::string> &devPropMap)
-    : mDevType("ptp"), DeviceClass(devPropMap)
+PTPSubsystem::PTPSubsystem(const PdmDevPropertyBlockPtr &devProps)
+    : DeviceClass(devProps), mDevType("ptp")
 {
-    for (auto &prop : devPropMap)
-        mDevPropMap[prop.first] = prop.second;
 }
 
 PTPSubsystem::~PTPSubsystem() {}
 
-PTPSubsystem *PTPSubsystem::create(std::unordered_map<std::string, std::string> &devProMap)
+PTPSubsystem *PTPSubsystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
-    bool canProcessEve = PTPSubsystem::canProcessEvent(devProMap);
+    bool canProcessEve = PTPSubsystem::canProcessEvent(*devProMap);
 
     if (!canProcessEve)
         return nullptr;
@@ -47,5 +45,5 @@ PTPSubsystem *PTPSubsystem::create(std::unordered_map<std::string, std::string>
 
 std::string PTPSubsystem::getBusNum()
 {
-	return mDevPropMap[BUSNUM];
+	return getPropertyString(PdmDevProperty::BUSNUM);
 }
\ No newline at end of file
@@ -33,6 +33,24 @@ void PdmCommand::execute() {
     m_cmdCallBack(&cmdResponse,m_message);
 }
 
+CommandLane PdmCommand::getLane() const {
+    if(!m_cmdType)
+        return CommandLane::QUERY;
+
+    switch(m_cmdType->commandId)
+    {
+        case FORMAT:
+        case EJECT:
+        case FSCK:
+        case SET_VOLUME_LABEL:
+        case UMOUNT_ALL_DRIVE:
+        case MOUNT_FSCK:
+            return CommandLane::STORAGE_JOB;
+        default:
+            return CommandLane::QUERY;
+    }
+}
+
 PdmCommand::~PdmCommand(){
     PDM_LOG_DEBUG("PdmCommand:%s line: %d", __FUNCTION__, __LINE__);
     if(m_cmdType)
@@ -0,0 +1,191 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <algorithm>
+#include <cstring>
+#include "Common.h"
+#include "PdmDevPropertyBlock.h"
+
+namespace {
+    // Indexed by PdmDevProperty
+    const char* const sPropertyNames[] = {
+        "ACTION",
+        "SUBSYSTEM",
+        "DEVTYPE",
+        "DEVPATH",
+        "DEVNAME",
+        "DEVNUM",
+        "BUSNUM",
+        "DEVLINKS",
+        "SPEED",
+        "isPowerOnConnect",
+        "ID_USB_INTERFACES",
+        "ID_USB_DRIVER",
+        "ID_SERIAL_SHORT",
+        "ID_MODEL",
+        "ID_MODEL_ID",
+        "ID_VENDOR",
+        "ID_VENDOR_ID",
+        "ID_PRODUCT_ID",
+        "ID_VENDOR_FROM_DATABASE",
+        "ID_MEDIA_PLAYER",
+        "ID_BLACKLIST",
+        "ID_BLACK_LISTED_SUPER_SPEED_DEVICE",
+        "ID_FS_TYPE",
+        "ID_FS_UUID",
+        "ID_FS_LABEL_ENC",
+        "ID_INSTANCE",
+        "ID_ATA",
+        "CARD_READER",
+        "HARD_DISK",
+        "READ_ONLY",
+        "DISK_MEDIA_CHANGE",
+        "ID_GAMEPAD",
+        "ID_BLUETOOTH",
+        "ID_USB_SERIAL",
+        "ID_USB_MODEM_DONGLE",
+        "USB_SERIAL_SUB_TYPE",
+        "NET_IFIINDEX",
+        "NET_LINK_MODE",
+        "NET_DUPLEX",
+        "NET_ADDRESS",
+        "NET_OPERSTATE",
+        "PROCESSED",
+        "CARD_ID",
+        "CARD_NAME",
+        "CARD_NUMBER",
+        "ID_V4L_CAPABILITIES",
+        "ID_V4L_PRODUCT",
+        "ID_V4L_VERSION",
+        "USB_PORT",
+        "RFKILL_NAME"
+    };
+
+    static_assert(sizeof(sPropertyNames) / sizeof(sPropertyNames[0]) == static_cast<size_t>(PdmDevProperty::COUNT),
+                  "sPropertyNames must name every PdmDevProperty");
+
+    // Keyed by views of sPropertyNames, so looking up a udev name never allocates
+    const std::unordered_map<PdmStringView, PdmDevProperty>& propertyIds()
+    {
+        static const std::unordered_map<PdmStringView, PdmDevProperty> ids = []() {
+            std::unordered_map<PdmStringView, PdmDevProperty> map;
+            for (size_t i = 0; i < static_cast<size_t>(PdmDevProperty::COUNT); i++)
+                map.emplace(sPropertyNames[i], static_cast<PdmDevProperty>(i));
+            return map;
+        }();
+        return ids;
+    }
+
+    PdmDevPropertyBlock::Values getMapValues(const std::unordered_map<std::string, std::string> &devProps)
+    {
+        PdmDevPropertyBlock::Values values;
+        PdmDevProperty property;
+        for (auto const& prop : devProps) {
+            if (PdmDevPropertyBlock::fromName(prop.first, property))
+                values[static_cast<size_t>(property)] = prop.second;
+        }
+        return values;
+    }
+}
+
+PdmDevPropertyBlock::PdmDevPropertyBlock(const std::unordered_map<std::string, std::string> &devProps, bool isPowerOnConnect)
+    : PdmDevPropertyBlock(getMapValues(devProps), isPowerOnConnect)
+{
+}
+
+PdmDevPropertyBlock::PdmDevPropertyBlock(const Values &devValues, bool isPowerOnConnect)
+{
+    static const PdmStringView sDevPrefix("/dev/");
+
+    Values values = devValues;
+    if (isPowerOnConnect)
+        values[static_cast<size_t>(PdmDevProperty::ACTION)] = PdmDevAttributes::DEVICE_ADD;
+    values[static_cast<size_t>(PdmDevProperty::IS_POWER_ON_CONNECT)] = isPowerOnConnect ? "true" : "false";
+    PdmStringView &devName = values[static_cast<size_t>(PdmDevProperty::DEVNAME)];
+    if (devName.substr(0, sDevPrefix.length()) == sDevPrefix)
+        devName.remove_prefix(sDevPrefix.length());
+
+    size_t arenaSize = 0;
+    for (auto const& value : values)
+        arenaSize += value.length();
+    m_arena.reset(new char[arenaSize ? arenaSize : 1]);
+
+    uint32_t offset = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        if (values[i].data() == nullptr) {
+            m_slots[i] = {ABSENT, 0};
+            continue;
+        }
+        uint32_t length = static_cast<uint32_t>(values[i].length());
+        std::memcpy(m_arena.get() + offset, values[i].data(), length);
+        m_slots[i] = {offset, length};
+        offset += length;
+    }
+    const Slot &model = m_slots[static_cast<size_t>(PdmDevProperty::ID_MODEL)];
+    if (model.offset != ABSENT)
+        std::replace(m_arena.get() + model.offset, m_arena.get() + model.offset + model.length, '_', ' ');
+    m_action = parseAction(get(PdmDevProperty::ACTION));
+}
+
+PdmStringView PdmDevPropertyBlock::get(PdmDevProperty property) const
+{
+    const Slot &slot = m_slots[static_cast<size_t>(property)];
+    if (slot.offset == ABSENT)
+        return PdmStringView();
+    return PdmStringView(m_arena.get() + slot.offset, slot.length);
+}
+
+bool PdmDevPropertyBlock::has(PdmDevProperty property) const
+{
+    return m_slots[static_cast<size_t>(property)].offset != ABSENT;
+}
+
+PdmDevPropertyBlock::Values PdmDevPropertyBlock::getValues() const
+{
+    Values values;
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = get(static_cast<PdmDevProperty>(i));
+    return values;
+}
+
+bool PdmDevPropertyBlock::fromName(PdmStringView name, PdmDevProperty &property)
+{
+    auto const& ids = propertyIds();
+    auto itr = ids.find(name);
+    if (itr == ids.end())
+        return false;
+    property = itr->second;
+    return true;
+}
+
+const char* PdmDevPropertyBlock::getName(PdmDevProperty property)
+{
+    if (property >= PdmDevProperty::COUNT)
+        return "";
+    return sPropertyNames[static_cast<size_t>(property)];
+}
+
+DeviceActions PdmDevPropertyBlock::parseAction(PdmStringView action)
+{
+    if (action == "add")
+        return USB_DEV_ADD;
+    if (action == "remove")
+        return USB_DEV_REMOVE;
+    if (action == "change")
+        return USB_DEV_CHANGE;
+    return USB_DEV_UNKNOWN;
+}
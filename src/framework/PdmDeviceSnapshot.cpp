@@ -0,0 +1,85 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "Common.h"
+#include "DiskPartitionInfo.h"
+#include "MTPDevice.h"
+#include "PdmDeviceSnapshot.h"
+#include "PdmLogUtils.h"
+#include "StorageDevice.h"
+
+using namespace PdmDevAttributes;
+
+PdmDeviceSnapshot::PdmDeviceSnapshot(IDevice *device)
+    : m_kind(DEVICE)
+    , m_usbPortNum(device->getUsbPortNumber())
+    , m_deviceNum(device->getDeviceNum())
+    , m_usbPortSpeed(device->getPortSpeed())
+    , m_busNum(device->getBusNumber())
+    , m_isPowerOnConnect(device->isConnectedToPower())
+    , m_isToastRequired(device->canDisplayToast())
+    , m_driveSize(0)
+    , m_deviceStatus(device->getDeviceStatus())
+    , m_deviceType(device->getDeviceType())
+    , m_errorReason(device->getErrorReason())
+    , m_vendorName(device->getVendorName())
+    , m_productName(device->getProductName())
+    , m_serialNumber(device->getSerialNumber())
+    , m_devSpeed(device->getDevSpeed())
+    , m_devicePath(device->getDevicePath())
+    , m_deviceSubType(device->getDeviceSubType())
+    , m_deviceName(device->getDeviceName())
+#ifdef WEBOS_SESSION
+    , m_devPath(device->getDevPath())
+    , m_hubPortNumber(device->getHubPortNumber())
+    , m_vendorID(device->getVendorID())
+    , m_productID(device->getProductID())
+    , m_deviceSetId(device->getDeviceSetId())
+#endif
+{
+    Storage *storage = dynamic_cast<Storage*>(device);
+    if (!storage)
+        return;
+
+    m_driveName = storage->getDriveName();
+    m_driveSize = storage->getDriveSize();
+    if (dynamic_cast<StorageDevice*>(device))
+        m_kind = STORAGE_DEVICE;
+    else if (dynamic_cast<MTPDevice*>(device))
+        m_kind = MTP_DEVICE;
+    else if (dynamic_cast<DiskPartitionInfo*>(device))
+        m_kind = PARTITION;
+}
+
+void PdmDeviceSnapshot::setDeviceType(std::string devType)
+{
+    PDM_LOG_WARNING("PdmDeviceSnapshot:%s line: %d read-only copy of %s, device type %s ignored", __FUNCTION__, __LINE__, m_deviceName.c_str(), devType.c_str());
+}
+
+std::string PdmDeviceSnapshot::getDeviceSpeed(int speed) const
+{
+    switch(speed){
+        case SUPER:
+            return USB_SUPER_SPEED;
+        case HIGH:
+            return USB_HIGH_SPEED;
+        case FULL:
+            return USB_FULL_SPEED;
+        default:
+            return USB_LOW_SPEED;
+    }
+}
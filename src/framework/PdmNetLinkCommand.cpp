@@ -21,6 +21,8 @@
 PdmNetLinkCommand::PdmNetLinkCommand(DeviceClass *deviceClassEvent)
 {
     m_deviceClassEvent = deviceClassEvent;
+    if (m_deviceClassEvent)
+        m_orderingKey = m_deviceClassEvent->getUsbDevicePath();
 }
 
 PdmNetLinkCommand::~PdmNetLinkCommand()
@@ -30,6 +32,11 @@ PdmNetLinkCommand::~PdmNetLinkCommand()
     m_deviceClassEvent = nullptr;
 }
 
+std::string PdmNetLinkCommand::getOrderingKey() const
+{
+    return m_orderingKey;
+}
+
 void PdmNetLinkCommand::execute()
 {
     if (m_deviceClassEvent) {
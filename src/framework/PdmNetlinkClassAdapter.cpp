@@ -19,6 +19,8 @@
 #include "DeviceClass.h"
 #include "DeviceClassCommand.h"
 #include "DeviceClassFactory.h"
+#include "PdmBlockTopology.h"
+#include "PdmUeventRecorder.h"
 
 PdmNetlinkClassAdapter::PdmNetlinkClassAdapter() : mCmdManager(nullptr) {}
 
@@ -37,20 +39,23 @@ void PdmNetlinkClassAdapter::setCommandManager(CommandManager* cmdMgr)
 
 void PdmNetlinkClassAdapter::handleEvent(struct udev_device* device, bool isPowerOnConnect)
 {
-    PDM_LOG_DEBUG("PdmNetlinkClassAdapter:%s line: %d", __FUNCTION__, __LINE__);
-    DeviceClass* devClasPtr;
+    handleEvent(DeviceClassFactory::readDevProps(device, isPowerOnConnect));
+}
 
-    if(isPowerOnConnect){
-        PDM_LOG_DEBUG("PdmNetlinkClassAdapter:%s line: %d", __FUNCTION__, __LINE__);
-        devClasPtr = DeviceClassFactory::getInstance().create(device, true);
-    } else {
-        PDM_LOG_DEBUG("PdmNetlinkClassAdapter:%s line: %d", __FUNCTION__, __LINE__);
-        devClasPtr = DeviceClassFactory::getInstance().create(device, false);
-    }
+void PdmNetlinkClassAdapter::handleEvent(const PdmDevPropertyBlockPtr &devProps, std::chrono::steady_clock::time_point receiveTime)
+{
+    PDM_LOG_DEBUG("PdmNetlinkClassAdapter:%s line: %d", __FUNCTION__, __LINE__);
+    PdmUeventRecorder::getInstance().record(*devProps);
+    if (devProps->get(PdmDevProperty::SUBSYSTEM) == "block")
+        PdmBlockTopology::getInstance().invalidate(devProps->get(PdmDevProperty::DEVNAME).to_string());
+    sendDeviceClass(DeviceClassFactory::getInstance().create(devProps), receiveTime);
+}
 
+void PdmNetlinkClassAdapter::sendDeviceClass(DeviceClass* devClasPtr, std::chrono::steady_clock::time_point receiveTime)
+{
     if (mCmdManager && devClasPtr) {
         PDM_LOG_DEBUG("PdmNetlinkClassAdapter:%s line: %d", __FUNCTION__, __LINE__);
-        DeviceClassCommand *devClassCmd = new (std::nothrow) DeviceClassCommand(devClasPtr);
+        DeviceClassCommand *devClassCmd = new (std::nothrow) DeviceClassCommand(devClasPtr, receiveTime);
         mCmdManager->sendCommand(devClassCmd);
     }
     PDM_LOG_DEBUG("PdmNetlinkClassAdapter:%s line: %d", __FUNCTION__, __LINE__);
@@ -17,10 +17,15 @@
 #include "PdmNetlinkHandler.h"
 #include "DeviceManager.h"
 #include "PdmNetLinkCommand.h"
+#include "PdmUeventRecorder.h"
 
-PdmNetlinkHandler::PdmNetlinkHandler(CommandManager *cmdManager)
+#define PDM_UEVENT_COALESCING_WINDOW_MS 20
+#define PDM_UEVENT_RECEIVE_BUFFER_SIZE (4 * 1024 * 1024)
+
+PdmNetlinkHandler::PdmNetlinkHandler(CommandManager *cmdManager, PdmConfig *pConfObj)
 {
     m_commandManager = cmdManager;
+    m_pConfObj = pConfObj;
 }
 
 PdmNetlinkHandler::~PdmNetlinkHandler()
@@ -31,13 +36,72 @@ PdmNetlinkHandler::~PdmNetlinkHandler()
 bool PdmNetlinkHandler::start()
 {
     PDM_LOG_DEBUG("PdmNetlinkHandler:%s line: %d", __FUNCTION__, __LINE__);
+    this->setCoalescingWindow(readCoalescingWindow());
+    this->setReceiveBufferSize(readReceiveBufferSize());
+    std::string recordFile = readUeventRecordFile();
+    if (!recordFile.empty())
+        PdmUeventRecorder::getInstance().open(recordFile);
     return this->startListener();
 }
 
 bool PdmNetlinkHandler::stop()
 {
     PDM_LOG_DEBUG("PdmNetlinkHandler:%s line: %d", __FUNCTION__, __LINE__);
-    return this->stopListener();
+    bool result = this->stopListener();
+    PdmUeventRecorder::getInstance().close();
+    return result;
+}
+
+int PdmNetlinkHandler::readCoalescingWindow()
+{
+    int windowMs = PDM_UEVENT_COALESCING_WINDOW_MS;
+    if(!m_pConfObj)
+        return windowMs;
+
+    pbnjson::JValue windowConfVal = pbnjson::JValue();
+    PdmConfigStatus confErrCode = m_pConfObj->getValue("Common","UeventCoalescingWindowMs",windowConfVal);
+    if(confErrCode != PdmConfigStatus::PDM_CONFIG_ERROR_NONE)
+    {
+        PdmErrors::logPdmErrorCodeAndText(confErrCode);
+        return windowMs;
+    }
+    if (windowConfVal.isNumber())
+        windowMs = windowConfVal.asNumber<int>();
+
+    return windowMs;
+}
+
+int PdmNetlinkHandler::readReceiveBufferSize()
+{
+    int bufferSize = PDM_UEVENT_RECEIVE_BUFFER_SIZE;
+    if(!m_pConfObj)
+        return bufferSize;
+
+    pbnjson::JValue bufferConfVal = pbnjson::JValue();
+    PdmConfigStatus confErrCode = m_pConfObj->getValue("Common","UeventReceiveBufferSize",bufferConfVal);
+    if(confErrCode != PdmConfigStatus::PDM_CONFIG_ERROR_NONE)
+    {
+        PdmErrors::logPdmErrorCodeAndText(confErrCode);
+        return bufferSize;
+    }
+    if (bufferConfVal.isNumber())
+        bufferSize = bufferConfVal.asNumber<int>();
+
+    return bufferSize;
+}
+
+// Trace file for pdm-uevent-replay, recording is off when not configured
+std::string PdmNetlinkHandler::readUeventRecordFile()
+{
+    if(!m_pConfObj)
+        return std::string();
+
+    pbnjson::JValue recordConfVal = pbnjson::JValue();
+    PdmConfigStatus confErrCode = m_pConfObj->getValue("Common","UeventRecordFile",recordConfVal);
+    if(confErrCode != PdmConfigStatus::PDM_CONFIG_ERROR_NONE || !recordConfVal.isString())
+        return std::string();
+
+    return recordConfVal.asString();
 }
 
 void PdmNetlinkHandler::onEvent(DeviceClass *deviceClassEvent)
@@ -15,25 +15,146 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <libudev.h>
+#include <errno.h>
 #include <stdarg.h>
 #include <sys/epoll.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include "Common.h"
+#include "DeviceClassFactory.h"
 #include "PdmNetlinkListener.h"
 #include "PdmLogUtils.h"
 #include "PdmNetlinkClassAdapter.h"
+#include "PdmStartupMetrics.h"
 
 #define memzero(x,l) (std::memset((x), 0, (l)))
 #define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
-#define SUBSYSTEM "usb"
+#define USB_SUBSYSTEM "usb"
+#define PDM_ENUMERATION_MAX_WORKERS 4
+// Lets the rest of a burst drain from the socket before re-enumerating
+#define PDM_UEVENT_RESYNC_DELAY_MS 200
+
+struct EnumeratedDevice {
+    std::string sysPath;
+    PdmDevPropertyBlockPtr devProps;
+    size_t depth;
+    int subsystemRank;
+};
+
+namespace {
+    struct MonitoredSubsystem {
+        const char *subsystem;
+        const char *devType;
+    };
+
+    // Subsystems the monitor receives. Enumeration reads every usb device,
+    // the monitor only usb_device ones.
+    const MonitoredSubsystem sMonitoredSubsystems[] = {
+        {USB_SUBSYSTEM, "usb_device"},
+        {"block", nullptr},
+        {"input", nullptr},
+        {"sound", nullptr},
+        {"video4linux", nullptr},
+        {"net", nullptr},
+        {"tty", nullptr},
+        {"rfkill", nullptr}
+    };
+
+    bool isMonitored(const PdmDevPropertyBlock &devProps)
+    {
+        PdmStringView subsystem = devProps.get(PdmDevProperty::SUBSYSTEM);
+        for (auto const& monitored : sMonitoredSubsystems) {
+            if (subsystem == monitored.subsystem)
+                return !monitored.devType || devProps.get(PdmDevProperty::DEVTYPE) == monitored.devType;
+        }
+        return false;
+    }
+
+    // True if an enumerated device matches what the handlers were last told
+    bool isSameDeviceState(const PdmDevPropertyBlock &delivered, const PdmDevPropertyBlock &current)
+    {
+        for (size_t i = 0; i < static_cast<size_t>(PdmDevProperty::COUNT); i++) {
+            PdmDevProperty property = static_cast<PdmDevProperty>(i);
+            if (property == PdmDevProperty::ACTION || property == PdmDevProperty::IS_POWER_ON_CONNECT)
+                continue;
+            if (delivered.has(property) != current.has(property) || delivered.get(property) != current.get(property))
+                return false;
+        }
+        return true;
+    }
+
+    // Same properties as the delivered or enumerated ones, with the action
+    // the handlers are to be sent
+    PdmDevPropertyBlockPtr withAction(const PdmDevPropertyBlock &devProps, const char *action)
+    {
+        PdmDevPropertyBlock::Values values = devProps.getValues();
+        values[static_cast<size_t>(PdmDevProperty::ACTION)] = action;
+        return std::make_shared<const PdmDevPropertyBlock>(values, false);
+    }
+
+    size_t getDepth(PdmStringView devPath)
+    {
+        return std::count(devPath.begin(), devPath.end(), '/');
+    }
+    // Within one sysfs depth usb devices go first, then their interfaces,
+    // then whole disks and partitions, then everything else.
+    int getSubsystemRank(const PdmDevPropertyBlock &devProps)
+    {
+        PdmStringView subsystem = devProps.get(PdmDevProperty::SUBSYSTEM);
+        PdmStringView devType = devProps.get(PdmDevProperty::DEVTYPE);
+        if (subsystem == USB_SUBSYSTEM)
+            return (devType == "usb_device") ? 0 : 1;
+        if (subsystem == "block")
+            return (devType == "partition") ? 3 : 2;
+        return 4;
+    }
+
+    // Each worker reads with its own udev context, libudev objects must not
+    // be shared between threads.
+    void collectDeviceProperties(std::vector<EnumeratedDevice> &devices, std::atomic<size_t> &nextIndex, bool isPowerOnConnect)
+    {
+        struct udev* udevCtx = udev_new();
+        if (!udevCtx)
+            return;
+
+        for (size_t index = nextIndex++; index < devices.size(); index = nextIndex++) {
+            EnumeratedDevice &enumDevice = devices[index];
+            struct udev_device* device = udev_device_new_from_syspath(udevCtx, enumDevice.sysPath.c_str());
+            if (device == NULL)
+                continue;
+            enumDevice.devProps = DeviceClassFactory::readDevProps(device, isPowerOnConnect);
+            udev_device_unref(device);
+            enumDevice.depth = getDepth(enumDevice.devProps->get(PdmDevProperty::DEVPATH));
+            enumDevice.subsystemRank = getSubsystemRank(*enumDevice.devProps);
+        }
+        udev_unref(udevCtx);
+    }
+}
 
 
 struct udev* udev = nullptr;
 
-PdmNetlinkListener::PdmNetlinkListener(){
+PdmNetlinkListener::PdmNetlinkListener()
+    : m_coalescer([this](struct udev_device *device, std::chrono::steady_clock::time_point receiveTime) {
+          dispatchEvent(device, receiveTime);
+      })
+    , m_receiveBufferSize(0)
+    , m_lastSeqnum(0)
+    , m_overflows(0)
+    , m_seqnumGaps(0)
+    , m_inconsistentEvents(0)
+    , m_resyncs(0)
+    , m_resyncedEvents(0)
+{
 }
 
 PdmNetlinkListener::~PdmNetlinkListener(){
@@ -61,6 +182,28 @@ bool PdmNetlinkListener::stopListener(){
     return true;
 }
 
+void PdmNetlinkListener::setCoalescingWindow(int windowMs){
+    m_coalescer.setWindow(windowMs);
+}
+
+UeventCoalescingStats PdmNetlinkListener::getCoalescingStats() const{
+    return m_coalescer.getStats();
+}
+
+void PdmNetlinkListener::setReceiveBufferSize(int bufferSize){
+    m_receiveBufferSize = bufferSize;
+}
+
+UeventResyncStats PdmNetlinkListener::getResyncStats() const{
+    UeventResyncStats stats;
+    stats.overflows = m_overflows;
+    stats.seqnumGaps = m_seqnumGaps;
+    stats.inconsistentEvents = m_inconsistentEvents;
+    stats.resyncs = m_resyncs;
+    stats.resyncedEvents = m_resyncedEvents;
+    return stats;
+}
+
 /*  To get the new udev instances
 */
 void PdmNetlinkListener::init(){
@@ -74,33 +217,225 @@ void PdmNetlinkListener::init(){
 
 }
 
-void PdmNetlinkListener::enumerate_devices(struct udev* udev)
+void PdmNetlinkListener::collectDevices(struct udev* udev, const std::set<std::string> &subsystems,
+                                        bool isPowerOnConnect, std::vector<EnumeratedDevice> &enumDevices)
 {
     struct udev_enumerate* enumerate = udev_enumerate_new(udev);
+    if (!enumerate)
+        return;
 
-    udev_enumerate_add_match_subsystem(enumerate, SUBSYSTEM);
-    udev_enumerate_add_match_subsystem(enumerate, "block");
-    udev_enumerate_add_match_subsystem(enumerate, "input");
-    udev_enumerate_add_match_subsystem(enumerate, "sound");
-    udev_enumerate_add_match_subsystem(enumerate, "video4linux");
-    udev_enumerate_add_match_subsystem(enumerate, "net");
-    udev_enumerate_add_match_subsystem(enumerate, "tty");
-    udev_enumerate_add_match_subsystem(enumerate, "rfkill");
-
+    for (auto const& subsystem : subsystems)
+        udev_enumerate_add_match_subsystem(enumerate, subsystem.c_str());
     udev_enumerate_scan_devices(enumerate);
     struct udev_list_entry* devices = udev_enumerate_get_list_entry(enumerate);
     struct udev_list_entry* entry;
 
     udev_list_entry_foreach(entry, devices) {
-        const char* path = udev_list_entry_get_name(entry);
-        struct udev_device* device = udev_device_new_from_syspath(udev, path);
-        if (device != NULL) {
-            PdmNetlinkClassAdapter::getInstance().handleEvent(device, true);
+        EnumeratedDevice enumDevice;
+        enumDevice.sysPath = udev_list_entry_get_name(entry);
+        enumDevice.depth = 0;
+        enumDevice.subsystemRank = 0;
+        enumDevices.push_back(std::move(enumDevice));
+    }
+    udev_enumerate_unref(enumerate);
+
+    // Reading the udev database is the slow part, do it in parallel. The
+    // calling thread takes part too, so the collection completes even if no
+    // worker thread can be started.
+    std::atomic<size_t> nextIndex(0);
+    std::vector<std::thread> workers;
+    size_t workerCount = std::min<size_t>(std::thread::hardware_concurrency(), PDM_ENUMERATION_MAX_WORKERS);
+    for (size_t i = 1; i < workerCount && i < enumDevices.size(); i++) {
+        try {
+            workers.emplace_back(collectDeviceProperties, std::ref(enumDevices), std::ref(nextIndex), isPowerOnConnect);
+        }
+        catch (std::system_error &e) {
+            PDM_LOG_ERROR("PdmNetlinkListener: %s line: %d caught system_error: %s", __FUNCTION__, __LINE__, e.what());
+            break;
         }
-        udev_device_unref(device);
     }
+    collectDeviceProperties(enumDevices, nextIndex, isPowerOnConnect);
+    for (auto &worker : workers)
+        worker.join();
 
-    udev_enumerate_unref(enumerate);
+    // Topology order: a parent devpath is always shorter than its
+    // children's, so usb devices come before their disks and partitions
+    std::stable_sort(enumDevices.begin(), enumDevices.end(),
+                     [](const EnumeratedDevice &a, const EnumeratedDevice &b) {
+                         if (a.depth != b.depth)
+                             return a.depth < b.depth;
+                         return a.subsystemRank < b.subsystemRank;
+                     });
+}
+
+void PdmNetlinkListener::enumerate_devices(struct udev* udev)
+{
+    std::set<std::string> subsystems;
+    for (auto const& monitored : sMonitoredSubsystems)
+        subsystems.insert(monitored.subsystem);
+
+    PdmStartupMetrics::markEnumerationStart();
+    std::vector<EnumeratedDevice> enumDevices;
+    collectDevices(udev, subsystems, true, enumDevices);
+    PdmStartupMetrics::markEnumerationCollected(enumDevices.size());
+
+    for (auto &enumDevice : enumDevices) {
+        if (!enumDevice.devProps)
+            continue;
+        if (isMonitored(*enumDevice.devProps))
+            m_shadowDevices[enumDevice.devProps->get(PdmDevProperty::DEVPATH).to_string()] = enumDevice.devProps;
+        PdmNetlinkClassAdapter::getInstance().handleEvent(enumDevice.devProps);
+    }
+    PdmStartupMetrics::markEnumerationDispatched();
+}
+
+void PdmNetlinkListener::dispatchEvent(struct udev_device *device, std::chrono::steady_clock::time_point receiveTime)
+{
+    PdmDevPropertyBlockPtr devProps = DeviceClassFactory::readDevProps(device, false);
+    trackEvent(devProps);
+    PdmNetlinkClassAdapter::getInstance().handleEvent(devProps, receiveTime);
+}
+
+// Keeps the shadow state in step with the events handed to the handlers. An
+// event that contradicts it, a change or remove of a device the handlers
+// never saw, means earlier events of that subsystem were lost.
+void PdmNetlinkListener::trackEvent(const PdmDevPropertyBlockPtr &devProps)
+{
+    if (!isMonitored(*devProps))
+        return;
+
+    std::string devPath = devProps->get(PdmDevProperty::DEVPATH).to_string();
+    std::string action = devProps->get(PdmDevProperty::ACTION).to_string();
+    bool isKnown = (m_shadowDevices.find(devPath) != m_shadowDevices.end());
+
+    if (action == "remove") {
+        // Children are removed first, drop leftovers whose remove was lost
+        for (auto itr = m_shadowDevices.begin(); itr != m_shadowDevices.end();) {
+            if (itr->first.compare(0, devPath.length(), devPath) == 0 &&
+                (itr->first.length() == devPath.length() || itr->first[devPath.length()] == '/'))
+                itr = m_shadowDevices.erase(itr);
+            else
+                ++itr;
+        }
+    } else if (action == "add" || action == "change") {
+        m_shadowDevices[devPath] = devProps;
+    } else {
+        return;
+    }
+
+    if (!isKnown && action != "add") {
+        m_inconsistentEvents++;
+        PDM_LOG_WARNING("PdmNetlinkListener:%s line: %d %s of unknown device %s", __FUNCTION__, __LINE__, action.c_str(), devPath.c_str());
+        scheduleResync(devProps->get(PdmDevProperty::SUBSYSTEM).to_string());
+    }
+}
+
+// The monitor filter hides the uevents of other subsystems and udevd
+// finishes unrelated devices out of order, so a gap alone does not prove a
+// loss. Gaps are only counted; ENOBUFS and events contradicting the shadow
+// state trigger the resync.
+void PdmNetlinkListener::checkSeqnum(struct udev_device *device)
+{
+    unsigned long long seqnum = udev_device_get_seqnum(device);
+    if (seqnum == 0)
+        return;
+    if (m_lastSeqnum != 0 && seqnum > m_lastSeqnum + 1) {
+        m_seqnumGaps++;
+        PDM_LOG_DEBUG("PdmNetlinkListener:%s line: %d seqnum gap %llu -> %llu", __FUNCTION__, __LINE__, m_lastSeqnum, seqnum);
+    }
+    if (seqnum > m_lastSeqnum)
+        m_lastSeqnum = seqnum;
+}
+
+void PdmNetlinkListener::scheduleResync(const std::string &subsystem)
+{
+    if (m_resyncSubsystems.empty())
+        m_resyncDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(PDM_UEVENT_RESYNC_DELAY_MS);
+    if (!subsystem.empty()) {
+        m_resyncSubsystems.insert(subsystem);
+        return;
+    }
+    for (auto const& monitored : sMonitoredSubsystems)
+        m_resyncSubsystems.insert(monitored.subsystem);
+}
+
+int PdmNetlinkListener::getTimeoutMs() const
+{
+    int timeoutMs = m_coalescer.getTimeoutMs();
+    if (m_resyncSubsystems.empty())
+        return timeoutMs;
+
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(m_resyncDeadline - std::chrono::steady_clock::now()).count();
+    int resyncMs = remaining > 0 ? static_cast<int>(remaining) : 0;
+    return (timeoutMs < 0 || resyncMs < timeoutMs) ? resyncMs : timeoutMs;
+}
+
+// Re-enumerates the subsystems that lost events and sends the handlers the
+// difference to the shadow state: removes deepest first, then adds and
+// changes in topology order.
+void PdmNetlinkListener::resync()
+{
+    std::set<std::string> subsystems;
+    subsystems.swap(m_resyncSubsystems);
+    m_resyncs++;
+    // Pending events were read before the re-enumeration, apply them first
+    m_coalescer.flushAll();
+
+    std::vector<EnumeratedDevice> enumDevices;
+    collectDevices(udev, subsystems, false, enumDevices);
+
+    std::unordered_set<std::string> present;
+    std::vector<PdmDevPropertyBlockPtr> changed;
+    for (auto &enumDevice : enumDevices) {
+        if (!enumDevice.devProps || !isMonitored(*enumDevice.devProps))
+            continue;
+        std::string devPath = enumDevice.devProps->get(PdmDevProperty::DEVPATH).to_string();
+        auto itr = m_shadowDevices.find(devPath);
+        if (itr == m_shadowDevices.end())
+            changed.push_back(withAction(*enumDevice.devProps, "add"));
+        else if (!isSameDeviceState(*itr->second, *enumDevice.devProps))
+            changed.push_back(withAction(*enumDevice.devProps, "change"));
+        present.insert(std::move(devPath));
+    }
+
+    // Gone devices, with everything still known below them
+    std::vector<std::string> removed;
+    for (auto const& shadow : m_shadowDevices) {
+        if (subsystems.count(shadow.second->get(PdmDevProperty::SUBSYSTEM).to_string()) && !present.count(shadow.first))
+            removed.push_back(shadow.first);
+    }
+    size_t goneCount = removed.size();
+    for (auto const& shadow : m_shadowDevices) {
+        for (size_t i = 0; i < goneCount; i++) {
+            const std::string &parent = removed[i];
+            if (shadow.first.length() > parent.length() && shadow.first[parent.length()] == '/' &&
+                shadow.first.compare(0, parent.length(), parent) == 0 &&
+                std::find(removed.begin(), removed.end(), shadow.first) == removed.end()) {
+                removed.push_back(shadow.first);
+                break;
+            }
+        }
+    }
+    std::sort(removed.begin(), removed.end(), [](const std::string &a, const std::string &b) {
+        return getDepth(a) > getDepth(b);
+    });
+
+    for (auto const& devPath : removed) {
+        auto itr = m_shadowDevices.find(devPath);
+        if (itr == m_shadowDevices.end())
+            continue;
+        PdmDevPropertyBlockPtr devProps = withAction(*itr->second, "remove");
+        m_shadowDevices.erase(itr);
+        PdmNetlinkClassAdapter::getInstance().handleEvent(devProps);
+        m_resyncedEvents++;
+    }
+    for (auto const& devProps : changed) {
+        m_shadowDevices[devProps->get(PdmDevProperty::DEVPATH).to_string()] = devProps;
+        PdmNetlinkClassAdapter::getInstance().handleEvent(devProps);
+        m_resyncedEvents++;
+    }
+    PDM_LOG_INFO("PdmNetlinkListener:",0,"%s line: %d resynced %zu subsystems: %zu removed, %zu added or changed",
+                 __FUNCTION__, __LINE__, subsystems.size(), removed.size(), changed.size());
 }
 
 void PdmNetlinkListener::threadStart(){
@@ -132,6 +467,10 @@ void PdmNetlinkListener::threadStart(){
         goto out;
     }
 
+   // A burst of a hub full of devices overflows the default buffer
+   if (m_receiveBufferSize > 0 && udev_monitor_set_receive_buffer_size(monitor, m_receiveBufferSize) < 0)
+        PDM_LOG_ERROR("PdmNetlinkListener: %s line: %d failed to set receive buffer size %d", __FUNCTION__, __LINE__, m_receiveBufferSize);
+
    if (udev_monitor_enable_receiving(monitor) < 0) {
         PDM_LOG_ERROR("PdmNetlinkListener: %s line: %d bind failed\n", __FUNCTION__, __LINE__);
         goto out;
@@ -150,15 +489,27 @@ void PdmNetlinkListener::threadStart(){
     struct epoll_event ev[4];
     struct udev_device *device;
 
-    fdcount = epoll_wait(fd_ep, ev, ARRAY_SIZE(ev), -1);
+    fdcount = epoll_wait(fd_ep, ev, ARRAY_SIZE(ev), getTimeoutMs());
 
     for (int i = 0; i < fdcount; i++) {
         if (ev[i].data.fd == fd_udev && ev[i].events & EPOLLIN) {
+            errno = 0;
             device = udev_monitor_receive_device(monitor);
-			PdmNetlinkClassAdapter::getInstance().handleEvent(device, false);
-            udev_device_unref(device);
+            if (device) {
+                checkSeqnum(device);
+                m_coalescer.push(device);
+                udev_device_unref(device);
+            } else if (errno == ENOBUFS) {
+                // The kernel dropped events, which ones is unknown
+                m_overflows++;
+                PDM_LOG_ERROR("PdmNetlinkListener: %s line: %d uevent receive buffer overflow", __FUNCTION__, __LINE__);
+                scheduleResync(std::string());
+            }
             }
         }
+    m_coalescer.flushExpired();
+    if (!m_resyncSubsystems.empty() && std::chrono::steady_clock::now() >= m_resyncDeadline)
+        resync();
     }
 
    out:
@@ -35,10 +35,10 @@ PdmNetlinkManager::~PdmNetlinkManager()
     m_handler = nullptr;
 }
 
-int PdmNetlinkManager::start(CommandManager *cmdManager)
+int PdmNetlinkManager::start(CommandManager *cmdManager, PdmConfig *pConfObj)
 {
     PDM_LOG_DEBUG("PdmNetlinkManager:%s line: %d Starting NetlinkHandler...", __FUNCTION__, __LINE__);
-    m_handler = new (std::nothrow) PdmNetlinkHandler(cmdManager);
+    m_handler = new (std::nothrow) PdmNetlinkHandler(cmdManager, pConfObj);
 
     if( m_handler && m_handler->start() ) {
         PDM_LOG_DEBUG("PdmNetlinkManager:%s line: %d NetlinkHandler started...", __FUNCTION__, __LINE__);
@@ -48,6 +48,22 @@ int PdmNetlinkManager::start(CommandManager *cmdManager)
     return -1;
 }
 
+bool PdmNetlinkManager::getCoalescingStats(UeventCoalescingStats &stats) const
+{
+    if(!m_handler)
+        return false;
+    stats = m_handler->getCoalescingStats();
+    return true;
+}
+
+bool PdmNetlinkManager::getResyncStats(UeventResyncStats &stats) const
+{
+    if(!m_handler)
+        return false;
+    stats = m_handler->getResyncStats();
+    return true;
+}
+
 int PdmNetlinkManager::stop()
 {
      if (m_handler->stop()) {
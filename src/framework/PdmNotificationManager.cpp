@@ -23,9 +23,8 @@
 #include "DeviceManager.h"
 #include "PdmNotificationManager.h"
 #include "PdmLogUtils.h"
-#include "MTPDevice.h"
-#include "StorageDevice.h"
-#include "DiskPartitionInfo.h"
+#include "PdmDeviceSnapshot.h"
+#include "PdmObserverBus.h"
 #include "PdmUtils.h"
 #include <sys/shm.h>
 
@@ -40,6 +39,7 @@ PdmNotificationManager::PdmNotificationManager()
 
 PdmNotificationManager::~PdmNotificationManager()
 {
+    PdmObserverBus::getInstance().detach(this);
     std::list<DeviceHandler*> pDeviceHandlerList = DeviceManager::getInstance()->getDeviceHandlerList();
 
     for(auto handler : pDeviceHandlerList)
@@ -51,6 +51,16 @@ PdmNotificationManager::~PdmNotificationManager()
 
 void PdmNotificationManager::attachObservers()
 {
+    // Alerts go out over LS2 and signals, keep them off the handler threads
+    PdmObserverPolicy policy;
+    policy.name = "PdmNotificationManager";
+    policy.queueLimit = PDM_NOTIFICATION_QUEUE_LIMIT;
+    policy.canMerge = [](const PdmDeviceEvent &waiting, const PdmDeviceEvent &event) {
+        return (event.eventID == CONNECTING) && (waiting.eventID == CONNECTING) &&
+               (waiting.eventDeviceType == event.eventDeviceType);
+    };
+    PdmObserverBus::getInstance().attach(this, policy);
+
     std::list<DeviceHandler*> pDeviceHandlerList = DeviceManager::getInstance()->getDeviceHandlerList();
 
     for(auto handler : pDeviceHandlerList)
@@ -82,7 +92,9 @@ void PdmNotificationManager::update(const int &eventDeviceType, const int &event
     if(m_powerState == false)
         return;
 
-    if((device) && (!device->canDisplayToast()))
+    // Attached to the observer bus, so the device is always a snapshot
+    PdmDeviceSnapshot *snapshot = dynamic_cast<PdmDeviceSnapshot*>(device);
+    if((snapshot) && (!snapshot->canDisplayToast()))
          return;
 
     switch(eventID)
@@ -92,18 +104,18 @@ void PdmNotificationManager::update(const int &eventDeviceType, const int &event
         case REMOVE_BEFORE_MOUNT:
             if(eventDeviceType == PdmDevAttributes::MTP_DEVICE)
             {
-                unMountMtpDeviceAlert(device);
+                unMountMtpDeviceAlert(snapshot);
                 break;
             }else{
-                createAlertForUnmountedDeviceRemoval(device);
+                createAlertForUnmountedDeviceRemoval(snapshot);
                 break;
             }
-        case UNSUPPORTED_FS_FORMAT_NEEDED: createAlertForUnsupportedFileSystem(device);break;
-        case FSCK_TIMED_OUT: createAlertForFsckTimeout(device);break;
-        case FORMAT_STARTED: showFormatStartedToast(device);break;
-        case FORMAT_SUCCESS: showFormatSuccessToast(device);break;
-        case FORMAT_FAIL: showFormatFailToast(device);break;
-        case REMOVE_UNSUPPORTED_FS: closeUnsupportedFsAlert(device);break;
+        case UNSUPPORTED_FS_FORMAT_NEEDED: createAlertForUnsupportedFileSystem(snapshot);break;
+        case FSCK_TIMED_OUT: createAlertForFsckTimeout(snapshot);break;
+        case FORMAT_STARTED: showFormatStartedToast(snapshot);break;
+        case FORMAT_SUCCESS: showFormatSuccessToast(snapshot);break;
+        case FORMAT_FAIL: showFormatFailToast(snapshot);break;
+        case REMOVE_UNSUPPORTED_FS: closeUnsupportedFsAlert(snapshot);break;
     }
 }
 
@@ -181,7 +193,7 @@ void PdmNotificationManager::createAlertForMaxUsbStorageDevices()
     PdmNotificationManager::sendAlertInfo(MAX_COUNT_REACHED_EVENT, std::move(parameters));
 }
 
-void PdmNotificationManager::unMountMtpDeviceAlert(IDevice* device)
+void PdmNotificationManager::unMountMtpDeviceAlert(PdmDeviceSnapshot* device)
 {
     if(!device)
     {
@@ -189,27 +201,25 @@ void PdmNotificationManager::unMountMtpDeviceAlert(IDevice* device)
         return;
     }
 
-    MTPDevice*  pMtpDev = dynamic_cast<MTPDevice*>(device);
-    if(!pMtpDev)
+    if(device->getKind() != PdmDeviceSnapshot::MTP_DEVICE)
         return;
 
-    std::string driveName = pMtpDev->getDriveName();
+    std::string driveName = device->getDriveName();
     PDM_LOG_DEBUG("PdmNotificationManager:%s line: %d driveName: %s", __FUNCTION__, __LINE__, driveName.c_str());
     pbnjson::JValue parameters = pbnjson::Object();
     parameters.put("driveName", driveName);
     PdmNotificationManager::sendAlertInfo(REMOVE_BEFORE_MOUNT_MTP_EVENT, std::move(parameters));
 }
 
-void PdmNotificationManager::createAlertForUnmountedDeviceRemoval(IDevice* device)
+void PdmNotificationManager::createAlertForUnmountedDeviceRemoval(PdmDeviceSnapshot* device)
 {
     if(!device)
         return;
 
-    StorageDevice*  pStorageDev = dynamic_cast<StorageDevice*>(device);
-    if(!pStorageDev)
+    if(device->getKind() != PdmDeviceSnapshot::STORAGE_DEVICE)
         return;
 
-    std::string devNumStr = std::to_string(pStorageDev->getDeviceNum());
+    std::string devNumStr = std::to_string(device->getDeviceNum());
 
     PDM_LOG_DEBUG("PdmNotificationManager:%s line: %d devNumStr: %s", __FUNCTION__, __LINE__, devNumStr.c_str());
 
@@ -218,16 +228,15 @@ void PdmNotificationManager::createAlertForUnmountedDeviceRemoval(IDevice* devic
     PdmNotificationManager::sendAlertInfo(REMOVE_BEFORE_MOUNT_EVENT, std::move(parameters));
 }
 
-void PdmNotificationManager::createAlertForUnsupportedFileSystem(IDevice* device)
+void PdmNotificationManager::createAlertForUnsupportedFileSystem(PdmDeviceSnapshot* device)
 {
     if(!device)
         return;
 
-    StorageDevice*  pStorageDev = dynamic_cast<StorageDevice*>(device);
-    if(!pStorageDev)
+    if(device->getKind() != PdmDeviceSnapshot::STORAGE_DEVICE)
         return;
 
-    std::string devNumStr = std::to_string(pStorageDev->getDeviceNum());
+    std::string devNumStr = std::to_string(device->getDeviceNum());
 
     PDM_LOG_DEBUG("PdmNotificationManager:%s line: %d devNumStr: %s", __FUNCTION__, __LINE__, devNumStr.c_str());
 
@@ -236,19 +245,18 @@ void PdmNotificationManager::createAlertForUnsupportedFileSystem(IDevice* device
     PdmNotificationManager::sendAlertInfo(UNSUPPORTED_FS_FORMAT_NEEDED_EVENT, std::move(parameters));
 }
 
-void PdmNotificationManager::createAlertForFsckTimeout(IDevice* device)
+void PdmNotificationManager::createAlertForFsckTimeout(PdmDeviceSnapshot* device)
 {
     PDM_LOG_WARNING("PdmNotificationManager:%s line: %d Creating alert for fsck timeout", __FUNCTION__, __LINE__);
 
     if(!device)
         return;
 
-    StorageDevice*  pStorageDev = dynamic_cast<StorageDevice*>(device);
-    if(!pStorageDev)
+    if(device->getKind() != PdmDeviceSnapshot::STORAGE_DEVICE)
         return;
 
-    std::string devNumStr = std::to_string(pStorageDev->getDeviceNum());
-    std::string mountName = pStorageDev->getDeviceName();
+    std::string devNumStr = std::to_string(device->getDeviceNum());
+    std::string mountName = device->getDeviceName();
 
     PDM_LOG_DEBUG("PdmNotificationManager:%s line: %d devNumStr: %s mountName: %s", __FUNCTION__, __LINE__, devNumStr.c_str(), mountName.c_str());
 
@@ -258,18 +266,17 @@ void PdmNotificationManager::createAlertForFsckTimeout(IDevice* device)
     PdmNotificationManager::sendAlertInfo(FSCK_TIMED_OUT_EVENT, std::move(parameters));
 }
 
-void PdmNotificationManager::showFormatStartedToast(IDevice* device)
+void PdmNotificationManager::showFormatStartedToast(PdmDeviceSnapshot* device)
 {
     if(!device)
         return;
 
-    DiskPartitionInfo*  pPartition = dynamic_cast<DiskPartitionInfo*>(device);
-    if(!pPartition)
+    if(device->getKind() != PdmDeviceSnapshot::PARTITION)
         return;
 
     std::stringstream driveSizeInGb;
-    driveSizeInGb << std::fixed << std::setprecision(2) << pPartition->getDriveSize()/(float)(1024 * 1024);
-    std::string driveInfo = "[" + driveSizeInGb.str() + "GB] " + pPartition->getProductName();
+    driveSizeInGb << std::fixed << std::setprecision(2) << device->getDriveSize()/(float)(1024 * 1024);
+    std::string driveInfo = "[" + driveSizeInGb.str() + "GB] " + device->getProductName();
     PDM_LOG_DEBUG("PdmNotificationManager:%s line: %d driveInfo: %s", __FUNCTION__, __LINE__, driveInfo.c_str());
 
     pbnjson::JValue parameters = pbnjson::Object();
@@ -277,18 +284,17 @@ void PdmNotificationManager::showFormatStartedToast(IDevice* device)
     PdmNotificationManager::sendAlertInfo(FORMAT_STARTED_EVENT, std::move(parameters));
 }
 
-void PdmNotificationManager::showFormatSuccessToast(IDevice* device)
+void PdmNotificationManager::showFormatSuccessToast(PdmDeviceSnapshot* device)
 {
     if(!device)
         return;
 
-    DiskPartitionInfo*  pPartition = dynamic_cast<DiskPartitionInfo*>(device);
-    if(!pPartition)
+    if(device->getKind() != PdmDeviceSnapshot::PARTITION)
         return;
 
     std::stringstream driveSizeInGb;
-    driveSizeInGb << std::fixed << std::setprecision(2) << pPartition->getDriveSize()/(float)(1024 * 1024);
-    std::string driveInfo = "[" + driveSizeInGb.str() + "GB] " + pPartition->getProductName();
+    driveSizeInGb << std::fixed << std::setprecision(2) << device->getDriveSize()/(float)(1024 * 1024);
+    std::string driveInfo = "[" + driveSizeInGb.str() + "GB] " + device->getProductName();
     PDM_LOG_DEBUG("PdmNotificationManager:%s line: %d driveInfo: %s", __FUNCTION__, __LINE__, driveInfo.c_str());
 
     pbnjson::JValue parameters = pbnjson::Object();
@@ -296,18 +302,17 @@ void PdmNotificationManager::showFormatSuccessToast(IDevice* device)
     PdmNotificationManager::sendAlertInfo(FORMAT_SUCCESS_EVENT, std::move(parameters));
 }
 
-void PdmNotificationManager::showFormatFailToast(IDevice* device)
+void PdmNotificationManager::showFormatFailToast(PdmDeviceSnapshot* device)
 {
     if(!device)
         return;
 
-    DiskPartitionInfo*  pPartition = dynamic_cast<DiskPartitionInfo*>(device);
-    if(!pPartition)
+    if(device->getKind() != PdmDeviceSnapshot::PARTITION)
         return;
 
     std::stringstream driveSizeInGb;
-    driveSizeInGb << std::fixed << std::setprecision(2) << pPartition->getDriveSize()/(float)(1024 * 1024);
-    std::string driveInfo = "[" + driveSizeInGb.str() + "GB] " + pPartition->getProductName();
+    driveSizeInGb << std::fixed << std::setprecision(2) << device->getDriveSize()/(float)(1024 * 1024);
+    std::string driveInfo = "[" + driveSizeInGb.str() + "GB] " + device->getProductName();
     PDM_LOG_DEBUG("PdmNotificationManager:%s line: %d driveInfo: %s", __FUNCTION__, __LINE__, driveInfo.c_str());
 
     pbnjson::JValue parameters = pbnjson::Object();
@@ -315,16 +320,15 @@ void PdmNotificationManager::showFormatFailToast(IDevice* device)
     PdmNotificationManager::sendAlertInfo(FORMAT_FAIL_EVENT, std::move(parameters));
 }
 
-void PdmNotificationManager::closeUnsupportedFsAlert(IDevice* device)
+void PdmNotificationManager::closeUnsupportedFsAlert(PdmDeviceSnapshot* device)
 {
     if(!device)
         return;
 
-    StorageDevice*  pStorageDev = dynamic_cast<StorageDevice*>(device);
-    if(!pStorageDev)
+    if(device->getKind() != PdmDeviceSnapshot::STORAGE_DEVICE)
         return;
 
-    std::string devNumStr = std::to_string(pStorageDev->getDeviceNum());
+    std::string devNumStr = std::to_string(device->getDeviceNum());
 
     pbnjson::JValue parameters = pbnjson::Object();
     parameters.put("deviceNum", devNumStr);
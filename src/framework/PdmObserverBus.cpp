@@ -0,0 +1,149 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <glib.h>
+
+#include "PdmLatencyStats.h"
+#include "PdmLogUtils.h"
+#include "PdmObserverBus.h"
+
+PdmDeviceEvent::PdmDeviceEvent(int deviceType, int id, IDevice *dev)
+    : eventDeviceType(deviceType)
+    , eventID(id)
+    , device(dev ? new PdmDeviceSnapshot(dev) : nullptr)
+    , postTime(std::chrono::steady_clock::now())
+    , traced(PdmLatencyStats::EventScope::current() != nullptr)
+    , traceDeviceType(traced ? PdmLatencyStats::EventScope::current()->getDeviceType() : std::string())
+    , traceReceiveTime(traced ? PdmLatencyStats::EventScope::current()->getReceiveTime() : std::chrono::steady_clock::time_point())
+{
+}
+
+PdmObserverBus& PdmObserverBus::getInstance()
+{
+    static PdmObserverBus obj;
+    return obj;
+}
+
+void PdmObserverBus::attach(IObserver *observer, const PdmObserverPolicy &policy)
+{
+    if (!observer)
+        return;
+    std::lock_guard<std::mutex> lock(m_queuesMtx);
+    ObserverQueue &queue = m_queues[observer];
+    queue.policy = policy;
+    queue.scheduled = false;
+    queue.stats = PdmObserverQueueStats();
+    PDM_LOG_INFO("PdmObserverBus:",0,"%s line: %d %s queue limit: %zu", __FUNCTION__, __LINE__,
+                 policy.name.c_str(), policy.queueLimit);
+}
+
+void PdmObserverBus::detach(IObserver *observer)
+{
+    std::lock_guard<std::mutex> lock(m_queuesMtx);
+    m_queues.erase(observer);
+}
+
+bool PdmObserverBus::isAttached(IObserver *observer)
+{
+    std::lock_guard<std::mutex> lock(m_queuesMtx);
+    return m_queues.find(observer) != m_queues.end();
+}
+
+void PdmObserverBus::updateLive(IObserver *observer, int eventDeviceType, int eventID, IDevice *device)
+{
+    PdmLiveUpdateFn updateFn;
+    {
+        std::lock_guard<std::mutex> lock(m_queuesMtx);
+        auto itr = m_queues.find(observer);
+        if (itr == m_queues.end() || !itr->second.policy.updateLive)
+            return;
+        updateFn = itr->second.policy.updateLive;
+    }
+    updateFn(eventDeviceType, eventID, device);
+}
+
+bool PdmObserverBus::post(IObserver *observer, const std::shared_ptr<const PdmDeviceEvent> &event)
+{
+    std::lock_guard<std::mutex> lock(m_queuesMtx);
+    auto itr = m_queues.find(observer);
+    if (itr == m_queues.end() || !event)
+        return false;
+
+    ObserverQueue &queue = itr->second;
+    queue.stats.posted++;
+    if (!queue.events.empty() && queue.policy.canMerge && queue.policy.canMerge(*queue.events.back(), *event)) {
+        queue.events.back() = event;
+        queue.stats.merged++;
+        return true;
+    }
+    if (queue.policy.queueLimit > 0 && queue.events.size() >= queue.policy.queueLimit) {
+        const PdmDeviceEvent &dropped = *queue.events.front();
+        PDM_LOG_WARNING("PdmObserverBus:%s line: %d %s queue full, dropping event %d of device type %d", __FUNCTION__, __LINE__,
+                        queue.policy.name.c_str(), dropped.eventID, dropped.eventDeviceType);
+        queue.events.pop_front();
+        queue.stats.dropped++;
+    }
+    queue.events.push_back(event);
+    queue.stats.queueDepth = queue.events.size();
+    if (queue.stats.queueDepth > queue.stats.maxQueueDepth)
+        queue.stats.maxQueueDepth = queue.stats.queueDepth;
+
+    if (!queue.scheduled) {
+        queue.scheduled = true;
+        g_idle_add_full(G_PRIORITY_DEFAULT, &PdmObserverBus::deliverEvents, observer, nullptr);
+    }
+    return true;
+}
+
+int PdmObserverBus::deliverEvents(void *data)
+{
+    getInstance().deliver(static_cast<IObserver*>(data));
+    return G_SOURCE_REMOVE;
+}
+
+void PdmObserverBus::deliver(IObserver *observer)
+{
+    std::deque<std::shared_ptr<const PdmDeviceEvent>> events;
+    {
+        std::lock_guard<std::mutex> lock(m_queuesMtx);
+        auto itr = m_queues.find(observer);
+        if (itr == m_queues.end())
+            return;
+        ObserverQueue &queue = itr->second;
+        events.swap(queue.events);
+        queue.scheduled = false;
+        queue.stats.queueDepth = 0;
+        queue.stats.delivered += events.size();
+    }
+
+    for (auto const& event : events) {
+        std::unique_ptr<PdmLatencyStats::EventScope> eventScope;
+        if (event->traced)
+            eventScope.reset(new PdmLatencyStats::EventScope(event->traceDeviceType, event->traceReceiveTime));
+        PdmLatencyStats::record(PdmLatencyStage::OBSERVER_QUEUE, event->postTime, std::chrono::steady_clock::now());
+        observer->update(event->eventDeviceType, event->eventID, event->device.get());
+    }
+}
+
+std::list<std::pair<std::string, PdmObserverQueueStats>> PdmObserverBus::getStats()
+{
+    std::list<std::pair<std::string, PdmObserverQueueStats>> stats;
+    std::lock_guard<std::mutex> lock(m_queuesMtx);
+    for (auto const& queue : m_queues)
+        stats.push_back(std::make_pair(queue.second.policy.name, queue.second.stats));
+    return stats;
+}
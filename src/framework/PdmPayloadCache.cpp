@@ -0,0 +1,102 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "PdmLogUtils.h"
+#include "PdmPayloadCache.h"
+
+using namespace PdmDevAttributes;
+
+PdmPayloadCache::PdmPayloadCache()
+    : m_version(0)
+    , m_hits(0)
+    , m_misses(0)
+    , m_skipped(0)
+{
+    for (auto &typeVersion : m_typeVersions)
+        typeVersion = 0;
+}
+
+PdmPayloadCache& PdmPayloadCache::getInstance()
+{
+    static PdmPayloadCache obj;
+    return obj;
+}
+
+// Versions only grow, so the sum changes with any of them
+uint64_t PdmPayloadCache::getStamp(uint32_t dependsOn) const
+{
+    uint64_t stamp = 0;
+    for (int type = 0; type < UNKNOWN_DEVICE; type++) {
+        if (dependsOn & PDM_PAYLOAD_DEPENDS_ON(type))
+            stamp += m_typeVersions[type];
+    }
+    return stamp;
+}
+
+void PdmPayloadCache::invalidate(int eventDeviceType)
+{
+    if (eventDeviceType < 0 || eventDeviceType >= UNKNOWN_DEVICE || eventDeviceType == ALL_DEVICE) {
+        invalidateAll();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_typeVersions[eventDeviceType]++;
+    m_version++;
+}
+
+void PdmPayloadCache::invalidateAll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &typeVersion : m_typeVersions)
+        typeVersion++;
+    m_version++;
+}
+
+std::string PdmPayloadCache::get(const std::string &key, uint32_t dependsOn, const std::function<pbnjson::JValue()> &build)
+{
+    uint64_t stamp = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stamp = getStamp(dependsOn);
+        auto itr = m_entries.find(key);
+        if (itr != m_entries.end() && itr->second.stamp == stamp) {
+            m_hits++;
+            return itr->second.text;
+        }
+        m_misses++;
+    }
+
+    std::string text = build().stringify(NULL);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Not cached when a device changed while the payload was built
+    if (getStamp(dependsOn) == stamp) {
+        Entry &entry = m_entries[key];
+        entry.stamp = stamp;
+        entry.text = text;
+    }
+    PDM_LOG_DEBUG("PdmPayloadCache:%s line: %d built %s version: %llu", __FUNCTION__, __LINE__, key.c_str(),
+                  static_cast<unsigned long long>(m_version));
+    return text;
+}
+
+PdmPayloadCacheStats PdmPayloadCache::getStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PdmPayloadCacheStats stats = { m_version, m_hits, m_misses, m_skipped };
+    return stats;
+}
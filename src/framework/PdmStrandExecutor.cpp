@@ -0,0 +1,90 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "PdmStrandExecutor.h"
+#include "PdmLogUtils.h"
+
+PdmStrandExecutor::PdmStrandExecutor(size_t workers)
+    : m_pool(new PdmThreadPool(workers))
+{
+}
+
+PdmStrandExecutor::~PdmStrandExecutor()
+{
+    delete m_pool;
+    m_pool = nullptr;
+}
+
+void PdmStrandExecutor::post(const std::string &key, std::function<void()> task)
+{
+    const std::string *strandKey = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_strandMtx);
+        auto it = m_strands.find(key);
+        if (it != m_strands.end()) {
+            // The strand is already scheduled, its runner picks the task up
+            it->second.push_back(std::move(task));
+            return;
+        }
+        it = m_strands.emplace(key, std::deque<std::function<void()>>()).first;
+        it->second.push_back(std::move(task));
+        // Map nodes are stable, the key lives until the runner erases the strand
+        strandKey = &it->first;
+    }
+    m_pool->post(&PdmStrandExecutor::runStrandTask, this, const_cast<std::string*>(strandKey));
+}
+
+void PdmStrandExecutor::runStrandTask(void *context, void *arg)
+{
+    PdmStrandExecutor *executor = static_cast<PdmStrandExecutor*>(context);
+    // The key refers to the map node and is only used until the strand is erased
+    executor->runStrand(*static_cast<const std::string*>(arg));
+}
+
+void PdmStrandExecutor::runStrand(const std::string &key)
+{
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(m_strandMtx);
+            auto it = m_strands.find(key);
+            if (it == m_strands.end())
+                return;
+            if (it->second.empty()) {
+                m_strands.erase(it);
+                return;
+            }
+            task = std::move(it->second.front());
+            it->second.pop_front();
+        }
+        task();
+        // The strand stays in the map while its task runs so that tasks
+        // posted meanwhile are queued behind it instead of starting in parallel
+        std::lock_guard<std::mutex> lock(m_strandMtx);
+        auto it = m_strands.find(key);
+        if (it != m_strands.end() && it->second.empty()) {
+            m_strands.erase(it);
+            return;
+        }
+    }
+}
+
+size_t PdmStrandExecutor::getActiveStrandCount()
+{
+    std::lock_guard<std::mutex> lock(m_strandMtx);
+    return m_strands.size();
+}
@@ -0,0 +1,171 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "PdmUeventCoalescer.h"
+#include "PdmLogUtils.h"
+
+PdmUeventCoalescer::PdmUeventCoalescer(std::function<void(struct udev_device*, std::chrono::steady_clock::time_point)> dispatchFn)
+    : m_dispatch(dispatchFn)
+    , m_window(0)
+    , m_received(0)
+    , m_dispatched(0)
+    , m_mergedChanges(0)
+    , m_cancelledEvents(0)
+{
+}
+
+PdmUeventCoalescer::~PdmUeventCoalescer()
+{
+    for (auto &event : m_pending)
+        udev_device_unref(event.device);
+    m_pending.clear();
+}
+
+void PdmUeventCoalescer::setWindow(int windowMs)
+{
+    m_window = std::chrono::milliseconds(windowMs > 0 ? windowMs : 0);
+    PDM_LOG_INFO("PdmUeventCoalescer:",0,"%s line: %d window: %d ms", __FUNCTION__, __LINE__, windowMs);
+}
+
+void PdmUeventCoalescer::push(struct udev_device *device)
+{
+    if (!device)
+        return;
+
+    m_received++;
+    PendingEvent event;
+    event.device = udev_device_ref(device);
+    const char *devPath = udev_device_get_devpath(device);
+    const char *action = udev_device_get_action(device);
+    event.devPath = devPath ? devPath : "";
+    event.action = action ? action : "";
+    event.receiveTime = std::chrono::steady_clock::now();
+    event.deadline = event.receiveTime + m_window;
+
+    if (m_window.count() == 0) {
+        dispatch(event);
+        return;
+    }
+
+    if (event.action == "change") {
+        // Only the latest pending event of the devpath can absorb it, merging
+        // into an older one would move the change before events queued since
+        auto lastIt = m_pending.end();
+        for (auto it = m_pending.begin(); it != m_pending.end(); ++it) {
+            if (it->devPath == event.devPath)
+                lastIt = it;
+        }
+        if (lastIt != m_pending.end() && lastIt->action == "change") {
+            // Updated in place: the entry keeps its position among other
+            // devices and its first deadline, so a change storm cannot
+            // postpone the event forever
+            udev_device_unref(lastIt->device);
+            lastIt->device = event.device;
+            m_mergedChanges++;
+            PDM_LOG_DEBUG("PdmUeventCoalescer:%s line: %d merged change for %s", __FUNCTION__, __LINE__, event.devPath.c_str());
+            return;
+        }
+    } else if (event.action == "remove" && cancelPendingAdd(event.devPath)) {
+        udev_device_unref(event.device);
+        m_cancelledEvents++;
+        return;
+    }
+    m_pending.push_back(event);
+}
+
+bool PdmUeventCoalescer::cancelPendingAdd(const std::string &devPath)
+{
+    auto addIt = m_pending.end();
+    for (auto it = m_pending.begin(); it != m_pending.end(); ++it) {
+        if (it->action == "add" && it->devPath == devPath)
+            addIt = it;
+    }
+    if (addIt == m_pending.end())
+        return false;
+
+    // The device came and went inside the window, nothing of it reaches the handlers
+    for (auto it = addIt; it != m_pending.end();) {
+        if (it->devPath == devPath) {
+            udev_device_unref(it->device);
+            it = m_pending.erase(it);
+            m_cancelledEvents++;
+        } else {
+            ++it;
+        }
+    }
+    PDM_LOG_INFO("PdmUeventCoalescer:",0,"%s line: %d add/remove collapsed for %s", __FUNCTION__, __LINE__, devPath.c_str());
+    return true;
+}
+
+int PdmUeventCoalescer::getTimeoutMs() const
+{
+    if (m_pending.empty())
+        return -1;
+
+    auto earliest = m_pending.front().deadline;
+    for (auto &event : m_pending) {
+        if (event.deadline < earliest)
+            earliest = event.deadline;
+    }
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(earliest - std::chrono::steady_clock::now()).count();
+    return remaining > 0 ? static_cast<int>(remaining) : 0;
+}
+
+void PdmUeventCoalescer::flushExpired()
+{
+    auto now = std::chrono::steady_clock::now();
+    // Everything queued before the last expired event goes out with it to keep arrival order
+    auto last = m_pending.end();
+    for (auto it = m_pending.begin(); it != m_pending.end(); ++it) {
+        if (it->deadline <= now)
+            last = it;
+    }
+    if (last == m_pending.end())
+        return;
+
+    ++last;
+    while (m_pending.begin() != last) {
+        dispatch(m_pending.front());
+        m_pending.pop_front();
+    }
+}
+
+void PdmUeventCoalescer::flushAll()
+{
+    while (!m_pending.empty()) {
+        dispatch(m_pending.front());
+        m_pending.pop_front();
+    }
+}
+
+UeventCoalescingStats PdmUeventCoalescer::getStats() const
+{
+    UeventCoalescingStats stats;
+    stats.received = m_received.load();
+    stats.dispatched = m_dispatched.load();
+    stats.mergedChanges = m_mergedChanges.load();
+    stats.cancelledEvents = m_cancelledEvents.load();
+    return stats;
+}
+
+void PdmUeventCoalescer::dispatch(PendingEvent &event)
+{
+    m_dispatched++;
+    m_dispatch(event.device, event.receiveTime);
+    udev_device_unref(event.device);
+    event.device = nullptr;
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+
+#include <pbnjson.hpp>
+
+#include "PdmLogUtils.h"
+#include "PdmUeventRecorder.h"
+
+PdmUeventRecorder::PdmUeventRecorder()
+    : m_isRecording(false)
+{
+}
+
+PdmUeventRecorder::~PdmUeventRecorder()
+{
+    close();
+}
+
+PdmUeventRecorder& PdmUeventRecorder::getInstance()
+{
+    static PdmUeventRecorder obj;
+    return obj;
+}
+
+bool PdmUeventRecorder::open(const std::string &tracePath)
+{
+    std::lock_guard<std::mutex> lock(m_traceMtx);
+    if (m_trace.is_open())
+        m_trace.close();
+    m_trace.open(tracePath, std::ios::out | std::ios::trunc);
+    if (!m_trace.is_open()) {
+        PDM_LOG_ERROR("PdmUeventRecorder:%s line: %d cannot open %s", __FUNCTION__, __LINE__, tracePath.c_str());
+        m_isRecording = false;
+        return false;
+    }
+    m_startTime = std::chrono::steady_clock::now();
+    m_isRecording = true;
+    PDM_LOG_INFO("PdmUeventRecorder:",0,"%s line: %d recording uevents to %s", __FUNCTION__, __LINE__, tracePath.c_str());
+    return true;
+}
+
+void PdmUeventRecorder::close()
+{
+    std::lock_guard<std::mutex> lock(m_traceMtx);
+    m_isRecording = false;
+    if (m_trace.is_open())
+        m_trace.close();
+}
+
+void PdmUeventRecorder::record(const PdmDevPropertyBlock &devProps)
+{
+    if (!isRecording())
+        return;
+
+    // The power on flag is recorded on its own, replay passes it back in
+    bool isPowerOnConnect = (devProps.get(PdmDevProperty::IS_POWER_ON_CONNECT) == "true");
+    pbnjson::JValue props = pbnjson::Object();
+    for (size_t i = 0; i < static_cast<size_t>(PdmDevProperty::COUNT); i++) {
+        PdmDevProperty property = static_cast<PdmDevProperty>(i);
+        if (property != PdmDevProperty::IS_POWER_ON_CONNECT && devProps.has(property))
+            props.put(PdmDevPropertyBlock::getName(property), devProps.get(property).to_string());
+    }
+
+    std::lock_guard<std::mutex> lock(m_traceMtx);
+    if (!m_trace.is_open())
+        return;
+    auto elapsed = std::chrono::steady_clock::now() - m_startTime;
+    pbnjson::JValue record = pbnjson::Object();
+    record.put("timeUs", static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    record.put("powerOn", isPowerOnConnect);
+    record.put("props", props);
+    // Flushed per event so the trace survives a crash during the storm
+    m_trace << record.stringify() << std::endl;
+}
+
+bool PdmUeventRecorder::readTrace(const std::string &tracePath, std::vector<PdmUeventRecord> &records)
+{
+    std::ifstream trace(tracePath);
+    if (!trace.is_open())
+        return false;
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(trace, line)) {
+        lineNumber++;
+        if (line.empty())
+            continue;
+        pbnjson::JValue record = pbnjson::JDomParser::fromString(line);
+        if (!record.isObject() || !record["props"].isObject()) {
+            PDM_LOG_ERROR("PdmUeventRecorder:%s line: %d %s:%zu is not a uevent record", __FUNCTION__, __LINE__, tracePath.c_str(), lineNumber);
+            return false;
+        }
+        PdmUeventRecord uevent;
+        uevent.timeUs = record["timeUs"].isNumber() ? record["timeUs"].asNumber<int64_t>() : 0;
+        uevent.isPowerOnConnect = record["powerOn"].isBoolean() && record["powerOn"].asBool();
+        for (auto prop : record["props"].children()) {
+            if (prop.second.isString())
+                uevent.devProps[prop.first.asString()] = prop.second.asString();
+        }
+        records.push_back(std::move(uevent));
+    }
+    return true;
+}
@@ -24,19 +24,17 @@ using namespace PdmDevAttributes;
 
 bool SoundSubsystem::mIsObjRegistered = SoundSubsystem::RegisterSubSystem();
 
-SoundSubsystem::SoundSubsystem(std::unordered_map<std::string, std::string>& devPropMap)
-	: mDevType("sound"), DeviceClass(devPropMap)
+SoundSubsystem::SoundSubsystem(const PdmDevPropertyBlockPtr &devProps)
+	: DeviceClass(devProps), mDevType("sound")
 {
-	for (auto &prop : devPropMap)
-		mDevPropMap[prop.first] = prop.second;
 }
 
 SoundSubsystem::~SoundSubsystem() {}
 
-SoundSubsystem* SoundSubsystem::create(std::unordered_map<std::string, std::string>& devProMap)
+SoundSubsystem* SoundSubsystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
 	PDM_LOG_DEBUG("SoundSubsystem:%s line: %d", __FUNCTION__, __LINE__);
-	bool canProcessEve = SoundSubsystem::canProcessEvent(devProMap);
+	bool canProcessEve = SoundSubsystem::canProcessEvent(*devProMap);
 	
 	if (!canProcessEve)
 		return nullptr;
@@ -48,15 +46,15 @@ SoundSubsystem* SoundSubsystem::create(std::unordered_map<std::string, std::stri
 
 std::string SoundSubsystem::getCardId()
 {
-	return mDevPropMap[CARD_ID];
+	return getPropertyString(PdmDevProperty::CARD_ID);
 }
 
 std::string SoundSubsystem::getCardName()
 {
-	return mDevPropMap[CARD_NAME];
+	return getPropertyString(PdmDevProperty::CARD_NAME);
 }
 
 std::string SoundSubsystem::getCardNumber()
 {
-	return mDevPropMap[CARD_NUMBER];
+	return getPropertyString(PdmDevProperty::CARD_NUMBER);
 }
\ No newline at end of file
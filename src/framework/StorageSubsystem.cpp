@@ -24,18 +24,16 @@ using namespace PdmDevAttributes;
 
 bool StorageSubsystem::mIsObjRegistered = StorageSubsystem::RegisterSubSystem();
 
-StorageSubsystem::StorageSubsystem(std::unordered_map<std::string, std::string>& devPropMap)
-	: mDevType("storage"), DeviceClass(devPropMap)
+StorageSubsystem::StorageSubsystem(const PdmDevPropertyBlockPtr &devProps)
+	: DeviceClass(devProps), mDevType("storage")
 {
-	for (auto &prop : devPropMap)
-		mDevPropMap[prop.first] = prop.second;
 }
 
 StorageSubsystem::~StorageSubsystem() {}
 
-StorageSubsystem *StorageSubsystem::create(std::unordered_map<std::string, std::string> &devProMap)
+StorageSubsystem *StorageSubsystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
-    bool canProcessEve = StorageSubsystem::canProcessEvent(devProMap);
+    bool canProcessEve = StorageSubsystem::canProcessEvent(*devProMap);
 
     if (!canProcessEve)
         return nullptr;
@@ -47,35 +45,35 @@ StorageSubsystem *StorageSubsystem::create(std::unordered_map<std::string, std::
 
 std::string StorageSubsystem::getHardDisk()
 {
-    return mDevPropMap[ID_ATA];
+    return getPropertyString(PdmDevProperty::ID_ATA);
 }
 
 std::string StorageSubsystem::isCardReader()
 {
-    return mDevPropMap[CARD_READER];
+    return getPropertyString(PdmDevProperty::CARD_READER);
 }
 
 std::string StorageSubsystem::isHardDisk()
 {
-    return mDevPropMap[HARD_DISK];
+    return getPropertyString(PdmDevProperty::HARD_DISK);
 }
 
 std::string StorageSubsystem::getIdInstance()
 {
-    return mDevPropMap[ID_INSTANCE];
+    return getPropertyString(PdmDevProperty::ID_INSTANCE);
 }
 
 std::string StorageSubsystem::getIdBlackListedSuperSpeedDev()
 {
-    return mDevPropMap[ID_BLACK_LISTED_SUPER_SPEED_DEVICE];
+    return getPropertyString(PdmDevProperty::ID_BLACK_LISTED_SUPER_SPEED_DEVICE);
 }
 
 std::string StorageSubsystem::isReadOnly()
 {
-    return mDevPropMap[READ_ONLY];
+    return getPropertyString(PdmDevProperty::READ_ONLY);
 }
 
 std::string StorageSubsystem::isDiskMediaChange()
 {
-    return mDevPropMap[DISK_MEDIA_CHANGE];
+    return getPropertyString(PdmDevProperty::DISK_MEDIA_CHANGE);
 }
\ No newline at end of file
@@ -24,19 +24,17 @@ using namespace PdmDevAttributes;
 
 bool VideoSubsystem::mIsObjRegistered = VideoSubsystem::RegisterSubSystem();
 
-VideoSubsystem::VideoSubsystem(std::unordered_map<std::string, std::string>& devPropMap)
-	: mDevType("video4linux"), DeviceClass(devPropMap)
+VideoSubsystem::VideoSubsystem(const PdmDevPropertyBlockPtr &devProps)
+	: DeviceClass(devProps), mDevType("video4linux")
 {
-	for (auto &prop : devPropMap)
-		mDevPropMap[prop.first] = prop.second;
 }
 
 VideoSubsystem::~VideoSubsystem() {}
 
-VideoSubsystem* VideoSubsystem::create(std::unordered_map<std::string, std::string>& devProMap)
+VideoSubsystem* VideoSubsystem::create(const PdmDevPropertyBlockPtr &devProMap)
 {
 	PDM_LOG_DEBUG("VideoSubsystem:%s line: %d", __FUNCTION__, __LINE__);
-	bool canProcessEve = VideoSubsystem::canProcessEvent(devProMap);
+	bool canProcessEve = VideoSubsystem::canProcessEvent(*devProMap);
 	if(!canProcessEve)
 		return nullptr;
 
@@ -47,25 +45,25 @@ VideoSubsystem* VideoSubsystem::create(std::unordered_map<std::string, std::stri
 
 std::string VideoSubsystem::getCapabilities()
 {
-	return mDevPropMap[ID_V4L_CAPABILITIES];
+	return getPropertyString(PdmDevProperty::ID_V4L_CAPABILITIES);
 }
 
 std::string VideoSubsystem::getProductName()
 {
-	return mDevPropMap[ID_V4L_PRODUCT];
+	return getPropertyString(PdmDevProperty::ID_V4L_PRODUCT);
 }
 
 std::string VideoSubsystem::getVersion()
 {
-	return mDevPropMap[ID_V4L_VERSION];
+	return getPropertyString(PdmDevProperty::ID_V4L_VERSION);
 }
 
 // std::string VideoSubsystem::getDevSpeed()
 // {
-// 	return mDevPropMap[SPEED];
+// 	return getPropertyString(PdmDevProperty::SPEED);
 // }
 
 // std::string VideoSubsystem::getUsbDriverId()
 // {
-// 	return mDevPropMap[ID_USB_DRIVER];
+// 	return getPropertyString(PdmDevProperty::ID_USB_DRIVER);
 // }
\ No newline at end of file
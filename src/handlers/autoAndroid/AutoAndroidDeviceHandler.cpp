@@ -29,6 +29,9 @@ AutoAndroidDeviceHandler::AutoAndroidDeviceHandler(PdmConfig *const pConfObj, Pl
     : DeviceHandler(pConfObj, pluginAdapter), m_deviceRemoved(false), m_context(nullptr), mHandle(nullptr)
 
 {
+    m_handlerName = "AutoAndroidHandler";
+    // Accessory mode is detected from the product id of any event, so this
+    // handler keeps PDM_EVENT_ALL
     lunaHandler->registerLunaCallback(std::bind(&AutoAndroidDeviceHandler::GetAttachedDeviceStatus, this, _1, _2),
                                       GET_DEVICESTATUS);
     lunaHandler->registerLunaCallback(std::bind(&AutoAndroidDeviceHandler::GetAttachedNonStorageDeviceList, this, _1, _2),
@@ -42,7 +45,7 @@ AutoAndroidDeviceHandler::~AutoAndroidDeviceHandler()
 bool AutoAndroidDeviceHandler::HandlerEvent(DeviceClass *devClass)
 {
 #ifdef WEBOS_SESSION
-    if (devClass->getAction() == "remove")
+    if (devClass->getDeviceAction() == USB_DEV_REMOVE)
     {
         ProcessAutoAndroidDevice(devClass);
         if (m_deviceRemoved)
@@ -265,7 +268,7 @@ void AutoAndroidDeviceHandler::ProcessAutoAndroidDevice(DeviceClass *devClass)
     AutoAndroidDevice *androidDevice = nullptr;
     try
     {
-        switch (sMapDeviceActions.at(devClass->getAction()))
+        switch (devClass->getDeviceAction())
         {
         case DeviceActions::USB_DEV_ADD:
             androidDevice = getDeviceWithPath<AutoAndroidDevice>(sList, devClass->getDevPath());
@@ -276,11 +279,13 @@ void AutoAndroidDeviceHandler::ProcessAutoAndroidDevice(DeviceClass *devClass)
                     break;
                 androidDevice->setDeviceInfo(devClass);
                 androidDevice->registerCallback(std::bind(&AutoAndroidDeviceHandler::commandNotification, this, _1, _2));
-                sList.push_back(androidDevice);
+                sList.add(androidDevice);
                 Notify(AUTO_ANDROID_DEVICE, ADD, androidDevice);
             }
-            else
+            else {
                 androidDevice->setDeviceInfo(devClass);
+                sList.refresh(androidDevice);
+            }
             break;
         case DeviceActions::USB_DEV_REMOVE:
             androidDevice = getDeviceWithPath<AutoAndroidDevice>(sList, devClass->getDevPath());
@@ -315,12 +320,14 @@ bool AutoAndroidDeviceHandler::HandlePluginEvent(int eventType)
 
 bool AutoAndroidDeviceHandler::GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedDeviceStatus<AutoAndroidDevice>(sList, payload);
+    auto listLock = lockDeviceList();
+    return getAttachedDeviceStatus<AutoAndroidDevice>(sList.devices(), payload);
 }
 
 bool AutoAndroidDeviceHandler::GetAttachedNonStorageDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedNonStorageDeviceList<AutoAndroidDevice>(sList, payload);
+    auto listLock = lockDeviceList();
+    return getAttachedNonStorageDeviceList<AutoAndroidDevice>(sList.devices(), payload, PdmDeviceFilter::fromMessage(message));
 }
 
 void AutoAndroidDeviceHandler::commandNotification(EventType event, AutoAndroidDevice *device)
@@ -22,6 +22,8 @@ using namespace PdmDevAttributes;
 
 bool BluetoothDeviceHandler::mIsObjRegistered = BluetoothDeviceHandler::RegisterObject();
 BluetoothDeviceHandler::BluetoothDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter) : DeviceHandler(pConfObj, pluginAdapter) {
+    m_handlerName = "BluetoothHandler";
+    m_eventMask = PDM_EVENT_PROP_BLUETOOTH | PDM_EVENT_SUBSYSTEM_RFKILL;
     lunaHandler->registerLunaCallback(std::bind(&BluetoothDeviceHandler::GetAttachedDeviceStatus, this, _1, _2),
                                       GET_DEVICESTATUS);
     lunaHandler->registerLunaCallback(std::bind(&BluetoothDeviceHandler::GetAttachedNonStorageDeviceList, this, _1, _2),
@@ -44,7 +46,7 @@ bool BluetoothDeviceHandler::HandlerEvent(DeviceClass* devClass){
 
     bool btDeviceProcessed = false;
     PDM_LOG_DEBUG("BluetoothDeviceHandler:%s line: %d", __FUNCTION__, __LINE__);
-   if (devClass->getAction() == "remove")
+   if (devClass->getDeviceAction() == USB_DEV_REMOVE)
     {
       ProcessBluetoothDevice(devClass);
       return btDeviceProcessed;
@@ -76,7 +78,7 @@ void BluetoothDeviceHandler::ProcessBluetoothDevice(DeviceClass* devClass){
     std::string devicePath = devClass->getDevPath();
     PDM_LOG_INFO("BluetoothDeviceHandler:",0,"%s line: %d DEVTYPE: %s ACTION: %s", __FUNCTION__,__LINE__, deviceType.c_str(), deviceAction.c_str());
  try {
-        switch(sMapDeviceActions.at(devClass->getAction()))
+        switch(devClass->getDeviceAction())
         {
             case DeviceActions::USB_DEV_ADD:
             bluetoothDevice = getDeviceWithPath< BluetoothDevice >(sList,devicePath);
@@ -86,17 +88,19 @@ void BluetoothDeviceHandler::ProcessBluetoothDevice(DeviceClass* devClass){
                 if (devClass->getSubsystemName() == "rfkill")
                 {
                     bluetoothDevice->updateDeviceInfo(devClass);
+                    sList.refresh(bluetoothDevice);
                     Notify(BLUETOOTH_DEVICE,ADD, bluetoothDevice);
                 }
 #else
                 PDM_LOG_DEBUG("BluetoothDeviceHandler:%s line: %d ACTION: DEVICE_ADD. Already present", __FUNCTION__, __LINE__);
                 bluetoothDevice->setDeviceInfo(devClass);
+                sList.refresh(bluetoothDevice);
 #endif
             } else {
                 bluetoothDevice = new(std::nothrow) BluetoothDevice(m_pConfObj, m_pluginAdapter);
                 if(bluetoothDevice){
                     bluetoothDevice->setDeviceInfo(devClass);
-                    sList.push_back(bluetoothDevice);
+                    sList.add(bluetoothDevice);
 #ifndef WEBOS_SESSION
                     Notify(BLUETOOTH_DEVICE,ADD);
 #endif
@@ -129,10 +133,12 @@ bool BluetoothDeviceHandler::HandlerCommand(CommandType *cmdtypes, CommandRespon
 
 bool BluetoothDeviceHandler::GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedDeviceStatus< BluetoothDevice >(sList, payload);
+    auto listLock = lockDeviceList();
+    return getAttachedDeviceStatus< BluetoothDevice >(sList.devices(), payload);
 }
 
 bool BluetoothDeviceHandler::GetAttachedNonStorageDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedNonStorageDeviceList< BluetoothDevice >(sList, payload);
+    auto listLock = lockDeviceList();
+    return getAttachedNonStorageDeviceList< BluetoothDevice >(sList.devices(), payload, PdmDeviceFilter::fromMessage(message));
 }
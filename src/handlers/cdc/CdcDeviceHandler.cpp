@@ -25,6 +25,8 @@ bool CdcDeviceHandler::mIsObjRegistered = CdcDeviceHandler::RegisterObject();
 
 CdcDeviceHandler::CdcDeviceHandler(PdmConfig *const pConfObj, PluginAdapter *const pluginAdapter) : DeviceHandler(pConfObj, pluginAdapter), m_is3g4gDongleSupported(true), m_deviceRemoved(false)
 {
+    m_handlerName = "CdcHandler";
+    m_eventMask = PDM_EVENT_IFC_CDC | PDM_EVENT_PROP_USB_SERIAL | PDM_EVENT_PROP_MODEM_DONGLE;
     lunaHandler->registerLunaCallback(std::bind(&CdcDeviceHandler::GetAttachedDeviceStatus, this, _1, _2),
                                       GET_DEVICESTATUS);
     lunaHandler->registerLunaCallback(std::bind(&CdcDeviceHandler::GetAttachedNonStorageDeviceList, this, _1, _2),
@@ -49,7 +51,7 @@ bool CdcDeviceHandler::HandlerEvent(DeviceClass *devClass)
 {
     PDM_LOG_DEBUG("CdcDeviceHandler:%s line: %d ", __FUNCTION__, __LINE__);
 
-    if (devClass->getAction() == "remove")
+    if (devClass->getDeviceAction() == USB_DEV_REMOVE)
     {
         m_deviceRemoved = false;
         ProcessCdcDevice(devClass);
@@ -92,7 +94,7 @@ void CdcDeviceHandler::ProcessCdcDevice(DeviceClass *devClass)
     PDM_LOG_DEBUG("CdcDeviceHandler:%s line: %d CdcDeviceHandler: DEVTYPE: %s ACTION: %s", __FUNCTION__, __LINE__, devClass->getDevType().c_str(), devClass->getAction().c_str());
     try
     {
-        switch (sMapDeviceActions.at(devClass->getAction()))
+        switch (devClass->getDeviceAction())
         {
         case DeviceActions::USB_DEV_ADD:
             PDM_LOG_DEBUG("CdcDeviceHandler:%s line: %d  Add CDC device", __FUNCTION__, __LINE__);
@@ -103,10 +105,9 @@ void CdcDeviceHandler::ProcessCdcDevice(DeviceClass *devClass)
                 if (cdcDevice)
                 {
                     cdcDevice->setDeviceInfo(devClass);
-                    sList.push_back(cdcDevice);
+                    sList.add(cdcDevice);
                     if (cdcSubsystem->getUsbModemId() == YES)
                     { // In case of modem dongle there is only a single event and no update happens later.
-                        sList.push_back(cdcDevice);
                         Notify(CDC_DEVICE, ADD); // So notify now itself
                     }
                 }
@@ -117,8 +118,8 @@ void CdcDeviceHandler::ProcessCdcDevice(DeviceClass *devClass)
             }
             else
             {
-                sList.push_back(cdcDevice);
                 cdcDevice->updateDeviceInfo(devClass);
+                sList.refresh(cdcDevice);
                 Notify(CDC_DEVICE, ADD, cdcDevice);
             }
             break;
@@ -180,15 +181,18 @@ bool CdcDeviceHandler::HandlePluginEvent(int eventType)
 
 bool CdcDeviceHandler::GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedDeviceStatus<CdcDevice>(sList, payload);
+    auto listLock = lockDeviceList();
+    return getAttachedDeviceStatus<CdcDevice>(sList.devices(), payload);
 }
 
 bool CdcDeviceHandler::GetAttachedNonStorageDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedNonStorageDeviceList<CdcDevice>(sList, payload);
+    auto listLock = lockDeviceList();
+    return getAttachedNonStorageDeviceList<CdcDevice>(sList.devices(), payload, PdmDeviceFilter::fromMessage(message));
 }
 
 bool CdcDeviceHandler::GetAttachedNetDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedNetDeviceList<CdcDevice>(sList, payload);
+    auto listLock = lockDeviceList();
+    return getAttachedNetDeviceList<CdcDevice>(sList.devices(), payload);
 }
\ No newline at end of file
@@ -24,6 +24,8 @@ bool GamepadDeviceHandler::mIsObjRegistered = GamepadDeviceHandler::RegisterObje
 
 GamepadDeviceHandler::GamepadDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter)
                      : DeviceHandler(pConfObj, pluginAdapter), m_deviceRemoved(false) {
+    m_handlerName = "GamepadHandler";
+    m_eventMask = PDM_EVENT_PROP_GAMEPAD;
     lunaHandler->registerLunaCallback(std::bind(&GamepadDeviceHandler::GetAttachedDeviceStatus, this, _1, _2),
                                       GET_DEVICESTATUS);
     lunaHandler->registerLunaCallback(std::bind(&GamepadDeviceHandler::GetAttachedNonStorageDeviceList, this, _1, _2),
@@ -34,7 +36,7 @@ bool GamepadDeviceHandler::HandlerEvent(DeviceClass* devClass)
 {
     GamepadSubSystem* gamepadSubsystem = (GamepadSubSystem*)devClass;
 
-    if (devClass->getAction() == "remove")
+    if (devClass->getDeviceAction() == USB_DEV_REMOVE)
     {
       m_deviceRemoved = false;
       ProcessGamepadDevice(devClass);
@@ -64,7 +66,7 @@ void GamepadDeviceHandler::ProcessGamepadDevice(DeviceClass* devClass){
     PDM_LOG_INFO("GamepadDeviceHandler:",0,"%s line: %d DEVTYPE: %s ACTION: %s", __FUNCTION__, __LINE__, devClass->getDevType().c_str(), devClass->getAction().c_str());
 
     try {
-            switch(sMapDeviceActions.at(devClass->getAction()))
+            switch(devClass->getDeviceAction())
             {
                 case DeviceActions::USB_DEV_ADD:
                     PDM_LOG_DEBUG("GamepadDeviceHandler:%s line: %d action : %s", __FUNCTION__, __LINE__, devClass->getAction().c_str());
@@ -73,7 +75,7 @@ void GamepadDeviceHandler::ProcessGamepadDevice(DeviceClass* devClass){
                         gamepadDevice = new (std::nothrow) GamepadDevice(m_pConfObj, m_pluginAdapter);
                         if(gamepadDevice) {
                             gamepadDevice->setDeviceInfo(devClass);
-                            sList.push_back(gamepadDevice);
+                            sList.add(gamepadDevice);
                             Notify(GAMEPAD_DEVICE,ADD);
                         }
                     }
@@ -104,10 +106,12 @@ bool GamepadDeviceHandler::HandlerCommand(CommandType *cmdtypes, CommandResponse
 
 bool GamepadDeviceHandler::GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedDeviceStatus< GamepadDevice >(sList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedDeviceStatus< GamepadDevice >(sList.devices(), payload );
 }
 
 bool GamepadDeviceHandler::GetAttachedNonStorageDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedNonStorageDeviceList< GamepadDevice >( sList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedNonStorageDeviceList< GamepadDevice >( sList.devices(), payload, PdmDeviceFilter::fromMessage(message));
 }
@@ -23,6 +23,8 @@ bool HIDDeviceHandler::mIsObjRegistered = HIDDeviceHandler::RegisterObject();
 
 HIDDeviceHandler::HIDDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter) 
                  : DeviceHandler(pConfObj, pluginAdapter), m_deviceRemoved(false){
+    m_handlerName = "HIDHandler";
+    m_eventMask = PDM_EVENT_IFC_HID;
     lunaHandler->registerLunaCallback(std::bind(&HIDDeviceHandler::GetAttachedDeviceStatus, this, _1, _2),
                                                                           GET_DEVICESTATUS);
     lunaHandler->registerLunaCallback(std::bind(&HIDDeviceHandler::GetAttachedNonStorageDeviceList, this, _1, _2),
@@ -34,7 +36,7 @@ HIDDeviceHandler::~HIDDeviceHandler() {
 
 bool HIDDeviceHandler::HandlerEvent(DeviceClass* devClass)
 {
-    if (devClass->getAction()== "remove")
+    if (devClass->getDeviceAction() == USB_DEV_REMOVE)
     {
         m_deviceRemoved = false;
         ProcessHIDDevice(devClass);
@@ -71,7 +73,7 @@ void HIDDeviceHandler::removeDevice(HIDDevice* hidDevice)
 void HIDDeviceHandler::ProcessHIDDevice(DeviceClass* devClass){
     HIDDevice *hidDevice;
    try {
-            switch(sMapDeviceActions.at(devClass->getAction()))
+            switch(devClass->getDeviceAction())
             {
                 case DeviceActions::USB_DEV_ADD:
                     hidDevice = getDeviceWithPath< HIDDevice >(sList, devClass->getDevPath());
@@ -83,9 +85,10 @@ void HIDDeviceHandler::ProcessHIDDevice(DeviceClass* devClass){
                             break;
                         hidDevice->registerCallback(std::bind(&HIDDeviceHandler::commandNotification, this, _1, _2));
                         hidDevice->setDeviceInfo(devClass);
-                        sList.push_back(hidDevice);
+                        sList.add(hidDevice);
                     }else {
                         hidDevice->setDeviceInfo(devClass);
+                        sList.refresh(hidDevice);
                     }
                     break;
                 case DeviceActions::USB_DEV_REMOVE:
@@ -120,12 +123,14 @@ bool HIDDeviceHandler::HandlePluginEvent(int eventType)
 
 bool HIDDeviceHandler::GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedDeviceStatus< HIDDevice >(sList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedDeviceStatus< HIDDevice >(sList.devices(), payload );
 }
 
 bool HIDDeviceHandler::GetAttachedNonStorageDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedNonStorageDeviceList< HIDDevice >( sList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedNonStorageDeviceList< HIDDevice >( sList.devices(), payload, PdmDeviceFilter::fromMessage(message));
 }
 
 void HIDDeviceHandler::commandNotification(EventType event, HIDDevice* device)
@@ -23,6 +23,8 @@ using namespace PdmDevAttributes;
 bool MTPDeviceHandler::mIsObjRegistered = MTPDeviceHandler::RegisterObject();
 
 MTPDeviceHandler::MTPDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter) : DeviceHandler(pConfObj, pluginAdapter){
+    m_handlerName = "MTPHandler";
+    m_eventMask = PDM_EVENT_PROP_MEDIA_PLAYER;
     lunaHandler->registerLunaCallback(std::bind(&MTPDeviceHandler::GetAttachedDeviceStatus, this, _1, _2),GET_DEVICESTATUS);
     lunaHandler->registerLunaCallback(std::bind(&MTPDeviceHandler::GetAttachedStorageDeviceList, this, _1, _2), GET_STORAGEDEVICELIST);
     lunaHandler->registerLunaCallback(std::bind(&MTPDeviceHandler::GetAttachedStorageDeviceList, this, _1, _2), GET_EXAMPLE);
@@ -36,7 +38,7 @@ bool MTPDeviceHandler::HandlerEvent(DeviceClass* devClass){
     
 #ifndef WEBOS_SESSION
    PDM_LOG_DEBUG("MTPDeviceHandler::HandlerEvent");
-   if (devClass->getAction()== "remove")
+   if (devClass->getDeviceAction() == USB_DEV_REMOVE)
    {
       ProcessMTPDevice(devClass);
       return false;
@@ -62,7 +64,7 @@ void MTPDeviceHandler::ProcessMTPDevice(DeviceClass *devClass) {
    MTPDevice *mtpDevice;
     PDM_LOG_INFO("MTPDeviceHandler:",0,"%s line: %d DEVTYPE: %s ACTION: %s", __FUNCTION__, __LINE__, devClass->getDevType().c_str(), devClass->getAction().c_str());
    try {
-            switch(sMapDeviceActions.at(devClass->getAction()))
+            switch(devClass->getDeviceAction())
             {
                 case DeviceActions::USB_DEV_ADD:
                     PDM_LOG_DEBUG("MTPDeviceHandler:%s line: %d action : %s", __FUNCTION__, __LINE__, devClass->getAction().c_str());
@@ -73,7 +75,7 @@ void MTPDeviceHandler::ProcessMTPDevice(DeviceClass *devClass) {
                         mtpDevice->setDeviceInfo(devClass);
                         mtpDevice->registerCallback(std::bind(&MTPDeviceHandler::commandNotification, this, _1, _2));
                         if(mtpDevice->mtpMount(devClass->getDevName()) == PdmDevStatus::PDM_DEV_SUCCESS){
-                            mMtpList.push_back(mtpDevice);
+                            mMtpList.add(mtpDevice);
                             Notify(MTP_DEVICE,ADD);
                         } else {
                       PDM_LOG_CRITICAL("MTPDeviceHandler:%s line: %d Unable to mount MTP Device removing", __FUNCTION__, __LINE__);
@@ -126,12 +128,14 @@ bool MTPDeviceHandler::eject(CommandType *cmdtypes, CommandResponse *cmdResponse
 
 bool MTPDeviceHandler::GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedDeviceStatus< MTPDevice >(mMtpList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedDeviceStatus< MTPDevice >(mMtpList.devices(), payload );
 }
 
 bool MTPDeviceHandler::GetAttachedStorageDeviceList (pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedStorageDeviceList< MTPDevice >(mMtpList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedStorageDeviceList< MTPDevice >(mMtpList.devices(), payload, PdmDeviceFilter::fromMessage(message));
 }
 
 void MTPDeviceHandler::commandNotification(EventType event, MTPDevice* device)
@@ -22,6 +22,8 @@ NfcDeviceHandler::NfcDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* con
                         , m_deviceRemoved(false)
 
 {
+    m_handlerName = "NfcHandler";
+    m_eventMask = PDM_EVENT_IFC_SMARTCARD;
     lunaHandler->registerLunaCallback(std::bind(&NfcDeviceHandler::GetAttachedDeviceStatus, this, _1, _2),
                                                                           GET_DEVICESTATUS);
     lunaHandler->registerLunaCallback(std::bind(&NfcDeviceHandler::GetAttachedNonStorageDeviceList, this, _1, _2),
@@ -33,7 +35,7 @@ NfcDeviceHandler::~NfcDeviceHandler() {
 
 bool NfcDeviceHandler::HandlerEvent(DeviceClass* devClass)
 {
-    if (devClass->getAction()== "remove")
+    if (devClass->getDeviceAction() == USB_DEV_REMOVE)
     {
       ProcessNfcDevice(devClass);
       if(m_deviceRemoved)
@@ -63,7 +65,7 @@ void NfcDeviceHandler::ProcessNfcDevice(DeviceClass* devClass){
     PDM_LOG_INFO("NfcDeviceHandler:",0,"%s line: %d DEVTYPE: %s ACTION: %s", __FUNCTION__, __LINE__, devClass->getDevType().c_str(), devClass->getAction().c_str());
     NfcDevice* nfcDevice = nullptr;
     try {
-        switch(sMapDeviceActions.at(devClass->getAction()))
+        switch(devClass->getDeviceAction())
         {
             case DeviceActions::USB_DEV_ADD:
                 nfcDevice = getDeviceWithPath< NfcDevice >(sList, devClass->getDevPath());
@@ -74,10 +76,12 @@ void NfcDeviceHandler::ProcessNfcDevice(DeviceClass* devClass){
                         break;
                     nfcDevice->setDeviceInfo(devClass);
                     nfcDevice->registerCallback(std::bind(&NfcDeviceHandler::commandNotification, this, _1, _2));
-                    sList.push_back(nfcDevice);
+                    sList.add(nfcDevice);
                     Notify(NFC_DEVICE,ADD, nfcDevice);
-                }else
+                }else {
                     nfcDevice->setDeviceInfo(devClass);
+                    sList.refresh(nfcDevice);
+                }
                 break;
             case DeviceActions::USB_DEV_REMOVE:
                 nfcDevice = getDeviceWithPath< NfcDevice >(sList, devClass->getDevPath());
@@ -109,12 +113,14 @@ bool NfcDeviceHandler::HandlePluginEvent(int eventType)
 
 bool NfcDeviceHandler::GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedDeviceStatus< NfcDevice >(sList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedDeviceStatus< NfcDevice >(sList.devices(), payload );
 }
 
 bool NfcDeviceHandler::GetAttachedNonStorageDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-   return getAttachedNonStorageDeviceList< NfcDevice >( sList, payload );
+    auto listLock = lockDeviceList();
+   return getAttachedNonStorageDeviceList< NfcDevice >( sList.devices(), payload, PdmDeviceFilter::fromMessage(message));
 }
 
 void NfcDeviceHandler::commandNotification(EventType event, NfcDevice* device)
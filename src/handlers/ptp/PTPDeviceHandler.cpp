@@ -22,6 +22,8 @@ using namespace PdmDevAttributes;
 bool PTPDeviceHandler::mIsObjRegistered = PTPDeviceHandler::RegisterObject();
 
 PTPDeviceHandler::PTPDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter) : DeviceHandler(pConfObj, pluginAdapter){
+    m_handlerName = "PTPHandler";
+    m_eventMask = PDM_EVENT_IFC_IMAGE;
     lunaHandler->registerLunaCallback(std::bind(&PTPDeviceHandler::GetAttachedDeviceStatus, this, _1, _2),GET_DEVICESTATUS);
     lunaHandler->registerLunaCallback(std::bind(&PTPDeviceHandler::GetAttachedStorageDeviceList, this, _1, _2), GET_STORAGEDEVICELIST);
     lunaHandler->registerLunaCallback(std::bind(&PTPDeviceHandler::GetAttachedStorageDeviceList, this, _1, _2), GET_EXAMPLE);
@@ -35,7 +37,7 @@ bool PTPDeviceHandler::HandlerEvent(DeviceClass* devClass)
 #ifndef WEBOS_SESSION
     PDM_LOG_DEBUG("PTPDeviceHandler::HandlerEvent");
 
-   if (devClass->getAction() == "remove")
+   if (devClass->getDeviceAction() == USB_DEV_REMOVE)
    {
       ProcessPTPDevice(devClass);
       return false;
@@ -69,7 +71,7 @@ void PTPDeviceHandler::ProcessPTPDevice(DeviceClass* devClass) {
     PTPDevice *ptpDevice;
     PDM_LOG_INFO("PTPDeviceHandler:",0,"%s line: %d DEVTYPE: %s ACTION: %s", __FUNCTION__,__LINE__, devClass->getDevType().c_str(), devClass->getAction().c_str());
     try {
-            switch(sMapDeviceActions.at(devClass->getAction()))
+            switch(devClass->getDeviceAction())
             {
                 case DeviceActions::USB_DEV_ADD:
                     PDM_LOG_DEBUG("PTPDeviceHandler:%s line: %d action : %s", __FUNCTION__, __LINE__, devClass->getAction().c_str());
@@ -81,7 +83,7 @@ void PTPDeviceHandler::ProcessPTPDevice(DeviceClass* devClass) {
                     ptpDevice->setDeviceInfo(devClass);
                     if(ptpDevice->getIsMounted()){
                         ptpDevice->registerCallback(std::bind(&PTPDeviceHandler::commandNotification, this, _1, _2));
-                        sList.push_back(ptpDevice);
+                        sList.add(ptpDevice);
                         Notify(PTP_DEVICE, ADD);
                     } else {
                        PDM_LOG_CRITICAL("PTPDeviceHandler:%s line: %d Unable to mount PTP Device removing", __FUNCTION__, __LINE__);
@@ -136,12 +138,14 @@ bool PTPDeviceHandler::eject(CommandType *cmdtypes, CommandResponse *cmdResponse
 
 bool PTPDeviceHandler::GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedStreamingDeviceStatus< PTPDevice >(sList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedStreamingDeviceStatus< PTPDevice >(sList.devices(), payload );
 }
 
 bool PTPDeviceHandler::GetAttachedStorageDeviceList (pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedStorageDeviceList< PTPDevice >(sList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedStorageDeviceList< PTPDevice >(sList.devices(), payload, PdmDeviceFilter::fromMessage(message));
 }
 
 bool PTPDeviceHandler::HandlePluginEvent(int eventType) {
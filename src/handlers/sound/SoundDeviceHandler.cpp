@@ -25,6 +25,8 @@ bool SoundDeviceHandler::mIsObjRegistered = SoundDeviceHandler::RegisterObject()
 SoundDeviceHandler::SoundDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter)
     : DeviceHandler(pConfObj, pluginAdapter), m_deviceRemoved(false)
 {
+    m_handlerName = "SoundHandler";
+    m_eventMask = PDM_EVENT_IFC_AUDIO | PDM_EVENT_SUBSYSTEM_SOUND;
     lunaHandler->registerLunaCallback(std::bind(&SoundDeviceHandler::GetAttachedDeviceStatus, this, _1, _2),
                                                                           GET_DEVICESTATUS);
     lunaHandler->registerLunaCallback(std::bind(&SoundDeviceHandler::GetAttachedAudioDeviceList, this, _1, _2),
@@ -49,7 +51,7 @@ SoundDeviceHandler::~SoundDeviceHandler() {
 bool SoundDeviceHandler::HandlerEvent(DeviceClass* deviceClass)
 {
     PDM_LOG_DEBUG("SoundDeviceHandleri check:%s line: %d ", __FUNCTION__, __LINE__);
-    if ((deviceClass->getAction() != "remove") && !isSoundDevice(deviceClass)) {
+    if ((deviceClass->getDeviceAction() != USB_DEV_REMOVE) && !isSoundDevice(deviceClass)) {
         return false;
     }
 
@@ -77,7 +79,7 @@ void SoundDeviceHandler::removeDevice(SoundDevice* soundDevice)
 void SoundDeviceHandler::ProcessSoundDevice(DeviceClass* deviceClass){
     SoundDevice *soundDevice;
     try {
-            switch(sMapDeviceActions.at(deviceClass->getAction()))
+            switch(deviceClass->getDeviceAction())
             {
                 case DeviceActions::USB_DEV_ADD:
                 soundDevice = getDeviceWithPath< SoundDevice >(sList, deviceClass->getDevPath());
@@ -86,13 +88,14 @@ void SoundDeviceHandler::ProcessSoundDevice(DeviceClass* deviceClass){
                         soundDevice = new (std::nothrow) SoundDevice(m_pConfObj, m_pluginAdapter);
                         if(soundDevice) {
                             soundDevice->setDeviceInfo(deviceClass);
-                            sList.push_back(soundDevice);
+                            sList.add(soundDevice);
                         } else {
                             PDM_LOG_CRITICAL("SoundDeviceHandler:%s line: %d Unable to create new Sound device", __FUNCTION__, __LINE__);
                         }
                     }
                 } else {
                     soundDevice->updateDeviceInfo(deviceClass);
+                    sList.refresh(soundDevice);
                     if (soundDevice->getBuiltIn()) {
                         PDM_LOG_DEBUG("SoundDeviceHandler:%s line: %d notify for builtin devices", __FUNCTION__, __LINE__);
                         Notify(SOUND_DEVICE, ADD);
@@ -112,6 +115,7 @@ void SoundDeviceHandler::ProcessSoundDevice(DeviceClass* deviceClass){
                 if(soundDevice){
                    PDM_LOG_DEBUG("SoundDeviceHandlerif:%s line: %d USB_DEV_CHANGE ", __FUNCTION__, __LINE__);
                    soundDevice->updateDeviceInfo(deviceClass);
+                   sList.refresh(soundDevice);
                    Notify(SOUND_DEVICE,ADD);
                 }
                  break;
@@ -138,22 +142,26 @@ bool SoundDeviceHandler::HandlePluginEvent(int eventType)
 
 bool SoundDeviceHandler::GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedDeviceStatus< SoundDevice >(sList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedDeviceStatus< SoundDevice >(sList.devices(), payload );
 }
 
 bool SoundDeviceHandler::GetAttachedAudioDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedAudioDeviceList< SoundDevice >( sList, payload, false);
+    auto listLock = lockDeviceList();
+    return getAttachedAudioDeviceList< SoundDevice >( sList.devices(), payload, false);
 }
 
 bool SoundDeviceHandler::GetAttachedAudioSubDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedAudioDeviceList< SoundDevice >( sList, payload, true);
+    auto listLock = lockDeviceList();
+    return getAttachedAudioDeviceList< SoundDevice >( sList.devices(), payload, true);
 }
 
 bool SoundDeviceHandler::GetAttachedNonStorageDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedNonStorageDeviceList< SoundDevice >( sList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedNonStorageDeviceList< SoundDevice >( sList.devices(), payload, PdmDeviceFilter::fromMessage(message));
 }
 
 bool SoundDeviceHandler::isSoundDevice(DeviceClass* deviceClass)
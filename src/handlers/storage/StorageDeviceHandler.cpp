@@ -16,6 +16,7 @@
 
 #include "StorageDeviceHandler.h"
 #include "PdmErrors.h"
+#include "PdmDeviceHistory.h"
 #include "PdmLogUtils.h"
 #include "PdmJson.h"
 #include <algorithm>
@@ -43,9 +44,12 @@ bool StorageDeviceHandler::mIsObjRegistered = StorageDeviceHandler::RegisterObje
 
 StorageDeviceHandler::StorageDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter)
             : DeviceHandler(pConfObj, pluginAdapter)
-            , mSpaceInfoThreadStatus(false) {
+            , mSpaceInfoThreadStatus(false)
+            , mPendingDevices(0) {
 
     m_handlerName = "StorageHandler";
+    m_eventMask = PDM_EVENT_IFC_STORAGE | PDM_EVENT_PROP_ATA;
+    m_ownsListLock = true;
     m_maxStorageDevices = readMaxUsbStorageDevices();
     lunaHandler->registerLunaCallback(std::bind(&StorageDeviceHandler::GetAttachedDeviceStatus, this, _1, _2), GET_DEVICESTATUS);
     lunaHandler->registerLunaCallback(std::bind(&StorageDeviceHandler::GetAttachedStorageDeviceList, this, _1, _2), GET_STORAGEDEVICELIST);
@@ -98,7 +102,7 @@ int StorageDeviceHandler::readMaxUsbStorageDevices()
 bool StorageDeviceHandler::HandlerEvent(DeviceClass* devClass)
 {
     PDM_LOG_DEBUG("StorageDeviceHandler::HandlerEvent");
-   if (devClass->getAction()== "remove")
+   if (devClass->getDeviceAction() == USB_DEV_REMOVE)
    {
       if(deleteStorageDevice(devClass)) {
          PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d  DEVTYPE=usb_device removed", __FUNCTION__, __LINE__);
@@ -165,7 +169,7 @@ bool StorageDeviceHandler::HandlerCommand(CommandType *cmdtypes, CommandResponse
 void StorageDeviceHandler::ProcessStorageDevice(DeviceClass* devClass) {
     PDM_LOG_INFO("StorageDeviceHandler:",0,"%s line: %d DEVTYPE: %s ACTION: %s", __FUNCTION__,__LINE__, devClass->getDevType().c_str(), devClass->getAction().c_str());
     try {
-        switch(sMapDeviceActions.at(devClass->getAction()))
+        switch(devClass->getDeviceAction())
          {
              case DeviceActions::USB_DEV_ADD:
              case DeviceActions::USB_DEV_CHANGE:
@@ -181,9 +185,17 @@ void StorageDeviceHandler::ProcessStorageDevice(DeviceClass* devClass) {
     }
 }
 
-void StorageDeviceHandler::checkStorageDevice(DeviceClass* devClass) {
+void StorageDeviceHandler::checkStorageDevice(DeviceClass* devClass, bool replay) {
 
-    StorageDevice *storageDevPath = getDeviceWithPath< StorageDevice >(mStorageList, devClass->getDevPath());
+    StorageDevice *storageDevPath = nullptr;
+    StorageDevice *storageDevName = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mStorageListMtx);
+        storageDevPath = getDeviceWithPath< StorageDevice >(mStorageList, devClass->getDevPath());
+        storageDevName = getDeviceWithName< StorageDevice >(mStorageList, devClass->getDevName());
+        if(!replay && (holdEventLocked(storageDevName, devClass) || holdEventLocked(storageDevPath, devClass)))
+            return;
+    }
     if((devClass->getDevType() == USB_DEVICE) && (storageDevPath == nullptr)) {
         PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d New device with path DEVNAME: %s", __FUNCTION__, __LINE__, devClass->getDevName().c_str());
         createStorageDevice(devClass, nullptr);
@@ -193,14 +205,14 @@ void StorageDeviceHandler::checkStorageDevice(DeviceClass* devClass) {
     if(storageDevPath && storageDevPath->getDeviceName() == "") {
         PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d updated device name empty DEVNAME: %s", __FUNCTION__, __LINE__, devClass->getDevName().c_str());
         storageDevPath->setDeviceInfo(devClass);
+        refreshDevice(storageDevPath);
         return;
     }
 
-    StorageDevice *storageDevName = getDeviceWithName< StorageDevice >(mStorageList, devClass->getDevName());
-
     if(storageDevName && storageDevPath) {
         PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d update device with name DEVNAME: %s", __FUNCTION__, __LINE__, devClass->getDevName().c_str());
         storageDevName->setDeviceInfo(devClass);
+        refreshDevice(storageDevName);
         return;
     }
     if(storageDevPath && storageDevName == nullptr) {
@@ -214,14 +226,20 @@ void StorageDeviceHandler::checkStorageDevice(DeviceClass* devClass) {
 void StorageDeviceHandler::createStorageDevice(DeviceClass* devClass, IDevice *device)
 {
     PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d DEVNAME: %s", __FUNCTION__, __LINE__, devClass->getDevName().c_str());
-    if(mStorageList.size() >= m_maxStorageDevices) {
-        PDM_LOG_CRITICAL("StorageDeviceHandler:%s line: %d Storage Device count: %zd has reached max. Dont process", __FUNCTION__, __LINE__, mStorageList.size());
-        Notify(STORAGE_DEVICE,MAX_COUNT_REACHED);
-        return;
+    {
+        std::lock_guard<std::mutex> lock(mStorageListMtx);
+        if(mStorageList.size() + mPendingDevices >= m_maxStorageDevices) {
+            PDM_LOG_CRITICAL("StorageDeviceHandler:%s line: %d Storage Device count: %zd has reached max. Dont process", __FUNCTION__, __LINE__, mStorageList.size());
+            Notify(STORAGE_DEVICE,MAX_COUNT_REACHED);
+            return;
+        }
+        mPendingDevices++;
     }
     StorageDevice *storageDev = new (std::nothrow) StorageDevice(m_pConfObj, m_pluginAdapter);
     if(nullptr == storageDev) {
          PDM_LOG_CRITICAL("StorageDeviceHandler:%s line: %d Unable to create new USB StorageDevice", __FUNCTION__, __LINE__);
+         std::lock_guard<std::mutex> lock(mStorageListMtx);
+         mPendingDevices--;
          return;
     }
     storageDev->registerCallback(std::bind(&StorageDeviceHandler::commandNotification, this, _1, _2));
@@ -231,7 +249,8 @@ void StorageDeviceHandler::createStorageDevice(DeviceClass* devClass, IDevice *d
     }
     storageDev->setDeviceInfo(devClass);
     std::lock_guard<std::mutex> lock(mStorageListMtx);
-    mStorageList.push_back(storageDev);
+    mPendingDevices--;
+    mStorageList.add(storageDev);
     PDM_LOG_DEBUG("StorageDeviceHandler: %s line: %d Storage Device count: %zd ", __FUNCTION__,__LINE__,mStorageList.size());
 
 }
@@ -243,14 +262,18 @@ bool StorageDeviceHandler::deleteStorageDevice(DeviceClass* devClass)
    bool deviceRemoveStatus =  false;
 
     if(devClass->getDevType() == USB_DEVICE) {
+           std::lock_guard<std::mutex> lock(mStorageListMtx);
            PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d with USB_DEVICE list size: %zd", __FUNCTION__, __LINE__, mStorageList.size());
            storageDev = getDeviceWithPath < StorageDevice > (mStorageList, devClass->getDevPath());
          if(storageDev) {
             deviceRemoveStatus = true;
          }
     } else if(devClass->getDevType() == DISK) {
-        PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d with DISK list size: %zd", __FUNCTION__, __LINE__, mStorageList.size());
-        storageDev = getDeviceWithName < StorageDevice > (mStorageList, devClass->getDevName());
+        {
+            std::lock_guard<std::mutex> lock(mStorageListMtx);
+            PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d with DISK list size: %zd", __FUNCTION__, __LINE__, mStorageList.size());
+            storageDev = getDeviceWithName < StorageDevice > (mStorageList, devClass->getDevName());
+        }
         if(nullptr == storageDev){
             PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d with storageDev is null for DEVNAME: %s", __FUNCTION__, __LINE__, devClass->getDevName().c_str());
             return deviceRemoveStatus;
@@ -260,6 +283,16 @@ bool StorageDeviceHandler::deleteStorageDevice(DeviceClass* devClass)
     }
    if(nullptr == storageDev)
         return deviceRemoveStatus;
+    {
+        std::lock_guard<std::mutex> lock(mStorageListMtx);
+        mRemovingDevices.insert(storageDev);
+        if(mDeviceUseCount.find(storageDev) != mDeviceUseCount.end()) {
+            PDM_LOG_INFO("StorageDeviceHandler:",0,"%s line: %d device in use by a command, removal deferred", __FUNCTION__,__LINE__);
+            mStorageList.remove(storageDev);
+            mDeferredRemoval.insert(storageDev);
+            return deviceRemoveStatus;
+        }
+    }
     storageDev->onDeviceRemove();
     removeDevice(storageDev);
    return deviceRemoveStatus;
@@ -272,6 +305,8 @@ void StorageDeviceHandler::removeDevice(StorageDevice *storageDevice)
         PDM_LOG_INFO("StorageDeviceHandler:",0,"%s line: %d", __FUNCTION__,__LINE__);
         std::lock_guard<std::mutex> lock(mStorageListMtx);
         mStorageList.remove(storageDevice);
+        mRemovingDevices.erase(storageDevice);
+        mHeldEvents.erase(storageDevice);
         if(storageDevice->isDevAddNotified()) {
             PDM_LOG_INFO("StorageDeviceHandler:",0,"%s line: %d", __FUNCTION__,__LINE__);
             Notify(STORAGE_DEVICE, REMOVE, storageDevice);
@@ -282,17 +317,133 @@ void StorageDeviceHandler::removeDevice(StorageDevice *storageDevice)
     }
 }
 
+void StorageDeviceHandler::refreshDevice(StorageDevice *storageDevice)
+{
+    std::lock_guard<std::mutex> lock(mStorageListMtx);
+    mStorageList.refresh(storageDevice);
+}
+
+void StorageDeviceHandler::acquireDeviceLocked(StorageDevice *storageDevice)
+{
+    if(storageDevice)
+        mDeviceUseCount[storageDevice]++;
+}
+
+StorageDevice* StorageDeviceHandler::acquireDeviceWithName(const std::string &devName)
+{
+    std::lock_guard<std::mutex> lock(mStorageListMtx);
+    StorageDevice *storageDev = getDeviceWithName<StorageDevice>(mStorageList, devName);
+    if(storageDev && mRemovingDevices.count(storageDev))
+        return nullptr;
+    acquireDeviceLocked(storageDev);
+    return storageDev;
+}
+
+StorageDevice* StorageDeviceHandler::acquireDeviceWithNum(int devNum)
+{
+    std::lock_guard<std::mutex> lock(mStorageListMtx);
+    StorageDevice *storageDev = getDeviceWithNum<StorageDevice>(mStorageList, devNum);
+    if(storageDev && mRemovingDevices.count(storageDev))
+        return nullptr;
+    acquireDeviceLocked(storageDev);
+    return storageDev;
+}
+
+std::list<StorageDevice*> StorageDeviceHandler::acquireAllDevices()
+{
+    std::list<StorageDevice*> devices;
+    std::lock_guard<std::mutex> lock(mStorageListMtx);
+    for(auto storageDev : mStorageList) {
+        if(mRemovingDevices.count(storageDev))
+            continue;
+        acquireDeviceLocked(storageDev);
+        devices.push_back(storageDev);
+    }
+    return devices;
+}
+
+// A job must not race the hotplug update of the device it works on, so the
+// add/change events of a device in use are kept until the job is done
+bool StorageDeviceHandler::holdEventLocked(StorageDevice *storageDevice, DeviceClass *devClass)
+{
+    if(!storageDevice || mDeviceUseCount.find(storageDevice) == mDeviceUseCount.end())
+        return false;
+    PDM_LOG_INFO("StorageDeviceHandler:",0,"%s line: %d device in use, event held DEVNAME: %s", __FUNCTION__,__LINE__,devClass->getDevName().c_str());
+    mHeldEvents[storageDevice].emplace_back(new StorageSubsystem(*static_cast<StorageSubsystem*>(devClass)));
+    return true;
+}
+
+void StorageDeviceHandler::releaseDevice(StorageDevice *storageDevice)
+{
+    if(!storageDevice)
+        return;
+
+    for(;;) {
+        std::list<std::unique_ptr<DeviceClass>> heldEvents;
+        bool completeRemoval = false;
+        {
+            std::lock_guard<std::mutex> lock(mStorageListMtx);
+            auto it = mDeviceUseCount.find(storageDevice);
+            if(it == mDeviceUseCount.end())
+                return;
+            // The last user replays the held events while still holding the
+            // device, events arriving meanwhile are held behind them
+            auto held = mHeldEvents.find(storageDevice);
+            if(it->second == 1 && held != mHeldEvents.end() && !mRemovingDevices.count(storageDevice)) {
+                heldEvents.swap(held->second);
+                mHeldEvents.erase(held);
+            } else {
+                if(--it->second > 0)
+                    return;
+                mDeviceUseCount.erase(it);
+                mHeldEvents.erase(storageDevice);
+                completeRemoval = (mDeferredRemoval.erase(storageDevice) > 0);
+            }
+        }
+        if(heldEvents.empty()) {
+            if(completeRemoval) {
+                PDM_LOG_INFO("StorageDeviceHandler:",0,"%s line: %d completing deferred device removal", __FUNCTION__,__LINE__);
+                storageDevice->onDeviceRemove();
+                removeDevice(storageDevice);
+            }
+            return;
+        }
+        for(auto &event : heldEvents) {
+            {
+                std::lock_guard<std::mutex> lock(mStorageListMtx);
+                if(mRemovingDevices.count(storageDevice))
+                    break;
+            }
+            checkStorageDevice(event.get(), true);
+        }
+    }
+}
+
+// The processes which kept a drive busy, so that the caller can close them
+void StorageDeviceHandler::appendBusyPids(CommandResponse *cmdResponse, const std::vector<pid_t> &busyPids)
+{
+    if(cmdResponse == nullptr || busyPids.empty())
+        return;
+    pbnjson::JValue pids = pbnjson::Array();
+    for(auto pid : busyPids)
+        pids.append(static_cast<int64_t>(pid));
+    cmdResponse->cmdResponse.put("busyPids", pids);
+}
+
 bool StorageDeviceHandler::format(CommandType *cmdtypes, CommandResponse *cmdResponse) {
     PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d", __FUNCTION__, __LINE__);
     FormatCommand *formatcmd = reinterpret_cast<FormatCommand*>(cmdtypes);
-    StorageDevice* storageDev = getDeviceWithName<StorageDevice>(mStorageList,formatcmd->driveName);
+    StorageDevice* storageDev = acquireDeviceWithName(formatcmd->driveName);
     PdmDevStatus result = PdmDevStatus::PDM_DEV_DRIVE_NOT_FOUND;
+    std::vector<pid_t> busyPids;
     bool ret = false;
     if(storageDev) {
-        result = storageDev->formatDiskStart(formatcmd->driveName,formatcmd->fsType,formatcmd->volumeLabel);
+        result = storageDev->formatDiskStart(formatcmd->driveName,formatcmd->fsType,formatcmd->volumeLabel,&busyPids);
+        releaseDevice(storageDev);
         ret =  true;
     }
     commandResponse(cmdResponse,result);
+    appendBusyPids(cmdResponse,busyPids);
     return ret;
 }
 
@@ -300,15 +451,18 @@ bool StorageDeviceHandler::format(CommandType *cmdtypes, CommandResponse *cmdRes
 bool StorageDeviceHandler::eject(CommandType *cmdtypes, CommandResponse *cmdResponse) {
     EjectCommand *ejectcmd = reinterpret_cast<EjectCommand*>(cmdtypes);
     PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d deviceNum:%d", __FUNCTION__, __LINE__, ejectcmd->deviceNumber);
-    StorageDevice *storageDev = getDeviceWithNum<StorageDevice>(mStorageList,ejectcmd->deviceNumber);
+    StorageDevice *storageDev = acquireDeviceWithNum(ejectcmd->deviceNumber);
     PdmDevStatus result = PdmDevStatus::PDM_DEV_DEVICE_NOT_FOUND;
+    std::vector<pid_t> busyPids;
     bool ret = false;
     if(storageDev) {
-        result = storageDev->eject();
+        result = storageDev->eject(&busyPids);
+        releaseDevice(storageDev);
         Notify(STORAGE_DEVICE,UNMOUNTALL);
         ret = true;
     }
     commandResponse(cmdResponse,result);
+    appendBusyPids(cmdResponse,busyPids);
     return ret;
 }
 
@@ -319,34 +473,41 @@ bool StorageDeviceHandler::fsck(CommandType *cmdtypes, CommandResponse *cmdRespo
     std::string::iterator end_pos = std::remove(driveName.begin(), driveName.end(), ' ');
     driveName.erase(end_pos, driveName.end());
     PdmDevStatus result = PdmDevStatus::PDM_DEV_DRIVE_NOT_FOUND;
+    std::vector<pid_t> busyPids;
     bool ret = false;
-    StorageDevice *storageDev = getDeviceWithName<StorageDevice>(mStorageList,driveName);
+    StorageDevice *storageDev = acquireDeviceWithName(driveName);
     if(storageDev) {
         PDM_LOG_INFO("StorageDeviceHandler:",0,"%s line: %d deviceName:%s", __FUNCTION__,__LINE__,storageDev->getDeviceName().c_str());
-        result = storageDev->fsck(driveName);
+        result = storageDev->fsck(driveName, &busyPids);
+        releaseDevice(storageDev);
         ret = true;
     }
     commandResponse(cmdResponse,result);
+    appendBusyPids(cmdResponse,busyPids);
     return ret;
 }
 
 bool StorageDeviceHandler::umountAllDrive(CommandResponse *cmdResponse) {
     PdmDevStatus result = PdmDevStatus::PDM_DEV_SUCCESS;
+    std::vector<pid_t> busyPids;
     bool ret = false;
     PDM_LOG_DEBUG("StorageDeviceHandler:%s line: %d", __FUNCTION__, __LINE__);
 
-    if(!mStorageList.empty()){
-        for (std::list<StorageDevice*>::iterator it = mStorageList.begin(); it != mStorageList.end(); it++){
-                PdmDevStatus tempResult = (*it)->umountAllPartition(false);
+    std::list<StorageDevice*> storageDevices = acquireAllDevices();
+    if(!storageDevices.empty()){
+        for (auto storageDev : storageDevices){
+                PdmDevStatus tempResult = storageDev->umountAllPartition(false, &busyPids);
                 if(tempResult != PdmDevStatus::PDM_DEV_SUCCESS) {
                     PDM_LOG_ERROR("StorageDeviceHandler:%s line: %d Fail to umount all drive", __FUNCTION__, __LINE__);
                     result = tempResult;
                 }
+                releaseDevice(storageDev);
         }
         Notify(STORAGE_DEVICE,UNMOUNTALL);
         ret = true;
     }
     commandResponse(cmdResponse,result);
+    appendBusyPids(cmdResponse,busyPids);
     return ret;
 }
 
@@ -357,9 +518,10 @@ bool StorageDeviceHandler::setVolumeLabel(CommandType *cmdtypes, CommandResponse
     PdmDevStatus result = PdmDevStatus::PDM_DEV_DRIVE_NOT_FOUND;
     bool ret= false;
     // Get the device in which the partition is present
-    StorageDevice* storageDev = getDeviceWithName<StorageDevice>(mStorageList, volumeLabelcmd->driveName);
+    StorageDevice* storageDev = acquireDeviceWithName(volumeLabelcmd->driveName);
     if(storageDev) {
         result = storageDev->setPartitionVolumeLabel(volumeLabelcmd->driveName,volumeLabelcmd->volumeLabel);
+        releaseDevice(storageDev);
         ret =  true;
     }
     commandResponse(cmdResponse,result);
@@ -373,9 +535,10 @@ bool StorageDeviceHandler::isWritableDrive(CommandType *cmdtypes, CommandRespons
     PdmDevStatus result = PdmDevStatus::PDM_DEV_ERROR;
     bool ret = false;
     // Get the device in which the partition is present
-    StorageDevice* storageDev = getDeviceWithName<StorageDevice>(mStorageList,isWritablecmd->driveName);
+    StorageDevice* storageDev = acquireDeviceWithName(isWritablecmd->driveName);
     if(storageDev) {
         result = storageDev->isWritable(isWritablecmd->driveName, isWritable);
+        releaseDevice(storageDev);
         ret = true;
     }
     commandResponse(cmdResponse,result);
@@ -391,38 +554,43 @@ void StorageDeviceHandler::commandNotification(EventType event, Storage* device)
     else
         Notify(STORAGE_DEVICE,event,device);
 
+    // Events of different devices may notify concurrently. The device list
+    // may be locked by the notifier, the thread checks for mounted devices
+    // itself and ends right away if there is none.
+    std::lock_guard<std::mutex> lock(mSpaceInfoThreadMtx);
     if(mSpaceInfoThreadStatus == false)
     {
-        if ( std::any_of(mStorageList.begin(), mStorageList.end(), [&](StorageDevice* dev){return dev->getIsMounted();}) )
+        if(mSpaceInfoThread.joinable())
         {
-            if(mSpaceInfoThread.joinable())
-            {
-                mSpaceInfoThread.join();
-            }
-            mSpaceInfoThread = std::thread(&StorageDeviceHandler::computeSpaceInfoThread,this);
+            mSpaceInfoThread.join();
         }
+        mSpaceInfoThreadStatus = true;
+        mSpaceInfoThread = std::thread(&StorageDeviceHandler::computeSpaceInfoThread,this);
     }
 }
 
 bool StorageDeviceHandler::GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedStorageDeviceStatus< StorageDevice >(mStorageList, payload );
+    std::lock_guard<std::mutex> lock(mStorageListMtx);
+    return getAttachedStorageDeviceStatus< StorageDevice >(mStorageList.devices(), payload );
 }
 
 bool StorageDeviceHandler::GetAttachedStorageDeviceList (pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedUsbStorageDeviceList< StorageDevice >(mStorageList, payload );
+    std::lock_guard<std::mutex> lock(mStorageListMtx);
+    return getAttachedUsbStorageDeviceList< StorageDevice >(mStorageList.devices(), payload, PdmDeviceFilter::fromMessage(message));
 }
 
 bool StorageDeviceHandler::GetExampleAttachedUsbStorageDeviceList (pbnjson::JValue &payload, LSMessage *message)
 {
-    return getExampleAttachedUsbStorageDeviceList< StorageDevice >(mStorageList, payload );
+    std::lock_guard<std::mutex> lock(mStorageListMtx);
+    return getExampleAttachedUsbStorageDeviceList< StorageDevice >(mStorageList.devices(), payload );
 }
 
 bool StorageDeviceHandler::getSpaceInfo (CommandType *cmdtypes, CommandResponse *cmdResponse)
 {
     SpaceInfoCommand *spaceCmd = reinterpret_cast<SpaceInfoCommand*>(cmdtypes);
-    StorageDevice* storageDev = getDeviceWithName<StorageDevice>(mStorageList,spaceCmd->driveName);
+    StorageDevice* storageDev = acquireDeviceWithName(spaceCmd->driveName);
 
     if(!storageDev) {
         commandResponse(cmdResponse,PdmDevStatus::PDM_DEV_DRIVE_NOT_FOUND);
@@ -443,12 +611,12 @@ bool StorageDeviceHandler::getSpaceInfo (CommandType *cmdtypes, CommandResponse
         commandResponse(cmdResponse,PdmDevStatus::PDM_DEV_DRIVE_NOT_MOUNTED);
         PDM_LOG_WARNING("StorageDeviceHandler:%s line: %d driveName:%s Device not mounted", __FUNCTION__, __LINE__, spaceCmd->driveName.c_str());
     }
+    releaseDevice(storageDev);
     return true;
 }
 
 void StorageDeviceHandler::computeSpaceInfoThread()
 {
-    mSpaceInfoThreadStatus = true;
     while(mSpaceInfoThreadStatus) {
         mStorageListMtx.lock();
         if(mStorageList.empty()) {
@@ -495,9 +663,10 @@ bool StorageDeviceHandler::mountFsck(CommandType *cmdtypes, CommandResponse *cmd
     PDM_LOG_INFO("StorageDeviceHandler:",0,"%s line: %d mountName: %s, needFsck : %d", __FUNCTION__,__LINE__,formatcmd->mountName.c_str(),formatcmd->needFsck);
     PdmDevStatus result = PdmDevStatus::PDM_DEV_ERROR;
     bool ret=  false;
-    StorageDevice* storageDev = getDeviceWithName<StorageDevice>(mStorageList,formatcmd->mountName);
+    StorageDevice* storageDev = acquireDeviceWithName(formatcmd->mountName);
     if(storageDev) {
         result  = storageDev->enforceFsckAndMount(formatcmd->needFsck);
+        releaseDevice(storageDev);
         ret = true;
     }
     commandResponse(cmdResponse,result);
@@ -531,29 +700,8 @@ bool StorageDeviceHandler::HandlePluginEvent(int eventType) {
 bool StorageDeviceHandler::umountAllDrive(bool lazyUnmount) {
     bool retVal = true;
 #ifdef WEBOS_SESSION
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue query;
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                             {"where", pbnjson::JArray{{{"prop", "deviceType"}, {"op", "="}, {"val", "USB_STORAGE"}}}}};
-
-    find_query.put("query", query);
-
-    LS::Payload find_payload(find_query);
-    LS::Call call = LunaIPC::getInstance()->getLSCPPHandle()->callOneReply("luna://com.webos.service.db/find", find_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull())
-    {
-        PDM_LOG_ERROR("PdmLunaService::%s line: %d Nothing is there in Db ",  __FUNCTION__, __LINE__);
-    }
-
-    if(!request["returnValue"].asBool())
-    {
-        PDM_LOG_ERROR("PdmLunaService::%s line: %d not able to find from db",  __FUNCTION__, __LINE__);
-    }
+    // Runs on suspend, the mount names come from memory instead of DB8
+    pbnjson::JValue request = PdmDeviceHistory::getInstance().findDeviceType("USB_STORAGE");
 
     for(ssize_t index = 0; index < request.arraySize() ; index++) {
         if(request[index]["deviceType"] == "USB_STORAGE") {
@@ -576,9 +724,10 @@ bool StorageDeviceHandler::umountAllDrive(bool lazyUnmount) {
     }
 
 #else
-    for(auto storageDevice : mStorageList) {
+    for(auto storageDevice : acquireAllDevices()) {
         if(storageDevice->suspendUmountAllPartitions(lazyUnmount) == false)
             retVal = false;
+        releaseDevice(storageDevice);
     }
 #endif
     return retVal;
@@ -586,13 +735,17 @@ bool StorageDeviceHandler::umountAllDrive(bool lazyUnmount) {
 
 void StorageDeviceHandler::suspendRequest() {
 
-    for( auto storageDev : mStorageList  )
+    for( auto storageDev : acquireAllDevices() ) {
         storageDev->suspendRequest();
+        releaseDevice(storageDev);
+    }
 }
 
 void StorageDeviceHandler::resumeRequest(const int &eventType) {
     PDM_LOG_INFO("StorageDeviceHandler:",0,"%s line: %d", __FUNCTION__,__LINE__);
-    for( auto storageDev : mStorageList  )
+    for( auto storageDev : acquireAllDevices() ) {
         storageDev->resumeRequest(eventType);
+        releaseDevice(storageDev);
+    }
     Notify(STORAGE_DEVICE, ADD);
 }
\ No newline at end of file
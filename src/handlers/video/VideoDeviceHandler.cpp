@@ -24,6 +24,8 @@ bool VideoDeviceHandler::mIsObjRegistered = VideoDeviceHandler::RegisterObject()
 
 VideoDeviceHandler::VideoDeviceHandler(PdmConfig* const pConfObj, PluginAdapter* const pluginAdapter) :
                        DeviceHandler(pConfObj, pluginAdapter),mIsCameraReady(true),mdeviceRemoved(false){
+    m_handlerName = "VideoHandler";
+    m_eventMask = PDM_EVENT_IFC_VIDEO;
     lunaHandler->registerLunaCallback(std::bind(&VideoDeviceHandler::GetAttachedDeviceStatus, this, _1, _2),
                                                                           GET_DEVICESTATUS);
     lunaHandler->registerLunaCallback(std::bind(&VideoDeviceHandler::GetAttachedNonStorageDeviceList, this, _1, _2),
@@ -43,7 +45,7 @@ bool VideoDeviceHandler::HandlerEvent(DeviceClass* devClass)
 
     PDM_LOG_DEBUG("VideoDeviceHandler::HandlerEvent");
     std::string interfaceClass = devClass->getInterfaceClass();
-    if((interfaceClass.find(iClass) == std::string::npos) && (devClass->getAction() != "remove"))
+    if((interfaceClass.find(iClass) == std::string::npos) && (devClass->getDeviceAction() != USB_DEV_REMOVE))
         return false;
     if(devClass->getDevType() ==  USB_DEVICE) {
         ProcessVideoDevice(devClass);
@@ -73,7 +75,7 @@ void VideoDeviceHandler::ProcessVideoDevice(DeviceClass* devClass){
     VideoDevice *videoDevice;
     PDM_LOG_INFO("VideoDeviceHandler:",0,"%s line: %d DEVTYPE: %s SUBSYSTEM:%s ACTION: %s", __FUNCTION__,__LINE__, devClass->getDevType().c_str(), devClass->getSubsystemName().c_str(), devClass->getAction().c_str());
     try {
-            switch(sMapDeviceActions.at(devClass->getAction()))
+            switch(devClass->getDeviceAction())
             {
                 case DeviceActions::USB_DEV_ADD:
                     PDM_LOG_DEBUG("VideoDeviceHandler:%s line: %d action : %s DEVPATH: %s", __FUNCTION__, __LINE__, devClass->getAction().c_str(), devClass->getDevPath().c_str());
@@ -85,10 +87,11 @@ void VideoDeviceHandler::ProcessVideoDevice(DeviceClass* devClass){
                             return;
                         }
                         videoDevice->setDeviceInfo(devClass, mIsCameraReady);
-                        sList.push_back(videoDevice);
+                        sList.add(videoDevice);
                     } else {
                         PDM_LOG_INFO("VideoDeviceHandler",0," update the video device info.");
                         videoDevice->updateDeviceInfo(devClass);
+                        sList.refresh(videoDevice);
                         if(!mIsCameraReady)
                             Notify(UNKNOWN_DEVICE, ADD);
                         else {
@@ -140,21 +143,25 @@ bool VideoDeviceHandler::HandlePluginEvent(int eventType) {
 
 bool VideoDeviceHandler::GetAttachedDeviceStatus(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedDeviceStatus< VideoDevice >(sList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedDeviceStatus< VideoDevice >(sList.devices(), payload );
 }
 
 bool VideoDeviceHandler::GetAttachedNonStorageDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-    return getAttachedNonStorageDeviceList< VideoDevice >( sList, payload );
+    auto listLock = lockDeviceList();
+    return getAttachedNonStorageDeviceList< VideoDevice >( sList.devices(), payload, PdmDeviceFilter::fromMessage(message));
 }
 
 
 bool VideoDeviceHandler::GetAttachedVideoDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-       return getAttachedVideoDeviceList< VideoDevice >( sList, payload, false);
+    auto listLock = lockDeviceList();
+       return getAttachedVideoDeviceList< VideoDevice >( sList.devices(), payload, false);
 }
 
 bool VideoDeviceHandler::GetAttachedVideoSubDeviceList(pbnjson::JValue &payload, LSMessage *message)
 {
-        return getAttachedVideoDeviceList< VideoDevice >( sList, payload, true);
+    auto listLock = lockDeviceList();
+        return getAttachedVideoDeviceList< VideoDevice >( sList.devices(), payload, true);
 }
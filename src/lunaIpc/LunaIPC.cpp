@@ -35,7 +35,7 @@ LunaIPC::~LunaIPC()
 {
 }
 
-bool LunaIPC::init(GMainLoop *mainLoop,CommandManager *pCommandManager)
+bool LunaIPC::init(GMainLoop *mainLoop,CommandManager *pCommandManager, PdmConfig* const pConfObj)
 {
     PDM_LOG_DEBUG("LunaIPC: %s line: %d", __FUNCTION__, __LINE__);
     bool retVal = false;
@@ -45,7 +45,7 @@ bool LunaIPC::init(GMainLoop *mainLoop,CommandManager *pCommandManager)
         PDM_LOG_ERROR("LunaIPC: %s line: %d Failed allocation for PdmLunaService", __FUNCTION__, __LINE__);
         return retVal;
     }
-    retVal = mPdmService->init(mainLoop);
+    retVal = mPdmService->init(mainLoop, pConfObj);
     if(retVal)
     {
         mServiceHandle = mPdmService->get_LSHandle();
@@ -0,0 +1,158 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <chrono>
+
+#include "PdmDeltaHistory.h"
+#include "PdmLogUtils.h"
+
+PdmDeltaHistory::PdmDeltaHistory(const std::string &listField, const std::string &idField)
+    : m_listField(listField)
+    , m_idField(idField)
+{
+    // Sequence numbers start at the creation time in microseconds, so a
+    // restarted service never hands out numbers a client already has
+    m_seq = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+std::map<std::string, std::string> PdmDeltaHistory::parseEntries(const std::string &payloadText) const
+{
+    std::map<std::string, std::string> entries;
+    pbnjson::JValue list = pbnjson::JDomParser::fromString(payloadText)[m_listField];
+    if (!list.isArray())
+        return entries;
+    for (ssize_t index = 0; index < list.arraySize(); index++) {
+        pbnjson::JValue entry = list[index];
+        std::string text = entry.stringify(NULL);
+        std::string id = (!m_idField.empty() && entry.hasKey(m_idField)) ? entry[m_idField].stringify(NULL) : text;
+        // Entries sharing an id are told apart by their position
+        std::string uniqueId = id;
+        for (int count = 1; entries.find(uniqueId) != entries.end(); count++)
+            uniqueId = id + "#" + std::to_string(count);
+        entries[uniqueId] = text;
+    }
+    return entries;
+}
+
+bool PdmDeltaHistory::update(const std::string &payloadText)
+{
+    if (payloadText == m_lastPayload)
+        return false;
+    m_lastPayload = payloadText;
+
+    std::map<std::string, std::string> entries = parseEntries(payloadText);
+    Record record;
+    for (auto &entry : entries) {
+        auto itr = m_entries.find(entry.first);
+        if (itr == m_entries.end())
+            record.changes.push_back({ADDED, entry.first, entry.second});
+        else if (itr->second != entry.second)
+            record.changes.push_back({CHANGED, entry.first, entry.second});
+    }
+    for (auto &entry : m_entries) {
+        if (entries.find(entry.first) == entries.end())
+            record.changes.push_back({REMOVED, entry.first, entry.second});
+    }
+    m_entries.swap(entries);
+    // Only fields outside the list changed, e.g. returnValue
+    if (record.changes.empty())
+        return false;
+
+    record.seq = ++m_seq;
+    m_records.push_back(std::move(record));
+    if (m_records.size() > PDM_DELTA_HISTORY_LIMIT)
+        m_records.pop_front();
+    PDM_LOG_DEBUG("PdmDeltaHistory:%s line: %d %s seq: %llu changes: %zu", __FUNCTION__, __LINE__, m_listField.c_str(),
+                  static_cast<unsigned long long>(m_seq), m_records.back().changes.size());
+    return true;
+}
+
+pbnjson::JValue PdmDeltaHistory::createDelta(uint64_t fromSeq, uint64_t seq, const std::vector<EntryChange> &changes)
+{
+    pbnjson::JValue added = pbnjson::Array();
+    pbnjson::JValue changed = pbnjson::Array();
+    pbnjson::JValue removed = pbnjson::Array();
+    for (auto &change : changes) {
+        pbnjson::JValue entry = pbnjson::JDomParser::fromString(change.entry);
+        if (change.change == ADDED)
+            added.append(entry);
+        else if (change.change == CHANGED)
+            changed.append(entry);
+        else
+            removed.append(entry);
+    }
+    pbnjson::JValue delta = pbnjson::Object();
+    delta.put("delta", true);
+    delta.put("fromSeq", (int64_t)fromSeq);
+    delta.put("seq", (int64_t)seq);
+    delta.put("added", added);
+    delta.put("changed", changed);
+    delta.put("removed", removed);
+    return delta;
+}
+
+pbnjson::JValue PdmDeltaHistory::getLastDelta() const
+{
+    if (m_records.empty())
+        return createDelta(m_seq, m_seq, std::vector<EntryChange>());
+    const Record &record = m_records.back();
+    return createDelta(record.seq - 1, record.seq, record.changes);
+}
+
+bool PdmDeltaHistory::getChangesSince(uint64_t seq, pbnjson::JValue &delta) const
+{
+    if (seq > m_seq)
+        return false;
+    if (seq < m_seq && (m_records.empty() || seq + 1 < m_records.front().seq))
+        return false;
+
+    // First and last change of every entry, in the order they first changed
+    std::vector<std::string> order;
+    std::map<std::string, std::pair<Change, EntryChange>> folded;
+    for (auto &record : m_records) {
+        if (record.seq <= seq)
+            continue;
+        for (auto &change : record.changes) {
+            auto itr = folded.find(change.id);
+            if (itr == folded.end()) {
+                order.push_back(change.id);
+                folded.insert(std::make_pair(change.id, std::make_pair(change.change, change)));
+            } else {
+                itr->second.second = change;
+            }
+        }
+    }
+
+    std::vector<EntryChange> changes;
+    for (auto &id : order) {
+        Change first = folded[id].first;
+        EntryChange last = folded[id].second;
+        if (last.change == REMOVED) {
+            // Added and removed again in between
+            if (first == ADDED)
+                continue;
+        } else if (first == ADDED) {
+            last.change = ADDED;
+        } else {
+            last.change = CHANGED;
+        }
+        changes.push_back(last);
+    }
+    delta = createDelta(seq, m_seq, changes);
+    return true;
+}
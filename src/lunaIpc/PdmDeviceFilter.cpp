@@ -0,0 +1,120 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+
+#include <algorithm>
+#include <cctype>
+
+#include "PdmDeviceFilter.h"
+
+PdmDeviceFilter::PdmDeviceFilter()
+    : m_hasDeviceType(false), m_hasStorageType(false), m_hasUsbPortNum(false), m_hasIsMounted(false)
+    , m_hasVendorId(false), m_hasProductId(false), m_usbPortNum(0), m_isMounted(false)
+{
+}
+
+PdmDeviceFilter::PdmDeviceFilter(const pbnjson::JValue &request)
+    : PdmDeviceFilter()
+{
+    if (!request.isObject())
+        return;
+    if (request.hasKey("deviceType")) {
+        m_hasDeviceType = true;
+        m_deviceType = request["deviceType"].asString();
+    }
+    if (request.hasKey("storageType")) {
+        m_hasStorageType = true;
+        m_storageType = request["storageType"].asString();
+    }
+    if (request.hasKey("usbPortNum")) {
+        m_hasUsbPortNum = true;
+        m_usbPortNum = request["usbPortNum"].asNumber<int32_t>();
+    }
+    if (request.hasKey("isMounted")) {
+        m_hasIsMounted = true;
+        m_isMounted = request["isMounted"].asBool();
+    }
+    if (request.hasKey("vendorId")) {
+        m_hasVendorId = true;
+        m_vendorId = toLower(request["vendorId"].asString());
+    }
+    if (request.hasKey("productId")) {
+        m_hasProductId = true;
+        m_productId = toLower(request["productId"].asString());
+    }
+    if (request.hasKey("fields")) {
+        for (auto const& field : request["fields"].items())
+            m_fields.insert(field.asString());
+    }
+}
+
+PdmDeviceFilter PdmDeviceFilter::fromMessage(LSMessage *message)
+{
+    if (!message)
+        return PdmDeviceFilter();
+    const char *payload = LSMessageGetPayload(message);
+    if (!payload)
+        return PdmDeviceFilter();
+    return PdmDeviceFilter(pbnjson::JDomParser::fromString(payload));
+}
+
+std::string PdmDeviceFilter::toLower(const std::string &id)
+{
+    std::string lower(id);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    return lower;
+}
+
+bool PdmDeviceFilter::isEmpty() const
+{
+    return !m_hasDeviceType && !m_hasStorageType && !m_hasUsbPortNum && !m_hasIsMounted &&
+           !m_hasVendorId && !m_hasProductId && m_fields.empty();
+}
+
+std::string PdmDeviceFilter::toString() const
+{
+    std::string text;
+    if (m_hasDeviceType)
+        text += "deviceType=" + m_deviceType + ";";
+    if (m_hasStorageType)
+        text += "storageType=" + m_storageType + ";";
+    if (m_hasUsbPortNum)
+        text += "usbPortNum=" + std::to_string(m_usbPortNum) + ";";
+    if (m_hasIsMounted)
+        text += std::string("isMounted=") + (m_isMounted ? "true" : "false") + ";";
+    if (m_hasVendorId)
+        text += "vendorId=" + m_vendorId + ";";
+    if (m_hasProductId)
+        text += "productId=" + m_productId + ";";
+    if (!m_fields.empty()) {
+        text += "fields=";
+        for (auto const& field : m_fields)
+            text += field + ",";
+    }
+    return text;
+}
+
+bool PdmDeviceFilter::wantsAny(std::initializer_list<const char*> fields) const
+{
+    if (m_fields.empty())
+        return true;
+    for (auto field : fields) {
+        if (m_fields.count(field))
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,239 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <algorithm>
+
+#include "PdmDeviceHistory.h"
+#include "PdmLogUtils.h"
+#include "PdmPayloadCache.h"
+
+namespace {
+
+pbnjson::JValue hubPortPathQuery(const std::string &hubPortPath)
+{
+    pbnjson::JValue params = pbnjson::Object();
+    params.put("query", pbnjson::JObject{{"from", PDM_DEVICE_HISTORY_KIND},
+                                         {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}});
+    return params;
+}
+
+}
+
+PdmDeviceHistory::PdmDeviceHistory()
+    : m_handle(nullptr)
+    , m_flushSourceId(0)
+    , m_writes(0)
+    , m_dbCalls(0)
+{
+}
+
+PdmDeviceHistory& PdmDeviceHistory::getInstance()
+{
+    static PdmDeviceHistory obj;
+    return obj;
+}
+
+pbnjson::JValue PdmDeviceHistory::load(LS::Handle *handle)
+{
+    pbnjson::JValue results = pbnjson::Array();
+    if (!handle)
+        return results;
+
+    pbnjson::JValue find_query = pbnjson::Object();
+    find_query.put("query", pbnjson::JObject{{"from", PDM_DEVICE_HISTORY_KIND}});
+    LS::Payload find_payload(find_query);
+    LS::Call call = handle->callOneReply("luna://com.webos.service.db/find", find_payload.getJson(), NULL, this, NULL);
+    LS::Message message = call.get();
+    pbnjson::JValue request = message.accessPayload().getJValue();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_handle = handle->get();
+    if (request.isNull() || !request["returnValue"].asBool() || !request["results"].isArray()) {
+        PDM_LOG_ERROR("PdmDeviceHistory:%s line: %d not able to read the history from db", __FUNCTION__, __LINE__);
+        return results;
+    }
+    results = request["results"];
+    for (ssize_t index = 0; index < results.arraySize(); ++index) {
+        std::string hubPortPath = results[index]["hubPortPath"].asString();
+        if (!hubPortPath.empty())
+            m_records[hubPortPath] = results[index].duplicate();
+    }
+    PDM_LOG_INFO("PdmDeviceHistory:",0,"%s line: %d loaded %zu records", __FUNCTION__, __LINE__, m_records.size());
+    return results;
+}
+
+pbnjson::JValue PdmDeviceHistory::find(const std::string &hubPortPath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto itr = m_records.find(hubPortPath);
+    if (itr == m_records.end())
+        return pbnjson::JValue();
+    return itr->second.duplicate();
+}
+
+pbnjson::JValue PdmDeviceHistory::findDeviceType(const std::string &deviceType)
+{
+    pbnjson::JValue records = pbnjson::Array();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto const& record : m_records) {
+        if (record.second["deviceType"].asString() == deviceType)
+            records.append(record.second.duplicate());
+    }
+    return records;
+}
+
+void PdmDeviceHistory::merge(const std::string &hubPortPath, pbnjson::JValue props)
+{
+    if (hubPortPath.empty() || !props.isObject())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pbnjson::JValue &record = m_records[hubPortPath];
+        if (!record.isObject())
+            record = pbnjson::Object();
+        PendingWrite &pending = m_pending[hubPortPath];
+        if (pending.props.isNull() && !pending.remove)
+            m_pendingOrder.push_back(hubPortPath);
+        if (!pending.props.isObject())
+            pending.props = pbnjson::Object();
+        for (auto prop : props.children()) {
+            record.put(prop.first.asString(), prop.second.duplicate());
+            pending.props.put(prop.first.asString(), prop.second.duplicate());
+        }
+        m_writes++;
+        scheduleFlush();
+    }
+    PdmPayloadCache::getInstance().invalidateAll();
+}
+
+void PdmDeviceHistory::remove(const std::string &hubPortPath)
+{
+    if (hubPortPath.empty())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_records.erase(hubPortPath);
+        PendingWrite &pending = m_pending[hubPortPath];
+        if (pending.props.isNull() && !pending.remove)
+            m_pendingOrder.push_back(hubPortPath);
+        pending.remove = true;
+        pending.props = pbnjson::JValue();
+        m_writes++;
+        scheduleFlush();
+    }
+    PdmPayloadCache::getInstance().invalidateAll();
+}
+
+void PdmDeviceHistory::removeDeviceType(const std::string &deviceType)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto itr = m_records.begin(); itr != m_records.end();) {
+            if (itr->second["deviceType"].asString() == deviceType) {
+                // Also from the order, a later merge() queues the path again
+                if (m_pending.erase(itr->first))
+                    m_pendingOrder.erase(std::remove(m_pendingOrder.begin(), m_pendingOrder.end(), itr->first), m_pendingOrder.end());
+                itr = m_records.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+        m_writes++;
+        pbnjson::JValue params = pbnjson::Object();
+        params.put("query", pbnjson::JObject{{"from", PDM_DEVICE_HISTORY_KIND},
+                                             {"where", pbnjson::JArray{{{"prop", "deviceType"}, {"op", "="}, {"val", deviceType.c_str()}}}}});
+        callDb("luna://com.webos.service.db/del", params);
+    }
+    PdmPayloadCache::getInstance().invalidateAll();
+}
+
+// Called with m_mutex held
+void PdmDeviceHistory::scheduleFlush()
+{
+    if (!m_flushSourceId)
+        m_flushSourceId = g_timeout_add(PDM_DEVICE_HISTORY_WRITE_DELAY_MS, &PdmDeviceHistory::flushCb, this);
+}
+
+// Called with m_mutex held
+bool PdmDeviceHistory::callDb(const char *method, const pbnjson::JValue &params)
+{
+    LSError lserror;
+    LSErrorInit(&lserror);
+    m_dbCalls++;
+    if (!m_handle || !LSCallOneReply(m_handle, method, params.stringify(NULL).c_str(), cbDbResponse, nullptr, NULL, &lserror)) {
+        PDM_LOG_ERROR("PdmDeviceHistory:%s line: %d %s failed", __FUNCTION__, __LINE__, method);
+        if (m_handle) {
+            LSErrorPrint(&lserror, stderr);
+            LSErrorFree(&lserror);
+        }
+        return false;
+    }
+    return true;
+}
+
+int PdmDeviceHistory::flushCb(void *data)
+{
+    PdmDeviceHistory *history = static_cast<PdmDeviceHistory*>(data);
+    {
+        std::lock_guard<std::mutex> lock(history->m_mutex);
+        history->m_flushSourceId = 0;
+    }
+    history->flush();
+    return G_SOURCE_REMOVE;
+}
+
+void PdmDeviceHistory::flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_flushSourceId) {
+        g_source_remove(m_flushSourceId);
+        m_flushSourceId = 0;
+    }
+    for (auto const& hubPortPath : m_pendingOrder) {
+        auto itr = m_pending.find(hubPortPath);
+        if (itr == m_pending.end())
+            continue;
+        PendingWrite &pending = itr->second;
+        if (pending.remove)
+            callDb("luna://com.webos.service.db/del", hubPortPathQuery(hubPortPath));
+        if (pending.props.isObject()) {
+            pbnjson::JValue params = hubPortPathQuery(hubPortPath);
+            pending.props.put("_kind", PDM_DEVICE_HISTORY_KIND);
+            pending.props.put("hubPortPath", hubPortPath);
+            params.put("props", pending.props);
+            callDb("luna://com.webos.service.db/mergePut", params);
+        }
+    }
+    m_pending.clear();
+    m_pendingOrder.clear();
+}
+
+bool PdmDeviceHistory::cbDbResponse(LSHandle *sh, LSMessage *message, void *user_data)
+{
+    const char *payload = LSMessageGetPayload(message);
+    pbnjson::JValue response = payload ? pbnjson::JDomParser::fromString(payload) : pbnjson::JValue();
+    if (response.isNull() || !response["returnValue"].asBool())
+        PDM_LOG_ERROR("PdmDeviceHistory:%s line: %d db write failed: %s", __FUNCTION__, __LINE__, payload ? payload : "");
+    return true;
+}
+
+PdmDeviceHistoryStats PdmDeviceHistory::getStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PdmDeviceHistoryStats stats = { m_records.size(), m_writes, m_dbCalls };
+    return stats;
+}
@@ -28,13 +28,21 @@ extern "C" {
 #include <sys/statfs.h>
 #include "Common.h"
 #include "CommandManager.h"
+#include "DeviceManager.h"
+#include "PdmBusyDetector.h"
 #include "JsonUtils.h"
 #include "PdmCommand.h"
+#include "PdmDeviceFilter.h"
+#include "PdmDeviceHistory.h"
 #include "PdmErrors.h"
 #include "PdmGetExampleUtil.h"
+#include "PdmLatencyStats.h"
 #include "PdmLogUtils.h"
 #include "PdmLunaHandler.h"
 #include "PdmLunaService.h"
+#include "PdmNetlinkManager.h"
+#include "PdmObserverBus.h"
+#include "PdmPayloadCache.h"
 #include "SchemaValidationApi.h"
 #include "PdmUtils.h"
 #include "DiskFormat.h"
@@ -43,9 +51,10 @@ extern "C" {
 #include <luna-service2++/handle.hpp>
 #include "LunaIPC.h"
 
-#ifdef WEBOS_SESSION
-#define DB8_KIND "com.webos.service.pdmhistory:1"
+// Device changes within this window share one reply per subscription key
+#define PDM_NOTIFY_COALESCING_WINDOW_MS 30
 
+#ifdef WEBOS_SESSION
 #define USER_MOUNT                            1
 
 #define MOUNT_FILE_MODE        (S_IRWXU|S_IRGRP) //740
@@ -95,6 +104,7 @@ LSMethod PdmLunaService::pdm_methods[] = {
     {"isWritableDrive",                    PdmLunaService::_cbisWritableDrive},
     {"umountAllDrive",                    PdmLunaService::_cbumountAllDrive},
     {"mountandFullFsck",                PdmLunaService::_cbmountandFullFsck},
+    {"getPerformanceStats",             PdmLunaService::_cbgetPerformanceStats},
 #ifdef WEBOS_SESSION
     {"getAttachedAllDeviceList",        PdmLunaService::_cbgetAttachedAllDeviceList},
     {"getAttachedDeviceList",           PdmLunaService::_cbgetAttachedDeviceList},
@@ -117,6 +127,10 @@ PdmLunaService::PdmLunaService(CommandManager *cmdManager)
     , replyMsg(nullptr)
     , isGetSpaceInfoRequest(false)
 #endif
+    , mNotifyWindowMs(PDM_NOTIFY_COALESCING_WINDOW_MS)
+    , mNotifyFlushSourceId(0)
+    , mNotifyRequests(0)
+    , mNotifyFlushes(0)
 {
 
 }
@@ -140,8 +154,9 @@ void PdmLunaService::appendErrorResponse(pbnjson::JValue &payload, int errorCode
     payload.put("errorText", errorText.c_str());
 }
 
-bool PdmLunaService::init(GMainLoop *mainLoop) {
+bool PdmLunaService::init(GMainLoop *mainLoop, PdmConfig* const pConfObj) {
     PDM_LOG_DEBUG("PdmLunaService::init");
+    mNotifyWindowMs = readNotifyCoalescingWindow(pConfObj);
 
 #ifdef WEBOS_SESSION
     mServiceCPPHandle = new LS::Handle(PDM_SERVICE_NAME);
@@ -207,11 +222,34 @@ bool PdmLunaService::deinit()
     LSError error;
     LSErrorInit(&error);
 
+    if (mNotifyFlushSourceId) {
+        g_source_remove(mNotifyFlushSourceId);
+        mNotifyFlushSourceId = 0;
+    }
     bRetVal = LSUnregister(mServiceHandle, &error);
     LSERROR_CHECK_AND_PRINT(bRetVal, error);
     return bRetVal;
 }
 
+int PdmLunaService::readNotifyCoalescingWindow(PdmConfig* const pConfObj)
+{
+    int windowMs = PDM_NOTIFY_COALESCING_WINDOW_MS;
+    if(!pConfObj)
+        return windowMs;
+
+    pbnjson::JValue windowConfVal = pbnjson::JValue();
+    PdmConfigStatus confErrCode = pConfObj->getValue("Common","NotifyCoalescingWindowMs",windowConfVal);
+    if(confErrCode != PdmConfigStatus::PDM_CONFIG_ERROR_NONE)
+    {
+        PdmErrors::logPdmErrorCodeAndText(confErrCode);
+        return windowMs;
+    }
+    if (windowConfVal.isNumber() && windowConfVal.asNumber<int>() >= 0)
+        windowMs = windowConfVal.asNumber<int>();
+
+    return windowMs;
+}
+
 LSHandle *PdmLunaService::get_LSHandle()
 {
     return mServiceHandle;
@@ -310,6 +348,234 @@ pbnjson::JValue PdmLunaService::createJsonGetAttachedNonStorageDeviceList(LSMess
     return payload;
 }
 
+namespace {
+    std::string getPayloadCacheKey(const std::string &payloadName, int returnValue)
+    {
+        if(returnValue < 0)
+            return payloadName;
+        return payloadName + (returnValue ? "#true" : "#false");
+    }
+
+    typedef struct PdmDeltaList {
+        const char *eventKey;
+        const char *listField;
+        // Empty when entries have no identifying field
+        const char *idField;
+    }PdmDeltaList;
+
+    const PdmDeltaList deltaLists[] = {
+        {PDM_EVENT_STORAGE_DEVICES,               "storageDeviceList",    "deviceNum"},
+        {PDM_EVENT_NON_STORAGE_DEVICES,           "nonStorageDeviceList", "deviceNum"},
+        {PDM_EVENT_AUDIO_DEVICES,                 "audioDeviceList",      "cardNumber"},
+        {PDM_EVENT_AUDIO_SUB_DEVICES,             "audioDeviceList",      "cardNumber"},
+        {PDM_EVENT_NON_STORAGE_DEVICES_VIDEO,     "videoDeviceList",      "KERNEL"},
+        {PDM_EVENT_NON_STORAGE_SUB_DEVICES_VIDEO, "videoDeviceList",      ""},
+        {PDM_EVENT_ALL_ATTACHED_DEVICES,          "deviceStatusList",     "deviceNum"}
+    };
+}
+
+std::string PdmLunaService::getStorageDeviceListText(int returnValue)
+{
+    return PdmPayloadCache::getInstance().get(getPayloadCacheKey(PDM_EVENT_STORAGE_DEVICES, returnValue), PDM_PAYLOAD_DEPENDS_ON_STORAGE,
+        [this, returnValue]() {
+            pbnjson::JValue payload = createJsonGetAttachedStorageDeviceList(nullptr);
+            if(returnValue >= 0)
+                payload.put("returnValue", returnValue != 0);
+            return payload;
+        });
+}
+
+std::string PdmLunaService::getNonStorageDeviceListText(const std::string &deviceType, int returnValue)
+{
+    // Any other category gets the mismatch error, it is not worth a cache entry
+    if(!deviceType.empty() && deviceType != "Audio" && deviceType != "AudioSubDevices" && deviceType != "Video" &&
+       deviceType != "VideoSubDevices" && deviceType != "Net") {
+        pbnjson::JValue payload = createJsonGetAttachedNonStorageDeviceList(nullptr, deviceType);
+        if(returnValue >= 0)
+            payload.put("returnValue", returnValue != 0);
+        return payload.stringify(NULL);
+    }
+    return PdmPayloadCache::getInstance().get(getPayloadCacheKey(std::string(PDM_EVENT_NON_STORAGE_DEVICES) + "/" + deviceType, returnValue),
+        PDM_PAYLOAD_DEPENDS_ON_NON_STORAGE,
+        [this, &deviceType, returnValue]() {
+            pbnjson::JValue payload = createJsonGetAttachedNonStorageDeviceList(nullptr, deviceType);
+            if(returnValue >= 0)
+                payload.put("returnValue", returnValue != 0);
+            return payload;
+        });
+}
+
+std::string PdmLunaService::getDeviceStatusText(int returnValue)
+{
+    return PdmPayloadCache::getInstance().get(getPayloadCacheKey(PDM_EVENT_ALL_ATTACHED_DEVICES, returnValue), PDM_PAYLOAD_DEPENDS_ON_ALL,
+        [this, returnValue]() {
+            pbnjson::JValue payload = createJsonGetAttachedDeviceStatus(nullptr);
+            if(returnValue >= 0)
+                payload.put("returnValue", returnValue != 0);
+            return payload;
+        });
+}
+
+PdmDeltaHistory* PdmLunaService::getDeltaHistory(const std::string &eventKey, bool create)
+{
+    auto itr = mDeltaHistories.find(eventKey);
+    if(itr != mDeltaHistories.end())
+        return itr->second.get();
+    if(!create)
+        return nullptr;
+    for(auto &deltaList : deltaLists) {
+        if(eventKey == deltaList.eventKey) {
+            PdmDeltaHistory *history = new PdmDeltaHistory(deltaList.listField, deltaList.idField);
+            mDeltaHistories[eventKey].reset(history);
+            return history;
+        }
+    }
+    return nullptr;
+}
+
+// The payload notifySubscribers sends for eventKey
+std::string PdmLunaService::getEventPayloadText(const std::string &eventKey)
+{
+    if(eventKey == PDM_EVENT_STORAGE_DEVICES)
+        return getStorageDeviceListText();
+    if(eventKey == PDM_EVENT_AUDIO_DEVICES)
+        return getNonStorageDeviceListText("Audio");
+    if(eventKey == PDM_EVENT_AUDIO_SUB_DEVICES)
+        return getNonStorageDeviceListText("AudioSubDevices");
+    if(eventKey == PDM_EVENT_NON_STORAGE_DEVICES_VIDEO)
+        return getNonStorageDeviceListText("Video");
+    if(eventKey == PDM_EVENT_NON_STORAGE_SUB_DEVICES_VIDEO)
+        return getNonStorageDeviceListText("VideoSubDevices");
+    if(eventKey == PDM_EVENT_ALL_ATTACHED_DEVICES)
+        return getDeviceStatusText();
+    return getNonStorageDeviceListText(std::string());
+}
+
+void PdmLunaService::notifyDeltaSubscribers(const std::string &eventKey, const std::string &payloadText)
+{
+    // Lists nobody asked deltas of have no history to keep
+    PdmDeltaHistory *history = getDeltaHistory(eventKey, false);
+    if(!history || !history->update(payloadText))
+        return;
+
+    LSError error;
+    LSErrorInit(&error);
+    pbnjson::JValue delta = history->getLastDelta();
+    delta.put("returnValue", true);
+    std::string deltaKey = eventKey + PDM_EVENT_DELTA_SUFFIX;
+    if(!LSSubscriptionReply(mServiceHandle, deltaKey.c_str(), delta.stringify(NULL).c_str(), &error))
+        LSErrorPrintAndFree(&error);
+}
+
+bool PdmLunaService::isDeltaRequest(LSMessage *message)
+{
+    const char *payloadMsg = LSMessageGetPayload(message);
+    if(!payloadMsg)
+        return false;
+    pbnjson::JValue request = pbnjson::JDomParser::fromString(payloadMsg);
+    return request.hasKey("delta") && request["delta"].asBool();
+}
+
+/*
+ replyDelta
+ Replies the changes after the requested sinceSeq when the history still
+ has them, else the full list with the current seq. Subscribers get the
+ delta of every later change.
+*/
+bool PdmLunaService::replyDelta(LSHandle *sh, LSMessage *message, const std::string &eventKey)
+{
+    LSError error;
+    LSErrorInit(&error);
+    std::string payloadText = getEventPayloadText(eventKey);
+    PdmDeltaHistory *history = getDeltaHistory(eventKey, true);
+    if(!history)
+        return false;
+    // A change nobody was notified of yet goes to the current subscribers first
+    if(history->update(payloadText)) {
+        pbnjson::JValue delta = history->getLastDelta();
+        delta.put("returnValue", true);
+        std::string deltaKey = eventKey + PDM_EVENT_DELTA_SUFFIX;
+        if(!LSSubscriptionReply(mServiceHandle, deltaKey.c_str(), delta.stringify(NULL).c_str(), &error))
+            LSErrorPrintAndFree(&error);
+    }
+
+    bool subscribed = false;
+    if(LSMessageIsSubscription(message))
+        subscribed = subscriptionAdd(sh, (eventKey + PDM_EVENT_DELTA_SUFFIX).c_str(), message);
+
+    pbnjson::JValue request = pbnjson::JDomParser::fromString(LSMessageGetPayload(message));
+    pbnjson::JValue payload;
+    if(!request.hasKey("sinceSeq") ||
+       !history->getChangesSince(static_cast<uint64_t>(request["sinceSeq"].asNumber<int64_t>()), payload)) {
+        payload = pbnjson::JDomParser::fromString(payloadText);
+        payload.put("seq", (int64_t)history->getSeq());
+    }
+    payload.put("returnValue", subscribed);
+
+    bool bRetVal = LSMessageReply(sh, message, payload.stringify(NULL).c_str(), &error);
+    LSERROR_CHECK_AND_PRINT(bRetVal, error);
+    return true;
+}
+
+std::string PdmLunaService::getFilteredListText(const std::string &eventKey, LSMessage *message, int returnValue)
+{
+    pbnjson::JValue payload = (eventKey == PDM_EVENT_STORAGE_DEVICES) ? createJsonGetAttachedStorageDeviceList(message)
+                                                                      : createJsonGetAttachedNonStorageDeviceList(message);
+    if(returnValue >= 0)
+        payload.put("returnValue", returnValue != 0);
+    return payload.stringify(NULL);
+}
+
+/*
+ replyFiltered
+ Replies the list of eventKey with the filters and fields of the request.
+ Deltas are kept for the shared list only, filtered subscribers get their
+ whole list on every change.
+*/
+bool PdmLunaService::replyFiltered(LSHandle *sh, LSMessage *message, const std::string &eventKey)
+{
+    LSError error;
+    LSErrorInit(&error);
+    bool subscribed = false;
+    if(LSMessageIsSubscription(message))
+        subscribed = subscriptionAdd(sh, (eventKey + PDM_EVENT_FILTER_SUFFIX).c_str(), message);
+
+    bool bRetVal = LSMessageReply(sh, message, getFilteredListText(eventKey, message, subscribed).c_str(), &error);
+    LSERROR_CHECK_AND_PRINT(bRetVal, error);
+    return true;
+}
+
+/*
+ replyFilteredSubscribers
+ Replies the filtered subscribers of eventKey, building the list once per
+ distinct filter
+*/
+void PdmLunaService::replyFilteredSubscribers(const std::string &eventKey)
+{
+    std::string filterKey = eventKey + PDM_EVENT_FILTER_SUFFIX;
+    if(LSSubscriptionGetHandleSubscribersCount(mServiceHandle, filterKey.c_str()) == 0)
+        return;
+
+    LSError error;
+    LSErrorInit(&error);
+    LSSubscriptionIter *iter = nullptr;
+    if(!LSSubscriptionAcquire(mServiceHandle, filterKey.c_str(), &iter, &error)) {
+        LSErrorPrintAndFree(&error);
+        return;
+    }
+    std::map<std::string, std::string> payloads;
+    while(LSSubscriptionHasNext(iter)) {
+        LSMessage *message = LSSubscriptionNext(iter);
+        std::string filterText = PdmDeviceFilter::fromMessage(message).toString();
+        auto itr = payloads.find(filterText);
+        if(itr == payloads.end())
+            itr = payloads.emplace(filterText, getFilteredListText(eventKey, message)).first;
+        if(!LSMessageReply(mServiceHandle, message, itr->second.c_str(), &error))
+            LSErrorPrintAndFree(&error);
+    }
+    LSSubscriptionRelease(iter);
+}
+
 bool PdmLunaService::cbGetExample(LSHandle *sh, LSMessage *message)
 {
     PDM_LOG_DEBUG("PdmLunaService:%s line: %d", __FUNCTION__, __LINE__);
@@ -390,19 +656,30 @@ bool PdmLunaService::cbGetAttachedStorageDeviceList(LSHandle *sh, LSMessage *mes
     }
 #else
 
-    VALIDATE_SCHEMA_AND_RETURN(sh, message, JSON_SCHEMA_VALIDATE_ATTACH_DEVICE_LIST);
-    pbnjson::JValue payload = createJsonGetAttachedStorageDeviceList(message);
+    VALIDATE_SCHEMA_AND_RETURN(sh, message, JSON_SCHEMA_VALIDATE_STORAGE_ATTACH_DEVICE_LIST);
 
     PDM_LOG_DEBUG("PdmLunaService::cbgetAttachedStorageDeviceList");
 
+    // Deltas are kept for the full list only
+    if (!PdmDeviceFilter::fromMessage(message).isEmpty()) {
+        if (!isDeltaRequest(message))
+            return replyFiltered(sh, message, PDM_EVENT_STORAGE_DEVICES);
+        pbnjson::JValue payload = pbnjson::Object();
+        appendErrorResponse(payload, PdmPayload::PDM_RESPONSE_FILTER_WITH_DELTA, PdmErrors::mPdmErrorTextTable[PdmPayload::PDM_RESPONSE_FILTER_WITH_DELTA]);
+        bRetVal  =  LSMessageReply (sh,  message,  payload.stringify(NULL).c_str() ,  &error);
+        LSERROR_CHECK_AND_PRINT(bRetVal, error);
+        return true;
+    }
+
+    if (isDeltaRequest(message))
+        return replyDelta(sh, message, PDM_EVENT_STORAGE_DEVICES);
+
     if (LSMessageIsSubscription(message))
     {
         subscribed = subscriptionAdd(sh, PDM_EVENT_STORAGE_DEVICES, message);
     }
 
-    payload.put("returnValue", subscribed);
-
-    bRetVal  =  LSMessageReply (sh,  message,  payload.stringify(NULL).c_str() ,  &error);
+    bRetVal  =  LSMessageReply (sh,  message,  getStorageDeviceListText(subscribed).c_str() ,  &error);
 #endif
     LSERROR_CHECK_AND_PRINT(bRetVal, error);
     return true;
@@ -493,39 +770,49 @@ bool PdmLunaService::cbGetAttachedNonStorageDeviceList(LSHandle *sh, LSMessage *
         category = list["category"].asString();
         groupSubDevices = list["groupSubDevices"].asBool();
     }
-    pbnjson::JValue payload;
-    if(groupSubDevices && category.compare("Video") == 0)
-        payload = createJsonGetAttachedNonStorageDeviceList(message, "VideoSubDevices");
-    else if (category.compare("Video") == 0)
-        payload = createJsonGetAttachedNonStorageDeviceList(message, "Video");
-    else if(groupSubDevices && category.compare("Audio") == 0)
-        payload = createJsonGetAttachedNonStorageDeviceList(message, "AudioSubDevices");
-    else if (category.compare("Audio") == 0)
-        payload = createJsonGetAttachedNonStorageDeviceList(message, "Audio");
-    else
-        payload = createJsonGetAttachedNonStorageDeviceList(message, category);
+    std::string deviceType = category;
+    if(groupSubDevices && (category.compare("Video") == 0 || category.compare("Audio") == 0))
+        deviceType += "SubDevices";
 
     PDM_LOG_DEBUG("PdmLunaService::cbgetAttachedNonStorageDeviceList");
-    if(LSMessageIsSubscription(message)){
-        const char* event = PDM_EVENT_NON_STORAGE_DEVICES;
-        if(!category.empty() && category.compare("Video") == 0) {
-            if(groupSubDevices) {
-                event = PDM_EVENT_NON_STORAGE_SUB_DEVICES_VIDEO;
-            } else {
-                event = PDM_EVENT_NON_STORAGE_DEVICES_VIDEO;
-            }
-        } else if(!category.empty() && category.compare("Audio") == 0) {
-            if(groupSubDevices) {
-                event = PDM_EVENT_AUDIO_SUB_DEVICES;
-            } else {
-                event = PDM_EVENT_AUDIO_DEVICES;
-            }
+    const char* event = PDM_EVENT_NON_STORAGE_DEVICES;
+    if(!category.empty() && category.compare("Video") == 0) {
+        if(groupSubDevices) {
+            event = PDM_EVENT_NON_STORAGE_SUB_DEVICES_VIDEO;
+        } else {
+            event = PDM_EVENT_NON_STORAGE_DEVICES_VIDEO;
         }
+    } else if(!category.empty() && category.compare("Audio") == 0) {
+        if(groupSubDevices) {
+            event = PDM_EVENT_AUDIO_SUB_DEVICES;
+        } else {
+            event = PDM_EVENT_AUDIO_DEVICES;
+        }
+    }
+    // Filters select from the device list, the category lists are not
+    // filtered and reject them, as do deltas which follow the full list
+    if(!PdmDeviceFilter::fromMessage(message).isEmpty()) {
+        bool delta = isDeltaRequest(message);
+        if(category.empty() && !delta)
+            return replyFiltered(sh, message, PDM_EVENT_NON_STORAGE_DEVICES);
+        int errorCode = category.empty() ? PdmPayload::PDM_RESPONSE_FILTER_WITH_DELTA : PdmPayload::PDM_RESPONSE_FILTER_WITH_CATEGORY;
+        pbnjson::JValue payload = pbnjson::Object();
+        appendErrorResponse(payload, errorCode, PdmErrors::mPdmErrorTextTable[errorCode]);
+        bRetVal  =  LSMessageReply (sh,  message,  payload.stringify(NULL).c_str() ,  &error);
+        LSERROR_CHECK_AND_PRINT(bRetVal, error);
+        return true;
+    }
+
+    // Deltas follow the list the event carries, all non storage devices
+    // for the other categories
+    if(isDeltaRequest(message))
+        return replyDelta(sh, message, event);
+
+    if(LSMessageIsSubscription(message)){
         subscribed = subscriptionAdd(sh, event, message);
     }
-    payload.put("returnValue", subscribed);
 
-    bRetVal  =  LSMessageReply (sh,  message,  payload.stringify(NULL).c_str() ,  &error);
+    bRetVal  =  LSMessageReply (sh,  message,  getNonStorageDeviceListText(deviceType, subscribed).c_str() ,  &error);
 #endif
     LSERROR_CHECK_AND_PRINT(bRetVal, error);
     return true;
@@ -538,18 +825,18 @@ bool PdmLunaService::cbGetAttachedDeviceStatus(LSHandle *sh, LSMessage *message)
     LSErrorInit(&error);
     bool subscribed = false;
     VALIDATE_SCHEMA_AND_RETURN(sh, message, JSON_SCHEMA_VALIDATE_ATTACH_DEVICE_LIST);
-    pbnjson::JValue payload = createJsonGetAttachedDeviceStatus(message);
 
     PDM_LOG_DEBUG("PdmLunaService::cbgetAttachedDeviceStatus");
 
+    if (isDeltaRequest(message))
+        return replyDelta(sh, message, PDM_EVENT_ALL_ATTACHED_DEVICES);
+
     if (LSMessageIsSubscription(message))
     {
         subscribed = subscriptionAdd(sh, PDM_EVENT_ALL_ATTACHED_DEVICES, message);
     }
 
-    payload.put("returnValue", subscribed);
-
-    bRetVal  =  LSMessageReply (sh,  message,  payload.stringify(NULL).c_str() ,  &error);
+    bRetVal  =  LSMessageReply (sh,  message,  getDeviceStatusText(subscribed).c_str() ,  &error);
     LSERROR_CHECK_AND_PRINT(bRetVal, error);
     return true;
 }
@@ -593,6 +880,7 @@ bool PdmLunaService::cbGetSpaceInfo(LSHandle *sh, LSMessage *message)
         {"where", pbnjson::JArray{{{"prop", "deviceType"}, {"op", "="}, {"val","USB_STORAGE"}}}}};
 
     find_query.put("query", request);
+    PdmDeviceHistory::getInstance().flush();
     if (LSCallOneReply(sh,"luna://com.webos.service.db/find",
                          find_query.stringify().c_str(), cbFindDriveName, this, NULL, &lserror) == false) {
         PDM_LOG_DEBUG("finding to the db failed in %s", __PRETTY_FUNCTION__ );
@@ -720,6 +1008,7 @@ void PdmLunaService::findDevice(LSHandle * sh,int deviceNum)
                                     {"where", pbnjson::JArray{{{"prop", "deviceNum"}, {"op", "="}, {"val",deviceNum}}}}};
 
     find_query.put("query", request);
+    PdmDeviceHistory::getInstance().flush();
     if (LSCallOneReply(sh,"luna://com.webos.service.db/find",
                              find_query.stringify().c_str(), cbEjectDevice, this, NULL, &lserror) == false) {
         PDM_LOG_DEBUG("finding to the db failed in %s", __PRETTY_FUNCTION__ );
@@ -783,11 +1072,6 @@ bool PdmLunaService::ejectDevice(pbnjson::JValue list, PdmLunaService* object)
     LSErrorInit(&lserror);
     bool allPartitionUnmounted = false;
 
-    //Add kind to the object
-    list.put("_kind", DB8_KIND);
-    pbnjson::JValue mergeput_query = pbnjson::Object();
-    pbnjson::JValue query;
-    pbnjson::JValue props = pbnjson::Object();
     std::string hubPortPath = list[0]["hubPortPath"].asString();
     std::string deviceSetId = list[0]["deviceSetId"].asString();
     std::string errorReason = list[0]["errorReason"].asString();
@@ -812,8 +1096,6 @@ bool PdmLunaService::ejectDevice(pbnjson::JValue list, PdmLunaService* object)
     }
     m_ejectedDeviceSetId = deviceSetId;
     PDM_LOG_DEBUG("PdmLunaService::%s line:%d hubPortPath: %s deviceSetId:%s", __FUNCTION__, __LINE__, hubPortPath.c_str(),deviceSetId.c_str());
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                               {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
 
     if (list[0]["deviceType"] == "USB_STORAGE")
     {
@@ -844,17 +1126,7 @@ bool PdmLunaService::ejectDevice(pbnjson::JValue list, PdmLunaService* object)
             list[0].put("errorReason","Ejected");
         }
     }
-    mergeput_query.put("query", query);
-    mergeput_query.put("props", list[0]);
-
-    PDM_LOG_DEBUG("PdmLunaService::%s line:%d MergePutPayload: %s", __FUNCTION__, __LINE__, mergeput_query.stringify().c_str());
-    if (LSCallOneReply(mServiceHandle,"luna://com.webos.service.db/mergePut",
-                       mergeput_query.stringify().c_str(), cbDb8Response, this, NULL, &lserror) == false) {
-        PDM_LOG_DEBUG("Store device info to History table call failed in %s", __PRETTY_FUNCTION__ );
-        LSErrorPrint(&lserror, stderr);
-        LSErrorFree(&lserror);
-        return false;
-    }
+    PdmDeviceHistory::getInstance().merge(hubPortPath, list[0]);
     pbnjson::JValue json = pbnjson::Object();
     json.put("returnValue", true);
     if(!allPartitionUnmounted) {
@@ -892,6 +1164,7 @@ void PdmLunaService::updateStorageDeviceList(std::string deviceSetId)
     request = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
                               {"where", pbnjson::JArray{{{"prop", "deviceSetId"}, {"op", "="}, {"val", deviceSetId.c_str()}}}}};
     find_query.put("query", request);
+    PdmDeviceHistory::getInstance().flush();
     if (LSCallOneReply(mServiceHandle,"luna://com.webos.service.db/find",
                       find_query.stringify().c_str(), cbUpdateStorageDeviceListResponse, this, NULL, &lserror) == false) {
         PDM_LOG_DEBUG("finding to the db failed in %s", __PRETTY_FUNCTION__ );
@@ -909,6 +1182,7 @@ void PdmLunaService::updateDeviceList(std::string deviceSetId)
     request = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
                               {"where", pbnjson::JArray{{{"prop", "deviceSetId"}, {"op", "="}, {"val", deviceSetId.c_str()}}}}};
     find_query.put("query", request);
+    PdmDeviceHistory::getInstance().flush();
     if (LSCallOneReply(mServiceHandle,"luna://com.webos.service.db/find",
                       find_query.stringify().c_str(), cbUpdateDeviceListResponse, this, NULL, &lserror) == false) {
         PDM_LOG_DEBUG("finding to the db failed in %s", __PRETTY_FUNCTION__ );
@@ -1060,6 +1334,7 @@ bool PdmLunaService::cbIsWritableDrive(LSHandle *sh, LSMessage *message)
                                     {"where", pbnjson::JArray{{{"prop", "deviceType"}, {"op", "="}, {"val","USB_STORAGE"}}}}};
 
         find_query.put("query", request);
+        PdmDeviceHistory::getInstance().flush();
         if (LSCallOneReply(sh,"luna://com.webos.service.db/find",
                              find_query.stringify().c_str(), cbFindDriveName, this, NULL, &lserror) == false) {
             PDM_LOG_DEBUG("finding to the db failed in %s", __PRETTY_FUNCTION__ );
@@ -1121,7 +1396,8 @@ bool PdmLunaService::cbFindDriveName(LSHandle * sh, LSMessage * message, void *
             std::string mountName =  resultArray[index]["storageDriveList"][idx]["mountName"].asString();
             if(driveName == m_requestedDrive){
                 driveFound = true;
-                if (object->isDriveBusy(mountName) == false ){
+                std::vector<pid_t> busyPids;
+                if (object->isDriveBusy(mountName, &busyPids) == false ){
                     if(object->isGetSpaceInfoRequest) {
                         struct statfs fsInfo = {0};
                         if (statfs( mountName.c_str(), &fsInfo ) != 0) {
@@ -1157,6 +1433,10 @@ bool PdmLunaService::cbFindDriveName(LSHandle * sh, LSMessage * message, void *
                 } else {
                     json.put("returnValue", false);
                     json.put("errorText", "drive is busy");
+                    pbnjson::JValue pids = pbnjson::Array();
+                    for (auto pid : busyPids)
+                        pids.append(static_cast<int64_t>(pid));
+                    json.put("busyPids", pids);
                 }
                 break;
             }
@@ -1180,14 +1460,14 @@ bool PdmLunaService::cbFindDriveName(LSHandle * sh, LSMessage * message, void *
     }
     return true;
 }
-bool PdmLunaService::isDriveBusy(std::string mountName)
+bool PdmLunaService::isDriveBusy(std::string mountName, std::vector<pid_t> *busyPids)
 {
     PDM_LOG_INFO("PdmLunaService:",0,"%s line: %d Mount Name: %s", __FUNCTION__,__LINE__,mountName.c_str());
-    std::string sysCommand("lsof +D ");
-    sysCommand.append(mountName);
-    std::string result = PdmUtils::execShellCmd(sysCommand);
-    if(!result.empty()){
-        PDM_LOG_ERROR("PdmLunaService:%s line: %d error on isDriveBusy", __FUNCTION__, __LINE__);
+    std::vector<pid_t> pids;
+    if(PdmBusyDetector::isBusy(mountName, pids)){
+        PDM_LOG_ERROR("PdmLunaService:%s line: %d drive is busy, used by: %s", __FUNCTION__, __LINE__, PdmBusyDetector::describe(pids).c_str());
+        if(busyPids)
+            *busyPids = pids;
         return true;
     }
      return false;
@@ -1235,10 +1515,6 @@ bool PdmLunaService::notifySubscribers(unsigned int eventDeviceType, const int &
 {
     PDM_LOG_DEBUG("PdmLunaService::notifySubscribers - Device Type: %s",DeviceEventTable[eventDeviceType]);
 
-    bool bRetVal = false;
-    LSError error;
-    LSErrorInit(&error);
-    pbnjson::JValue payload ;
 #ifdef WEBOS_SESSION
     if((2 == eventID) && (eventDeviceType == STORAGE_DEVICE || eventDeviceType == NON_STORAGE_DEVICE)) {
         if(!hubPortPath.empty()) {
@@ -1252,45 +1528,142 @@ bool PdmLunaService::notifySubscribers(unsigned int eventDeviceType, const int &
     }
 #endif
 
-    if(eventDeviceType == STORAGE_DEVICE) {
-        payload = createJsonGetAttachedStorageDeviceList(nullptr);
+    mNotifyRequests++;
+    mPendingNotifyTypes.insert(eventDeviceType);
+    // The end to end latency of the event includes its coalescing delay
+    PdmLatencyStats::EventScope *event = PdmLatencyStats::EventScope::current();
+    if (event && event->markReplied())
+        mPendingNotifyTraces.push_back(std::make_pair(event->getDeviceType(), event->getReceiveTime()));
 
-    }else if(eventDeviceType == VIDEO_DEVICE) {
-        payload = createJsonGetAttachedNonStorageDeviceList(nullptr, "VideoSubDevices");
-        bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_NON_STORAGE_SUB_DEVICES_VIDEO, payload.stringify(NULL).c_str(), &error);
-        LSERROR_CHECK_AND_PRINT(bRetVal, error);
+    if (mNotifyWindowMs <= 0)
+        return flushNotifications();
+    scheduleNotifyFlush();
+    return true;
+}
 
-        payload = createJsonGetAttachedNonStorageDeviceList(nullptr, "Video");
-    } else if (eventDeviceType == SOUND_DEVICE) {
-        payload = createJsonGetAttachedNonStorageDeviceList(nullptr, "AudioSubDevices");
-        bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUDIO_SUB_DEVICES, payload.stringify(NULL).c_str(), &error);
-        LSERROR_CHECK_AND_PRINT(bRetVal, error);
+/*
+ scheduleNotifyFlush
+ A change arriving after a quiet window is flushed as soon as the main loop
+ is idle, which still merges the events already queued with it. Changes
+ following a flush wait for the rest of the window.
+*/
+void PdmLunaService::scheduleNotifyFlush()
+{
+    if (mNotifyFlushSourceId)
+        return;
+    auto sinceFlush = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - mLastNotifyFlush).count();
+    if (sinceFlush >= mNotifyWindowMs)
+        mNotifyFlushSourceId = g_idle_add(&PdmLunaService::flushNotificationsCb, this);
+    else
+        mNotifyFlushSourceId = g_timeout_add(mNotifyWindowMs - sinceFlush, &PdmLunaService::flushNotificationsCb, this);
+}
 
-        payload = createJsonGetAttachedNonStorageDeviceList(nullptr, "Audio");
-    } else if(eventDeviceType != ALL_DEVICE) {
-        payload = createJsonGetAttachedNonStorageDeviceList(nullptr);
-    }
+int PdmLunaService::flushNotificationsCb(void *data)
+{
+    PdmLunaService *service = static_cast<PdmLunaService*>(data);
+    service->mNotifyFlushSourceId = 0;
+    service->flushNotifications();
+    return G_SOURCE_REMOVE;
+}
 
-    if(eventDeviceType != ALL_DEVICE){
-        // subscription reply
-        bRetVal = LSSubscriptionReply(mServiceHandle, DeviceEventTable[eventDeviceType], payload.stringify(NULL).c_str(), &error);
+bool PdmLunaService::flushNotifications()
+{
+    std::set<unsigned int> eventDeviceTypes;
+    std::vector<std::pair<std::string, std::chrono::steady_clock::time_point>> traces;
+    eventDeviceTypes.swap(mPendingNotifyTypes);
+    traces.swap(mPendingNotifyTraces);
+    mLastNotifyFlush = std::chrono::steady_clock::now();
+    mNotifyFlushes++;
+
+    bool bRetVal = false;
+    LSError error;
+    LSErrorInit(&error);
+    std::string payloadText;
+    // Build and reply stages are accounted to the latest merged event
+    std::unique_ptr<PdmLatencyStats::EventScope> eventScope;
+    if (!traces.empty() && !PdmLatencyStats::EventScope::current())
+        eventScope.reset(new PdmLatencyStats::EventScope(traces.back().first, traces.back().second));
+    PdmLatencyStats::StageTimer buildTimer(PdmLatencyStage::PAYLOAD_BUILD);
+    PdmLatencyStats::StageTimer replyTimer(PdmLatencyStage::SUBSCRIPTION_REPLY);
+    // Recorded once the first replies are out, also when one of them failed
+    struct TraceRecorder {
+        std::vector<std::pair<std::string, std::chrono::steady_clock::time_point>> &traces;
+        ~TraceRecorder() {
+            auto now = std::chrono::steady_clock::now();
+            for (auto const& trace : traces)
+                PdmLatencyStats::record(PdmLatencyStage::END_TO_END, trace.first, trace.second, now);
+        }
+    } traceRecorder{traces};
+
+    // Keys nobody subscribed to cost neither a payload nor a reply
+    auto replySubscribers = [&](const char *eventKey, const std::function<std::string()> &build) {
+        replyFilteredSubscribers(eventKey);
+        if(!hasSubscribers(eventKey))
+            return true;
+        buildTimer.start();
+        payloadText = build();
+        buildTimer.stop();
+        replyTimer.start();
+        bRetVal = LSSubscriptionReply(mServiceHandle, eventKey, payloadText.c_str(), &error);
+        notifyDeltaSubscribers(eventKey, payloadText);
+        replyTimer.stop();
         LSERROR_CHECK_AND_PRINT(bRetVal, error);
+        return true;
+    };
+
+    for (auto eventDeviceType : eventDeviceTypes) {
+        if(eventDeviceType == VIDEO_DEVICE) {
+            if(!replySubscribers(PDM_EVENT_NON_STORAGE_SUB_DEVICES_VIDEO, [this]{ return getNonStorageDeviceListText("VideoSubDevices"); }))
+                return false;
+        } else if (eventDeviceType == SOUND_DEVICE) {
+            if(!replySubscribers(PDM_EVENT_AUDIO_SUB_DEVICES, [this]{ return getNonStorageDeviceListText("AudioSubDevices"); }))
+                return false;
+        }
+
+        if(eventDeviceType != ALL_DEVICE){
+            // subscription reply
+            if(!replySubscribers(DeviceEventTable[eventDeviceType], [this, eventDeviceType] {
+                if(eventDeviceType == STORAGE_DEVICE)
+                    return getStorageDeviceListText();
+                else if(eventDeviceType == VIDEO_DEVICE)
+                    return getNonStorageDeviceListText("Video");
+                else if(eventDeviceType == SOUND_DEVICE)
+                    return getNonStorageDeviceListText("Audio");
+                return getNonStorageDeviceListText(std::string());
+            }))
+                return false;
+        }
     }
     // Always notify who have subscribed for all device changes
-    payload = createJsonGetAttachedDeviceStatus(nullptr);
-    bRetVal = LSSubscriptionReply(mServiceHandle, DeviceEventTable[ALL_DEVICE], payload.stringify(NULL).c_str(), &error);
-    LSERROR_CHECK_AND_PRINT(bRetVal, error);
+    if(!replySubscribers(DeviceEventTable[ALL_DEVICE], [this]{ return getDeviceStatusText(); }))
+        return false;
 
 #ifdef WEBOS_SESSION
-    if((eventDeviceType == NON_STORAGE_DEVICE) || (eventDeviceType == STORAGE_DEVICE)) {
-         payload = createJsonGetAttachedAllDeviceList(nullptr);
-         bRetVal = LSSubscriptionReply(mServiceHandle,PDM_EVENT_ALL_ATTACHED_DEVICE_LIST, payload.stringify(NULL).c_str(), &error);
-         LSERROR_CHECK_AND_PRINT(bRetVal, error);
+    if(eventDeviceTypes.count(NON_STORAGE_DEVICE) || eventDeviceTypes.count(STORAGE_DEVICE)) {
+        if(!replySubscribers(PDM_EVENT_ALL_ATTACHED_DEVICE_LIST, [this]{ return createJsonGetAttachedAllDeviceList(nullptr).stringify(NULL); }))
+            return false;
     }
 #endif
     return true;
 }
 
+/*
+ hasSubscribers
+ @return
+ Whether a reply on eventKey reaches anybody, counts the payloads saved
+ when it does not
+*/
+bool PdmLunaService::hasSubscribers(const char *eventKey)
+{
+    std::string deltaKey = std::string(eventKey) + PDM_EVENT_DELTA_SUFFIX;
+    if(LSSubscriptionGetHandleSubscribersCount(mServiceHandle, eventKey) > 0 ||
+       LSSubscriptionGetHandleSubscribersCount(mServiceHandle, deltaKey.c_str()) > 0)
+        return true;
+    PdmPayloadCache::getInstance().countSkipped();
+    return false;
+}
+
 bool PdmLunaService::subscriptionAdd(LSHandle *a_sh, const char *a_key, LSMessage *a_message)
 {
     LSError lsError;
@@ -1325,6 +1698,140 @@ bool PdmLunaService::cbmountandFullFsck(LSHandle *sh, LSMessage *message)
     return true;
 }
 
+bool PdmLunaService::cbGetPerformanceStats(LSHandle *sh, LSMessage *message)
+{
+    PDM_LOG_DEBUG("PdmLunaService:%s line: %d payload:%s", __FUNCTION__, __LINE__, LSMessageGetPayload(message));
+    VALIDATE_SCHEMA_AND_RETURN(sh, message, JSON_SCHEMA_VALIDATE_PERFORMANCE_STATS);
+    bool bRetVal;
+    LSError error;
+    LSErrorInit(&error);
+
+    pbnjson::JValue request = pbnjson::JDomParser::fromString(LSMessageGetPayload(message));
+    bool reset = request.hasKey("reset") && request["reset"].asBool();
+
+    pbnjson::JValue deviceTypes = pbnjson::Array();
+    for (auto const& deviceStats : PdmLatencyStats::getHistograms()) {
+        pbnjson::JValue stages = pbnjson::Object();
+        for (size_t index = 0; index < deviceStats.second.size(); index++) {
+            const PdmLatencyHistogram &histogram = deviceStats.second[index];
+            if (histogram.count == 0)
+                continue;
+            pbnjson::JValue buckets = pbnjson::Array();
+            for (auto bucket : histogram.buckets)
+                buckets.append((int64_t)bucket);
+            pbnjson::JValue stage = pbnjson::Object();
+            stage.put("count", (int64_t)histogram.count);
+            stage.put("avgUs", (int64_t)(histogram.totalUs / histogram.count));
+            stage.put("maxUs", (int64_t)histogram.maxUs);
+            stage.put("p50Us", (int64_t)PdmLatencyStats::getPercentileUs(histogram, 50));
+            stage.put("p90Us", (int64_t)PdmLatencyStats::getPercentileUs(histogram, 90));
+            stage.put("p99Us", (int64_t)PdmLatencyStats::getPercentileUs(histogram, 99));
+            stage.put("histogram", buckets);
+            stages.put(PdmLatencyStats::getStageName(static_cast<PdmLatencyStage>(index)), stage);
+        }
+        pbnjson::JValue deviceType = pbnjson::Object();
+        deviceType.put("deviceType", deviceStats.first);
+        deviceType.put("stages", stages);
+        deviceTypes.append(deviceType);
+    }
+    if (reset)
+        PdmLatencyStats::reset();
+
+    pbnjson::JValue observers = pbnjson::Array();
+    for (auto const& observerStats : PdmObserverBus::getInstance().getStats()) {
+        pbnjson::JValue observer = pbnjson::Object();
+        observer.put("name", observerStats.first);
+        observer.put("posted", (int64_t)observerStats.second.posted);
+        observer.put("delivered", (int64_t)observerStats.second.delivered);
+        observer.put("merged", (int64_t)observerStats.second.merged);
+        observer.put("dropped", (int64_t)observerStats.second.dropped);
+        observer.put("queueDepth", (int64_t)observerStats.second.queueDepth);
+        observer.put("maxQueueDepth", (int64_t)observerStats.second.maxQueueDepth);
+        observers.append(observer);
+    }
+
+    pbnjson::JValue handlers = pbnjson::Array();
+    for (auto const& entry : DeviceManager::getInstance()->getHandlerStats()) {
+        pbnjson::JValue handler = pbnjson::Object();
+        handler.put("name", entry.first);
+        handler.put("invoked", (int64_t)entry.second.invocations);
+        handler.put("claimed", (int64_t)entry.second.claimed);
+        handler.put("skipped", (int64_t)entry.second.skipped);
+        handler.put("totalUs", (int64_t)(entry.second.totalTimeNs / 1000));
+        handler.put("maxUs", (int64_t)(entry.second.maxTimeNs / 1000));
+        handlers.append(handler);
+    }
+
+    pbnjson::JValue commandLanes = pbnjson::Array();
+    for (size_t index = 0; index < static_cast<size_t>(CommandLane::MAX_LANES); index++) {
+        CommandLane lane = static_cast<CommandLane>(index);
+        CommandLaneStats laneStats = mCommandManager->getLaneStats(lane);
+        pbnjson::JValue commandLane = pbnjson::Object();
+        commandLane.put("name", CommandManager::getLaneName(lane));
+        commandLane.put("enqueued", (int64_t)laneStats.enqueued);
+        commandLane.put("completed", (int64_t)laneStats.completed);
+        commandLane.put("queueDepth", (int64_t)laneStats.queueDepth);
+        commandLane.put("maxQueueDepth", (int64_t)laneStats.maxQueueDepth);
+        commandLane.put("avgWaitUs", (int64_t)(laneStats.completed ? laneStats.totalWaitUs / laneStats.completed : 0));
+        commandLane.put("maxWaitUs", (int64_t)laneStats.maxWaitUs);
+        commandLane.put("avgExecUs", (int64_t)(laneStats.completed ? laneStats.totalExecUs / laneStats.completed : 0));
+        commandLane.put("maxExecUs", (int64_t)laneStats.maxExecUs);
+        commandLanes.append(commandLane);
+    }
+
+    PdmPayloadCacheStats cacheStats = PdmPayloadCache::getInstance().getStats();
+    pbnjson::JValue payloadCache = pbnjson::Object();
+    payloadCache.put("version", (int64_t)cacheStats.version);
+    payloadCache.put("hits", (int64_t)cacheStats.hits);
+    payloadCache.put("misses", (int64_t)cacheStats.misses);
+    payloadCache.put("skipped", (int64_t)cacheStats.skipped);
+
+    pbnjson::JValue replyPayload = pbnjson::Object();
+    replyPayload.put("deviceTypes", deviceTypes);
+    replyPayload.put("observers", observers);
+    replyPayload.put("handlers", handlers);
+    replyPayload.put("commandLanes", commandLanes);
+    replyPayload.put("payloadCache", payloadCache);
+    pbnjson::JValue notifyCoalescing = pbnjson::Object();
+    notifyCoalescing.put("windowMs", mNotifyWindowMs);
+    notifyCoalescing.put("requests", (int64_t)mNotifyRequests);
+    notifyCoalescing.put("flushes", (int64_t)mNotifyFlushes);
+    replyPayload.put("notifyCoalescing", notifyCoalescing);
+    UeventCoalescingStats coalescingStats;
+    if (PdmNetlinkManager::getInstance()->getCoalescingStats(coalescingStats)) {
+        pbnjson::JValue ueventCoalescing = pbnjson::Object();
+        ueventCoalescing.put("received", (int64_t)coalescingStats.received);
+        ueventCoalescing.put("dispatched", (int64_t)coalescingStats.dispatched);
+        ueventCoalescing.put("mergedChanges", (int64_t)coalescingStats.mergedChanges);
+        ueventCoalescing.put("cancelledEvents", (int64_t)coalescingStats.cancelledEvents);
+        replyPayload.put("ueventCoalescing", ueventCoalescing);
+    }
+    UeventResyncStats resyncStats;
+    if (PdmNetlinkManager::getInstance()->getResyncStats(resyncStats)) {
+        pbnjson::JValue ueventResync = pbnjson::Object();
+        ueventResync.put("overflows", (int64_t)resyncStats.overflows);
+        ueventResync.put("seqnumGaps", (int64_t)resyncStats.seqnumGaps);
+        ueventResync.put("inconsistentEvents", (int64_t)resyncStats.inconsistentEvents);
+        ueventResync.put("resyncs", (int64_t)resyncStats.resyncs);
+        ueventResync.put("resyncedEvents", (int64_t)resyncStats.resyncedEvents);
+        replyPayload.put("ueventResync", ueventResync);
+    }
+#ifdef WEBOS_SESSION
+    PdmDeviceHistoryStats historyStats = PdmDeviceHistory::getInstance().getStats();
+    pbnjson::JValue deviceHistory = pbnjson::Object();
+    deviceHistory.put("records", (int64_t)historyStats.records);
+    deviceHistory.put("writes", (int64_t)historyStats.writes);
+    deviceHistory.put("dbCalls", (int64_t)historyStats.dbCalls);
+    replyPayload.put("deviceHistory", deviceHistory);
+#endif
+    replyPayload.put("reset", reset);
+    replyPayload.put("returnValue", true);
+
+    bRetVal = LSMessageReply(sh, message, replyPayload.stringify(NULL).c_str(), &error);
+    LSERROR_CHECK_AND_PRINT(bRetVal, error);
+    return true;
+}
+
 #ifdef WEBOS_SESSION
 
 void PdmLunaService::removeHubPortPathFromMap(std::string hubPortPath) {
@@ -1915,19 +2422,8 @@ bool PdmLunaService::queryForSession()
 
 bool PdmLunaService::updateIsMount(pbnjson::JValue list, std::string driveName)
 {
-    LSError lserror;
-    LSErrorInit(&lserror);
-
-    //Add kind to the object
-    list.put("_kind", DB8_KIND);
-    pbnjson::JValue mergeput_query = pbnjson::Object();
-    pbnjson::JValue query;
-    pbnjson::JValue props = pbnjson::Object();
-
     std::string hubPortPath = list["hubPortPath"].asString();
     PDM_LOG_DEBUG("PdmLunaService::%s line:%d hubPortPath: %s", __FUNCTION__, __LINE__, hubPortPath.c_str());
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                              {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
 
     struct statfs fsInfo = {0};
     int32_t driveSize;
@@ -1946,70 +2442,27 @@ bool PdmLunaService::updateIsMount(pbnjson::JValue list, std::string driveName)
             break;
         }
     }
-    mergeput_query.put("query", query);
-    mergeput_query.put("props", list);
-
-    PDM_LOG_DEBUG("PdmLunaService::%s line:%d MergePutPayload: %s", __FUNCTION__, __LINE__, mergeput_query.stringify().c_str());
-    if (LSCallOneReply(mServiceHandle,"luna://com.webos.service.db/mergePut",
-                       mergeput_query.stringify().c_str(), cbDb8Response, this, NULL, &lserror) == false) {
-        PDM_LOG_DEBUG("Store device info to History table call failed in %s", __PRETTY_FUNCTION__ );
-        LSErrorPrint(&lserror, stderr);
-        LSErrorFree(&lserror);
-        return false;
-    }
+    PdmDeviceHistory::getInstance().merge(hubPortPath, list);
     return true;
 }
 
 bool PdmLunaService::updateErrorReason(pbnjson::JValue list)
 {
-    PDM_LOG_DEBUG("PdmLunaService::%s line:%d ", __FUNCTION__, __LINE__);
-    LSError lserror;
-    LSErrorInit(&lserror);
-
-    //Add kind to the object
-    list.put("_kind", DB8_KIND);
-    pbnjson::JValue mergeput_query = pbnjson::Object();
-    pbnjson::JValue query;
-    pbnjson::JValue props = pbnjson::Object();
-
     std::string hubPortPath = list["hubPortPath"].asString();
     PDM_LOG_DEBUG("PdmLunaService::%s line:%d hubPortPath: %s", __FUNCTION__, __LINE__, hubPortPath.c_str());
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                               {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
 
     if (list["deviceType"].asString() == "USB_STORAGE")
     {
         list.put("errorReason","nothing");
     }
-    mergeput_query.put("query", query);
-    mergeput_query.put("props", list);
-
-    PDM_LOG_DEBUG("PdmLunaService::%s line:%d MergePutPayload: %s", __FUNCTION__, __LINE__, mergeput_query.stringify().c_str());
-    if (LSCallOneReply(mServiceHandle,"luna://com.webos.service.db/mergePut",
-                       mergeput_query.stringify().c_str(), cbDb8Response, this, NULL, &lserror) == false) {
-        PDM_LOG_DEBUG("Store device info to History table call failed in %s", __PRETTY_FUNCTION__ );
-        LSErrorPrint(&lserror, stderr);
-        LSErrorFree(&lserror);
-        return false;
-    }
+    PdmDeviceHistory::getInstance().merge(hubPortPath, list);
     return true;
 }
 
 bool PdmLunaService::storeDeviceInfo(pbnjson::JValue list)
 {
-    LSError lserror;
-    LSErrorInit(&lserror);
-
-    //Add kind to the object
-    list.put("_kind", DB8_KIND);
-    pbnjson::JValue mergeput_query = pbnjson::Object();
-    pbnjson::JValue query;
-    pbnjson::JValue props = pbnjson::Object();
-
     std::string hubPortPath = list["hubPortPath"].asString();
     PDM_LOG_DEBUG("PdmLunaService::%s line:%d hubPortPath: %s", __FUNCTION__, __LINE__, hubPortPath.c_str());
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                               {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
 
     if (list["deviceType"].asString() == "USB_STORAGE")
     {
@@ -2031,28 +2484,9 @@ bool PdmLunaService::storeDeviceInfo(pbnjson::JValue list)
         }
         list.put("rootPath", rootPath);
     }
-    mergeput_query.put("query", query);
-    mergeput_query.put("props", list);
-
-    LS::Payload merge_payload(mergeput_query);
-    LS::Call call = LunaIPC::getInstance()->getLSCPPHandle()->callOneReply("luna://com.webos.service.db/mergePut", merge_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull())
-    {
-        PDM_LOG_ERROR("PdmLunaService::%s line: %d not able to merge from Db ",  __FUNCTION__, __LINE__);
-        return false;
-    }
-
-    if(!request["returnValue"].asBool())
-    {
-        PDM_LOG_ERROR("PdmLunaService::%s line: %d not able to merge from Db",  __FUNCTION__, __LINE__);
-        return false;
-    }
-    PDM_LOG_DEBUG("PdmLunaService::%s line:%d updated the db for hubPortPath: %s", __FUNCTION__, __LINE__, hubPortPath.c_str());
+    // Written to DB8 behind, readers use PdmDeviceHistory
+    PdmDeviceHistory::getInstance().merge(hubPortPath, list);
+    PDM_LOG_DEBUG("PdmLunaService::%s line:%d updated the history for hubPortPath: %s", __FUNCTION__, __LINE__, hubPortPath.c_str());
     return true;
 }
 
@@ -2289,35 +2723,31 @@ bool PdmLunaService::notifyToDisplay(pbnjson::JValue deviceList, std::string dev
     bool bRetVal = false;
     LSError error;
     LSErrorInit(&error);
-    deviceList.put("returnValue", true);
+    const char *eventKey = nullptr;
     if(deviceType== "USB_STORAGE") {
-        if (deviceSetId == "AVN") {
-            bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUTO_DEVICES_AVN, deviceList.stringify(NULL).c_str(), &error);
-        }
-        if (deviceSetId == "RSE-L") {
-            bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUTO_DEVICES_RSE_L, deviceList.stringify(NULL).c_str(), &error);
-        }
-        if (deviceSetId == "RSE-R") {
-            bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUTO_DEVICES_RSE_R, deviceList.stringify(NULL).c_str(), &error);
-        }
-        if(deviceSetId == "HOST") {
-            bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUTO_STORAGE_DEVICES, deviceList.stringify(NULL).c_str(), &error);
-        }
-    }
-
-    if(deviceType != "USB_STORAGE") {
-        if (deviceSetId == "AVN") {
-            bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUTO_NON_STORAGE_DEVICES_AVN, deviceList.stringify(NULL).c_str(), &error);
-        }
-        if (deviceSetId == "RSE-L") {
-            bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUTO_NON_STORAGE_DEVICES_RSE_L, deviceList.stringify(NULL).c_str(), &error);
-        }
-        if (deviceSetId =="RSE-R") {
-            bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUTO_NON_STORAGE_DEVICES_RSE_R, deviceList.stringify(NULL).c_str(), &error);
-        }
-        if(deviceSetId == "HOST") {
-            bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUTO_NON_STORAGE_DEVICES, deviceList.stringify(NULL).c_str(), &error);
-        }
+        if (deviceSetId == "AVN")
+            eventKey = PDM_EVENT_AUTO_DEVICES_AVN;
+        else if (deviceSetId == "RSE-L")
+            eventKey = PDM_EVENT_AUTO_DEVICES_RSE_L;
+        else if (deviceSetId == "RSE-R")
+            eventKey = PDM_EVENT_AUTO_DEVICES_RSE_R;
+        else if(deviceSetId == "HOST")
+            eventKey = PDM_EVENT_AUTO_STORAGE_DEVICES;
+    } else {
+        if (deviceSetId == "AVN")
+            eventKey = PDM_EVENT_AUTO_NON_STORAGE_DEVICES_AVN;
+        else if (deviceSetId == "RSE-L")
+            eventKey = PDM_EVENT_AUTO_NON_STORAGE_DEVICES_RSE_L;
+        else if (deviceSetId =="RSE-R")
+            eventKey = PDM_EVENT_AUTO_NON_STORAGE_DEVICES_RSE_R;
+        else if(deviceSetId == "HOST")
+            eventKey = PDM_EVENT_AUTO_NON_STORAGE_DEVICES;
+    }
+    if (eventKey) {
+        if (!hasSubscribers(eventKey))
+            return true;
+        deviceList.put("returnValue", true);
+        bRetVal = LSSubscriptionReply(mServiceHandle, eventKey, deviceList.stringify(NULL).c_str(), &error);
     }
    LSERROR_CHECK_AND_PRINT(bRetVal, error);
    return bRetVal;
@@ -2328,16 +2758,19 @@ bool PdmLunaService::notifyAllDeviceToDisplay(std::string deviceSetId, pbnjson::
     bool bRetVal = false;
     LSError error;
     LSErrorInit(&error);
-    deviceList.put("returnValue", true);
+    const char *eventKey = nullptr;
 
-    if (deviceSetId == "AVN") {
-        bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUTO_ATTACHED_ALL_DEVICES_AVN, deviceList.stringify(NULL).c_str(), &error);
-    }
-    if (deviceSetId == "RSE-L") {
-        bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUTO_ATTACHED_ALL_DEVICES_RSE_L, deviceList.stringify(NULL).c_str(), &error);
-    }
-    if (deviceSetId == "RSE-R") {
-        bRetVal = LSSubscriptionReply(mServiceHandle, PDM_EVENT_AUTO_ATTACHED_ALL_DEVICES_RSE_R, deviceList.stringify(NULL).c_str(), &error);
+    if (deviceSetId == "AVN")
+        eventKey = PDM_EVENT_AUTO_ATTACHED_ALL_DEVICES_AVN;
+    else if (deviceSetId == "RSE-L")
+        eventKey = PDM_EVENT_AUTO_ATTACHED_ALL_DEVICES_RSE_L;
+    else if (deviceSetId == "RSE-R")
+        eventKey = PDM_EVENT_AUTO_ATTACHED_ALL_DEVICES_RSE_R;
+    if (eventKey) {
+        if (!hasSubscribers(eventKey))
+            return true;
+        deviceList.put("returnValue", true);
+        bRetVal = LSSubscriptionReply(mServiceHandle, eventKey, deviceList.stringify(NULL).c_str(), &error);
     }
     LSERROR_CHECK_AND_PRINT(bRetVal, error);
     return bRetVal;
@@ -2384,6 +2817,7 @@ bool PdmLunaService::cbgetAttachedDeviceList(LSHandle *sh, LSMessage *message) {
     request = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
                               {"where", pbnjson::JArray{{{"prop", "deviceSetId"}, {"op", "="}, {"val", deviceSetId.c_str()}}}}};
     find_query.put("query", request);
+    PdmDeviceHistory::getInstance().flush();
     if (LSCallOneReply(sh,"luna://com.webos.service.db/find",
                       find_query.stringify().c_str(), cbDbResponse, this, NULL, &lserror) == false) {
         PDM_LOG_DEBUG("finding to the db failed in %s", __PRETTY_FUNCTION__ );
@@ -2503,6 +2937,7 @@ bool PdmLunaService::getDevicesFromDB(std::string deviceType, std::string sessio
 
     find_query.put("query", request);
     PDM_LOG_DEBUG("PdmLunaService::%s line:%d find_query: %s", __FUNCTION__, __LINE__, find_query.stringify().c_str());
+    PdmDeviceHistory::getInstance().flush();
     if (LSCallOneReply(mServiceHandle,"luna://com.webos.service.db/find",
                  find_query.stringify().c_str(), cbDb8FindResponse, this, NULL, &error) == false)
     {
@@ -2579,53 +3014,15 @@ bool PdmLunaService::cbDb8FindResponse(LSHandle * sh, LSMessage * message, void
 bool PdmLunaService::queryDevice(std::string hubPortPath)
 {
     PDM_LOG_DEBUG("PdmLunaService:%s line: %d", __FUNCTION__, __LINE__);
-    LSError lserror;
-    LSErrorInit(&lserror);
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue request;
-    request = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                              {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
-    find_query.put("query", request);
-    if (LSCallOneReply(mServiceHandle,"luna://com.webos.service.db/find",
-                             find_query.stringify().c_str(), cbQueryResponse, this, NULL, &lserror) == false) {
-        PDM_LOG_DEBUG("finding to the db failed in %s", __PRETTY_FUNCTION__ );
-        LSErrorPrint(&lserror, stderr);
-        LSErrorFree(&lserror);
-        return false;
-    }
-    return true;
-}
-
-bool PdmLunaService::cbQueryResponse(LSHandle * sh, LSMessage * message, void * user_data) {
-
-    PDM_LOG_DEBUG("PdmLunaService:%s line: %d", __FUNCTION__, __LINE__);
-    const char* payload = LSMessageGetPayload(message);
-    if(!payload) {
-        PDM_LOG_ERROR("PdmLunaService:%s line: %d payload is empty ", __FUNCTION__, __LINE__);
-        return false;
-    }
-    pbnjson::JValue request = pbnjson::JDomParser::fromString(payload);
-    if(request.isNull() || (!request["returnValue"].asBool()))
-    {
-        PDM_LOG_ERROR("PdmLunaService:%s line: %d Db8Response is empty ", __FUNCTION__, __LINE__);
+    pbnjson::JValue record = PdmDeviceHistory::getInstance().find(hubPortPath);
+    if(record.isNull()) {
+        PDM_LOG_ERROR("PdmLunaService:%s line: %d No device Info in DB ", __FUNCTION__, __LINE__);
         return false;
     }
-    PdmLunaService* object = (PdmLunaService*)user_data;
-    if(nullptr == object) {
-        PDM_LOG_ERROR("PdmLunaService:%s line: %d PdmLunaService obj is NULL", __FUNCTION__, __LINE__);
-        return false;
-    }
-
-    pbnjson::JValue resultArray = request["results"];
-    PDM_LOG_DEBUG("PdmLunaService:%s line: %d list:%s", __FUNCTION__, __LINE__, resultArray.stringify().c_str());
-    if(resultArray.isArray()) {
-        if(resultArray.arraySize() == 0) {
-            PDM_LOG_ERROR("PdmLunaService:%s line: %d No device Info in DB ", __FUNCTION__, __LINE__);
-            return false;
-        }
-        if((object) &&(!object->deleteAndUpdatePayload(resultArray))) {
-            PDM_LOG_ERROR("PdmLunaService:%s line: %d unable to delete from db", __FUNCTION__, __LINE__);
-        }
+    pbnjson::JValue resultArray = pbnjson::Array();
+    resultArray.append(record);
+    if(!deleteAndUpdatePayload(resultArray)) {
+        PDM_LOG_ERROR("PdmLunaService:%s line: %d unable to delete from db", __FUNCTION__, __LINE__);
     }
     return true;
 }
@@ -2657,17 +3054,9 @@ bool PdmLunaService::deleteAndUpdatePayload(pbnjson::JValue resultArray) {
             PDM_LOG_DEBUG("PdmLunaService::%s line:%d unable to remove the rootPath :%s", __FUNCTION__, __LINE__, rootPath.c_str());
         }
     }
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue request;
-    request = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                              {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
-    find_query.put("query", request);
-    if (LSCallOneReply(mServiceHandle,"luna://com.webos.service.db/del",
-                             find_query.stringify().c_str(), cbDeleteResponse, this, NULL, &lserror) == false) {
-        PDM_LOG_DEBUG("finding to the db failed in %s", __PRETTY_FUNCTION__ );
-        LSErrorPrint(&lserror, stderr);
-        LSErrorFree(&lserror);
-        return false;
+    PdmDeviceHistory::getInstance().remove(hubPortPath);
+    if(!updatePayload(m_deviceSetId, m_deviceType)) {
+        PDM_LOG_ERROR("PdmLunaService:%s line: %d not able to update the payload ", __FUNCTION__, __LINE__);
     }
     if (m_deviceType == "USB_STORAGE") {
         displayDisconnectedToast("Storage", m_deviceSetId);
@@ -2677,31 +3066,6 @@ bool PdmLunaService::deleteAndUpdatePayload(pbnjson::JValue resultArray) {
     return true;
 }
 
-bool PdmLunaService::cbDeleteResponse(LSHandle * sh, LSMessage * message, void * user_data) {
-    PDM_LOG_DEBUG("PdmLunaService:%s line: %d", __FUNCTION__, __LINE__);
-    const char* payload = LSMessageGetPayload(message);
-    if(!payload) {
-        PDM_LOG_ERROR("PdmLunaService:%s line: %d payload is empty ", __FUNCTION__, __LINE__);
-        return false;
-    }
-    PdmLunaService* object = (PdmLunaService*)user_data;
-    if(nullptr == object) {
-        PDM_LOG_ERROR("PdmLunaService:%s line: %d PdmLunaService obj is NULL", __FUNCTION__, __LINE__);
-        return false;
-    }
-    pbnjson::JValue request = pbnjson::JDomParser::fromString(payload);
-    PDM_LOG_DEBUG("PdmLunaService:%s line: %d request:%s", __FUNCTION__, __LINE__, request.stringify().c_str());
-    if(request.isNull() || (!request["returnValue"].asBool()) || (!request["count"].asNumber<int>()))
-    {
-        PDM_LOG_ERROR("PdmLunaService:%s line: %d Not able to delete ", __FUNCTION__, __LINE__);
-    } else {
-        if((object) && !(object->updatePayload(m_deviceSetId, m_deviceType))) {
-            PDM_LOG_ERROR("PdmLunaService:%s line: %d not able to update the payload ", __FUNCTION__, __LINE__);
-        }
-    }
-    return true;
-}
-
 bool PdmLunaService::updatePayload(std::string deviceSetId, std::string deviceType) {
     PDM_LOG_DEBUG("PdmLunaService:%s line: %d", __FUNCTION__, __LINE__);
     LSError lserror;
@@ -2719,6 +3083,7 @@ bool PdmLunaService::updatePayload(std::string deviceSetId, std::string deviceTy
                                                                  {{"prop", "deviceType"}, {"op", "!="}, {"val", "USB_STORAGE"}}}}};
     }
     find_query.put("query", request);
+    PdmDeviceHistory::getInstance().flush();
     if (LSCallOneReply(mServiceHandle,"luna://com.webos.service.db/find",
                              find_query.stringify().c_str(), cbPayloadResponse, this, NULL, &lserror) == false) {
         PDM_LOG_DEBUG("finding to the db failed in %s", __PRETTY_FUNCTION__ );
@@ -2810,6 +3175,7 @@ void PdmLunaService::updateHostPayload(std::string deviceType) {
                                     {"where", pbnjson::JArray{{{"prop", "deviceType"}, {"op", "!="}, {"val", "USB_STORAGE"}}}}};
     }
     find_query.put("query", request);
+    PdmDeviceHistory::getInstance().flush();
     if (LSCallOneReply(mServiceHandle,"luna://com.webos.service.db/find",
                              find_query.stringify().c_str(), cbHostPayloadResponse, this, NULL, &lserror) == false) {
         PDM_LOG_DEBUG("finding to the db failed in %s", __PRETTY_FUNCTION__ );
@@ -2891,6 +3257,7 @@ void PdmLunaService::updateAllDeviceSessionPayload(std::string deviceSetId) {
     request = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
                                     {"where", pbnjson::JArray{{{"prop", "deviceSetId"}, {"op", "="}, {"val", deviceSetId.c_str()}}}}};
     find_query.put("query", request);
+    PdmDeviceHistory::getInstance().flush();
     if (LSCallOneReply(mServiceHandle,"luna://com.webos.service.db/find",
                              find_query.stringify().c_str(), cbAllDeviceSessionResponse, this, NULL, &lserror) == false) {
         PDM_LOG_DEBUG("finding to the db failed in %s", __PRETTY_FUNCTION__ );
@@ -2955,42 +3322,23 @@ void PdmLunaService::deleteDeviceFromDbExceptBTDongle()
 {
     PDM_LOG_INFO("PdmLunaService:",0,"%s line: %d ", __FUNCTION__,__LINE__);
 
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue query;
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"}};
-
-    find_query.put("query", query);
-
-    LS::Payload find_payload(find_query);
-    LS::Call call = get_LSCPPHandle()->callOneReply("luna://com.webos.service.db/find", find_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull() || !request["returnValue"].asBool())
-    {
-        PDM_LOG_ERROR("PdmLunaService:%s line: %d request is empty ", __FUNCTION__, __LINE__);
+    // The only DB8 read of the history, later lookups are served from memory
+    pbnjson::JValue resultArray = PdmDeviceHistory::getInstance().load(get_LSCPPHandle());
+    if(resultArray.arraySize() == 0) {
+        PDM_LOG_INFO("PdmLunaService:",0,"%s line: %d DB is empty", __FUNCTION__,__LINE__);
         return;
     }
-
-    pbnjson::JValue resultArray = request["results"];
-    if(resultArray.isArray()) {
-        if(resultArray.arraySize() == 0) {
-            PDM_LOG_INFO("PdmLunaService:",0,"%s line: %d DB is empty", __FUNCTION__,__LINE__);
-        } else{
-            PDM_LOG_INFO("PdmLunaService:",0,"%s line: %d array size:%zu", __FUNCTION__,__LINE__, resultArray.arraySize());
-            for(ssize_t index = 0; index < resultArray.arraySize() ; ++index) {
-               std::string hubPortPath = resultArray[index]["hubPortPath"].asString();
-                std::string deviceType = resultArray[index]["deviceType"].asString();
-                std::string deviceSetId = resultArray[index]["deviceSetId"].asString();
-                PDM_LOG_INFO("PdmLunaService:",0,"%s line: %d hubPortPath: %s deviceType :%s deviceSetId: %s", __FUNCTION__,__LINE__, hubPortPath.c_str(), deviceType.c_str(), deviceSetId.c_str());
-                if((!hubPortPath.empty()) && (!deviceType.empty())) {
-                    if(deviceType != "BLUETOOTH")
-                    {
-                        deleteDeviceFromDb(deviceType);
-                    }
-                }
+    PDM_LOG_INFO("PdmLunaService:",0,"%s line: %d array size:%zu", __FUNCTION__,__LINE__, resultArray.arraySize());
+    std::set<std::string> deletedTypes;
+    for(ssize_t index = 0; index < resultArray.arraySize() ; ++index) {
+        std::string hubPortPath = resultArray[index]["hubPortPath"].asString();
+        std::string deviceType = resultArray[index]["deviceType"].asString();
+        std::string deviceSetId = resultArray[index]["deviceSetId"].asString();
+        PDM_LOG_INFO("PdmLunaService:",0,"%s line: %d hubPortPath: %s deviceType :%s deviceSetId: %s", __FUNCTION__,__LINE__, hubPortPath.c_str(), deviceType.c_str(), deviceSetId.c_str());
+        if((!hubPortPath.empty()) && (!deviceType.empty())) {
+            if(deviceType != "BLUETOOTH" && deletedTypes.insert(deviceType).second)
+            {
+                deleteDeviceFromDb(deviceType);
             }
         }
     }
@@ -2998,62 +3346,18 @@ void PdmLunaService::deleteDeviceFromDbExceptBTDongle()
 
 void PdmLunaService::deleteDeviceFromDb(std::string deviceType)
 {
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue query;
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                            {"where", pbnjson::JArray{{{"prop", "deviceType"}, {"op", "="}, {"val", deviceType.c_str()}}}}};
-
-    find_query.put("query", query);
-
-    LS::Payload find_payload(find_query);
-    LS::Call call = get_LSCPPHandle()->callOneReply("luna://com.webos.service.db/del", find_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull() || !request["returnValue"].asBool())
-    {
-        PDM_LOG_ERROR("PdmLunaService:%s line: %d request is empty ", __FUNCTION__, __LINE__);
-    }
+    PdmDeviceHistory::getInstance().removeDeviceType(deviceType);
 }
 
 void PdmLunaService::deletePreviousMountName(std::string hubPortPath)
 {
     PDM_LOG_DEBUG("PdmLunaService::%s line:%d hubPortPath:%s ", __FUNCTION__, __LINE__, hubPortPath.c_str());
-    LSError lserror;
-    LSErrorInit(&lserror);
-
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue query;
-    int32_t driveSize = 0;
-
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                             {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
-
-    find_query.put("query", query);
-
-    LS::Payload find_payload(find_query);
-    LS::Call call = LunaIPC::getInstance()->getLSCPPHandle()->callOneReply("luna://com.webos.service.db/find", find_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull())
-    {
-        PDM_LOG_DEBUG("Db8 LS2 response is empty in %s", __PRETTY_FUNCTION__ );
-    }
-
-    if(!request["returnValue"].asBool())
-    {
-        PDM_LOG_DEBUG("Call to Db8 to is failed in %s", __PRETTY_FUNCTION__ );
-    }
+    pbnjson::JValue record = PdmDeviceHistory::getInstance().find(hubPortPath);
 
-    if (request["results"][0]["deviceType"] == "USB_STORAGE")
+    if (record["deviceType"].asString() == "USB_STORAGE")
     {
-        for(ssize_t idx = 0; idx < request["results"][0]["storageDriveList"].arraySize() ; idx++) {
-            std::string mountName = request["results"][0]["storageDriveList"][idx]["mountName"].asString();
+        for(ssize_t idx = 0; idx < record["storageDriveList"].arraySize() ; idx++) {
+            std::string mountName = record["storageDriveList"][idx]["mountName"].asString();
             PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d driveName:%s", __FUNCTION__, __LINE__,mountName.c_str());
             if(umount(mountName)) {
                 int ret = PdmUtils::removeDirRecursive(mountName);
@@ -3068,34 +3372,7 @@ void PdmLunaService::deletePreviousMountName(std::string hubPortPath)
 void PdmLunaService::deletePreviousPayload(std::string hubPortPath)
 {
     PDM_LOG_DEBUG("PdmLunaService::%s line:%d hubPortPath:%s ", __FUNCTION__, __LINE__, hubPortPath.c_str());
-    LSError lserror;
-    LSErrorInit(&lserror);
-
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue query;
-    int32_t driveSize = 0;
-
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                             {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
-
-    find_query.put("query", query);
-
-    LS::Payload find_payload(find_query);
-    LS::Call call = LunaIPC::getInstance()->getLSCPPHandle()->callOneReply("luna://com.webos.service.db/del", find_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull())
-    {
-        PDM_LOG_ERROR("PdmLunaService::%s:%d Db8 LS2 response is empty", __FUNCTION__, __LINE__);
-    }
-
-    if(!request["returnValue"].asBool())
-    {
-        PDM_LOG_ERROR("PdmLunaService::%s:%d NOT able to delete from db", __FUNCTION__, __LINE__);
-    }
+    PdmDeviceHistory::getInstance().remove(hubPortPath);
     PDM_LOG_INFO("PdmLunaService:",0,"%s line: %d deleted the previous set device", __FUNCTION__,__LINE__);
 }
 
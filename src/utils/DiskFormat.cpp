@@ -17,7 +17,7 @@
 #include "DiskFormat.h"
 #include "Common.h"
 #include "PdmLogUtils.h"
-#include <cstdlib>
+#include "PdmProcessRunner.h"
 
 DiskFormat::DiskFormat()
 {
@@ -39,19 +39,26 @@ PdmDevStatus DiskFormat::formatDrive(const std::string driveName,const std::stri
         return PdmDevStatus::PDM_DEV_UNSUPPORTED_FS;
     }
 
-    std::string syscommand(formatFsCommands[fsType]);
-
+    PdmProcessSpec spec;
+    spec.argv = PdmProcessRunner::splitArgs(formatFsCommands[fsType]);
+    spec.argv.push_back("/dev/" + driveName);
     if(!volumeLabel.empty())
     {
-        syscommand += " /dev/"+ driveName + volumeLabelOptions[fsType] + volumeLabel;
+        std::vector<std::string> labelOption = PdmProcessRunner::splitArgs(volumeLabelOptions[fsType]);
+        spec.argv.insert(spec.argv.end(), labelOption.begin(), labelOption.end());
+        spec.argv.push_back(volumeLabel);
     }
-    else
-        syscommand += " /dev/"+ driveName;
+    spec.niceValue = PDM_FSCK_NICE_VALUE;
+    spec.ioClass = PdmIoPriorityClass::BEST_EFFORT;
+    spec.ioLevel = PDM_FSCK_IO_LEVEL;
+    spec.onOutputLine = [driveName](const std::string &line) {
+        PDM_LOG_DEBUG("DiskFormat: %s progress: %s", driveName.c_str(), line.c_str());
+    };
 
-    PDM_LOG_INFO("DiskFormat:",0,"%s line: %d system command: %s", __FUNCTION__,__LINE__,syscommand.c_str());
-    int ret  = system(syscommand.c_str());
-    if (ret){
-        PDM_LOG_ERROR("DiskFormat:%s line: %d Format failed", __FUNCTION__, __LINE__);
+    PDM_LOG_INFO("DiskFormat:",0,"%s line: %d command: %s /dev/%s", __FUNCTION__,__LINE__,spec.argv[0].c_str(),driveName.c_str());
+    PdmProcessResult result = PdmProcessRunner::getInstance().run(spec);
+    if (!result.succeeded()){
+        PDM_LOG_ERROR("DiskFormat:%s line: %d Format failed, %s", __FUNCTION__, __LINE__, PdmProcessRunner::describe(result).c_str());
         return PdmDevStatus::PDM_DEV_FORMAT_FAIL;
     }
     return PdmDevStatus::PDM_DEV_SUCCESS;
@@ -16,6 +16,7 @@
 
 #include "Common.h"
 #include "DiskPartitionInfo.h"
+#include "PdmDeviceHistory.h"
 #include "PdmLogUtils.h"
 #include <luna-service2/lunaservice.hpp>
 #include <luna-service2++/handle.hpp>
@@ -29,6 +30,7 @@ DiskPartitionInfo::DiskPartitionInfo(PdmConfig* const pConfObj, PluginAdapter* c
             , m_fsckStatus(PARTITION_FSCK_NONE)
             , m_isSupportedFS(false)
             , driveStatus(MOUNT_NOT_OK)
+            , m_fsState("unknown")
 {
 }
 
@@ -55,7 +57,7 @@ void DiskPartitionInfo::setDriveStatus(std::string dStatus)
 {
     m_isMounted = false;
     driveStatus = dStatus;
-    if( driveStatus == MOUNT_OK )
+    if( driveStatus == MOUNT_OK || driveStatus == MOUNT_READ_ONLY_OK )
         m_isMounted = true;
 }
 
@@ -88,39 +90,8 @@ void DiskPartitionInfo::setVolumeLabel(const std::string &label) {
 #ifdef WEBOS_SESSION
 bool DiskPartitionInfo::isPartitionMounted(std::string hubPortPath) {
 
-    PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d hubPortPath:%s", __FUNCTION__, __LINE__, hubPortPath.c_str());
-    LSError lserror;
-    LSErrorInit(&lserror);
-
-    std::string m_errorReason;
-
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue query;
-
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                             {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
-
-    find_query.put("query", query);
-
-    LS::Payload find_payload(find_query);
-    LS::Call call = LunaIPC::getInstance()->getLSCPPHandle()->callOneReply("luna://com.webos.service.db/find", find_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull())
-    {
-        PDM_LOG_DEBUG("Db8 LS2 response is empty in %s", __PRETTY_FUNCTION__ );
-    }
-
-    if(!request["returnValue"].asBool())
-    {
-        PDM_LOG_DEBUG("Call to Db8 to is failed in %s", __PRETTY_FUNCTION__ );
-    }
-
-    m_errorReason = request["results"][0]["errorReason"].asString();
-    PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d deviceSetId: %s", __FUNCTION__, __LINE__, m_errorReason.c_str());
+    std::string m_errorReason = PdmDeviceHistory::getInstance().find(hubPortPath)["errorReason"].asString();
+    PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d hubPortPath:%s errorReason: %s", __FUNCTION__, __LINE__, hubPortPath.c_str(), m_errorReason.c_str());
     if(m_errorReason == "nothing") {
        return true;
     }
@@ -129,94 +100,36 @@ bool DiskPartitionInfo::isPartitionMounted(std::string hubPortPath) {
 
 std::string DiskPartitionInfo::getPartitionMountName(std::string hubPortPath, std::string driveName) {
 
-    PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d hubPortPath:%s driveName:%s", __FUNCTION__, __LINE__, hubPortPath.c_str(), driveName.c_str());
-    LSError lserror;
-    LSErrorInit(&lserror);
-
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue query;
     std::string mountName;
-
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                             {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
-
-    find_query.put("query", query);
-
-    LS::Payload find_payload(find_query);
-    LS::Call call = LunaIPC::getInstance()->getLSCPPHandle()->callOneReply("luna://com.webos.service.db/find", find_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull())
+    pbnjson::JValue record = PdmDeviceHistory::getInstance().find(hubPortPath);
+    if (record["deviceType"].asString() == "USB_STORAGE")
     {
-        PDM_LOG_DEBUG("Db8 LS2 response is empty in %s", __PRETTY_FUNCTION__ );
-    }
-
-    if(!request["returnValue"].asBool())
-    {
-        PDM_LOG_DEBUG("Call to Db8 to is failed in %s", __PRETTY_FUNCTION__ );
-    }
-
-    if (request["results"][0]["deviceType"] == "USB_STORAGE")
-    {
-        for(ssize_t idx = 0; idx < request["results"][0]["storageDriveList"].arraySize() ; idx++) {
-            std::string partitionName = request["results"][0]["storageDriveList"][idx]["driveName"].asString();
-            PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d mountName: %s driveName:%s", __FUNCTION__, __LINE__, mountName.c_str(), driveName.c_str());
+        for(ssize_t idx = 0; idx < record["storageDriveList"].arraySize() ; idx++) {
+            std::string partitionName = record["storageDriveList"][idx]["driveName"].asString();
             if(partitionName == driveName){
-                mountName = request["results"][0]["storageDriveList"][idx]["mountName"].asString();
+                mountName = record["storageDriveList"][idx]["mountName"].asString();
                 break;
             }
         }
     }
-    PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d mountName: %s", __FUNCTION__, __LINE__, mountName.c_str());
+    PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d hubPortPath:%s driveName:%s mountName: %s", __FUNCTION__, __LINE__, hubPortPath.c_str(), driveName.c_str(), mountName.c_str());
     return mountName;
 }
 int DiskPartitionInfo::getPartitionSize(std::string hubPortPath, std::string driveName) {
 
-    PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d hubPortPath:%s driveName:%s", __FUNCTION__, __LINE__, hubPortPath.c_str(), driveName.c_str());
-    LSError lserror;
-    LSErrorInit(&lserror);
-
-    pbnjson::JValue find_query = pbnjson::Object();
-    pbnjson::JValue query;
     int32_t driveSize = 0;
-
-    query = pbnjson::JObject{{"from", "com.webos.service.pdmhistory:1"},
-                             {"where", pbnjson::JArray{{{"prop", "hubPortPath"}, {"op", "="}, {"val", hubPortPath.c_str()}}}}};
-
-    find_query.put("query", query);
-
-    LS::Payload find_payload(find_query);
-    LS::Call call = LunaIPC::getInstance()->getLSCPPHandle()->callOneReply("luna://com.webos.service.db/find", find_payload.getJson(), NULL, this, NULL);
-    LS::Message message = call.get();
-
-    LS::PayloadRef response_payload = message.accessPayload();
-    pbnjson::JValue request = response_payload.getJValue();
-
-    if(request.isNull())
-    {
-        PDM_LOG_DEBUG("Db8 LS2 response is empty in %s", __PRETTY_FUNCTION__ );
-    }
-
-    if(!request["returnValue"].asBool())
-    {
-        PDM_LOG_DEBUG("Call to Db8 to is failed in %s", __PRETTY_FUNCTION__ );
-    }
-
-    if (request["results"][0]["deviceType"] == "USB_STORAGE")
+    pbnjson::JValue record = PdmDeviceHistory::getInstance().find(hubPortPath);
+    if (record["deviceType"].asString() == "USB_STORAGE")
     {
-        for(ssize_t idx = 0; idx < request["results"][0]["storageDriveList"].arraySize() ; idx++) {
-            std::string partitionName = request["results"][0]["storageDriveList"][idx]["driveName"].asString();
-            PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d driveName:%s", __FUNCTION__, __LINE__,driveName.c_str());
+        for(ssize_t idx = 0; idx < record["storageDriveList"].arraySize() ; idx++) {
+            std::string partitionName = record["storageDriveList"][idx]["driveName"].asString();
             if(partitionName == driveName){
-                driveSize = request["results"][0]["storageDriveList"][idx]["driveSize"].asNumber<int>();
+                driveSize = record["storageDriveList"][idx]["driveSize"].asNumber<int>();
                 break;
             }
         }
     }
-    PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d driveSize: %d", __FUNCTION__, __LINE__, driveSize);
+    PDM_LOG_DEBUG("DiskPartitionInfo::%s line:%d hubPortPath:%s driveName:%s driveSize: %d", __FUNCTION__, __LINE__, hubPortPath.c_str(), driveName.c_str(), driveSize);
     return driveSize;
 }
 #endif
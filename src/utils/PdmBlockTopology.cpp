@@ -0,0 +1,145 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <algorithm>
+#include <dirent.h>
+#include <fstream>
+
+#include "PdmBlockTopology.h"
+#include "PdmLogUtils.h"
+
+PdmBlockTopology::PdmBlockTopology()
+    : m_generation(0)
+    , m_sysfsRoot(PDM_SYSFS_CLASS_BLOCK)
+{
+}
+
+PdmBlockTopology& PdmBlockTopology::getInstance()
+{
+    static PdmBlockTopology obj;
+    return obj;
+}
+
+std::string PdmBlockTopology::getKernelName(const std::string &devName)
+{
+    size_t pos = devName.find_last_of('/');
+    return (pos == std::string::npos) ? devName : devName.substr(pos + 1);
+}
+
+bool PdmBlockTopology::readValue(const std::string &path, uint64_t &value)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+    file >> value;
+    return !file.fail();
+}
+
+bool PdmBlockTopology::readDisk(const std::string &diskName, PdmBlockDisk &disk) const
+{
+    std::string diskPath = m_sysfsRoot + "/" + diskName;
+    uint64_t value = 0;
+    if (!readValue(diskPath + "/size", disk.size))
+        return false;
+    disk.name = diskName;
+    disk.readOnly = readValue(diskPath + "/ro", value) && value;
+    disk.removable = readValue(diskPath + "/removable", value) && value;
+    disk.rotational = readValue(diskPath + "/queue/rotational", value) && value;
+    disk.partitions.clear();
+
+    DIR *pDir = opendir(diskPath.c_str());
+    if (!pDir)
+        return false;
+    struct dirent *pDirEnt;
+    while ((pDirEnt = readdir(pDir)) != nullptr) {
+        std::string entry = pDirEnt->d_name;
+        // Partitions are the subdirectories named after the disk that have a partition file
+        if (entry.compare(0, diskName.size(), diskName) != 0)
+            continue;
+        std::string partitionPath = diskPath + "/" + entry;
+        uint64_t number = 0;
+        if (!readValue(partitionPath + "/partition", number))
+            continue;
+        PdmBlockPartition partition;
+        partition.name = entry;
+        partition.number = static_cast<int>(number);
+        partition.start = 0;
+        partition.size = 0;
+        readValue(partitionPath + "/start", partition.start);
+        readValue(partitionPath + "/size", partition.size);
+        partition.readOnly = readValue(partitionPath + "/ro", value) && value;
+        disk.partitions.push_back(partition);
+    }
+    closedir(pDir);
+    std::sort(disk.partitions.begin(), disk.partitions.end(), [](const PdmBlockPartition &a, const PdmBlockPartition &b) {
+        return a.number < b.number;
+    });
+    return true;
+}
+
+bool PdmBlockTopology::getDisk(const std::string &devName, PdmBlockDisk &disk)
+{
+    std::string diskName = getKernelName(devName);
+    if (diskName.empty())
+        return false;
+
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMtx);
+        auto itr = m_cache.find(diskName);
+        if (itr != m_cache.end()) {
+            disk = itr->second;
+            return true;
+        }
+        generation = m_generation;
+    }
+
+    if (!readDisk(diskName, disk)) {
+        PDM_LOG_DEBUG("PdmBlockTopology:%s line: %d %s not found in sysfs", __FUNCTION__, __LINE__, diskName.c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_cacheMtx);
+    if (m_generation == generation)
+        m_cache[diskName] = disk;
+    return true;
+}
+
+int PdmBlockTopology::getPartitionCount(const std::string &devName)
+{
+    PdmBlockDisk disk;
+    if (!getDisk(devName, disk))
+        return 0;
+    return static_cast<int>(disk.partitions.size());
+}
+
+void PdmBlockTopology::invalidate(const std::string &devName)
+{
+    std::string name = getKernelName(devName);
+    if (name.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_cacheMtx);
+    m_generation++;
+    for (auto itr = m_cache.begin(); itr != m_cache.end();) {
+        // The disk itself or one of its partitions, sda1 or mmcblk0p1
+        if (name.compare(0, itr->first.size(), itr->first) == 0)
+            itr = m_cache.erase(itr);
+        else
+            ++itr;
+    }
+}
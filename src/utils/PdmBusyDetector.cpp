@@ -0,0 +1,163 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <chrono>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <limits.h>
+#include <set>
+#include <unistd.h>
+
+#include "PdmBusyDetector.h"
+#include "PdmLogUtils.h"
+
+namespace {
+    const std::string DELETED_SUFFIX = " (deleted)";
+
+    bool readLink(const std::string &path, std::string &target)
+    {
+        char buffer[PATH_MAX];
+        ssize_t len = readlink(path.c_str(), buffer, sizeof(buffer) - 1);
+        if (len <= 0)
+            return false;
+        target.assign(buffer, len);
+        if (target.size() > DELETED_SUFFIX.size() &&
+            target.compare(target.size() - DELETED_SUFFIX.size(), DELETED_SUFFIX.size(), DELETED_SUFFIX) == 0)
+            target.erase(target.size() - DELETED_SUFFIX.size());
+        return true;
+    }
+
+    // Index of the mount point path lies below, -1 if none
+    int findMountPoint(const std::vector<std::string> &mountPoints, const std::string &path)
+    {
+        if (path.empty() || path[0] != '/')
+            return -1;
+        for (size_t index = 0; index < mountPoints.size(); index++) {
+            const std::string &mountPoint = mountPoints[index];
+            if (path.compare(0, mountPoint.size(), mountPoint) == 0 &&
+                (path.size() == mountPoint.size() || path[mountPoint.size()] == '/'))
+                return static_cast<int>(index);
+        }
+        return -1;
+    }
+
+    void checkProcess(const std::string &pidDir, const std::vector<std::string> &mountPoints, std::set<int> &matches)
+    {
+        std::string target;
+        if (readLink(pidDir + "/cwd", target))
+            matches.insert(findMountPoint(mountPoints, target));
+        if (readLink(pidDir + "/root", target))
+            matches.insert(findMountPoint(mountPoints, target));
+
+        std::string fdDir = pidDir + "/fd";
+        DIR *pDir = opendir(fdDir.c_str());
+        if (pDir) {
+            struct dirent *pDirEnt;
+            while ((pDirEnt = readdir(pDir)) != nullptr) {
+                if (pDirEnt->d_name[0] == '.')
+                    continue;
+                if (readLink(fdDir + "/" + pDirEnt->d_name, target))
+                    matches.insert(findMountPoint(mountPoints, target));
+            }
+            closedir(pDir);
+        }
+
+        // Path is the last field of a mapping, only file backed ones have it
+        std::ifstream maps(pidDir + "/maps");
+        std::string line;
+        while (std::getline(maps, line)) {
+            size_t pos = line.find('/');
+            if (pos == std::string::npos)
+                continue;
+            target = line.substr(pos);
+            if (target.size() > DELETED_SUFFIX.size() &&
+                target.compare(target.size() - DELETED_SUFFIX.size(), DELETED_SUFFIX.size(), DELETED_SUFFIX) == 0)
+                target.erase(target.size() - DELETED_SUFFIX.size());
+            matches.insert(findMountPoint(mountPoints, target));
+        }
+        matches.erase(-1);
+    }
+}
+
+bool PdmBusyDetector::findUsers(const std::vector<std::string> &mountPoints, std::map<std::string, std::vector<pid_t>> &users,
+                                unsigned int budgetMs)
+{
+    users.clear();
+    std::vector<std::string> normalized;
+    for (auto mountPoint : mountPoints) {
+        while (mountPoint.size() > 1 && mountPoint.back() == '/')
+            mountPoint.pop_back();
+        if (!mountPoint.empty())
+            normalized.push_back(mountPoint);
+    }
+    if (normalized.empty())
+        return true;
+
+    DIR *pDir = opendir("/proc");
+    if (!pDir) {
+        PDM_LOG_ERROR("PdmBusyDetector:%s line: %d opendir /proc failed", __FUNCTION__, __LINE__);
+        return false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budgetMs);
+    bool complete = true;
+    struct dirent *pDirEnt;
+    while ((pDirEnt = readdir(pDir)) != nullptr) {
+        char *end = nullptr;
+        long pid = strtol(pDirEnt->d_name, &end, 10);
+        if (pid <= 0 || *end != '\0')
+            continue;
+        if (std::chrono::steady_clock::now() > deadline) {
+            complete = false;
+            break;
+        }
+        std::set<int> matches;
+        checkProcess(std::string("/proc/") + pDirEnt->d_name, normalized, matches);
+        for (auto index : matches)
+            users[normalized[index]].push_back(static_cast<pid_t>(pid));
+    }
+    closedir(pDir);
+
+    if (!complete)
+        PDM_LOG_WARNING("PdmBusyDetector:%s line: %d scan exceeded %u ms", __FUNCTION__, __LINE__, budgetMs);
+    return complete;
+}
+
+bool PdmBusyDetector::isBusy(const std::string &mountPoint, std::vector<pid_t> &pids)
+{
+    pids.clear();
+    std::map<std::string, std::vector<pid_t>> users;
+    bool complete = findUsers(std::vector<std::string>{mountPoint}, users);
+    if (!users.empty())
+        pids = users.begin()->second;
+    return !complete || !pids.empty();
+}
+
+std::string PdmBusyDetector::describe(const std::vector<pid_t> &pids)
+{
+    std::string description;
+    for (auto pid : pids) {
+        std::string name;
+        std::ifstream comm("/proc/" + std::to_string(pid) + "/comm");
+        std::getline(comm, name);
+        if (!description.empty())
+            description.append(" ");
+        description.append(std::to_string(pid) + "(" + name + ")");
+    }
+    return description;
+}
@@ -18,9 +18,12 @@
 
 #include "Common.h"
 #include "DiskFormat.h"
+#include "PdmBusyDetector.h"
 #include "PdmFs.h"
 #include "PdmFsck.h"
 #include "PdmLogUtils.h"
+#include "PdmProcessRunner.h"
+#include "PdmSuperblockProbe.h"
 #include "PdmUtils.h"
 
 #include <unordered_map>
@@ -85,12 +88,26 @@ PdmDevStatus PdmFs::fsck(DiskPartitionInfo &partition, const std::string &fsckMo
 {
     PDM_LOG_INFO("PdmFs:",0,"%s line: %d driveType : %s partitionName : %s",
                  __FUNCTION__,__LINE__,partition.getFsType().c_str(), partition.getDriveName().c_str());
+    // Only a forced check runs the checker on a volume marked clean
+    PdmFsState fsState = probeFsState(partition);
+    if(fsState == PdmFsState::CLEAN && fsckMode != PDM_FSCK_FORCE) {
+        PDM_LOG_INFO("PdmFs:",0,"%s line: %d %s is clean, skipping fsck", __FUNCTION__,__LINE__,partition.getDriveName().c_str());
+        partition.setFsckStatus(PdmDevStatus::PDM_DEV_SUCCESS);
+        return PdmDevStatus::PDM_DEV_SUCCESS;
+    }
     PdmFsck dfsckObj;
     partition.setFsckStatus(PARTITION_FSCK_STARTED);
-    PdmDevStatus fsckStatus =  dfsckObj.fsck(fsckMode, partition.getFsType(), partition.getDriveName());
+    bool checkerRan = false;
+    PdmDevStatus fsckStatus =  dfsckObj.fsck(fsckMode, partition.getFsType(), partition.getDriveName(), &checkerRan);
     partition.setFsckStatus(fsckStatus);
     if(PdmDevStatus::PDM_DEV_FSCK_TIMEOUT == fsckStatus)
         partition.setDriveStatus(PDM_ERR_NEED_FSCK);
+    // Only a checker that ran to its end changes the probed state, a timed
+    // out, cancelled or missing one tells nothing about the volume
+    if(checkerRan && PdmDevStatus::PDM_DEV_SUCCESS == fsckStatus)
+        partition.setFsState(PdmSuperblockProbe::getStateName(PdmFsState::CLEAN));
+    else if(checkerRan && PdmDevStatus::PDM_DEV_FSCK_FAIL == fsckStatus)
+        partition.setFsState(PdmSuperblockProbe::getStateName(PdmFsState::ERROR));
     return fsckStatus;
 }
 
@@ -133,6 +150,39 @@ bool PdmFs::mountPartition(DiskPartitionInfo &partition, const bool &readOnly)
     return false;
 }
 
+PdmDevStatus PdmFs::checkOnly(DiskPartitionInfo &partition)
+{
+    PdmFsck dfsckObj;
+    PdmDevStatus fsckStatus = dfsckObj.checkOnly(partition.getFsType(), partition.getDriveName());
+    if(PdmDevStatus::PDM_DEV_SUCCESS == fsckStatus)
+        partition.setFsState(PdmSuperblockProbe::getStateName(PdmFsState::CLEAN));
+    else if(PdmDevStatus::PDM_DEV_FSCK_FAIL == fsckStatus)
+        partition.setFsState(PdmSuperblockProbe::getStateName(PdmFsState::ERROR));
+    return fsckStatus;
+}
+
+bool PdmFs::canCheckOnly(DiskPartitionInfo &partition) const
+{
+    return PdmFsck::hasCheckOnly(partition.getFsType());
+}
+
+bool PdmFs::remountReadWrite(DiskPartitionInfo &partition)
+{
+    std::string fsType = partition.getFsType();
+    const char *data   = mountData[fsType].c_str();
+    uint64_t mountFlag = mountflags(fsType, false) | MS_REMOUNT;
+    std::string driveName("/dev/");
+
+    driveName.append(partition.getDriveName());
+
+    if(mount(driveName.c_str(), partition.getMountName().c_str(), fsType.c_str(), mountFlag, (void*)data)) {
+        PDM_LOG_ERROR("PdmFs:%s line: %d remount of %s failed. errno: %d strerror: %s", __FUNCTION__, __LINE__, driveName.c_str(), errno, strerror(errno));
+        return false;
+    }
+    PDM_LOG_DEBUG("PdmFs:%s line: %d Partition %s is writable", __FUNCTION__, __LINE__, partition.getMountName().c_str());
+    return true;
+}
+
 bool PdmFs::umount(DiskPartitionInfo &partition, const bool lazyUnmount) const
 {
     bool retValue = true;
@@ -151,8 +201,6 @@ bool PdmFs::umount(DiskPartitionInfo &partition, const bool lazyUnmount) const
 
 PdmDevStatus PdmFs::setVolumeLabel(DiskPartitionInfo *partition, const std::string &volLabel)
 {
-    int ret = -1;
-
     const std::string driveName = partition->getDriveName();
     partition->partitionLock();
     PDM_LOG_DEBUG("PdmFs:%s line: %d Volume label to be set : %s", __FUNCTION__, __LINE__, volLabel.c_str());
@@ -161,28 +209,28 @@ PdmDevStatus PdmFs::setVolumeLabel(DiskPartitionInfo *partition, const std::stri
         partition->partitionUnLock();
         return PdmDevStatus::PDM_DEV_VOLUME_LABEL_EMPTY;
     }
-    std::string sysCommand = "";
+    PdmProcessSpec spec;
     std::string fsType = partition->getFsType();
 
      PDM_LOG_DEBUG("PdmFs:%s line: %d File system type : %s", __FUNCTION__, __LINE__, fsType.c_str());
 
     if ( fsType == "tntfs" || fsType == "ntfs") {
-        sysCommand = "ntfslabel -f  /dev/" + driveName + " " + volLabel;
+        spec.argv = {"ntfslabel", "-f", "/dev/" + driveName, volLabel};
     } else if ( fsType == "vfat" || fsType == "tfat" ) {
-        sysCommand = "fatlabel -f -l "+ volLabel + " /dev/"+ driveName;
+        spec.argv = {"fatlabel", "-f", "-l", volLabel, "/dev/" + driveName};
     } else if ( fsType == "ext2" || fsType == "ext3" || fsType == "ext4" ) {
-        sysCommand = "e2label  /dev/" + driveName + " " + volLabel;
+        spec.argv = {"e2label", "/dev/" + driveName, volLabel};
     } else {
         partition->partitionUnLock();
         PDM_LOG_WARNING("PdmFs:%s line: %d Unsupporetd File system", __FUNCTION__, __LINE__);
         return PdmDevStatus::PDM_DEV_UNSUPPORTED_FS;
     }
-    PDM_LOG_INFO("PdmFs:",0,"%s line: %d System command to set label : %s", __FUNCTION__,__LINE__,sysCommand.c_str());
+    PDM_LOG_INFO("PdmFs:",0,"%s line: %d Setting label with %s on /dev/%s", __FUNCTION__,__LINE__,spec.argv[0].c_str(),driveName.c_str());
 
-    ret = system(sysCommand.c_str());
+    PdmProcessResult result = PdmProcessRunner::getInstance().run(spec);
 
-    if (ret == -1 || ret == 127 ) {
-        PDM_LOG_ERROR("PdmFs:%s line: %d Setting volume Label:%s failed", __FUNCTION__, __LINE__, volLabel.c_str());
+    if (!result.succeeded()) {
+        PDM_LOG_ERROR("PdmFs:%s line: %d Setting volume Label:%s failed, %s", __FUNCTION__, __LINE__, volLabel.c_str(), PdmProcessRunner::describe(result).c_str());
         partition->partitionUnLock();
         return PdmDevStatus::PDM_DEV_SET_VOLUME_LABEL_FAIL;
     } else {
@@ -280,21 +328,47 @@ void PdmFs::checkFileSystem(DiskPartitionInfo &partition) {
 
     bool result = isSupportedFileSystem(partition.getFsType(), partition.getStorageTypeString());
     partition.setIsSupportedFs(result);
+    if(result)
+        probeFsState(partition);
     bool isDirCreated =  PdmUtils::createDir(partition.getMountName());
     PDM_LOG_INFO("DiskPartitionInfo:",0,"%s line: %d Directory is created? %s Mount path: %s",
                             __FUNCTION__,__LINE__,isDirCreated?"YES":"NO", partition.getMountName().c_str());
 }
 
-bool PdmFs::isDriveBusy(DiskPartitionInfo &partition) const
+PdmFsState PdmFs::probeFsState(DiskPartitionInfo &partition)
+{
+    PdmFsState fsState = PdmSuperblockProbe::probeState("/dev/" + partition.getDriveName(), partition.getFsType());
+    partition.setFsState(PdmSuperblockProbe::getStateName(fsState));
+    return fsState;
+}
+
+bool PdmFs::isDriveBusy(DiskPartitionInfo &partition, std::vector<pid_t> *busyPids) const
 {
     PDM_LOG_INFO("PdmFs:",0,"%s line: %d Drive Mount Name: %s", __FUNCTION__,__LINE__,partition.getMountName().c_str());
-    std::string sysCommand("lsof +D ");
-    sysCommand.append(partition.getMountName());
-    std::string result = PdmUtils::execShellCmd(sysCommand);
-    if(!result.empty()){
-        PDM_LOG_ERROR("PdmFs:%s line: %d error on isDriveBusy", __FUNCTION__, __LINE__);
+    std::vector<pid_t> pids;
+    if(PdmBusyDetector::isBusy(partition.getMountName(), pids)){
+        PDM_LOG_ERROR("PdmFs:%s line: %d drive is busy, used by: %s", __FUNCTION__, __LINE__, PdmBusyDetector::describe(pids).c_str());
+        if(busyPids)
+            busyPids->insert(busyPids->end(), pids.begin(), pids.end());
         return true;
     }
 
     return false;
 }
+
+bool PdmFs::isAnyDriveBusy(const std::list<DiskPartitionInfo*> &partitions, std::vector<pid_t> *busyPids) const
+{
+    std::vector<std::string> mountNames;
+    for(auto partition : partitions)
+        mountNames.push_back(partition->getMountName());
+
+    std::map<std::string, std::vector<pid_t>> users;
+    bool complete = PdmBusyDetector::findUsers(mountNames, users);
+    for(auto const& user : users) {
+        PDM_LOG_ERROR("PdmFs:%s line: %d %s is busy, used by: %s", __FUNCTION__, __LINE__, user.first.c_str(),
+                      PdmBusyDetector::describe(user.second).c_str());
+        if(busyPids)
+            busyPids->insert(busyPids->end(), user.second.begin(), user.second.end());
+    }
+    return !complete || !users.empty();
+}
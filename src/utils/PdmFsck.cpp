@@ -17,6 +17,8 @@
 #include "PdmFsck.h"
 #include "StorageDevice.h"
 #include "PdmLogUtils.h"
+#include "PdmFsckScheduler.h"
+#include "PdmProcessRunner.h"
 #include "Common.h"
 
 using namespace PdmDevAttributes;
@@ -37,6 +39,13 @@ using namespace PdmDevAttributes;
         { PDM_DRV_TYPE_ERR, { "", "" }},
     };
 
+    // Checkers that can run in no-modify mode
+    fsckCmdMap fsckCheckOnlyBinOptionMap =    {
+        { PDM_DRV_TYPE_FAT, { "fsck.vfat", "-n" }},
+        { PDM_DRV_TYPE_EXT2, { "fsck.ext2", "-n" }},
+        { PDM_DRV_TYPE_EXT3, { "fsck.ext3", "-n" }},
+        { PDM_DRV_TYPE_EXT4, { "fsck.ext4", "-n" }},
+    };
 
 PdmFsck::PdmFsck()
 {
@@ -47,8 +56,10 @@ PdmFsck::~PdmFsck()
 
 }
 
-PdmDevStatus PdmFsck::fsck(const std::string& fsckMode,const std::string driveType,const std::string partitionName)
+PdmDevStatus PdmFsck::fsck(const std::string& fsckMode,const std::string driveType,const std::string partitionName, bool *checkerRan)
 {
+    if(checkerRan)
+        *checkerRan = false;
    PDM_LOG_DEBUG("PdmFsck: %s line: %d partitionName: %s, driveType: %s, fsckMode = %s", __FUNCTION__, __LINE__, partitionName.c_str(), driveType.c_str(),fsckMode.c_str());
 
     fsckBinOptionPair binOption = fsckDriveTypeBinOptionMap[driveType];
@@ -62,30 +73,94 @@ PdmDevStatus PdmFsck::fsck(const std::string& fsckMode,const std::string driveTy
     }
     std::string fsckOption = binOption.second;
     std::string Mode = getFsckMode(driveType,fsckMode);
-    std::string sysCommand;
-    if(fsckMode == PDM_FSCK_AUTO && driveType != PDM_DRV_TYPE_TNTFS && driveType != PDM_DRV_TYPE_TFAT){
-            sysCommand = timeout + fsckbin + " " + Mode + " " + fsckOption + " /dev/" + partitionName;
-    }
-    else
-        sysCommand = fsckbin + " " + Mode + " " + fsckOption + " /dev/" + partitionName;
+    PdmProcessSpec spec;
+    spec.argv = PdmProcessRunner::splitArgs(fsckbin + " " + Mode + " " + fsckOption);
+    spec.argv.push_back("/dev/" + partitionName);
+    if(fsckMode == PDM_FSCK_AUTO && driveType != PDM_DRV_TYPE_TNTFS && driveType != PDM_DRV_TYPE_TFAT)
+        spec.timeoutMs = PDM_FSCK_AUTO_TIMEOUT_MS;
+    spec.niceValue = PDM_FSCK_NICE_VALUE;
+    spec.ioClass = PdmIoPriorityClass::BEST_EFFORT;
+    spec.ioLevel = PDM_FSCK_IO_LEVEL;
+    spec.onOutputLine = [partitionName](const std::string &line) {
+        PDM_LOG_DEBUG("PdmFsck: %s progress: %s", partitionName.c_str(), line.c_str());
+    };
 
-    PDM_LOG_INFO("PdmFsck:",0,"%s line: %d] %s FSCK Mode, %s FSCK fsckOption, %s FSCK sysCommand ", __FUNCTION__,__LINE__,Mode.c_str(), fsckOption.c_str(), sysCommand.c_str());
-    int32_t result = system(sysCommand.c_str());
-    if (result == 1 || result == 2)
+    PDM_LOG_INFO("PdmFsck:",0,"%s line: %d] %s FSCK Mode, %s FSCK fsckOption, timeout: %u ms", __FUNCTION__,__LINE__,Mode.c_str(), fsckOption.c_str(), spec.timeoutMs);
+    PdmProcessResult result = PdmFsckScheduler::getInstance().runProcess(spec);
+    if(result.status == PdmProcessResult::SPAWN_FAILED)
     {
-        PDM_LOG_ERROR("PdmFsck: %s line: %d partitionName:%s FSCK fail !!\n",__FUNCTION__,__LINE__,partitionName.c_str());
-        return PdmDevStatus::PDM_DEV_FSCK_FAIL;
+        PDM_LOG_WARNING("PdmFsck: %s line: %d partitionName: %s no checker available, %s",__FUNCTION__,__LINE__,partitionName.c_str(), PdmProcessRunner::describe(result).c_str());
+        return PdmDevStatus::PDM_DEV_SUCCESS;
+    }
+    // The device went away, it is neither mounted nor marked
+    if(result.status == PdmProcessResult::CANCELLED)
+    {
+        PDM_LOG_INFO("PdmFsck:",0,"%s line: %d partitionName: %s FSCK cancelled",__FUNCTION__,__LINE__,partitionName.c_str());
+        return PdmDevStatus::PDM_DEV_ERROR;
     }
-    else if(result == FSCK_COMMAND_TIMEOUT)
+    if(checkerRan)
+        *checkerRan = true;
+    if(result.status == PdmProcessResult::TIMEOUT)
     {
         PDM_LOG_WARNING("PdmFsck: %s line: %d partitionName: %s FSCK Commands timeout !!\n",__FUNCTION__,__LINE__,partitionName.c_str());
         return PdmDevStatus::PDM_DEV_FSCK_TIMEOUT;
     }
-    else
+    // 0: no errors, 1: errors corrected, anything else left errors behind
+    if (result.status != PdmProcessResult::EXITED || result.exitCode > 1)
     {
-        PDM_LOG_DEBUG("PdmFsck: %s line : %d  partitionName :%s FSCK success , result : %d!!\n",__FUNCTION__,__LINE__,partitionName.c_str(), result);
-        return PdmDevStatus::PDM_DEV_SUCCESS;
+        PDM_LOG_ERROR("PdmFsck: %s line: %d partitionName:%s FSCK fail, %s !!\n",__FUNCTION__,__LINE__,partitionName.c_str(), PdmProcessRunner::describe(result).c_str());
+        return PdmDevStatus::PDM_DEV_FSCK_FAIL;
+    }
+    PDM_LOG_DEBUG("PdmFsck: %s line : %d  partitionName :%s FSCK success , result : %d!!\n",__FUNCTION__,__LINE__,partitionName.c_str(), result.exitCode);
+    return PdmDevStatus::PDM_DEV_SUCCESS;
+}
+
+bool PdmFsck::hasCheckOnly(const std::string &driveType)
+{
+    return fsckCheckOnlyBinOptionMap.find(driveType) != fsckCheckOnlyBinOptionMap.end();
+}
+
+PdmDevStatus PdmFsck::checkOnly(const std::string driveType,const std::string partitionName)
+{
+    auto binOption = fsckCheckOnlyBinOptionMap.find(driveType);
+    if(binOption == fsckCheckOnlyBinOptionMap.end())
+    {
+        PDM_LOG_DEBUG("PdmFsck: %s line: %d no read-only checker for %s", __FUNCTION__, __LINE__, driveType.c_str());
+        return PdmDevStatus::PDM_DEV_UNSUPPORTED_FS;
+    }
+    PdmProcessSpec spec;
+    spec.argv = {binOption->second.first, binOption->second.second, "/dev/" + partitionName};
+    spec.timeoutMs = PDM_FSCK_CHECK_ONLY_TIMEOUT_MS;
+    spec.niceValue = PDM_FSCK_NICE_VALUE;
+    spec.ioClass = PdmIoPriorityClass::BEST_EFFORT;
+    spec.ioLevel = PDM_FSCK_IO_LEVEL;
+    spec.onOutputLine = [partitionName](const std::string &line) {
+        PDM_LOG_DEBUG("PdmFsck: %s progress: %s", partitionName.c_str(), line.c_str());
+    };
+
+    PdmProcessResult result = PdmFsckScheduler::getInstance().runProcess(spec);
+    if(result.status == PdmProcessResult::SPAWN_FAILED)
+    {
+        PDM_LOG_WARNING("PdmFsck: %s line: %d partitionName: %s no checker available, %s", __FUNCTION__, __LINE__, partitionName.c_str(), PdmProcessRunner::describe(result).c_str());
+        return PdmDevStatus::PDM_DEV_UNSUPPORTED_FS;
+    }
+    if(result.status == PdmProcessResult::CANCELLED)
+    {
+        PDM_LOG_INFO("PdmFsck:",0,"%s line: %d partitionName: %s check cancelled", __FUNCTION__, __LINE__, partitionName.c_str());
+        return PdmDevStatus::PDM_DEV_ERROR;
+    }
+    if(result.status == PdmProcessResult::TIMEOUT)
+    {
+        PDM_LOG_WARNING("PdmFsck: %s line: %d partitionName: %s check timeout", __FUNCTION__, __LINE__, partitionName.c_str());
+        return PdmDevStatus::PDM_DEV_FSCK_TIMEOUT;
+    }
+    // Any error found makes the checker exit non zero in no-modify mode
+    if(!result.succeeded())
+    {
+        PDM_LOG_WARNING("PdmFsck: %s line: %d partitionName: %s has errors, %s", __FUNCTION__, __LINE__, partitionName.c_str(), PdmProcessRunner::describe(result).c_str());
+        return PdmDevStatus::PDM_DEV_FSCK_FAIL;
     }
+    return PdmDevStatus::PDM_DEV_SUCCESS;
 }
 
 std::string PdmFsck::getFsckMode(std::string driveType, std::string fsckMode)
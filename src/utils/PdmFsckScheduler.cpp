@@ -0,0 +1,221 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <algorithm>
+#include <exception>
+
+#include "PdmBlockTopology.h"
+#include "PdmFsckScheduler.h"
+#include "PdmLogUtils.h"
+
+PdmFsckScheduler::PdmFsckScheduler()
+    : m_nextSeq(0)
+    , m_stop(false)
+{
+    for (unsigned int i = 0; i < PDM_FSCK_SCHEDULER_MAX_CONCURRENT; i++)
+        m_workers.emplace_back(&PdmFsckScheduler::workerLoop, this);
+}
+
+PdmFsckScheduler::~PdmFsckScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_queue.clear();
+    }
+    m_taskCv.notify_all();
+    for (auto &worker : m_workers) {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+PdmFsckScheduler& PdmFsckScheduler::getInstance()
+{
+    static PdmFsckScheduler obj;
+    return obj;
+}
+
+unsigned int PdmFsckScheduler::readDiskLimit(const std::string &diskName)
+{
+    PdmBlockDisk disk;
+    // Unknown disks are treated as rotational, serializing is always safe
+    if (!PdmBlockTopology::getInstance().getDisk(diskName, disk) || disk.rotational)
+        return PDM_FSCK_ROTATIONAL_DISK_LIMIT;
+    return PDM_FSCK_FLASH_DISK_LIMIT;
+}
+
+void PdmFsckScheduler::submit(const void *owner, const std::string &diskName, uint64_t priority, std::function<void()> fn)
+{
+    unsigned int diskLimit = readDiskLimit(diskName);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop)
+            return;
+        if (m_diskLimit.find(diskName) == m_diskLimit.end())
+            m_diskLimit[diskName] = diskLimit;
+        Task task = { m_nextSeq++, owner, diskName, priority, std::move(fn) };
+        m_queue.push_back(std::move(task));
+        PDM_LOG_DEBUG("PdmFsckScheduler:%s line: %d disk: %s priority: %llu limit: %u queued: %zu", __FUNCTION__, __LINE__,
+                      diskName.c_str(), static_cast<unsigned long long>(priority), m_diskLimit[diskName], m_queue.size());
+    }
+    m_taskCv.notify_one();
+}
+
+// Caller holds m_mutex
+std::list<PdmFsckScheduler::Task>::iterator PdmFsckScheduler::nextRunnable()
+{
+    auto best = m_queue.end();
+    for (auto itr = m_queue.begin(); itr != m_queue.end(); ++itr) {
+        if (m_diskRunning[itr->diskName] >= m_diskLimit[itr->diskName])
+            continue;
+        if (best == m_queue.end() || itr->priority > best->priority ||
+            (itr->priority == best->priority && itr->seq < best->seq))
+            best = itr;
+    }
+    return best;
+}
+
+// Caller holds m_mutex
+void PdmFsckScheduler::releaseDisk(const std::string &diskName)
+{
+    if (m_diskRunning[diskName] > 0)
+        m_diskRunning[diskName]--;
+    if (m_diskRunning[diskName] > 0)
+        return;
+    bool queued = std::any_of(m_queue.begin(), m_queue.end(), [&](const Task &task) { return task.diskName == diskName; });
+    if (!queued) {
+        // Read the limit again next time, the disk may have been replaced
+        m_diskRunning.erase(diskName);
+        m_diskLimit.erase(diskName);
+    }
+}
+
+void PdmFsckScheduler::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        auto itr = m_queue.end();
+        m_taskCv.wait(lock, [this, &itr] {
+            if (m_stop)
+                return true;
+            itr = nextRunnable();
+            return itr != m_queue.end();
+        });
+        if (m_stop)
+            return;
+
+        Task task = std::move(*itr);
+        m_queue.erase(itr);
+        m_diskRunning[task.diskName]++;
+        m_running.push_back({task.owner, std::this_thread::get_id(), PDM_INVALID_PROCESS_ID, false});
+        lock.unlock();
+
+        try {
+            task.fn();
+        }
+        catch (std::exception &e) {
+            PDM_LOG_ERROR("PdmFsckScheduler:%s line: %d Caught exception: %s", __FUNCTION__, __LINE__, e.what());
+        }
+
+        lock.lock();
+        auto running = std::find_if(m_running.begin(), m_running.end(), [](const Running &r) {
+            return r.worker == std::this_thread::get_id();
+        });
+        if (running != m_running.end())
+            m_running.erase(running);
+        releaseDisk(task.diskName);
+        m_doneCv.notify_all();
+        // A task of the disk this one held may be runnable now
+        m_taskCv.notify_all();
+    }
+}
+
+// Caller holds m_mutex
+PdmFsckScheduler::Running* PdmFsckScheduler::findRunning(std::thread::id worker)
+{
+    auto running = std::find_if(m_running.begin(), m_running.end(), [worker](const Running &r) {
+        return r.worker == worker;
+    });
+    return (running != m_running.end()) ? &*running : nullptr;
+}
+
+PdmProcessResult PdmFsckScheduler::runProcess(const PdmProcessSpec &spec)
+{
+    std::thread::id self = std::this_thread::get_id();
+    PdmProcessResult result = PdmProcessRunner::getInstance().run(spec, [this, self](PdmProcessId id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Running *running = findRunning(self);
+        if (!running)
+            return;
+        running->process = id;
+        // The owner went away before the process was queued
+        if (running->cancelled)
+            PdmProcessRunner::getInstance().cancel(id);
+    });
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Running *running = findRunning(self);
+    if (running)
+        running->process = PDM_INVALID_PROCESS_ID;
+    return result;
+}
+
+size_t PdmFsckScheduler::cancel(const void *owner)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    size_t dropped = 0;
+    std::vector<std::string> disks;
+    for (auto itr = m_queue.begin(); itr != m_queue.end();) {
+        if (itr->owner == owner) {
+            disks.push_back(itr->diskName);
+            itr = m_queue.erase(itr);
+            dropped++;
+        } else {
+            ++itr;
+        }
+    }
+    for (auto &diskName : disks) {
+        if (m_diskRunning[diskName] == 0)
+            releaseDisk(diskName);
+    }
+
+    // A task cancelling its own owner does not wait for itself
+    std::thread::id self = std::this_thread::get_id();
+    for (auto &running : m_running) {
+        if (running.owner != owner || running.worker == self)
+            continue;
+        running.cancelled = true;
+        if (running.process != PDM_INVALID_PROCESS_ID) {
+            PDM_LOG_INFO("PdmFsckScheduler:",0,"%s line: %d terminating a running check", __FUNCTION__, __LINE__);
+            PdmProcessRunner::getInstance().cancel(running.process);
+        }
+    }
+    m_doneCv.wait(lock, [this, owner, self] {
+        return std::none_of(m_running.begin(), m_running.end(), [owner, self](const Running &r) {
+            return r.owner == owner && r.worker != self;
+        });
+    });
+    if (dropped)
+        PDM_LOG_INFO("PdmFsckScheduler:",0,"%s line: %d dropped %zu queued tasks", __FUNCTION__, __LINE__, dropped);
+    return dropped;
+}
+
+size_t PdmFsckScheduler::getQueuedCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
@@ -0,0 +1,191 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <mutex>
+
+#include "PdmLatencyStats.h"
+
+#define PDM_LATENCY_NO_DEVICE_TYPE "none"
+
+namespace {
+    std::mutex sHistogramsMtx;
+    std::map<std::string, PdmLatencyStageHistograms> sHistograms;
+    thread_local PdmLatencyStats::EventScope *sCurrentEvent = nullptr;
+
+    size_t getBucket(uint64_t us)
+    {
+        size_t bucket = 0;
+        while (bucket < PDM_LATENCY_BUCKET_COUNT - 1 && us >= (1ULL << bucket))
+            bucket++;
+        return bucket;
+    }
+
+    void addSample(PdmLatencyStage stage, const std::string &deviceType, PdmLatencyStats::Clock::duration elapsed)
+    {
+        size_t index = static_cast<size_t>(stage);
+        if (index >= static_cast<size_t>(PdmLatencyStage::MAX_STAGES))
+            return;
+        int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        uint64_t sample = us > 0 ? static_cast<uint64_t>(us) : 0;
+
+        std::lock_guard<std::mutex> lock(sHistogramsMtx);
+        auto itr = sHistograms.find(deviceType);
+        if (itr == sHistograms.end())
+            itr = sHistograms.emplace(deviceType, PdmLatencyStageHistograms()).first;
+        PdmLatencyHistogram &histogram = itr->second[index];
+        histogram.count++;
+        histogram.totalUs += sample;
+        if (sample > histogram.maxUs)
+            histogram.maxUs = sample;
+        histogram.buckets[getBucket(sample)]++;
+    }
+}
+
+PdmLatencyStats::EventScope::EventScope(const std::string &deviceType, Clock::time_point receiveTime)
+    : m_deviceType(deviceType.empty() ? PDM_LATENCY_NO_DEVICE_TYPE : deviceType)
+    , m_receiveTime(receiveTime)
+    , m_replied(false)
+    , m_previous(sCurrentEvent)
+{
+    sCurrentEvent = this;
+}
+
+PdmLatencyStats::EventScope::~EventScope()
+{
+    sCurrentEvent = m_previous;
+}
+
+PdmLatencyStats::EventScope* PdmLatencyStats::EventScope::current()
+{
+    return sCurrentEvent;
+}
+
+bool PdmLatencyStats::EventScope::markReplied()
+{
+    if (m_replied)
+        return false;
+    m_replied = true;
+    return true;
+}
+
+PdmLatencyStats::StageTimer::StageTimer(PdmLatencyStage stage)
+    : m_stage(stage)
+    , m_elapsed(Clock::duration::zero())
+    , m_running(false)
+    , m_used(false)
+{
+}
+
+PdmLatencyStats::StageTimer::~StageTimer()
+{
+    stop();
+    if (!m_used)
+        return;
+    EventScope *event = EventScope::current();
+    addSample(m_stage, event ? event->getDeviceType() : PDM_LATENCY_NO_DEVICE_TYPE, m_elapsed);
+}
+
+void PdmLatencyStats::StageTimer::start()
+{
+    if (m_running)
+        return;
+    m_start = Clock::now();
+    m_running = true;
+    m_used = true;
+}
+
+void PdmLatencyStats::StageTimer::stop()
+{
+    if (!m_running)
+        return;
+    m_elapsed += Clock::now() - m_start;
+    m_running = false;
+}
+
+void PdmLatencyStats::record(PdmLatencyStage stage, const std::string &deviceType, Clock::time_point start, Clock::time_point end)
+{
+    addSample(stage, deviceType.empty() ? PDM_LATENCY_NO_DEVICE_TYPE : deviceType, end - start);
+}
+
+void PdmLatencyStats::record(PdmLatencyStage stage, Clock::time_point start, Clock::time_point end)
+{
+    EventScope *event = EventScope::current();
+    addSample(stage, event ? event->getDeviceType() : PDM_LATENCY_NO_DEVICE_TYPE, end - start);
+}
+
+void PdmLatencyStats::markReplied()
+{
+    EventScope *event = EventScope::current();
+    if (event && event->markReplied())
+        addSample(PdmLatencyStage::END_TO_END, event->getDeviceType(), Clock::now() - event->getReceiveTime());
+}
+
+std::map<std::string, PdmLatencyStageHistograms> PdmLatencyStats::getHistograms()
+{
+    std::lock_guard<std::mutex> lock(sHistogramsMtx);
+    return sHistograms;
+}
+
+void PdmLatencyStats::reset()
+{
+    std::lock_guard<std::mutex> lock(sHistogramsMtx);
+    sHistograms.clear();
+}
+
+// Upper bound of the bucket holding the given percentile, capped by the maximum
+uint64_t PdmLatencyStats::getPercentileUs(const PdmLatencyHistogram &histogram, unsigned int percentile)
+{
+    if (histogram.count == 0)
+        return 0;
+    uint64_t rank = (histogram.count * percentile + 99) / 100;
+    if (rank == 0)
+        rank = 1;
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < PDM_LATENCY_BUCKET_COUNT; bucket++) {
+        seen += histogram.buckets[bucket];
+        if (seen >= rank) {
+            uint64_t upperUs = 1ULL << bucket;
+            return upperUs < histogram.maxUs ? upperUs : histogram.maxUs;
+        }
+    }
+    return histogram.maxUs;
+}
+
+const char* PdmLatencyStats::getStageName(PdmLatencyStage stage)
+{
+    switch (stage)
+    {
+        case PdmLatencyStage::DISPATCH:
+            return "dispatch";
+        case PdmLatencyStage::QUEUE_WAIT:
+            return "queueWait";
+        case PdmLatencyStage::HANDLER:
+            return "handler";
+        case PdmLatencyStage::NOTIFY:
+            return "notify";
+        case PdmLatencyStage::OBSERVER_QUEUE:
+            return "observerQueue";
+        case PdmLatencyStage::PAYLOAD_BUILD:
+            return "payloadBuild";
+        case PdmLatencyStage::SUBSCRIPTION_REPLY:
+            return "subscriptionReply";
+        case PdmLatencyStage::END_TO_END:
+            return "endToEnd";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,455 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "PdmLogUtils.h"
+#include "PdmProcessRunner.h"
+
+extern char **environ;
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    // Polling interval for children without pidfd, on kernels older than 5.3
+    const int REAP_POLL_INTERVAL_MS = 50;
+    const int IOPRIO_WHO_PROCESS = 1;
+    const int IOPRIO_CLASS_SHIFT = 13;
+
+    int openPidFd(pid_t pid)
+    {
+#ifdef SYS_pidfd_open
+        int fd = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+        if (fd >= 0)
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        return fd;
+#else
+        return -1;
+#endif
+    }
+
+    // posix_spawn cannot set these for the child, they are applied right
+    // after the spawn instead
+    void applyPriority(pid_t pid, const PdmProcessSpec &spec)
+    {
+        if (spec.niceValue != 0 && setpriority(PRIO_PROCESS, pid, spec.niceValue) != 0)
+            PDM_LOG_WARNING("PdmProcessRunner:%s line: %d setpriority %d failed: %s", __FUNCTION__, __LINE__, pid, strerror(errno));
+#ifdef SYS_ioprio_set
+        if (spec.ioClass != PdmIoPriorityClass::INHERIT) {
+            int ioprio = (static_cast<int>(spec.ioClass) << IOPRIO_CLASS_SHIFT) | (spec.ioLevel & 0x7);
+            if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, pid, ioprio) != 0)
+                PDM_LOG_WARNING("PdmProcessRunner:%s line: %d ioprio_set %d failed: %s", __FUNCTION__, __LINE__, pid, strerror(errno));
+        }
+#endif
+    }
+
+    unsigned int elapsedMs(Clock::time_point from, Clock::time_point to)
+    {
+        return static_cast<unsigned int>(std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count());
+    }
+}
+
+struct PdmProcessRunner::Request {
+    PdmProcessId id;
+    PdmProcessSpec spec;
+    PdmProcessDoneCb done;
+    PdmProcessResult result;
+    pid_t pid = -1;
+    int pidFd = -1;
+    int outFd = -1;
+    bool started = false;
+    bool exited = false;
+    std::atomic<bool> cancelRequested{false};
+    bool termSent = false;
+    Clock::time_point startTime;
+    Clock::time_point deadline;
+    Clock::time_point killTime;
+    std::string lineBuffer;
+};
+
+PdmProcessRunner::PdmProcessRunner()
+    : m_nextId(PDM_INVALID_PROCESS_ID + 1)
+    , m_maxConcurrent(PDM_PROCESS_MAX_CONCURRENT)
+    , m_running(0)
+    , m_urgentRunning(0)
+    , m_wakeFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+    , m_stop(false)
+{
+    if (m_wakeFd < 0)
+        PDM_LOG_ERROR("PdmProcessRunner:%s line: %d eventfd failed: %s", __FUNCTION__, __LINE__, strerror(errno));
+    m_thread = std::thread(&PdmProcessRunner::runLoop, this);
+}
+
+PdmProcessRunner::~PdmProcessRunner()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    wake();
+    if (m_thread.joinable())
+        m_thread.join();
+    if (m_wakeFd >= 0)
+        close(m_wakeFd);
+}
+
+PdmProcessRunner& PdmProcessRunner::getInstance()
+{
+    static PdmProcessRunner obj;
+    return obj;
+}
+
+void PdmProcessRunner::wake()
+{
+    uint64_t one = 1;
+    if (m_wakeFd >= 0 && write(m_wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+        PDM_LOG_WARNING("PdmProcessRunner:%s line: %d wakeup failed: %s", __FUNCTION__, __LINE__, strerror(errno));
+}
+
+std::vector<std::string> PdmProcessRunner::splitArgs(const std::string &cmdLine)
+{
+    std::vector<std::string> args;
+    size_t pos = 0;
+    while (pos < cmdLine.size()) {
+        size_t start = cmdLine.find_first_not_of(" \t", pos);
+        if (start == std::string::npos)
+            break;
+        size_t end = cmdLine.find_first_of(" \t", start);
+        if (end == std::string::npos)
+            end = cmdLine.size();
+        args.push_back(cmdLine.substr(start, end - start));
+        pos = end;
+    }
+    return args;
+}
+
+std::string PdmProcessRunner::describe(const PdmProcessResult &result)
+{
+    switch (result.status) {
+        case PdmProcessResult::EXITED: return "exit " + std::to_string(result.exitCode);
+        case PdmProcessResult::SIGNALED: return "signal " + std::to_string(result.signal);
+        case PdmProcessResult::TIMEOUT: return "timeout";
+        case PdmProcessResult::CANCELLED: return "cancelled";
+        default: return "spawn failed";
+    }
+}
+
+PdmProcessId PdmProcessRunner::runAsync(const PdmProcessSpec &spec, PdmProcessDoneCb done)
+{
+    RequestPtr request = std::make_shared<Request>();
+    request->spec = spec;
+    request->done = std::move(done);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        request->id = m_nextId++;
+        m_requests[request->id] = request;
+        if (spec.urgent)
+            m_urgentPending.push_back(request);
+        else
+            m_pending.push_back(request);
+    }
+    wake();
+    return request->id;
+}
+
+PdmProcessResult PdmProcessRunner::run(const PdmProcessSpec &spec, std::function<void(PdmProcessId)> onQueued)
+{
+    struct Waiter {
+        std::mutex mtx;
+        std::condition_variable cv;
+        bool done = false;
+        PdmProcessResult result;
+    };
+    std::shared_ptr<Waiter> waiter = std::make_shared<Waiter>();
+    PdmProcessId id = runAsync(spec, [waiter](const PdmProcessResult &result) {
+        std::lock_guard<std::mutex> lock(waiter->mtx);
+        waiter->result = result;
+        waiter->done = true;
+        waiter->cv.notify_one();
+    });
+    if (onQueued)
+        onQueued(id);
+    std::unique_lock<std::mutex> lock(waiter->mtx);
+    waiter->cv.wait(lock, [waiter] { return waiter->done; });
+    return waiter->result;
+}
+
+bool PdmProcessRunner::cancel(PdmProcessId id)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_requests.find(id);
+        if (it == m_requests.end())
+            return false;
+        it->second->cancelRequested = true;
+    }
+    wake();
+    return true;
+}
+
+bool PdmProcessRunner::spawn(const RequestPtr &request)
+{
+    const PdmProcessSpec &spec = request->spec;
+    request->startTime = Clock::now();
+    if (spec.argv.empty()) {
+        PDM_LOG_ERROR("PdmProcessRunner:%s line: %d empty command", __FUNCTION__, __LINE__);
+        return false;
+    }
+
+    int pipeFds[2];
+    if (pipe2(pipeFds, O_CLOEXEC) != 0) {
+        PDM_LOG_ERROR("PdmProcessRunner:%s line: %d pipe failed: %s", __FUNCTION__, __LINE__, strerror(errno));
+        return false;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2(&actions, pipeFds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, pipeFds[1], STDERR_FILENO);
+
+    // Children start with default dispositions and an empty mask whatever
+    // the calling thread uses
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t signals;
+    sigemptyset(&signals);
+    posix_spawnattr_setsigmask(&attr, &signals);
+    sigfillset(&signals);
+    posix_spawnattr_setsigdefault(&attr, &signals);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+    std::vector<char*> argv;
+    for (const auto &arg : spec.argv)
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    pid_t pid = -1;
+    int err = posix_spawnp(&pid, argv[0], &actions, &attr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    close(pipeFds[1]);
+    if (err != 0) {
+        close(pipeFds[0]);
+        PDM_LOG_ERROR("PdmProcessRunner:%s line: %d spawn %s failed: %s", __FUNCTION__, __LINE__, argv[0], strerror(err));
+        return false;
+    }
+
+    fcntl(pipeFds[0], F_SETFL, fcntl(pipeFds[0], F_GETFL) | O_NONBLOCK);
+    request->pid = pid;
+    request->outFd = pipeFds[0];
+    request->pidFd = openPidFd(pid);
+    if (spec.timeoutMs)
+        request->deadline = request->startTime + std::chrono::milliseconds(spec.timeoutMs);
+    applyPriority(pid, spec);
+    PDM_LOG_DEBUG("PdmProcessRunner:%s line: %d started %s pid: %d", __FUNCTION__, __LINE__, argv[0], pid);
+    return true;
+}
+
+void PdmProcessRunner::startPending(std::deque<RequestPtr> &pending, unsigned int &running, unsigned int maxConcurrent,
+                                    std::vector<RequestPtr> &finished)
+{
+    while (!pending.empty() && running < maxConcurrent) {
+        RequestPtr request = pending.front();
+        pending.pop_front();
+        if (request->cancelRequested) {
+            request->result.status = PdmProcessResult::CANCELLED;
+            finished.push_back(request);
+            continue;
+        }
+        if (!spawn(request)) {
+            request->result.status = PdmProcessResult::SPAWN_FAILED;
+            finished.push_back(request);
+            continue;
+        }
+        request->started = true;
+        running++;
+    }
+}
+
+void PdmProcessRunner::readOutput(const RequestPtr &request)
+{
+    char buffer[4096];
+    while (request->outFd >= 0) {
+        ssize_t len = read(request->outFd, buffer, sizeof(buffer));
+        if (len < 0 && errno == EINTR)
+            continue;
+        if (len < 0 && errno == EAGAIN)
+            return;
+        if (len <= 0) {
+            close(request->outFd);
+            request->outFd = -1;
+            break;
+        }
+        std::string &output = request->result.output;
+        output.append(buffer, len);
+        if (output.size() > PDM_PROCESS_OUTPUT_LIMIT)
+            output.erase(0, output.size() - PDM_PROCESS_OUTPUT_LIMIT);
+        if (!request->spec.onOutputLine)
+            continue;
+        // Progress meters often rewrite the line with \r
+        for (ssize_t i = 0; i < len; i++) {
+            if (buffer[i] == '\n' || buffer[i] == '\r') {
+                if (!request->lineBuffer.empty())
+                    request->spec.onOutputLine(request->lineBuffer);
+                request->lineBuffer.clear();
+            } else if (request->lineBuffer.size() < PDM_PROCESS_OUTPUT_LIMIT) {
+                request->lineBuffer.push_back(buffer[i]);
+            }
+        }
+    }
+    if (!request->lineBuffer.empty() && request->spec.onOutputLine)
+        request->spec.onOutputLine(request->lineBuffer);
+    request->lineBuffer.clear();
+}
+
+bool PdmProcessRunner::reap(const RequestPtr &request)
+{
+    int status = 0;
+    pid_t ret;
+    do {
+        ret = waitpid(request->pid, &status, WNOHANG);
+    } while (ret < 0 && errno == EINTR);
+    if (ret == 0)
+        return false;
+
+    PdmProcessResult &result = request->result;
+    if (ret < 0) {
+        // Someone else reaped it, e.g. SIGCHLD set to SIG_IGN
+        PDM_LOG_WARNING("PdmProcessRunner:%s line: %d waitpid %d failed: %s", __FUNCTION__, __LINE__, request->pid, strerror(errno));
+        result.status = PdmProcessResult::EXITED;
+    } else if (WIFEXITED(status)) {
+        result.status = PdmProcessResult::EXITED;
+        result.exitCode = WEXITSTATUS(status);
+    } else {
+        result.status = PdmProcessResult::SIGNALED;
+        result.signal = WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+    }
+    if (request->termSent)
+        result.status = request->cancelRequested ? PdmProcessResult::CANCELLED : PdmProcessResult::TIMEOUT;
+    request->exited = true;
+    return true;
+}
+
+void PdmProcessRunner::finish(const RequestPtr &request)
+{
+    if (request->pidFd >= 0)
+        close(request->pidFd);
+    request->pidFd = -1;
+    // Drain what is buffered but do not wait for EOF, a daemonized FUSE
+    // helper may still hold the pipe
+    readOutput(request);
+    if (request->outFd >= 0)
+        close(request->outFd);
+    request->outFd = -1;
+    request->result.durationMs = elapsedMs(request->startTime, Clock::now());
+}
+
+void PdmProcessRunner::runLoop()
+{
+    while (true) {
+        std::vector<RequestPtr> finished;
+        std::vector<RequestPtr> running;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop)
+                break;
+            startPending(m_urgentPending, m_urgentRunning, PDM_PROCESS_URGENT_MAX_CONCURRENT, finished);
+            startPending(m_pending, m_running, m_maxConcurrent, finished);
+            for (const auto &entry : m_requests) {
+                if (entry.second->started)
+                    running.push_back(entry.second);
+            }
+        }
+
+        Clock::time_point now = Clock::now();
+        int timeoutMs = -1;
+        std::vector<struct pollfd> fds;
+        if (m_wakeFd >= 0)
+            fds.push_back({m_wakeFd, POLLIN, 0});
+        for (const auto &request : running) {
+            bool cancelRequested = request->cancelRequested;
+            bool expired = request->spec.timeoutMs && now >= request->deadline;
+            if ((cancelRequested || expired) && !request->termSent) {
+                PDM_LOG_WARNING("PdmProcessRunner:%s line: %d terminating %s pid: %d, %s", __FUNCTION__, __LINE__,
+                                request->spec.argv[0].c_str(), request->pid, cancelRequested ? "cancelled" : "timed out");
+                kill(request->pid, SIGTERM);
+                request->termSent = true;
+                request->killTime = now + std::chrono::milliseconds(PDM_PROCESS_KILL_GRACE_MS);
+            } else if (request->termSent && now >= request->killTime) {
+                kill(request->pid, SIGKILL);
+                request->killTime = now + std::chrono::milliseconds(PDM_PROCESS_KILL_GRACE_MS);
+            }
+
+            Clock::time_point wakeAt = request->termSent ? request->killTime : request->deadline;
+            if (request->termSent || request->spec.timeoutMs) {
+                int waitMs = static_cast<int>(elapsedMs(now, std::max(now, wakeAt))) + 1;
+                timeoutMs = (timeoutMs < 0) ? waitMs : std::min(timeoutMs, waitMs);
+            }
+            if (request->pidFd >= 0)
+                fds.push_back({request->pidFd, POLLIN, 0});
+            else
+                timeoutMs = (timeoutMs < 0) ? REAP_POLL_INTERVAL_MS : std::min(timeoutMs, REAP_POLL_INTERVAL_MS);
+            if (request->outFd >= 0)
+                fds.push_back({request->outFd, POLLIN, 0});
+        }
+
+        if (finished.empty() && poll(fds.data(), fds.size(), timeoutMs) < 0 && errno != EINTR)
+            PDM_LOG_ERROR("PdmProcessRunner:%s line: %d poll failed: %s", __FUNCTION__, __LINE__, strerror(errno));
+
+        uint64_t counter;
+        if (m_wakeFd >= 0)
+            while (read(m_wakeFd, &counter, sizeof(counter)) > 0);
+
+        for (const auto &request : running) {
+            readOutput(request);
+            if (!reap(request))
+                continue;
+            finish(request);
+            finished.push_back(request);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto &request : finished) {
+                if (request->started)
+                    (request->spec.urgent ? m_urgentRunning : m_running)--;
+                m_requests.erase(request->id);
+            }
+        }
+        for (const auto &request : finished) {
+            PDM_LOG_DEBUG("PdmProcessRunner:%s line: %d %s done: %s in %u ms", __FUNCTION__, __LINE__,
+                          request->spec.argv.empty() ? "" : request->spec.argv[0].c_str(),
+                          describe(request->result).c_str(), request->result.durationMs);
+            if (request->done)
+                request->done(request->result);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <atomic>
+#include <chrono>
+
+#include "PdmLogUtils.h"
+#include "PdmStartupMetrics.h"
+
+namespace {
+    std::atomic<int64_t> sEnumerationStartUs(-1);
+    std::atomic<int64_t> sCollectTimeMs(-1);
+    std::atomic<int64_t> sDispatchTimeMs(-1);
+    std::atomic<int64_t> sFirstMountTimeMs(-1);
+
+    int64_t nowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    int64_t elapsedMs()
+    {
+        int64_t startUs = sEnumerationStartUs.load();
+        if (startUs < 0)
+            return -1;
+        return (nowUs() - startUs) / 1000;
+    }
+}
+
+void PdmStartupMetrics::markEnumerationStart()
+{
+    sEnumerationStartUs = nowUs();
+}
+
+void PdmStartupMetrics::markEnumerationCollected(size_t deviceCount)
+{
+    sCollectTimeMs = elapsedMs();
+    PDM_LOG_INFO("PdmStartupMetrics:",0,"%s line: %d %zu devices collected in %lld ms", __FUNCTION__, __LINE__,
+                 deviceCount, (long long)sCollectTimeMs.load());
+}
+
+void PdmStartupMetrics::markEnumerationDispatched()
+{
+    sDispatchTimeMs = elapsedMs();
+    PDM_LOG_INFO("PdmStartupMetrics:",0,"%s line: %d enumeration dispatched after %lld ms", __FUNCTION__, __LINE__,
+                 (long long)sDispatchTimeMs.load());
+}
+
+void PdmStartupMetrics::markFirstMount(const std::string &driveName)
+{
+    int64_t elapsed = elapsedMs();
+    if (elapsed < 0)
+        return;
+
+    int64_t unset = -1;
+    if (sFirstMountTimeMs.compare_exchange_strong(unset, elapsed))
+        PDM_LOG_INFO("PdmStartupMetrics:",0,"%s line: %d time to first mount: %lld ms (%s)", __FUNCTION__, __LINE__,
+                     (long long)elapsed, driveName.c_str());
+}
+
+int64_t PdmStartupMetrics::getCollectTimeMs()
+{
+    return sCollectTimeMs.load();
+}
+
+int64_t PdmStartupMetrics::getDispatchTimeMs()
+{
+    return sDispatchTimeMs.load();
+}
+
+int64_t PdmStartupMetrics::getTimeToFirstMountMs()
+{
+    return sFirstMountTimeMs.load();
+}
@@ -0,0 +1,289 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+#include "Common.h"
+#include "PdmLogUtils.h"
+#include "PdmSuperblockProbe.h"
+
+using namespace PdmDevAttributes;
+
+namespace {
+    const off_t EXT_SUPERBLOCK_OFFSET = 1024;
+    const size_t EXT_SUPERBLOCK_SIZE = 1024;
+    const uint16_t EXT_MAGIC = 0xEF53;
+    const size_t FAT_BOOT_SECTOR_SIZE = 512;
+    const size_t HASH_CHUNK_SIZE = 64 * 1024;
+    const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+    const uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+    uint16_t readLe16(const uint8_t *data) { return data[0] | (data[1] << 8); }
+    uint32_t readLe32(const uint8_t *data) { return readLe16(data) | (static_cast<uint32_t>(readLe16(data + 2)) << 16); }
+    uint64_t readLe64(const uint8_t *data) { return readLe32(data) | (static_cast<uint64_t>(readLe32(data + 4)) << 32); }
+
+    bool readExact(int fd, off_t offset, uint8_t *buffer, size_t size)
+    {
+        size_t done = 0;
+        while (done < size) {
+            ssize_t len = pread(fd, buffer + done, size - done, offset + done);
+            if (len < 0 && errno == EINTR)
+                continue;
+            if (len <= 0)
+                return false;
+            done += len;
+        }
+        return true;
+    }
+
+    uint64_t hashBytes(uint64_t hash, const uint8_t *data, size_t size)
+    {
+        for (size_t i = 0; i < size; i++) {
+            hash ^= data[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    const uint16_t EXT_STATE_VALID = 0x0001;
+    const uint16_t EXT_STATE_ERROR = 0x0002;
+    const uint32_t EXT_INCOMPAT_RECOVER = 0x0004;
+    const uint32_t FAT12_MAX_CLUSTERS = 4085;
+    const uint16_t FAT16_CLEAN_BIT = 0x8000;
+    const uint16_t FAT16_HARD_ERROR_BIT = 0x4000;
+    const uint32_t FAT32_CLEAN_BIT = 0x08000000;
+    const uint32_t FAT32_HARD_ERROR_BIT = 0x04000000;
+    const uint8_t FAT_EXTENDED_BOOT_SIGNATURE = 0x29;
+    const uint8_t FAT_BPB_DIRTY = 0x01;
+    const size_t NTFS_MAX_RECORD_SIZE = 4096;
+    const uint32_t NTFS_VOLUME_RECORD = 3;
+    const uint32_t NTFS_ATTR_VOLUME_INFORMATION = 0x70;
+    const uint32_t NTFS_ATTR_END = 0xFFFFFFFF;
+    const uint16_t NTFS_VOLUME_IS_DIRTY = 0x0001;
+    const size_t NTFS_FIXUP_STRIDE = 512;
+
+    PdmFsState probeExt(int fd)
+    {
+        uint8_t sb[EXT_SUPERBLOCK_SIZE];
+        if (!readExact(fd, EXT_SUPERBLOCK_OFFSET, sb, sizeof(sb)) || readLe16(sb + 0x38) != EXT_MAGIC)
+            return PdmFsState::UNKNOWN;
+        uint16_t state = readLe16(sb + 0x3A);
+        if (state & EXT_STATE_ERROR)
+            return PdmFsState::ERROR;
+        if (!(state & EXT_STATE_VALID) || (readLe32(sb + 0x60) & EXT_INCOMPAT_RECOVER))
+            return PdmFsState::DIRTY;
+        return PdmFsState::CLEAN;
+    }
+
+    PdmFsState probeFat(int fd)
+    {
+        uint8_t boot[FAT_BOOT_SECTOR_SIZE];
+        if (!readExact(fd, 0, boot, sizeof(boot)) || boot[510] != 0x55 || boot[511] != 0xAA)
+            return PdmFsState::UNKNOWN;
+        uint16_t bytesPerSector = readLe16(boot + 11);
+        uint8_t sectorsPerCluster = boot[13];
+        uint16_t reservedSectors = readLe16(boot + 14);
+        uint8_t numFats = boot[16];
+        uint16_t rootEntries = readLe16(boot + 17);
+        uint32_t totalSectors = readLe16(boot + 19);
+        if (totalSectors == 0)
+            totalSectors = readLe32(boot + 32);
+        bool isFat32 = (readLe16(boot + 22) == 0);
+        uint32_t sectorsPerFat = isFat32 ? readLe32(boot + 36) : readLe16(boot + 22);
+        if (bytesPerSector < FAT_BOOT_SECTOR_SIZE || sectorsPerCluster == 0 || reservedSectors == 0 || sectorsPerFat == 0)
+            return PdmFsState::UNKNOWN;
+
+        uint32_t rootSectors = (rootEntries * 32 + bytesPerSector - 1) / bytesPerSector;
+        uint64_t metaSectors = reservedSectors + static_cast<uint64_t>(numFats) * sectorsPerFat + rootSectors;
+        if (totalSectors <= metaSectors)
+            return PdmFsState::UNKNOWN;
+        uint32_t clusters = static_cast<uint32_t>((totalSectors - metaSectors) / sectorsPerCluster);
+
+        // Windows and Linux set bit 0 of the BPB state byte while mounted
+        size_t extOffset = isFat32 ? 0x40 : 0x24;
+        bool bpbDirty = (boot[extOffset + 2] == FAT_EXTENDED_BOOT_SIGNATURE) && (boot[extOffset + 1] & FAT_BPB_DIRTY);
+
+        // FAT12 has no flags in FAT[1]. FAT32 is told by its BPB, as the
+        // kernel does, small FAT32 volumes are common.
+        if (!isFat32 && clusters < FAT12_MAX_CLUSTERS)
+            return bpbDirty ? PdmFsState::DIRTY : PdmFsState::CLEAN;
+
+        uint8_t entries[8];
+        if (!readExact(fd, static_cast<off_t>(reservedSectors) * bytesPerSector, entries, sizeof(entries)))
+            return PdmFsState::UNKNOWN;
+        bool clean, hardError;
+        if (!isFat32) {
+            uint16_t entry = readLe16(entries + 2);
+            clean = entry & FAT16_CLEAN_BIT;
+            hardError = !(entry & FAT16_HARD_ERROR_BIT);
+        } else {
+            uint32_t entry = readLe32(entries + 4);
+            clean = entry & FAT32_CLEAN_BIT;
+            hardError = !(entry & FAT32_HARD_ERROR_BIT);
+        }
+        if (hardError)
+            return PdmFsState::ERROR;
+        return (clean && !bpbDirty) ? PdmFsState::CLEAN : PdmFsState::DIRTY;
+    }
+
+    // Flags of the $VOLUME_INFORMATION attribute in MFT record 3 ($Volume)
+    PdmFsState probeNtfs(int fd)
+    {
+        uint8_t boot[FAT_BOOT_SECTOR_SIZE];
+        if (!readExact(fd, 0, boot, sizeof(boot)) || memcmp(boot + 3, "NTFS    ", 8) != 0)
+            return PdmFsState::UNKNOWN;
+        uint32_t bytesPerSector = readLe16(boot + 0x0B);
+        int8_t clusterField = static_cast<int8_t>(boot[0x0D]);
+        uint64_t clusterSize = (clusterField > 0) ? static_cast<uint64_t>(clusterField) * bytesPerSector
+                                                  : (1ULL << -clusterField);
+        int8_t recordField = static_cast<int8_t>(boot[0x40]);
+        uint64_t recordSize = (recordField > 0) ? recordField * clusterSize : (1ULL << -recordField);
+        if (bytesPerSector == 0 || recordSize < NTFS_FIXUP_STRIDE || recordSize > NTFS_MAX_RECORD_SIZE)
+            return PdmFsState::UNKNOWN;
+
+        uint8_t record[NTFS_MAX_RECORD_SIZE];
+        off_t offset = static_cast<off_t>(readLe64(boot + 0x30) * clusterSize + NTFS_VOLUME_RECORD * recordSize);
+        if (!readExact(fd, offset, record, recordSize) || memcmp(record, "FILE", 4) != 0)
+            return PdmFsState::UNKNOWN;
+
+        // Undo the update sequence fixups at the end of each 512 byte stride
+        uint16_t usaOffset = readLe16(record + 4);
+        uint16_t usaCount = readLe16(record + 6);
+        if (usaCount == 0 || usaOffset + usaCount * 2u > recordSize || (usaCount - 1) * NTFS_FIXUP_STRIDE > recordSize)
+            return PdmFsState::UNKNOWN;
+        for (uint16_t i = 1; i < usaCount; i++) {
+            uint8_t *tail = record + i * NTFS_FIXUP_STRIDE - 2;
+            if (memcmp(tail, record + usaOffset, 2) != 0)
+                return PdmFsState::UNKNOWN;
+            memcpy(tail, record + usaOffset + i * 2, 2);
+        }
+
+        size_t attrOffset = readLe16(record + 0x14);
+        while (attrOffset + 0x18 <= recordSize) {
+            const uint8_t *attr = record + attrOffset;
+            uint32_t type = readLe32(attr);
+            uint32_t length = readLe32(attr + 4);
+            if (type == NTFS_ATTR_END || length == 0 || attrOffset + length > recordSize)
+                break;
+            if (type == NTFS_ATTR_VOLUME_INFORMATION && attr[8] == 0) {
+                uint32_t valueLength = readLe32(attr + 0x10);
+                uint16_t valueOffset = readLe16(attr + 0x14);
+                if (valueLength < 12 || valueOffset + valueLength > length)
+                    return PdmFsState::UNKNOWN;
+                uint16_t flags = readLe16(attr + valueOffset + 10);
+                return (flags & NTFS_VOLUME_IS_DIRTY) ? PdmFsState::DIRTY : PdmFsState::CLEAN;
+            }
+            attrOffset += length;
+        }
+        return PdmFsState::UNKNOWN;
+    }
+
+    bool readExtFingerprint(int fd, PdmFsFingerprint &fingerprint)
+    {
+        uint8_t sb[EXT_SUPERBLOCK_SIZE];
+        if (!readExact(fd, EXT_SUPERBLOCK_OFFSET, sb, sizeof(sb)) || readLe16(sb + 0x38) != EXT_MAGIC)
+            return false;
+        fingerprint.writeTime = readLe32(sb + 0x30);
+        fingerprint.mountCount = readLe16(sb + 0x34);
+        fingerprint.generation = readLe64(sb + 0x178);
+        return true;
+    }
+
+    bool readFatFingerprint(int fd, PdmFsFingerprint &fingerprint)
+    {
+        uint8_t boot[FAT_BOOT_SECTOR_SIZE];
+        if (!readExact(fd, 0, boot, sizeof(boot)) || boot[510] != 0x55 || boot[511] != 0xAA)
+            return false;
+        uint16_t bytesPerSector = readLe16(boot + 11);
+        uint16_t reservedSectors = readLe16(boot + 14);
+        uint32_t sectorsPerFat = readLe16(boot + 22);
+        if (sectorsPerFat == 0)
+            sectorsPerFat = readLe32(boot + 36);
+        if (bytesPerSector < FAT_BOOT_SECTOR_SIZE || reservedSectors == 0 || sectorsPerFat == 0)
+            return false;
+
+        // Reserved area holds the boot sector and FSInfo, followed by the first FAT
+        uint64_t size = static_cast<uint64_t>(reservedSectors + sectorsPerFat) * bytesPerSector;
+        if (size > PDM_FAT_FINGERPRINT_MAX_BYTES + static_cast<uint64_t>(reservedSectors) * bytesPerSector) {
+            PDM_LOG_DEBUG("PdmSuperblockProbe:%s line: %d FAT of %llu bytes is too big", __FUNCTION__, __LINE__,
+                          static_cast<unsigned long long>(size));
+            return false;
+        }
+        std::vector<uint8_t> chunk(HASH_CHUNK_SIZE);
+        uint64_t hash = FNV_OFFSET_BASIS;
+        for (uint64_t offset = 0; offset < size; offset += HASH_CHUNK_SIZE) {
+            size_t len = static_cast<size_t>(std::min<uint64_t>(HASH_CHUNK_SIZE, size - offset));
+            if (!readExact(fd, offset, chunk.data(), len))
+                return false;
+            hash = hashBytes(hash, chunk.data(), len);
+        }
+        fingerprint.generation = hash;
+        return true;
+    }
+}
+
+bool PdmSuperblockProbe::readFingerprint(const std::string &devPath, const std::string &fsType, PdmFsFingerprint &fingerprint)
+{
+    bool isExt = (fsType == PDM_DRV_TYPE_EXT2 || fsType == PDM_DRV_TYPE_EXT3 || fsType == PDM_DRV_TYPE_EXT4);
+    bool isFat = (fsType == PDM_DRV_TYPE_FAT || fsType == PDM_DRV_TYPE_TFAT);
+    if (!isExt && !isFat)
+        return false;
+
+    int fd = open(devPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        PDM_LOG_WARNING("PdmSuperblockProbe:%s line: %d open %s failed: %s", __FUNCTION__, __LINE__, devPath.c_str(), strerror(errno));
+        return false;
+    }
+    fingerprint = PdmFsFingerprint();
+    bool result = isExt ? readExtFingerprint(fd, fingerprint) : readFatFingerprint(fd, fingerprint);
+    close(fd);
+    return result;
+}
+
+PdmFsState PdmSuperblockProbe::probeState(const std::string &devPath, const std::string &fsType)
+{
+    bool isExt = (fsType == PDM_DRV_TYPE_EXT2 || fsType == PDM_DRV_TYPE_EXT3 || fsType == PDM_DRV_TYPE_EXT4);
+    bool isFat = (fsType == PDM_DRV_TYPE_FAT || fsType == PDM_DRV_TYPE_TFAT);
+    bool isNtfs = (fsType == PDM_DRV_TYPE_NTFS || fsType == PDM_DRV_TYPE_TNTFS);
+    if (!isExt && !isFat && !isNtfs)
+        return PdmFsState::UNKNOWN;
+
+    int fd = open(devPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        PDM_LOG_WARNING("PdmSuperblockProbe:%s line: %d open %s failed: %s", __FUNCTION__, __LINE__, devPath.c_str(), strerror(errno));
+        return PdmFsState::UNKNOWN;
+    }
+    PdmFsState state = isExt ? probeExt(fd) : (isFat ? probeFat(fd) : probeNtfs(fd));
+    close(fd);
+    PDM_LOG_DEBUG("PdmSuperblockProbe:%s line: %d %s (%s) is %s", __FUNCTION__, __LINE__, devPath.c_str(), fsType.c_str(), getStateName(state));
+    return state;
+}
+
+const char* PdmSuperblockProbe::getStateName(PdmFsState state)
+{
+    switch (state) {
+        case PdmFsState::CLEAN: return "clean";
+        case PdmFsState::DIRTY: return "dirty";
+        case PdmFsState::ERROR: return "error";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <pbnjson.hpp>
+
+#include "PdmLogUtils.h"
+#include "PdmUtils.h"
+#include "PdmVolumeRecords.h"
+
+PdmVolumeRecords::PdmVolumeRecords()
+    : m_loaded(false)
+    , m_filePath(PDM_VOLUME_RECORDS_FILE)
+{
+}
+
+PdmVolumeRecords& PdmVolumeRecords::getInstance()
+{
+    static PdmVolumeRecords obj;
+    return obj;
+}
+
+std::string PdmVolumeRecords::makeKey(const std::string &uuid, const std::string &serial)
+{
+    return uuid + "@" + serial;
+}
+
+void PdmVolumeRecords::load()
+{
+    if (m_loaded)
+        return;
+    m_loaded = true;
+
+    pbnjson::JValue records = pbnjson::JDomParser::fromFile(m_filePath.c_str());
+    if (!records.isArray())
+        return;
+    for (const pbnjson::JValue &item : records.items()) {
+        if (!item["key"].isString() || !item["generation"].isString())
+            continue;
+        Record record;
+        record.unmountTime = item["unmountTime"].asNumber<int64_t>();
+        record.fingerprint.mountCount = item["mountCount"].asNumber<int32_t>();
+        record.fingerprint.writeTime = item["writeTime"].asNumber<int64_t>();
+        record.fingerprint.generation = std::strtoull(item["generation"].asString().c_str(), nullptr, 16);
+        m_records[item["key"].asString()] = record;
+    }
+    PDM_LOG_DEBUG("PdmVolumeRecords:%s line: %d loaded %zu records", __FUNCTION__, __LINE__, m_records.size());
+}
+
+void PdmVolumeRecords::save()
+{
+    pbnjson::JValue records = pbnjson::Array();
+    for (const auto &entry : m_records) {
+        char generation[17];
+        snprintf(generation, sizeof(generation), "%016llx", static_cast<unsigned long long>(entry.second.fingerprint.generation));
+        records.append(pbnjson::JObject{{"key", entry.first},
+                                        {"unmountTime", entry.second.unmountTime},
+                                        {"mountCount", static_cast<int64_t>(entry.second.fingerprint.mountCount)},
+                                        {"writeTime", static_cast<int64_t>(entry.second.fingerprint.writeTime)},
+                                        {"generation", std::string(generation)}});
+    }
+
+    size_t pos = m_filePath.find_last_of('/');
+    if (pos != std::string::npos)
+        PdmUtils::createDir(m_filePath.substr(0, pos));
+    // Write a new file and rename it so a crash never leaves half a file
+    std::string tmpPath = m_filePath + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        file << records.stringify();
+        if (!file.good()) {
+            PDM_LOG_ERROR("PdmVolumeRecords:%s line: %d writing %s failed", __FUNCTION__, __LINE__, tmpPath.c_str());
+            return;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), m_filePath.c_str()) != 0)
+        PDM_LOG_ERROR("PdmVolumeRecords:%s line: %d rename to %s failed", __FUNCTION__, __LINE__, m_filePath.c_str());
+}
+
+void PdmVolumeRecords::recordCleanUnmount(const std::string &uuid, const std::string &serial,
+                                          const std::string &devPath, const std::string &fsType)
+{
+    if (uuid.empty())
+        return;
+    Record record;
+    if (!PdmSuperblockProbe::readFingerprint(devPath, fsType, record.fingerprint))
+        return;
+    record.unmountTime = static_cast<int64_t>(time(nullptr));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+    m_records[makeKey(uuid, serial)] = record;
+    while (m_records.size() > PDM_VOLUME_RECORD_LIMIT) {
+        auto oldest = m_records.begin();
+        for (auto it = m_records.begin(); it != m_records.end(); ++it) {
+            if (it->second.unmountTime < oldest->second.unmountTime)
+                oldest = it;
+        }
+        m_records.erase(oldest);
+    }
+    save();
+    PDM_LOG_DEBUG("PdmVolumeRecords:%s line: %d recorded %s, mount count: %u", __FUNCTION__, __LINE__,
+                  devPath.c_str(), record.fingerprint.mountCount);
+}
+
+bool PdmVolumeRecords::takeCleanRecord(const std::string &uuid, const std::string &serial,
+                                       const std::string &devPath, const std::string &fsType)
+{
+    if (uuid.empty())
+        return false;
+    Record record;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        load();
+        auto it = m_records.find(makeKey(uuid, serial));
+        if (it == m_records.end())
+            return false;
+        record = it->second;
+        m_records.erase(it);
+        save();
+    }
+
+    PdmFsFingerprint current;
+    if (!PdmSuperblockProbe::readFingerprint(devPath, fsType, current) || current != record.fingerprint) {
+        PDM_LOG_INFO("PdmVolumeRecords:",0,"%s line: %d %s changed since its clean unmount", __FUNCTION__, __LINE__, devPath.c_str());
+        return false;
+    }
+    PDM_LOG_INFO("PdmVolumeRecords:",0,"%s line: %d %s unchanged since clean unmount at %lld", __FUNCTION__, __LINE__,
+                 devPath.c_str(), static_cast<long long>(record.unmountTime));
+    return true;
+}
+
+void PdmVolumeRecords::forget(const std::string &uuid, const std::string &serial)
+{
+    if (uuid.empty())
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+    if (m_records.erase(makeKey(uuid, serial)))
+        save();
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "PdmDeltaHistory.h"
+
+namespace {
+    // Entries as id and value, e.g. {{"a", 1}, {"b", 2}}
+    using Entries = std::vector<std::pair<std::string, int>>;
+
+    std::string createPayload(const Entries &entries)
+    {
+        std::string payload = "{\"returnValue\":true,\"deviceList\":[";
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (i)
+                payload += ",";
+            payload += "{\"id\":\"" + entries[i].first + "\",\"value\":" + std::to_string(entries[i].second) + "}";
+        }
+        return payload + "]}";
+    }
+
+    // Id and value of each entry of one delta array
+    Entries getEntries(const pbnjson::JValue &delta, const std::string &key)
+    {
+        Entries entries;
+        pbnjson::JValue list = delta[key];
+        for (ssize_t index = 0; index < list.arraySize(); index++)
+            entries.push_back(std::make_pair(list[index]["id"].asString(), list[index]["value"].asNumber<int>()));
+        return entries;
+    }
+
+    uint64_t getSeq(const pbnjson::JValue &delta, const std::string &key)
+    {
+        return static_cast<uint64_t>(delta[key].asNumber<int64_t>());
+    }
+
+    class PdmDeltaHistoryTest : public ::testing::Test {
+    protected:
+        PdmDeltaHistory history{"deviceList", "id"};
+
+        pbnjson::JValue getChangesSince(uint64_t seq)
+        {
+            pbnjson::JValue delta;
+            EXPECT_TRUE(history.getChangesSince(seq, delta));
+            return delta;
+        }
+    };
+}
+
+TEST_F(PdmDeltaHistoryTest, UpdateSkipsPayloadsWithoutListChanges)
+{
+    EXPECT_TRUE(history.update(createPayload({{"a", 1}})));
+    uint64_t seq = history.getSeq();
+    EXPECT_FALSE(history.update(createPayload({{"a", 1}})));
+    EXPECT_FALSE(history.update("{\"returnValue\":false,\"deviceList\":[{\"id\":\"a\",\"value\":1}]}"));
+    EXPECT_EQ(seq, history.getSeq());
+}
+
+TEST_F(PdmDeltaHistoryTest, LastDeltaListsEachKindOfChange)
+{
+    history.update(createPayload({{"a", 1}, {"b", 1}}));
+    history.update(createPayload({{"b", 2}, {"c", 1}}));
+
+    pbnjson::JValue delta = history.getLastDelta();
+    EXPECT_EQ(history.getSeq() - 1, getSeq(delta, "fromSeq"));
+    EXPECT_EQ(history.getSeq(), getSeq(delta, "seq"));
+    EXPECT_EQ(Entries({{"c", 1}}), getEntries(delta, "added"));
+    EXPECT_EQ(Entries({{"b", 2}}), getEntries(delta, "changed"));
+    // Removed entries are reported as they were last seen
+    EXPECT_EQ(Entries({{"a", 1}}), getEntries(delta, "removed"));
+}
+
+TEST_F(PdmDeltaHistoryTest, AddedAndRemovedAgainFoldsAway)
+{
+    history.update(createPayload({{"a", 1}}));
+    uint64_t seq = history.getSeq();
+    history.update(createPayload({{"a", 1}, {"b", 1}}));
+    history.update(createPayload({{"a", 1}, {"b", 2}}));
+    history.update(createPayload({{"a", 1}}));
+
+    pbnjson::JValue delta = getChangesSince(seq);
+    EXPECT_TRUE(getEntries(delta, "added").empty());
+    EXPECT_TRUE(getEntries(delta, "changed").empty());
+    EXPECT_TRUE(getEntries(delta, "removed").empty());
+}
+
+TEST_F(PdmDeltaHistoryTest, RemovedAndAddedAgainFoldsToChanged)
+{
+    history.update(createPayload({{"a", 1}}));
+    uint64_t seq = history.getSeq();
+    history.update(createPayload({}));
+    history.update(createPayload({{"a", 2}}));
+
+    pbnjson::JValue delta = getChangesSince(seq);
+    EXPECT_TRUE(getEntries(delta, "added").empty());
+    EXPECT_EQ(Entries({{"a", 2}}), getEntries(delta, "changed"));
+    EXPECT_TRUE(getEntries(delta, "removed").empty());
+}
+
+TEST_F(PdmDeltaHistoryTest, FoldedChangesKeepTheFirstKindAndTheLastEntry)
+{
+    history.update(createPayload({{"a", 1}, {"b", 1}}));
+    uint64_t seq = history.getSeq();
+    history.update(createPayload({{"a", 2}, {"b", 1}, {"c", 1}}));
+    history.update(createPayload({{"a", 3}, {"c", 2}}));
+
+    pbnjson::JValue delta = getChangesSince(seq);
+    EXPECT_EQ(seq, getSeq(delta, "fromSeq"));
+    EXPECT_EQ(history.getSeq(), getSeq(delta, "seq"));
+    EXPECT_EQ(Entries({{"c", 2}}), getEntries(delta, "added"));
+    EXPECT_EQ(Entries({{"a", 3}}), getEntries(delta, "changed"));
+    EXPECT_EQ(Entries({{"b", 1}}), getEntries(delta, "removed"));
+}
+
+TEST_F(PdmDeltaHistoryTest, ChangesSinceTheCurrentSeqAreEmpty)
+{
+    pbnjson::JValue delta = getChangesSince(history.getSeq());
+    EXPECT_TRUE(getEntries(delta, "added").empty());
+
+    history.update(createPayload({{"a", 1}}));
+    delta = getChangesSince(history.getSeq());
+    EXPECT_EQ(history.getSeq(), getSeq(delta, "fromSeq"));
+    EXPECT_TRUE(getEntries(delta, "added").empty());
+}
+
+TEST_F(PdmDeltaHistoryTest, UnknownSeqIsRejected)
+{
+    pbnjson::JValue delta;
+    // Nothing recorded yet to reach back with
+    EXPECT_FALSE(history.getChangesSince(history.getSeq() - 1, delta));
+    history.update(createPayload({{"a", 1}}));
+    // Handed out by another service instance, or not yet reached
+    EXPECT_FALSE(history.getChangesSince(history.getSeq() + 1, delta));
+}
+
+TEST_F(PdmDeltaHistoryTest, HistoryReachesBackToTheOldestRecord)
+{
+    for (int value = 1; value <= PDM_DELTA_HISTORY_LIMIT + 3; value++)
+        history.update(createPayload({{"a", value}}));
+
+    // The oldest record kept is the one after oldestSeq
+    uint64_t oldestSeq = history.getSeq() - PDM_DELTA_HISTORY_LIMIT;
+    pbnjson::JValue delta = getChangesSince(oldestSeq);
+    EXPECT_EQ(oldestSeq, getSeq(delta, "fromSeq"));
+    EXPECT_EQ(Entries({{"a", PDM_DELTA_HISTORY_LIMIT + 3}}), getEntries(delta, "changed"));
+
+    EXPECT_FALSE(history.getChangesSince(oldestSeq - 1, delta));
+}
@@ -0,0 +1,243 @@
+// Copyright (c) 2024 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "PdmSuperblockProbe.h"
+
+namespace {
+    const size_t SECTOR_SIZE = 512;
+
+    void putLe16(std::vector<uint8_t> &image, size_t offset, uint16_t value)
+    {
+        image[offset] = value & 0xFF;
+        image[offset + 1] = value >> 8;
+    }
+
+    void putLe32(std::vector<uint8_t> &image, size_t offset, uint32_t value)
+    {
+        putLe16(image, offset, value & 0xFFFF);
+        putLe16(image, offset + 2, value >> 16);
+    }
+
+    // FAT12/16 boot sector and FAT[1] of a volume with the given number of
+    // sectors, one reserved sector and two FATs of 64 sectors
+    std::vector<uint8_t> createFat16Image(uint32_t totalSectors, uint16_t fat1)
+    {
+        std::vector<uint8_t> image(4 * SECTOR_SIZE);
+        putLe16(image, 11, SECTOR_SIZE);
+        image[13] = 4;                      // sectors per cluster
+        putLe16(image, 14, 1);              // reserved sectors
+        image[16] = 2;                      // FATs
+        putLe16(image, 17, 512);            // root entries
+        putLe32(image, 32, totalSectors);
+        putLe16(image, 22, 64);             // sectors per FAT
+        image[0x26] = 0x29;                 // extended boot signature
+        image[510] = 0x55;
+        image[511] = 0xAA;
+        putLe16(image, SECTOR_SIZE, 0xFFF8);
+        putLe16(image, SECTOR_SIZE + 2, fat1);
+        return image;
+    }
+
+    // FAT32 boot sector and FAT[1], 32 reserved sectors and two FATs of
+    // 512 sectors
+    std::vector<uint8_t> createFat32Image(uint32_t fat1)
+    {
+        std::vector<uint8_t> image(34 * SECTOR_SIZE);
+        putLe16(image, 11, SECTOR_SIZE);
+        image[13] = 8;
+        putLe16(image, 14, 32);
+        image[16] = 2;
+        putLe32(image, 32, 1000000);
+        putLe32(image, 36, 512);
+        image[0x42] = 0x29;
+        image[510] = 0x55;
+        image[511] = 0xAA;
+        putLe32(image, 32 * SECTOR_SIZE, 0x0FFFFFF8);
+        putLe32(image, 32 * SECTOR_SIZE + 4, fat1);
+        return image;
+    }
+
+    std::vector<uint8_t> createExtImage(uint16_t state, uint32_t incompat)
+    {
+        std::vector<uint8_t> image(4 * SECTOR_SIZE);
+        putLe16(image, 1024 + 0x38, 0xEF53);
+        putLe16(image, 1024 + 0x3A, state);
+        putLe32(image, 1024 + 0x60, incompat);
+        return image;
+    }
+
+    const size_t NTFS_RECORD_SIZE = 1024;
+    const size_t NTFS_VOLUME_RECORD_OFFSET = 4 * SECTOR_SIZE + 3 * NTFS_RECORD_SIZE;
+    const uint16_t NTFS_USN = 0x1234;
+
+    // $Volume record whose $VOLUME_INFORMATION flags sit at the end of the
+    // first sector, so they are only found after undoing the fixups
+    std::vector<uint8_t> createNtfsImage(uint16_t volumeFlags)
+    {
+        std::vector<uint8_t> image(NTFS_VOLUME_RECORD_OFFSET + NTFS_RECORD_SIZE);
+        memcpy(&image[3], "NTFS    ", 8);
+        putLe16(image, 0x0B, SECTOR_SIZE);
+        image[0x0D] = 1;                    // sectors per cluster
+        putLe32(image, 0x30, 4);            // $MFT cluster
+        image[0x40] = 0xF6;                 // 2^10 bytes per record
+
+        size_t record = NTFS_VOLUME_RECORD_OFFSET;
+        memcpy(&image[record], "FILE", 4);
+        putLe16(image, record + 4, 0x30);   // update sequence array offset
+        putLe16(image, record + 6, 3);      // USN and one entry per sector
+        putLe16(image, record + 0x30, NTFS_USN);
+        putLe16(image, record + 0x32, volumeFlags);
+        putLe16(image, record + 0x34, 0);
+
+        size_t attr = 476;
+        putLe16(image, record + 0x14, attr);
+        putLe32(image, record + attr, 0x70);
+        putLe32(image, record + attr + 4, 0x28);
+        putLe32(image, record + attr + 0x10, 12);
+        putLe16(image, record + attr + 0x14, 0x18);
+        putLe32(image, record + attr + 0x28, 0xFFFFFFFF);
+
+        // On disk the last two bytes of each sector hold the USN
+        putLe16(image, record + SECTOR_SIZE - 2, NTFS_USN);
+        putLe16(image, record + 2 * SECTOR_SIZE - 2, NTFS_USN);
+        return image;
+    }
+
+    class PdmSuperblockProbeTest : public ::testing::Test {
+    protected:
+        std::string devPath;
+
+        void TearDown() override
+        {
+            if (!devPath.empty())
+                unlink(devPath.c_str());
+        }
+
+        PdmFsState probe(const std::vector<uint8_t> &image, const std::string &fsType)
+        {
+            if (devPath.empty()) {
+                const char *tmpDir = getenv("TMPDIR");
+                std::string path = std::string(tmpDir ? tmpDir : "/tmp") + "/pdm-probe-XXXXXX";
+                std::vector<char> pathBuffer(path.begin(), path.end());
+                pathBuffer.push_back('\0');
+                int fd = mkstemp(pathBuffer.data());
+                if (fd < 0)
+                    return PdmFsState::UNKNOWN;
+                close(fd);
+                devPath = pathBuffer.data();
+            }
+            FILE *file = fopen(devPath.c_str(), "wb");
+            if (!file)
+                return PdmFsState::UNKNOWN;
+            fwrite(image.data(), 1, image.size(), file);
+            fclose(file);
+            return PdmSuperblockProbe::probeState(devPath, fsType);
+        }
+    };
+}
+
+TEST_F(PdmSuperblockProbeTest, Fat16ReadsTheFlagsOfFat1)
+{
+    EXPECT_EQ(PdmFsState::CLEAN, probe(createFat16Image(65536, 0xFFFF), "vfat"));
+    EXPECT_EQ(PdmFsState::DIRTY, probe(createFat16Image(65536, 0x7FFF), "vfat"));
+    EXPECT_EQ(PdmFsState::ERROR, probe(createFat16Image(65536, 0xBFFF), "vfat"));
+    // A hard error outweighs the volume being dirty
+    EXPECT_EQ(PdmFsState::ERROR, probe(createFat16Image(65536, 0x3FFF), "tfat"));
+}
+
+TEST_F(PdmSuperblockProbeTest, Fat32ReadsTheFlagsOfFat1)
+{
+    EXPECT_EQ(PdmFsState::CLEAN, probe(createFat32Image(0x0FFFFFFF), "vfat"));
+    EXPECT_EQ(PdmFsState::DIRTY, probe(createFat32Image(0x07FFFFFF), "vfat"));
+    EXPECT_EQ(PdmFsState::ERROR, probe(createFat32Image(0x0BFFFFFF), "vfat"));
+}
+
+TEST_F(PdmSuperblockProbeTest, FatBpbStateByteMarksTheVolumeDirty)
+{
+    std::vector<uint8_t> image = createFat16Image(65536, 0xFFFF);
+    image[0x25] = 0x01;
+    EXPECT_EQ(PdmFsState::DIRTY, probe(image, "vfat"));
+    // Without the extended boot signature the byte means nothing
+    image[0x26] = 0x28;
+    EXPECT_EQ(PdmFsState::CLEAN, probe(image, "vfat"));
+
+    image = createFat32Image(0x0FFFFFFF);
+    image[0x41] = 0x01;
+    EXPECT_EQ(PdmFsState::DIRTY, probe(image, "vfat"));
+}
+
+TEST_F(PdmSuperblockProbeTest, Fat12OnlyHasTheBpbStateByte)
+{
+    // Fewer than 4085 clusters, FAT[1] carries no flags
+    std::vector<uint8_t> image = createFat16Image(8000, 0x0000);
+    EXPECT_EQ(PdmFsState::CLEAN, probe(image, "vfat"));
+    image[0x25] = 0x01;
+    EXPECT_EQ(PdmFsState::DIRTY, probe(image, "vfat"));
+}
+
+TEST_F(PdmSuperblockProbeTest, FatWithoutBootSignatureIsUnknown)
+{
+    std::vector<uint8_t> image = createFat16Image(65536, 0xFFFF);
+    image[511] = 0;
+    EXPECT_EQ(PdmFsState::UNKNOWN, probe(image, "vfat"));
+}
+
+TEST_F(PdmSuperblockProbeTest, ExtReadsStateAndNeedsRecovery)
+{
+    EXPECT_EQ(PdmFsState::CLEAN, probe(createExtImage(0x0001, 0), "ext4"));
+    EXPECT_EQ(PdmFsState::DIRTY, probe(createExtImage(0x0000, 0), "ext4"));
+    EXPECT_EQ(PdmFsState::ERROR, probe(createExtImage(0x0003, 0), "ext3"));
+    // Journal not replayed yet
+    EXPECT_EQ(PdmFsState::DIRTY, probe(createExtImage(0x0001, 0x0004), "ext4"));
+    EXPECT_EQ(PdmFsState::CLEAN, probe(createExtImage(0x0001, 0x0002), "ext2"));
+}
+
+TEST_F(PdmSuperblockProbeTest, ExtWithoutMagicIsUnknown)
+{
+    std::vector<uint8_t> image = createExtImage(0x0001, 0);
+    image[1024 + 0x38] = 0;
+    EXPECT_EQ(PdmFsState::UNKNOWN, probe(image, "ext4"));
+}
+
+TEST_F(PdmSuperblockProbeTest, NtfsUndoesTheFixupsBeforeReadingTheFlags)
+{
+    EXPECT_EQ(PdmFsState::CLEAN, probe(createNtfsImage(0x0000), "ntfs"));
+    EXPECT_EQ(PdmFsState::DIRTY, probe(createNtfsImage(0x0001), "ntfs"));
+    EXPECT_EQ(PdmFsState::DIRTY, probe(createNtfsImage(0x0001), "tntfs"));
+}
+
+TEST_F(PdmSuperblockProbeTest, NtfsTornRecordIsUnknown)
+{
+    // A sector whose tail does not match the USN was not fully written
+    std::vector<uint8_t> image = createNtfsImage(0x0000);
+    putLe16(image, NTFS_VOLUME_RECORD_OFFSET + 2 * SECTOR_SIZE - 2, NTFS_USN + 1);
+    EXPECT_EQ(PdmFsState::UNKNOWN, probe(image, "ntfs"));
+}
+
+TEST_F(PdmSuperblockProbeTest, OtherTypesAreUnknown)
+{
+    EXPECT_EQ(PdmFsState::UNKNOWN, probe(createExtImage(0x0001, 0), "exfat"));
+    EXPECT_EQ(PdmFsState::UNKNOWN, PdmSuperblockProbe::probeState("/nonexistent/pdm-probe", "ext4"));
+}